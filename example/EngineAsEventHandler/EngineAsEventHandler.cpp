@@ -80,8 +80,15 @@ int EngineAsEventHandler::Run()
     int ExitCode;
 
     while(1) {
+        BGE_PROFILE_ZONE("Engine::Frame");
+        Timer->BeginFrame();
+
         /* Poll events for all windows */
-        bakge::Window::PollEvents();
+        {
+            bakge::FrameStageScope EventsTime(Timer,
+                                    bakge::FRAME_STAGE_EVENTS);
+            bakge::Window::PollEvents();
+        }
 
         if(AppWindow->IsOpen() == false) {
             printf("Closing EngineAsEventHandler window\n");
@@ -89,10 +96,45 @@ int EngineAsEventHandler::Run()
             break;
         }
 
-        Update(0);
-        PreRenderStage();
-        RenderStage();
-        PostRenderStage();
+        /* Run callbacks for sockets that are ready */
+        {
+            BGE_PROFILE_ZONE("Engine::ServiceNetwork");
+            bakge::FrameStageScope NetworkTime(Timer,
+                                    bakge::FRAME_STAGE_NETWORK);
+            ServiceNetwork();
+        }
+
+        {
+            BGE_PROFILE_ZONE("Engine::Update");
+            bakge::FrameStageScope UpdateTime(Timer,
+                                    bakge::FRAME_STAGE_UPDATE);
+            Timestep->BeginFrame();
+            while(Timestep->Step())
+                Update(Timestep->GetStepSize());
+        }
+
+        {
+            BGE_PROFILE_ZONE("Engine::PreRenderStage");
+            bakge::FrameStageScope PreRenderTime(Timer,
+                                    bakge::FRAME_STAGE_PRE_RENDER);
+            PreRenderStage();
+        }
+
+        {
+            BGE_PROFILE_ZONE("Engine::RenderStage");
+            bakge::FrameStageScope RenderTime(Timer,
+                                    bakge::FRAME_STAGE_RENDER);
+            RenderStage();
+        }
+
+        {
+            BGE_PROFILE_ZONE("Engine::PostRenderStage");
+            bakge::FrameStageScope PostRenderTime(Timer,
+                                    bakge::FRAME_STAGE_POST_RENDER);
+            PostRenderStage();
+        }
+
+        EndFrame();
     }
 
     return ExitCode;
@@ -28,9 +28,14 @@
 /* Include standard library dependencies */
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <float.h>
+#include <atomic>
+#include <new>
+#include <type_traits>
 
 /* GCC & Clang attributes */
 #if defined __GNUC__ || defined __clang__ || defined __MINGW__
@@ -72,6 +77,8 @@
 #define BGE_FACTORY static BGE_WUNUSED
 #define BGE_NCP const&
 #define BGE_INL inline
+/* Cache line size; keep data written by different threads this far apart */
+#define BGE_CACHE_LINE 64
 #define BGE_VER_MAJ 0
 #define BGE_VER_MIN 0
 #define BGE_VER_REV 0
@@ -95,12 +102,22 @@ extern "C"
 #include <stb/stb_truetype.h>
 #define STB_TRUETYPE_IMPLEMENTATION
 
-/* Include core Bakge classes */
+/* Basic types */
 #include <bakge/core/Type.h>
+
+/* Memory modules; core classes allocate from these */
+#include <bakge/memory/MemoryTracker.h>
+#include <bakge/memory/LinearArena.h>
+#include <bakge/memory/StackAllocator.h>
+#include <bakge/memory/DoubleBufferedArena.h>
+#include <bakge/memory/ObjectPool.h>
+
+/* Include core Bakge classes */
 #include <bakge/core/Input.h>
 #include <bakge/core/Utility.h>
 #include <bakge/core/Bindable.h>
 #include <bakge/core/Drawable.h>
+#include <bakge/core/Broadphase.h>
 #include <bakge/core/Renderer.h>
 #include <bakge/core/Engine.h>
 #include <bakge/core/EventHandler.h>
@@ -108,18 +125,41 @@ extern "C"
 
 /* System modules */
 #include <bakge/system/Clock.h>
+#include <bakge/system/PreciseDelay.h>
+#include <bakge/system/FixedTimestep.h>
+#include <bakge/system/FrameTimer.h>
+#include <bakge/system/Profiler.h>
+#include <bakge/system/JobScheduler.h>
 
 /* Math modules */
 #include <bakge/math/Math.h>
+#include <bakge/math/SIMD.h>
+#include <bakge/math/FastMath.h>
 #include <bakge/math/Vector3.h>
 #include <bakge/math/Vector4.h>
 #include <bakge/math/Matrix.h>
 #include <bakge/math/Quaternion.h>
+#include <bakge/math/VectorStream.h>
+#include <bakge/math/Transform.h>
+#include <bakge/math/DualQuaternion.h>
+#include <bakge/math/BoundingBox.h>
+#include <bakge/math/BoundingSphere.h>
+#include <bakge/math/Frustum.h>
 
 /* Data structure modules */
 #include <bakge/data/File.h>
 #include <bakge/data/SingleNode.h>
+#include <bakge/data/PoolAllocator.h>
+#include <bakge/data/HeapAllocator.h>
 #include <bakge/data/LinkedList.h>
+#include <bakge/data/SmallVector.h>
+#include <bakge/data/FlatHashMap.h>
+#include <bakge/data/SlotMap.h>
+#include <bakge/data/SPSCQueue.h>
+#include <bakge/data/MPMCQueue.h>
+#include <bakge/data/BoundingVolumeHierarchy.h>
+#include <bakge/data/LooseOctree.h>
+#include <bakge/data/UniformGrid.h>
 
 /* Network modules */
 #include <bakge/network/Remote.h>
@@ -129,6 +169,7 @@ extern "C"
 #include <bakge/api/Mutex.h>
 #include <bakge/api/Thread.h>
 #include <bakge/api/Socket.h>
+#include <bakge/api/Reactor.h>
 
 /* Utility headers */
 #include <bakge/input/XBoxController.h>
@@ -142,6 +183,11 @@ extern "C"
 #include <bakge/platform/osx_Bakge.h>
 #endif /* __linux__ */
 
+/* Locks built on the platform ones */
+#include <bakge/mutex/SpinLock.h>
+#include <bakge/mutex/AdaptiveMutex.h>
+#include <bakge/mutex/ScopedLock.h>
+
 /* Additional Bakge classes */
 #include <bakge/graphics/Shader.h>
 #include <bakge/graphics/ShaderProgram.h>
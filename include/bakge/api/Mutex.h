@@ -27,23 +27,115 @@
 
 namespace bakge
 {
+
+/* *
+ * Counters kept by each lock in debug builds. Times are in nanoseconds,
+ * and only exclusive holds are timed.
+ * */
+struct LockStats
+{
+    uint64_t NumAcquired;
+    uint64_t NumContended; /* Acquires that found the lock already held */
+    uint64_t HoldTime;
+    uint64_t MaxHoldTime;
+};
+
 namespace api
 {
 
 class BGE_API Mutex
 {
 
+#ifdef _DEBUG
+    std::atomic<uint64_t> NumAcquired;
+    std::atomic<uint64_t> NumContended;
+    std::atomic<uint64_t> HoldTime;
+    std::atomic<uint64_t> MaxHoldTime;
+
+    /* When the current exclusive hold began */
+    uint64_t HoldStart;
+#endif /* _DEBUG */
+
+
 protected:
 
     Mutex();
 
+#ifdef _DEBUG
+    /* Implementations call these after locking and before unlocking */
+    void Acquired(bool Contended);
+    void AcquiredShared(bool Contended);
+    void Releasing();
+#endif /* _DEBUG */
+
 
 public:
 
     virtual ~Mutex();
 
+    /* Blocks until the calling thread holds the lock */
+    virtual Result Lock() = 0;
+
+    /* Takes the lock only if no thread holds it, without blocking */
+    virtual bool TryLock() = 0;
+
+    virtual Result Unlock() = 0;
+
+#ifdef _DEBUG
+    LockStats GetStats() const;
+    void ResetStats();
+#endif /* _DEBUG */
+
 }; /* Mutex */
 
+
+/* *
+ * Any number of readers can hold the lock at once, or a single writer.
+ * Lock, TryLock and Unlock are the writer's side.
+ * */
+class BGE_API ReaderWriterLock : public Mutex
+{
+
+protected:
+
+    ReaderWriterLock();
+
+
+public:
+
+    virtual ~ReaderWriterLock();
+
+    virtual Result LockShared() = 0;
+    virtual bool TryLockShared() = 0;
+    virtual Result UnlockShared() = 0;
+
+}; /* ReaderWriterLock */
+
+
+/* *
+ * Lets threads sleep until another signals them. Wait takes the platform
+ * Mutex, so each platform declares its own.
+ * */
+class BGE_API ConditionVariable
+{
+
+protected:
+
+    ConditionVariable();
+
+
+public:
+
+    virtual ~ConditionVariable();
+
+    /* Wake one waiting thread */
+    virtual Result Signal() = 0;
+
+    /* Wake every waiting thread */
+    virtual Result Broadcast() = 0;
+
+}; /* ConditionVariable */
+
 } /* api */
 } /* bakge */
 
@@ -0,0 +1,131 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_API_REACTOR_H
+#define BAKGE_API_REACTOR_H
+
+/* Socket events a reactor watches for and reports, as bit flags */
+#define BGE_SOCKET_READABLE 0x1
+#define BGE_SOCKET_WRITABLE 0x2
+
+/* Reported whether asked for or not */
+#define BGE_SOCKET_ERROR 0x4
+
+/* Most ready sockets one Poll handles */
+#define BGE_REACTOR_BATCH 64
+
+namespace bakge
+{
+
+/* Called by Poll for ready sockets that were added with a callback */
+typedef void (*SocketEventCallback)(api::Socket* Sock, int Events,
+                                                    void* UserData);
+
+/* Reported by Poll for ready sockets that were added without one */
+struct SocketEvent
+{
+    api::Socket* Sock;
+    int Events;
+    void* UserData;
+};
+
+/* Defined in src/api/Reactor.cpp */
+struct ReactorEntry;
+
+namespace api
+{
+
+/* *
+ * Waits on many sockets at once, so one thread can service all of
+ * them: give it non-blocking sockets and call Poll from the main loop
+ * or a network thread. Readiness is level-triggered; a socket stays
+ * ready until it's drained, so events Poll had no room for come back
+ * on the next call.
+ *
+ * Remove sockets before deleting them. A callback may add or remove
+ * sockets, including its own, while Poll is running.
+ * */
+class BGE_API Reactor
+{
+    FlatHashMap<Socket*, ReactorEntry*> Entries;
+
+    /* Removed during Poll; freed when it finishes */
+    ReactorEntry* Retired;
+    bool Dispatching;
+
+
+protected:
+
+    Reactor();
+
+    /* *
+     * Platform parts. Wait reports each ready socket by the Key it was
+     * watched with; it returns 0 on timeout or wakeup and -1 on error.
+     * */
+    virtual Result Watch(intptr_t Handle, int Events, void* Key) = 0;
+    virtual Result Rewatch(intptr_t Handle, int Events, void* Key) = 0;
+    virtual Result Unwatch(intptr_t Handle) = 0;
+    virtual int Wait(void** Keys, int* Events, int MaxReady,
+                                            Seconds Timeout) = 0;
+
+
+public:
+
+    virtual ~Reactor();
+
+    /* *
+     * Starts watching Sock for Events. Poll calls Callback for the
+     * socket's events if there is one, and reports them otherwise.
+     * */
+    Result Add(Socket* Sock, int Events, SocketEventCallback Callback = NULL,
+                                                    void* UserData = NULL);
+
+    /* Changes which events Sock is watched for */
+    Result Modify(Socket* Sock, int Events);
+
+    Result Remove(Socket* Sock);
+
+    /* *
+     * Waits up to Timeout seconds for sockets to become ready; 0 checks
+     * without waiting and a negative Timeout waits until something
+     * happens. Runs callbacks and writes up to MaxEvents other events
+     * into Events, which may be NULL. Returns how many were written,
+     * or -1 on error.
+     * */
+    int Poll(SocketEvent* Events, int MaxEvents, Seconds Timeout);
+
+    /* Makes a Poll in progress or the next one return. Any thread */
+    virtual Result Wake() = 0;
+
+    BGE_INL int GetNumSockets() const
+    {
+        return Entries.GetSize();
+    }
+
+}; /* Reactor */
+
+} /* api */
+} /* bakge */
+
+#endif /* BAKGE_API_REACTOR_H */
@@ -25,6 +25,9 @@
 #ifndef BAKGE_API_SOCKET_H
 #define BAKGE_API_SOCKET_H
 
+/* Most datagrams a batched call moves with one system call */
+#define BGE_SOCKET_BATCH 64
+
 namespace bakge
 {
 namespace api
@@ -35,6 +38,8 @@ class BGE_API Socket
 
 protected:
 
+    bool Blocking;
+
     Socket();
 
 
@@ -42,10 +47,53 @@ public:
 
     virtual ~Socket();
 
-    /* Prototypes likely to change! */
+    /* *
+     * Receive returns NULL on error, or on a non-blocking socket when
+     * nothing has arrived. Datagrams larger than BGE_PACKET_CAPACITY
+     * are dropped rather than cut short.
+     * */
     virtual Packet* Receive() = 0;
     virtual Result Send(Remote* Destination, Packet* Data) = 0;
 
+    /* *
+     * Sockets start out blocking. Non-blocking ones return at once when
+     * there is nothing to receive or no room to send, so one thread can
+     * service many of them through a Reactor.
+     * */
+    virtual Result SetBlocking(bool Block) = 0;
+
+    BGE_INL bool IsBlocking() const
+    {
+        return Blocking;
+    }
+
+    /* Port the socket is bound to; useful after binding to port 0 */
+    virtual int GetPort() const = 0;
+
+    /* The operating system's handle for the socket */
+    virtual intptr_t GetHandle() const = 0;
+
+    /* *
+     * Waits for at least one packet, then takes up to MaxPackets that
+     * have already arrived, without waiting for more. New packets are
+     * put in Packets; returns how many, or -1 on error. Non-blocking
+     * sockets don't wait, and return 0 if nothing has arrived.
+     * Datagrams too large for a packet are dropped, so 0 is also
+     * returned when every one that arrived was.
+     *
+     * This version receives one packet per call. Platforms that can
+     * move many datagrams per system call override it.
+     * */
+    virtual int ReceiveMany(Packet** Packets, int MaxPackets);
+
+    /* *
+     * Sends Packets[i] to Destinations[i] for each of NumPackets.
+     * Returns how many were sent, stopping at the first failure.
+     * This version calls Send for each packet.
+     * */
+    virtual int SendMany(Remote* Destinations, Packet** Packets,
+                                                    int NumPackets);
+
 }; /* Socket */
 
 } /* api */
@@ -0,0 +1,93 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_CORE_BROADPHASE_H
+#define BAKGE_CORE_BROADPHASE_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+class BoundingBox;
+
+/* Two objects whose boxes overlap, by handle. A is the lower handle */
+struct BroadphasePair
+{
+    int A;
+    int B;
+};
+
+/* *
+ * A broadphase tracks the bounding boxes of many objects and quickly finds
+ * which of them a box touches, or which of them touch each other, so only
+ * those few need closer tests.
+ *
+ * Each object is identified by an int handle, with a user data pointer
+ * (e.g. its Pawn). Implementations trade build cost against query cost in
+ * different ways; see BoundingVolumeHierarchy, LooseOctree and UniformGrid.
+ * */
+class BGE_API Broadphase
+{
+
+public:
+
+    Broadphase();
+    virtual ~Broadphase();
+
+    /* Returns the new object's handle, or -1 if it couldn't be added */
+    virtual int Insert(BoundingBox BGE_NCP Box, void* Data) = 0;
+    virtual Result Remove(int Handle) = 0;
+
+    /* *
+     * Give an object new bounds. Returns true if the structure had to move
+     * it, or false if only its stored box changed. Handles that aren't
+     * objects in the structure are refused with false.
+     * */
+    virtual bool Update(int Handle, BoundingBox BGE_NCP Box) = 0;
+
+    virtual void Clear() = 0;
+
+    virtual void* GetData(int Handle) const = 0;
+    virtual BoundingBox BGE_NCP GetBox(int Handle) const = 0;
+    virtual int GetNumObjects() const = 0;
+
+    /* *
+     * Write the handles of objects touching Box to Results, stopping after
+     * MaxResults. Returns the number written.
+     * */
+    virtual int Query(BoundingBox BGE_NCP Box, int* Results,
+                                        int MaxResults) const = 0;
+
+    /* *
+     * Write each pair of objects whose boxes overlap to Pairs once,
+     * stopping after MaxPairs. Returns the number written.
+     * */
+    virtual int FindPairs(BroadphasePair* Pairs, int MaxPairs) const = 0;
+
+}; /* Broadphase */
+
+} /* bakge */
+
+#endif /* BAKGE_CORE_BROADPHASE_H */
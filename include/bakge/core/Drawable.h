@@ -30,6 +30,8 @@
 namespace bakge
 {
 
+class BoundingBox;
+
 class BGE_API Drawable : public Bindable
 {
 
@@ -40,6 +42,13 @@ public:
 
     virtual Result Draw() const = 0;
 
+    /* *
+     * World space bounds, which renderers use to skip objects that are
+     * out of view. Drawables without bounds return an empty box and are
+     * never culled.
+     * */
+    virtual BoundingBox GetBoundingBox() const;
+
 }; /* Drawable */
 
 } /* bakge */
@@ -27,12 +27,55 @@
 
 #include <bakge/Bakge.h>
 
+/* Size of the arena for scratch memory used within one frame */
+#define BGE_FRAME_ARENA_SIZE (1024 * 1024)
+
+/* Size of each half of the arena for data lasting into the next frame */
+#define BGE_CROSS_FRAME_ARENA_SIZE (256 * 1024)
+
 namespace bakge
 {
 
+class LinearArena;
+class DoubleBufferedArena;
+class FixedTimestep;
+class FrameTimer;
+
+namespace api
+{
+class Reactor;
+} /* api */
+
 class BGE_API Engine
 {
 
+protected:
+
+    /* Freed at the end of every main loop iteration */
+    LinearArena* FrameArena;
+
+    /* Allocations last until the end of the following iteration */
+    DoubleBufferedArena* CrossFrameArena;
+
+    /* *
+     * Run drives Update from this, once per step of simulation time.
+     * Starts at BGE_DEFAULT_TIMESTEP.
+     * */
+    FixedTimestep* Timestep;
+
+    /* *
+     * Times the stages of each frame and paces the main loop, at
+     * BGE_DEFAULT_FRAME_RATE to start with.
+     * */
+    FrameTimer* Timer;
+
+    /* *
+     * Sockets the main loop services each frame, through ServiceNetwork.
+     * Add non-blocking sockets with callbacks to it.
+     * */
+    api::Reactor* Network;
+
+
 public:
 
     Engine();
@@ -52,6 +95,13 @@ public:
      * */
     virtual Result Update(Seconds DeltaTime) = 0;
 
+    /* *
+     * Run calls this once per frame, after polling input events. By
+     * default it runs the callbacks of sockets in the reactor that are
+     * ready, without waiting for any that aren't.
+     * */
+    virtual Result ServiceNetwork();
+
     /* *
      * Rendering is split up into 3 stages, to allow for flexible
      * rendering targets such as offscreen framebuffers or textures.
@@ -68,6 +118,38 @@ public:
     virtual Result RenderStage() = 0;
     virtual Result PostRenderStage() = 0;
 
+    /* *
+     * Run calls this last in each iteration of the main loop. It frees
+     * the frame arena and the cross-frame memory of the frame before,
+     * then waits until the next frame is due.
+     * */
+    virtual Result EndFrame();
+
+    BGE_INL LinearArena* GetFrameArena() const
+    {
+        return FrameArena;
+    }
+
+    BGE_INL DoubleBufferedArena* GetCrossFrameArena() const
+    {
+        return CrossFrameArena;
+    }
+
+    BGE_INL FixedTimestep* GetTimestep() const
+    {
+        return Timestep;
+    }
+
+    BGE_INL FrameTimer* GetFrameTimer() const
+    {
+        return Timer;
+    }
+
+    BGE_INL api::Reactor* GetReactor() const
+    {
+        return Network;
+    }
+
 }; /* Engine */
 
 } /* bakge */
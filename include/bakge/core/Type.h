@@ -43,6 +43,13 @@ typedef unsigned long long Microseconds;
 typedef uint64_t Microseconds;
 #endif
 
+/* Signed so that differences between two timestamps can be negative */
+#ifdef _WIN32
+typedef long long Nanoseconds;
+#else
+typedef int64_t Nanoseconds;
+#endif /* _WIN32 */
+
 /* *
  * GLFW uses doubles for its mouse/scroll motion measurements.
  * Better to just deal with doubles than with casting to integral types
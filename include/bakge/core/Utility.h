@@ -56,6 +56,9 @@ BGE_FUNC Result Deinit();
 
 BGE_FUNC void SystemInfo();
 
+/* Number of processors available to run threads, at least 1 */
+BGE_FUNC int GetNumProcessors();
+
 BGE_WUNUSED BGE_FUNC Byte* LoadFileContents(const char* Path);
 
 } /* bakge */
@@ -72,6 +72,8 @@ public:
 
     BGE_FACTORY Window* Create(int Width, int Height);
 
+    BGE_POOLED_DECLARE
+
     /* Call manually to process events for all windows */
     static void PollEvents();
 
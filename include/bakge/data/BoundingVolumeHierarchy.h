@@ -0,0 +1,164 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_BOUNDINGVOLUMEHIERARCHY_H
+#define BAKGE_DATA_BOUNDINGVOLUMEHIERARCHY_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Dynamic bounding volume hierarchy of axis-aligned boxes, for finding
+ * which objects a box, sphere, frustum or ray touches without testing
+ * every one of them.
+ *
+ * Each object is a leaf identified by an int handle, with a user data
+ * pointer (e.g. its Pawn). Build creates a tree from scratch using the
+ * surface area heuristic and is the best choice for a whole scene.
+ * Insert, Remove and Update then change it incrementally, keeping it
+ * balanced with tree rotations.
+ *
+ * Nodes live in one flat array. A freshly built tree stores each node's
+ * subtree after it, so queries walk memory mostly forwards.
+ *
+ * Leaves store their box grown by a margin (see SetMargin) so objects
+ * that move a little don't need to be reinserted on every Update. Queries
+ * test those grown boxes, so they can report objects that are up to the
+ * margin away.
+ * */
+class BGE_API BoundingVolumeHierarchy : public Broadphase
+{
+    struct TreeNode
+    {
+        BoundingBox Box;
+        void* Data;
+
+        /* Links to other nodes, or -1. Parent links free nodes together */
+        int Parent;
+        int Left;
+        int Right;
+
+        /* 0 for leaves, -1 for free nodes */
+        int Height;
+    };
+
+    TreeNode* Nodes;
+    int Capacity;
+    int FreeList;
+    int Root;
+    int NumObjects;
+    Scalar Margin;
+
+    int AllocateNode();
+    void FreeNode(int Index);
+    Result Reserve(int NumNodes);
+
+    /* Fails if no node can be allocated for the leaf's new parent */
+    Result InsertLeaf(int Leaf);
+    void RemoveLeaf(int Leaf);
+    int Balance(int Index);
+
+    int BuildRange(int* Indices, const BoundingBox* Boxes,
+                    const Scalar* Centroids, int Begin, int End, int Depth);
+
+
+protected:
+
+    BoundingVolumeHierarchy();
+
+
+public:
+
+    virtual ~BoundingVolumeHierarchy();
+
+    BGE_FACTORY BoundingVolumeHierarchy* Create();
+
+    /* *
+     * Replace the tree's contents with Num objects. Handles receives the
+     * handle of each object, in the order of Boxes. Data may be NULL.
+     * */
+    Result Build(const BoundingBox* Boxes, void* const* Data, int Num,
+                                                        int* Handles);
+
+    /* Returns the new object's handle, or -1 if it couldn't be added */
+    virtual int Insert(BoundingBox BGE_NCP Box, void* Data);
+    virtual Result Remove(int Handle);
+
+    /* *
+     * Give an object new bounds. Returns true if it had to be reinserted,
+     * or false if the new bounds still fit in its grown box or Handle
+     * isn't an object in the tree.
+     * */
+    virtual bool Update(int Handle, BoundingBox BGE_NCP Box);
+
+    virtual void Clear();
+
+    /* Distance leaves' boxes are grown by on each side. Defaults to 0 */
+    void SetMargin(Scalar Distance);
+    Scalar GetMargin() const;
+
+    virtual void* GetData(int Handle) const;
+
+    /* The object's box, grown by the margin */
+    virtual BoundingBox BGE_NCP GetBox(int Handle) const;
+
+    virtual int GetNumObjects() const;
+
+    /* Levels below the root; 0 for a single object, -1 when empty */
+    int GetHeight() const;
+
+    /* *
+     * Queries write the handles of the objects they touch to Results,
+     * stopping after MaxResults. They return the number written.
+     * */
+    virtual int Query(BoundingBox BGE_NCP Box, int* Results,
+                                            int MaxResults) const;
+    int Query(BoundingSphere BGE_NCP Sphere, int* Results,
+                                                int MaxResults) const;
+    int Query(Frustum BGE_NCP View, int* Results, int MaxResults) const;
+
+    /* Pairs of objects whose grown boxes overlap */
+    virtual int FindPairs(BroadphasePair* Pairs, int MaxPairs) const;
+
+    /* *
+     * Objects whose boxes the ray from Origin along Direction enters
+     * within MaxDistance. Distances are in multiples of Direction.
+     * */
+    int Raycast(Vector4 BGE_NCP Origin, Vector4 BGE_NCP Direction,
+            Scalar MaxDistance, int* Results, int MaxResults) const;
+
+    /* *
+     * The object whose box the ray enters first, or -1 if it hits none.
+     * Distance, if not NULL, receives the distance to that box.
+     * */
+    int RaycastClosest(Vector4 BGE_NCP Origin, Vector4 BGE_NCP Direction,
+                            Scalar MaxDistance, Scalar* Distance) const;
+
+}; /* BoundingVolumeHierarchy */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_BOUNDINGVOLUMEHIERARCHY_H */
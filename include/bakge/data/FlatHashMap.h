@@ -0,0 +1,488 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_FLATHASHMAP_H
+#define BAKGE_DATA_FLATHASHMAP_H
+
+#include <bakge/Bakge.h>
+
+/* Control bytes for slots without a value; full slots hold 7 hash bits */
+#define BGE_FLATMAP_EMPTY ((signed char)-128)
+#define BGE_FLATMAP_DELETED ((signed char)-2)
+
+/* Slots probed at once */
+#define BGE_FLATMAP_GROUP 16
+
+namespace bakge
+{
+
+/* Mixes the bits of an integer so keys that differ slightly spread out */
+BGE_INL uint64_t MixHash(uint64_t Key)
+{
+    /* Finalizer from SplitMix64 */
+    Key ^= Key >> 30;
+    Key *= 0xBF58476D1CE4E5B9ULL;
+    Key ^= Key >> 27;
+    Key *= 0x94D049BB133111EBULL;
+    Key ^= Key >> 31;
+
+    return Key;
+}
+
+
+/* Default FlatHashMap hash for integer keys */
+template<class K>
+struct FlatHash
+{
+    size_t operator()(K BGE_NCP Key) const
+    {
+        return (size_t)MixHash((uint64_t)Key);
+    }
+};
+
+
+/* Pointer keys hash by address */
+template<class K>
+struct FlatHash<K*>
+{
+    size_t operator()(K* Key) const
+    {
+        return (size_t)MixHash((uint64_t)(uintptr_t)Key);
+    }
+};
+
+
+/* *
+ * Hash map storing keys and values directly in one array, instead of in
+ * a node per entry like std::unordered_map. Collisions are resolved by
+ * probing to other slots in the array.
+ *
+ * Alongside the array is one control byte per slot: empty, deleted, or 7
+ * bits of the hash of the key stored there. Lookups check 16 control
+ * bytes at a time, with one SSE2 compare where available and 64-bit
+ * integer tricks elsewhere, and only compare keys whose bits match, so
+ * most misses never touch the keys.
+ *
+ * Inserting may move every entry, invalidating pointers from Find. Keys
+ * need ==; Hash must be a functor returning size_t for a key.
+ * */
+template<class K, class V, class Hash = FlatHash<K>,
+                                class Allocator = HeapAllocator<Byte> >
+class FlatHashMap
+{
+    struct Entry
+    {
+        K Key;
+        V Value;
+    };
+
+    signed char* Control;
+    Entry* Entries;
+    int Capacity;
+    int Size;
+    int NumDeleted;
+
+    Hash Hasher;
+    Allocator Memory;
+
+    /* Copying isn't supported */
+    FlatHashMap(const FlatHashMap&);
+    void operator=(const FlatHashMap&);
+
+#ifndef BGE_SIMD_SSE
+    /* Eight control bytes as one integer, first byte lowest */
+    static uint64_t LoadWord(const signed char* Bytes)
+    {
+        uint64_t Word;
+
+        memcpy(&Word, Bytes, sizeof(Word));
+#if defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        Word = __builtin_bswap64(Word);
+#endif /* __BYTE_ORDER__ */
+
+        return Word;
+    }
+
+    /* Pack the top bit of each byte into the low 8 bits */
+    static unsigned int Gather(uint64_t TopBits)
+    {
+        return (unsigned int)(((TopBits >> 7) * 0x0102040810204080ULL)
+                                                                    >> 56);
+    }
+
+    /* *
+     * Bytes equal to Byte have their top bit set. May also flag a byte
+     * after a match, which is fine since keys are compared anyway.
+     * */
+    static unsigned int MatchWord(uint64_t Word, signed char Byte)
+    {
+        Word ^= 0x0101010101010101ULL * (unsigned char)Byte;
+
+        return Gather((Word - 0x0101010101010101ULL) & ~Word
+                                            & 0x8080808080808080ULL);
+    }
+#endif /* BGE_SIMD_SSE */
+
+    /* Bit i is set if Group[i] is Byte, and maybe a few more */
+    static unsigned int Match(const signed char* Group, signed char Byte)
+    {
+#ifdef BGE_SIMD_SSE
+        __m128i Bytes = _mm_loadu_si128((const __m128i*)Group);
+
+        return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(Bytes,
+                                                    _mm_set1_epi8(Byte)));
+#else
+        return MatchWord(LoadWord(Group), Byte)
+                        | MatchWord(LoadWord(Group + 8), Byte) << 8;
+#endif /* BGE_SIMD_SSE */
+    }
+
+    /* Bit i is set if slot i is empty; exactly, since probing relies on it */
+    static unsigned int MatchEmpty(const signed char* Group)
+    {
+#ifdef BGE_SIMD_SSE
+        return Match(Group, BGE_FLATMAP_EMPTY);
+#else
+        /* Empty has the top bit set and the next clear; nothing else does */
+        uint64_t Low = LoadWord(Group);
+        uint64_t High = LoadWord(Group + 8);
+
+        return Gather(Low & (~Low << 1) & 0x8080808080808080ULL)
+            | Gather(High & (~High << 1) & 0x8080808080808080ULL) << 8;
+#endif /* BGE_SIMD_SSE */
+    }
+
+    /* Bit i is set if slot i is empty or deleted */
+    static unsigned int MatchFree(const signed char* Group)
+    {
+        /* Only free slots have the top bit set */
+#ifdef BGE_SIMD_SSE
+        return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128(
+                                                (const __m128i*)Group));
+#else
+        return Gather(LoadWord(Group) & 0x8080808080808080ULL)
+            | Gather(LoadWord(Group + 8) & 0x8080808080808080ULL) << 8;
+#endif /* BGE_SIMD_SSE */
+    }
+
+    static int LowestBit(unsigned int Mask)
+    {
+#if defined __GNUC__ || defined __clang__
+        return __builtin_ctz(Mask);
+#else
+        int Bit = 0;
+
+        while((Mask & 1) == 0) {
+            Mask >>= 1;
+            ++Bit;
+        }
+
+        return Bit;
+#endif /* __GNUC__ */
+    }
+
+    static signed char Tag(size_t HashValue)
+    {
+        return (signed char)(HashValue & 0x7F);
+    }
+
+    /* *
+     * Groups are visited 1, 2, 3... groups apart. With a power of two
+     * groups this visits every one, and there's always an empty slot
+     * somewhere, so probing ends.
+     * */
+    int FindEntry(K BGE_NCP Key) const
+    {
+        size_t HashValue;
+        signed char KeyTag;
+        int GroupMask, Group;
+
+        if(Capacity == 0)
+            return -1;
+
+        HashValue = Hasher(Key);
+        KeyTag = Tag(HashValue);
+        GroupMask = Capacity / BGE_FLATMAP_GROUP - 1;
+        Group = (int)((HashValue >> 7) & GroupMask);
+
+        for(int Step = 1; ; ++Step) {
+            const signed char* Bytes = Control + Group * BGE_FLATMAP_GROUP;
+            unsigned int Matches = Match(Bytes, KeyTag);
+
+            while(Matches != 0) {
+                int Slot = Group * BGE_FLATMAP_GROUP + LowestBit(Matches);
+
+                if(Entries[Slot].Key == Key)
+                    return Slot;
+
+                Matches &= Matches - 1;
+            }
+
+            /* Inserting would have stopped here, so the key isn't past it */
+            if(MatchEmpty(Bytes) != 0)
+                return -1;
+
+            Group = (Group + Step) & GroupMask;
+        }
+    }
+
+    /* First empty or deleted slot along the key's probe sequence */
+    int FindFree(size_t HashValue) const
+    {
+        int GroupMask = Capacity / BGE_FLATMAP_GROUP - 1;
+        int Group = (int)((HashValue >> 7) & GroupMask);
+
+        for(int Step = 1; ; ++Step) {
+            unsigned int Free = MatchFree(Control + Group * BGE_FLATMAP_GROUP);
+
+            if(Free != 0)
+                return Group * BGE_FLATMAP_GROUP + LowestBit(Free);
+
+            Group = (Group + Step) & GroupMask;
+        }
+    }
+
+    void Rehash(int NewCapacity)
+    {
+        signed char* OldControl = Control;
+        Entry* OldEntries = Entries;
+        int OldCapacity = Capacity;
+
+        Control = (signed char*)Memory.AllocateArray(NewCapacity);
+        Entries = (Entry*)Memory.AllocateArray(NewCapacity * sizeof(Entry));
+        Capacity = NewCapacity;
+        NumDeleted = 0;
+        memset(Control, BGE_FLATMAP_EMPTY, NewCapacity);
+
+        for(int i = 0; i < OldCapacity; ++i) {
+            if(OldControl[i] < 0)
+                continue;
+
+            size_t HashValue = Hasher(OldEntries[i].Key);
+            int Slot = FindFree(HashValue);
+
+            Control[Slot] = Tag(HashValue);
+            new (&Entries[Slot]) Entry(std::move(OldEntries[i]));
+            OldEntries[i].~Entry();
+        }
+
+        if(OldCapacity > 0) {
+            Memory.FreeArray((Byte*)OldControl, OldCapacity);
+            Memory.FreeArray((Byte*)OldEntries, OldCapacity * sizeof(Entry));
+        }
+    }
+
+    /* Capacity keeping the map at most 7/16 full after Count entries */
+    static int CapacityFor(int Count)
+    {
+        int NewCapacity = BGE_FLATMAP_GROUP;
+
+        while(Count * 16 > NewCapacity * 7)
+            NewCapacity *= 2;
+
+        return NewCapacity;
+    }
+
+
+public:
+
+    FlatHashMap()
+    {
+        Control = NULL;
+        Entries = NULL;
+        Capacity = 0;
+        Size = 0;
+        NumDeleted = 0;
+    }
+
+    ~FlatHashMap()
+    {
+        Clear();
+
+        if(Capacity > 0) {
+            Memory.FreeArray((Byte*)Control, Capacity);
+            Memory.FreeArray((Byte*)Entries, Capacity * sizeof(Entry));
+        }
+    }
+
+    /* *
+     * Map Key to Value, replacing any value it had. True if the key is
+     * new to the map
+     * */
+    bool Insert(K BGE_NCP Key, V BGE_NCP Value)
+    {
+        int Slot = FindEntry(Key);
+        size_t HashValue;
+
+        if(Slot >= 0) {
+            Entries[Slot].Value = Value;
+            return false;
+        }
+
+        HashValue = Hasher(Key);
+
+        /* Deleted slots count, since they make probing longer too */
+        if((Size + NumDeleted + 1) * 8 > Capacity * 7) {
+            /* Key and Value may live in this map; copy them before growing */
+            K KeyCopy(Key);
+            V ValueCopy(Value);
+
+            /* The new arrays have no deleted slots to reuse */
+            Rehash(CapacityFor(Size + 1));
+            Slot = FindFree(HashValue);
+
+            Control[Slot] = Tag(HashValue);
+            new (&Entries[Slot].Key) K(std::move(KeyCopy));
+            new (&Entries[Slot].Value) V(std::move(ValueCopy));
+        } else {
+            Slot = FindFree(HashValue);
+            if(Control[Slot] == BGE_FLATMAP_DELETED)
+                --NumDeleted;
+
+            Control[Slot] = Tag(HashValue);
+            new (&Entries[Slot].Key) K(Key);
+            new (&Entries[Slot].Value) V(Value);
+        }
+
+        ++Size;
+
+        return true;
+    }
+
+    /* The value mapped to Key, or NULL */
+    V* Find(K BGE_NCP Key)
+    {
+        int Slot = FindEntry(Key);
+
+        return Slot >= 0 ? &Entries[Slot].Value : NULL;
+    }
+
+    const V* Find(K BGE_NCP Key) const
+    {
+        int Slot = FindEntry(Key);
+
+        return Slot >= 0 ? &Entries[Slot].Value : NULL;
+    }
+
+    bool Contains(K BGE_NCP Key) const
+    {
+        return FindEntry(Key) >= 0;
+    }
+
+    /* False if Key wasn't in the map */
+    bool Remove(K BGE_NCP Key)
+    {
+        int Slot = FindEntry(Key);
+        int Group;
+
+        if(Slot < 0)
+            return false;
+
+        Entries[Slot].~Entry();
+        --Size;
+
+        /* *
+         * A group with an empty slot has never been full, so no probe
+         * has gone past it and this slot can simply be emptied.
+         * Otherwise later keys may lie beyond it; leave a marker.
+         * */
+        Group = Slot - Slot % BGE_FLATMAP_GROUP;
+        if(MatchEmpty(Control + Group) != 0) {
+            Control[Slot] = BGE_FLATMAP_EMPTY;
+        } else {
+            Control[Slot] = BGE_FLATMAP_DELETED;
+            ++NumDeleted;
+        }
+
+        return true;
+    }
+
+    /* Make room for Count entries without rehashing */
+    void Reserve(int Count)
+    {
+        if(CapacityFor(Count) > Capacity)
+            Rehash(CapacityFor(Count));
+    }
+
+    /* Remove every entry. Keeps its memory */
+    void Clear()
+    {
+        for(int i = 0; i < Capacity; ++i) {
+            if(Control[i] >= 0)
+                Entries[i].~Entry();
+        }
+
+        if(Capacity > 0)
+            memset(Control, BGE_FLATMAP_EMPTY, Capacity);
+
+        Size = 0;
+        NumDeleted = 0;
+    }
+
+    int GetSize() const
+    {
+        return Size;
+    }
+
+    bool IsEmpty() const
+    {
+        return Size == 0;
+    }
+
+    /* *
+     * Slots holding entries, for walking the map in no particular order.
+     * -1 when there are no more:
+     *
+     *     for(Slot = Map.GetFirst(); Slot >= 0; Slot = Map.GetNext(Slot))
+     * */
+    int GetFirst() const
+    {
+        return GetNext(-1);
+    }
+
+    int GetNext(int Slot) const
+    {
+        while(++Slot < Capacity) {
+            if(Control[Slot] >= 0)
+                return Slot;
+        }
+
+        return -1;
+    }
+
+    const K& GetKey(int Slot) const
+    {
+        return Entries[Slot].Key;
+    }
+
+    V& GetValue(int Slot)
+    {
+        return Entries[Slot].Value;
+    }
+
+}; /* FlatHashMap */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_FLATHASHMAP_H */
@@ -0,0 +1,72 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_HEAPALLOCATOR_H
+#define BAKGE_DATA_HEAPALLOCATOR_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Allocates each object with new and frees it with delete. Has the same
+ * interface as PoolAllocator, for containers that take either.
+ *
+ * Containers that keep arrays, like SmallVector, take a HeapAllocator of
+ * Bytes, or any class with the same AllocateArray and FreeArray.
+ * */
+template<class T>
+class HeapAllocator
+{
+
+public:
+
+    T* Allocate()
+    {
+        return new T();
+    }
+
+    void Free(T* Object)
+    {
+        delete Object;
+    }
+
+    /* Memory for Count objects, left unconstructed */
+    T* AllocateArray(int Count)
+    {
+        return (T*)::operator new(Count * sizeof(T));
+    }
+
+    /* The count is for allocators that need it; delete doesn't */
+    void FreeArray(T* Array, int)
+    {
+        ::operator delete(Array);
+    }
+
+}; /* HeapAllocator */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_HEAPALLOCATOR_H */
@@ -30,7 +30,15 @@
 namespace bakge
 {
 
-template<class  T>
+/* *
+ * Singly linked list. Push and Pop work at the front, like a stack, and
+ * Append adds to the back, so Append and Pop together make a queue.
+ *
+ * Nodes come from Allocator, a pool by default so pushing and popping
+ * reuses nodes instead of calling new and delete every time. Pass
+ * HeapAllocator<SingleNode<T> > to allocate each node on its own.
+ * */
+template<class  T, class Allocator = PoolAllocator<SingleNode<T> > >
 class LinkedList
 {
 
@@ -40,6 +48,7 @@ public:
     {
         Head = NULL;
         Tail = NULL;
+        Count = 0;
     }
 
     ~LinkedList()
@@ -47,12 +56,13 @@ public:
         Clear();
     }
 
+    /* Add a value to the front of the list */
     T Push(T Value)
     {
         SingleNode<T>* NewNode;
 
         /* Create new node */
-        NewNode = new SingleNode<T>();
+        NewNode = Nodes.Allocate();
         NewNode->SetData(Value);
 
         /* Move pointers */
@@ -64,9 +74,33 @@ public:
             Head = NewNode;
         }
 
+        ++Count;
+
         return Value;
     }
 
+    /* Add a value to the back of the list */
+    T Append(T Value)
+    {
+        SingleNode<T>* NewNode;
+
+        NewNode = Nodes.Allocate();
+        NewNode->SetData(Value);
+        NewNode->SetNext(NULL);
+
+        if (Tail == NULL) {
+            Tail = Head = NewNode;
+        } else {
+            Tail->SetNext(NewNode);
+            Tail = NewNode;
+        }
+
+        ++Count;
+
+        return Value;
+    }
+
+    /* Remove and return the value at the front. The list can't be empty */
     T Pop()
     {
         SingleNode<T>* TopNode;
@@ -83,7 +117,8 @@ public:
 
         /* Memorize return value and free memory */
         DataValue = TopNode->GetData();
-        delete TopNode;
+        Nodes.Free(TopNode);
+        --Count;
 
         return DataValue;
     }
@@ -94,6 +129,26 @@ public:
         return (Head == NULL);
     }
 
+    int GetSize() const
+    {
+        return Count;
+    }
+
+    /* *
+     * Nodes in order, for walking the list:
+     *
+     *     for (Node = List.GetFirst(); Node != NULL; Node = Node->GetNext())
+     * */
+    SingleNode<T>* GetFirst() const
+    {
+        return Head;
+    }
+
+    SingleNode<T>* GetLast() const
+    {
+        return Tail;
+    }
+
     /* Delete the entire contents of the list */
     void Clear()
     {
@@ -102,8 +157,11 @@ public:
         while (Head != NULL) {
             Node = Head;
             Head = Head->GetNext();
-            delete Node;
+            Nodes.Free(Node);
         }
+
+        Tail = NULL;
+        Count = 0;
     }
 
 
@@ -111,6 +169,9 @@ protected:
 
     SingleNode<T>* Head;
     SingleNode<T>* Tail;
+    int Count;
+
+    Allocator Nodes;
 
 }; /* LinkedList */
 
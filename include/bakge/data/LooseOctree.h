@@ -0,0 +1,157 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_LOOSEOCTREE_H
+#define BAKGE_DATA_LOOSEOCTREE_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Loose octree broadphase, suited to scenes where most objects move every
+ * frame.
+ *
+ * The tree covers a cube of fixed size. Each node's cell is split into
+ * eight children, down to a maximum depth. An object is stored in the
+ * deepest node whose cell is at least as wide as the object and contains
+ * its center. Nodes are "loose": their bounds are twice the size of their
+ * cell, so an object never has to straddle a boundary and its node can be
+ * found directly from its size and position. Moving an object therefore
+ * costs at most one walk from the root, however many objects there are.
+ *
+ * Objects outside the cube are kept in the root node, so they are still
+ * found, but only by testing them on every query.
+ * */
+class BGE_API LooseOctree : public Broadphase
+{
+    struct OctreeNode
+    {
+        /* Center of the node's cell, and half its width */
+        Scalar Center[3];
+        Scalar HalfSize;
+
+        /* Levels below the root, or -1 for free nodes */
+        int Depth;
+
+        /* Parent also links free nodes together */
+        int Parent;
+        int Children[8];
+
+        /* First object stored here, and the number stored here and below */
+        int FirstObject;
+        int NumObjects;
+    };
+
+    struct OctreeObject
+    {
+        BoundingBox Box;
+        void* Data;
+
+        /* Node storing the object, or -1 for free objects */
+        int Node;
+
+        /* Neighbours in the node's list. Next also links free objects */
+        int Prev;
+        int Next;
+    };
+
+    OctreeNode* Nodes;
+    int NodeCapacity;
+    int FreeNodes;
+
+    OctreeObject* Objects;
+    int ObjectCapacity;
+    int FreeObjects;
+    int NumObjects;
+
+    int MaxDepth;
+
+    Result ReserveNodes(int NumNodes);
+    Result ReserveObjects(int Num);
+    int AllocateNode(int Parent, int Octant);
+    void FreeNode(int Index);
+
+    /* *
+     * Node an object with these bounds belongs in. Missing nodes on the
+     * way are created only when Create is true; otherwise -1 is returned
+     * if the node doesn't exist yet.
+     * */
+    int FindNode(BoundingBox BGE_NCP Box, bool Create);
+
+    void Link(int Object, int Node);
+    void Unlink(int Object);
+
+    /* *
+     * FindPairs helpers, each adding to Pairs from Count and returning the
+     * new count. Neighbours holds the 27 nodes at Node's depth around and
+     * including it, or -1 where there are none.
+     * */
+    int PairWithSubtree(int Object, int Node, BroadphasePair* Pairs,
+                                        int Count, int MaxPairs) const;
+    int PairNeighbourhood(int Node, const int* Neighbours,
+            BroadphasePair* Pairs, int Count, int MaxPairs) const;
+
+
+protected:
+
+    LooseOctree();
+
+
+public:
+
+    virtual ~LooseOctree();
+
+    /* *
+     * Octree covering the cube at Center extending HalfSize along each
+     * axis. Nodes at MaxDepth, which may be at most 16, are HalfSize /
+     * 2^MaxDepth across; choose it so they are about the size of the
+     * smallest objects.
+     * */
+    BGE_FACTORY LooseOctree* Create(Vector4 BGE_NCP Center, Scalar HalfSize,
+                                                            int MaxDepth);
+
+    virtual int Insert(BoundingBox BGE_NCP Box, void* Data);
+    virtual Result Remove(int Handle);
+
+    /* Returns true if the object moved to a different node */
+    virtual bool Update(int Handle, BoundingBox BGE_NCP Box);
+
+    virtual void Clear();
+
+    virtual void* GetData(int Handle) const;
+    virtual BoundingBox BGE_NCP GetBox(int Handle) const;
+    virtual int GetNumObjects() const;
+
+    virtual int Query(BoundingBox BGE_NCP Box, int* Results,
+                                            int MaxResults) const;
+
+    virtual int FindPairs(BroadphasePair* Pairs, int MaxPairs) const;
+
+}; /* LooseOctree */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_LOOSEOCTREE_H */
@@ -0,0 +1,194 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_MPMCQUEUE_H
+#define BAKGE_DATA_MPMCQUEUE_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Bounded lock-free queue any number of threads can push to and pop
+ * from, after Dmitry Vyukov's bounded MPMC queue. Push and Pop never
+ * block; they fail when the queue is full or empty.
+ *
+ * Each slot has a sequence number saying whose turn it is. A thread
+ * claims a slot by moving the shared index past it, then hands it on by
+ * bumping the slot's sequence, so threads only contend on the indices.
+ * Values from one producer are popped in the order they were pushed.
+ * */
+template<class T>
+class MPMCQueue
+{
+    struct Slot
+    {
+        std::atomic<size_t> Sequence;
+        T Value;
+    };
+
+    Slot* Slots;
+    size_t Mask;
+
+    char SlotsPadding[BGE_CACHE_LINE];
+
+    std::atomic<size_t> PushIndex;
+
+    char PushPadding[BGE_CACHE_LINE];
+
+    std::atomic<size_t> PopIndex;
+
+    char PopPadding[BGE_CACHE_LINE];
+
+
+protected:
+
+    MPMCQueue()
+    {
+        Slots = NULL;
+        Mask = 0;
+        PushIndex.store(0);
+        PopIndex.store(0);
+    }
+
+
+public:
+
+    ~MPMCQueue()
+    {
+        if(Slots != NULL)
+            delete[] Slots;
+    }
+
+    /* Capacity is rounded up to a power of two */
+    BGE_FACTORY MPMCQueue<T>* Create(int Capacity)
+    {
+        MPMCQueue<T>* Q;
+        size_t Size = 2;
+
+        if(Capacity < 1) {
+            printf("Queue capacity must be positive\n");
+            return NULL;
+        }
+
+        while(Size < (size_t)Capacity)
+            Size <<= 1;
+
+        Q = new MPMCQueue<T>;
+        Q->Slots = new Slot[Size];
+        Q->Mask = Size - 1;
+
+        /* Slot i is first pushed to when PushIndex reaches i */
+        for(size_t i = 0; i < Size; ++i)
+            Q->Slots[i].Sequence.store(i, std::memory_order_relaxed);
+
+        return Q;
+    }
+
+    /* False if the queue is full */
+    bool Push(T BGE_NCP Value)
+    {
+        size_t Index = PushIndex.load(std::memory_order_relaxed);
+        Slot* S;
+
+        while(1) {
+            S = &Slots[Index & Mask];
+            size_t Sequence = S->Sequence.load(std::memory_order_acquire);
+            ptrdiff_t Turn = (ptrdiff_t)(Sequence - Index);
+
+            if(Turn == 0) {
+                /* The slot is free; claim it unless another producer did */
+                if(PushIndex.compare_exchange_weak(Index, Index + 1,
+                                            std::memory_order_relaxed))
+                    break;
+            } else if(Turn < 0) {
+                /* Still holds the value pushed a lap ago */
+                return false;
+            } else {
+                Index = PushIndex.load(std::memory_order_relaxed);
+            }
+        }
+
+        S->Value = Value;
+        S->Sequence.store(Index + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /* False if the queue is empty */
+    bool Pop(T* Value)
+    {
+        size_t Index = PopIndex.load(std::memory_order_relaxed);
+        Slot* S;
+
+        while(1) {
+            S = &Slots[Index & Mask];
+            size_t Sequence = S->Sequence.load(std::memory_order_acquire);
+            ptrdiff_t Turn = (ptrdiff_t)(Sequence - (Index + 1));
+
+            if(Turn == 0) {
+                if(PopIndex.compare_exchange_weak(Index, Index + 1,
+                                            std::memory_order_relaxed))
+                    break;
+            } else if(Turn < 0) {
+                /* Nothing pushed here yet */
+                return false;
+            } else {
+                Index = PopIndex.load(std::memory_order_relaxed);
+            }
+        }
+
+        *Value = S->Value;
+
+        /* Free for the push one lap from now */
+        S->Sequence.store(Index + Mask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /* Only a hint while other threads are using the queue */
+    int GetSize() const
+    {
+        ptrdiff_t Size = (ptrdiff_t)(PushIndex.load(std::memory_order_acquire)
+                                - PopIndex.load(std::memory_order_acquire));
+
+        return Size > 0 ? (int)Size : 0;
+    }
+
+    bool IsEmpty() const
+    {
+        return GetSize() == 0;
+    }
+
+    int GetCapacity() const
+    {
+        return (int)(Mask + 1);
+    }
+
+}; /* MPMCQueue */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_MPMCQUEUE_H */
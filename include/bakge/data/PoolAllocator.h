@@ -0,0 +1,140 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_POOLALLOCATOR_H
+#define BAKGE_DATA_POOLALLOCATOR_H
+
+#include <bakge/Bakge.h>
+
+/* Slots in the first slab; each slab after that is twice as big */
+#define BGE_POOL_FIRST_SLAB 16
+
+/* Slabs stop growing at this many slots */
+#define BGE_POOL_MAX_SLAB 4096
+
+namespace bakge
+{
+
+/* *
+ * Hands out objects of one type from slabs of memory, keeping freed ones
+ * on a list to be handed out again. After the first few allocations it
+ * never calls the system allocator, and objects allocated together sit
+ * next to each other in memory.
+ *
+ * Memory is only returned to the system when the pool is destroyed, and
+ * objects still allocated then are not destructed. Not thread-safe.
+ * */
+template<class T>
+class PoolAllocator
+{
+    union Slot
+    {
+        Slot* Next;
+        typename std::aligned_storage<sizeof(T),
+                                std::alignment_of<T>::value>::type Object;
+    };
+
+    struct Slab
+    {
+        Slab* Next;
+        Slot* Slots;
+    };
+
+    Slot* FreeSlots;
+    Slab* Slabs;
+    int NextSlabSize;
+
+    /* Copies would free the same slabs */
+    PoolAllocator(const PoolAllocator&);
+    void operator=(const PoolAllocator&);
+
+    void Grow()
+    {
+        Slab* NewSlab = new Slab;
+
+        NewSlab->Slots = new Slot[NextSlabSize];
+        NewSlab->Next = Slabs;
+        Slabs = NewSlab;
+
+        /* Thread the new slots onto the free list, first slot first */
+        for(int i = NextSlabSize - 1; i >= 0; --i) {
+            NewSlab->Slots[i].Next = FreeSlots;
+            FreeSlots = &NewSlab->Slots[i];
+        }
+
+        if(NextSlabSize < BGE_POOL_MAX_SLAB)
+            NextSlabSize *= 2;
+    }
+
+
+public:
+
+    PoolAllocator()
+    {
+        FreeSlots = NULL;
+        Slabs = NULL;
+        NextSlabSize = BGE_POOL_FIRST_SLAB;
+    }
+
+    ~PoolAllocator()
+    {
+        Slab* Next;
+
+        while(Slabs != NULL) {
+            Next = Slabs->Next;
+            delete[] Slabs->Slots;
+            delete Slabs;
+            Slabs = Next;
+        }
+    }
+
+    /* A default-constructed object */
+    T* Allocate()
+    {
+        Slot* Free;
+
+        if(FreeSlots == NULL)
+            Grow();
+
+        Free = FreeSlots;
+        FreeSlots = Free->Next;
+
+        return new (&Free->Object) T();
+    }
+
+    /* Destructs an object from this pool and keeps its memory for reuse */
+    void Free(T* Object)
+    {
+        Slot* Freed = (Slot*)Object;
+
+        Object->~T();
+        Freed->Next = FreeSlots;
+        FreeSlots = Freed;
+    }
+
+}; /* PoolAllocator */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_POOLALLOCATOR_H */
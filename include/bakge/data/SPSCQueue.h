@@ -0,0 +1,160 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_SPSCQUEUE_H
+#define BAKGE_DATA_SPSCQUEUE_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Bounded lock-free queue for passing values from exactly one producer
+ * thread to exactly one consumer thread. Push and Pop never block; they
+ * fail when the queue is full or empty.
+ *
+ * Each side keeps a copy of the other side's index and only reloads it
+ * when the queue looks full or empty, so most calls touch no cache line
+ * the other thread writes to.
+ * */
+template<class T>
+class SPSCQueue
+{
+    T* Slots;
+    size_t Mask;
+
+    char SlotsPadding[BGE_CACHE_LINE];
+
+    /* Next slot to pop; written by the consumer */
+    std::atomic<size_t> Head;
+    size_t CachedTail;
+
+    char HeadPadding[BGE_CACHE_LINE];
+
+    /* Next slot to push; written by the producer */
+    std::atomic<size_t> Tail;
+    size_t CachedHead;
+
+    char TailPadding[BGE_CACHE_LINE];
+
+
+protected:
+
+    SPSCQueue()
+    {
+        Slots = NULL;
+        Mask = 0;
+        Head.store(0);
+        Tail.store(0);
+        CachedTail = 0;
+        CachedHead = 0;
+    }
+
+
+public:
+
+    ~SPSCQueue()
+    {
+        if(Slots != NULL)
+            delete[] Slots;
+    }
+
+    /* Capacity is rounded up to a power of two */
+    BGE_FACTORY SPSCQueue<T>* Create(int Capacity)
+    {
+        SPSCQueue<T>* Q;
+        size_t Size = 2;
+
+        if(Capacity < 1) {
+            printf("Queue capacity must be positive\n");
+            return NULL;
+        }
+
+        while(Size < (size_t)Capacity)
+            Size <<= 1;
+
+        Q = new SPSCQueue<T>;
+        Q->Slots = new T[Size];
+        Q->Mask = Size - 1;
+
+        return Q;
+    }
+
+    /* Producer only. False if the queue is full */
+    bool Push(T BGE_NCP Value)
+    {
+        size_t Index = Tail.load(std::memory_order_relaxed);
+
+        if(Index - CachedHead > Mask) {
+            CachedHead = Head.load(std::memory_order_acquire);
+            if(Index - CachedHead > Mask)
+                return false;
+        }
+
+        Slots[Index & Mask] = Value;
+        Tail.store(Index + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /* Consumer only. False if the queue is empty */
+    bool Pop(T* Value)
+    {
+        size_t Index = Head.load(std::memory_order_relaxed);
+
+        if(Index == CachedTail) {
+            CachedTail = Tail.load(std::memory_order_acquire);
+            if(Index == CachedTail)
+                return false;
+        }
+
+        *Value = Slots[Index & Mask];
+        Head.store(Index + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /* Only a hint while the other thread is using the queue */
+    int GetSize() const
+    {
+        return (int)(Tail.load(std::memory_order_acquire)
+                        - Head.load(std::memory_order_acquire));
+    }
+
+    bool IsEmpty() const
+    {
+        return GetSize() == 0;
+    }
+
+    int GetCapacity() const
+    {
+        return (int)(Mask + 1);
+    }
+
+}; /* SPSCQueue */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_SPSCQUEUE_H */
@@ -0,0 +1,303 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_SLOTMAP_H
+#define BAKGE_DATA_SLOTMAP_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Names a value in a SlotMap. Stays valid until that value is removed,
+ * however the map changes; after that it refers to nothing, even once
+ * the slot is reused. A default handle never refers to anything.
+ * */
+struct SlotHandle
+{
+    int Index;
+    unsigned int Generation;
+
+    SlotHandle()
+    {
+        Index = -1;
+        Generation = 0;
+    }
+
+    bool operator==(const SlotHandle& Other) const
+    {
+        return Index == Other.Index && Generation == Other.Generation;
+    }
+
+    bool operator!=(const SlotHandle& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+
+/* *
+ * Stores values behind handles that can be kept instead of pointers,
+ * for objects like nodes, meshes and textures that others refer to.
+ *
+ * Values are packed together in one array, so walking them all is as
+ * fast as walking an array. A handle leads to a slot which records
+ * where its value currently is, and a generation which is bumped each
+ * time the slot is freed, so stale handles are caught instead of
+ * reaching whatever took the slot next.
+ *
+ * Removing a value moves the last value into its place, and inserting
+ * may move all of them, so don't keep pointers into the map.
+ * */
+template<class T, class Allocator = HeapAllocator<Byte> >
+class SlotMap
+{
+    struct Slot
+    {
+        unsigned int Generation;
+        int Dense; /* Index of the value, or -1 when free */
+        int NextFree;
+    };
+
+    Slot* Slots;
+    int NumSlots;
+    int SlotCapacity;
+    int FreeSlot;
+
+    /* Values, and the slot each came from */
+    T* Values;
+    int* Owners;
+    int Size;
+    int Capacity;
+
+    Allocator Memory;
+
+    SlotMap(const SlotMap&);
+    void operator=(const SlotMap&);
+
+    void GrowSlots()
+    {
+        int NewCapacity = SlotCapacity > 0 ? SlotCapacity * 2 : 16;
+        Slot* NewSlots;
+
+        NewSlots = (Slot*)Memory.AllocateArray(NewCapacity * sizeof(Slot));
+        if(NumSlots > 0)
+            memcpy(NewSlots, Slots, NumSlots * sizeof(Slot));
+
+        if(SlotCapacity > 0)
+            Memory.FreeArray((Byte*)Slots, SlotCapacity * sizeof(Slot));
+
+        Slots = NewSlots;
+        SlotCapacity = NewCapacity;
+    }
+
+    void GrowValues()
+    {
+        int NewCapacity = Capacity > 0 ? Capacity * 2 : 16;
+        T* NewValues;
+        int* NewOwners;
+
+        NewValues = (T*)Memory.AllocateArray(NewCapacity * sizeof(T));
+        NewOwners = (int*)Memory.AllocateArray(NewCapacity * sizeof(int));
+
+        for(int i = 0; i < Size; ++i) {
+            new (&NewValues[i]) T(std::move(Values[i]));
+            Values[i].~T();
+            NewOwners[i] = Owners[i];
+        }
+
+        FreeValues();
+        Values = NewValues;
+        Owners = NewOwners;
+        Capacity = NewCapacity;
+    }
+
+    void FreeValues()
+    {
+        if(Capacity > 0) {
+            Memory.FreeArray((Byte*)Values, Capacity * sizeof(T));
+            Memory.FreeArray((Byte*)Owners, Capacity * sizeof(int));
+        }
+    }
+
+    /* The slot Handle refers to, or NULL if its value was removed */
+    Slot* Resolve(SlotHandle BGE_NCP Handle) const
+    {
+        Slot* S;
+
+        if(Handle.Index < 0 || Handle.Index >= NumSlots)
+            return NULL;
+
+        S = &Slots[Handle.Index];
+        if(S->Generation != Handle.Generation || S->Dense < 0)
+            return NULL;
+
+        return S;
+    }
+
+
+public:
+
+    SlotMap()
+    {
+        Slots = NULL;
+        NumSlots = 0;
+        SlotCapacity = 0;
+        FreeSlot = -1;
+        Values = NULL;
+        Owners = NULL;
+        Size = 0;
+        Capacity = 0;
+    }
+
+    ~SlotMap()
+    {
+        Clear();
+        FreeValues();
+
+        if(SlotCapacity > 0)
+            Memory.FreeArray((Byte*)Slots, SlotCapacity * sizeof(Slot));
+    }
+
+    SlotHandle Insert(T BGE_NCP Value)
+    {
+        SlotHandle Handle;
+        int Index;
+
+        if(Size == Capacity) {
+            /* Value may live in this map; copy it before growing */
+            T Copy(Value);
+
+            GrowValues();
+            new (&Values[Size]) T(std::move(Copy));
+        } else {
+            new (&Values[Size]) T(Value);
+        }
+
+        if(FreeSlot >= 0) {
+            Index = FreeSlot;
+            FreeSlot = Slots[Index].NextFree;
+        } else {
+            if(NumSlots == SlotCapacity)
+                GrowSlots();
+
+            Index = NumSlots++;
+            Slots[Index].Generation = 1;
+        }
+
+        Slots[Index].Dense = Size;
+        Owners[Size] = Index;
+        ++Size;
+
+        Handle.Index = Index;
+        Handle.Generation = Slots[Index].Generation;
+
+        return Handle;
+    }
+
+    /* The value Handle refers to, or NULL if it was removed */
+    T* Get(SlotHandle BGE_NCP Handle)
+    {
+        Slot* S = Resolve(Handle);
+
+        return S != NULL ? &Values[S->Dense] : NULL;
+    }
+
+    bool IsValid(SlotHandle BGE_NCP Handle) const
+    {
+        return Resolve(Handle) != NULL;
+    }
+
+    /* False if the value was already removed */
+    bool Remove(SlotHandle BGE_NCP Handle)
+    {
+        Slot* S = Resolve(Handle);
+        int Last = Size - 1;
+
+        if(S == NULL)
+            return false;
+
+        /* Fill the hole with the last value */
+        if(S->Dense != Last) {
+            Values[S->Dense] = std::move(Values[Last]);
+            Owners[S->Dense] = Owners[Last];
+            Slots[Owners[Last]].Dense = S->Dense;
+        }
+
+        Values[Last].~T();
+        --Size;
+
+        /* Generation 0 is never handed out, so default handles stay invalid */
+        if(++S->Generation == 0)
+            S->Generation = 1;
+
+        S->Dense = -1;
+        S->NextFree = FreeSlot;
+        FreeSlot = Handle.Index;
+
+        return true;
+    }
+
+    /* Remove every value. Every handle becomes invalid */
+    void Clear()
+    {
+        while(Size > 0) {
+            SlotHandle Handle = GetHandle(Size - 1);
+            Remove(Handle);
+        }
+    }
+
+    int GetSize() const
+    {
+        return Size;
+    }
+
+    bool IsEmpty() const
+    {
+        return Size == 0;
+    }
+
+    /* All values, packed together in no particular order */
+    T* GetData()
+    {
+        return Values;
+    }
+
+    /* Handle for the value at Index in GetData() */
+    SlotHandle GetHandle(int Index) const
+    {
+        SlotHandle Handle;
+
+        Handle.Index = Owners[Index];
+        Handle.Generation = Slots[Owners[Index]].Generation;
+
+        return Handle;
+    }
+
+}; /* SlotMap */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_SLOTMAP_H */
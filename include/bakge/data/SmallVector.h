@@ -0,0 +1,230 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_SMALLVECTOR_H
+#define BAKGE_DATA_SMALLVECTOR_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Growable array that keeps its first N values inside itself. Until it
+ * grows past N it never allocates, so short lists (a node's children, a
+ * mesh's submeshes) cost nothing beyond the object holding them. Past N
+ * it moves everything to memory from Allocator, doubling as needed.
+ *
+ * Pointers to values are invalidated when it grows.
+ * */
+template<class T, int N, class Allocator = HeapAllocator<Byte> >
+class SmallVector
+{
+    T* Data;
+    int Size;
+    int Capacity;
+
+    typename std::aligned_storage<sizeof(T),
+                            std::alignment_of<T>::value>::type Inline[N];
+
+    Allocator Memory;
+
+    void Grow(int MinCapacity)
+    {
+        int NewCapacity = Capacity * 2;
+        T* NewData;
+
+        if(NewCapacity < MinCapacity)
+            NewCapacity = MinCapacity;
+
+        NewData = (T*)Memory.AllocateArray(NewCapacity * sizeof(T));
+
+        for(int i = 0; i < Size; ++i) {
+            new (&NewData[i]) T(std::move(Data[i]));
+            Data[i].~T();
+        }
+
+        FreeData();
+        Data = NewData;
+        Capacity = NewCapacity;
+    }
+
+    void FreeData()
+    {
+        if(!IsInline())
+            Memory.FreeArray((Byte*)Data, Capacity * sizeof(T));
+    }
+
+
+public:
+
+    SmallVector()
+    {
+        Data = (T*)Inline;
+        Size = 0;
+        Capacity = N;
+    }
+
+    SmallVector(const SmallVector& Other)
+    {
+        Data = (T*)Inline;
+        Size = 0;
+        Capacity = N;
+
+        *this = Other;
+    }
+
+    ~SmallVector()
+    {
+        Clear();
+        FreeData();
+    }
+
+    SmallVector& operator=(const SmallVector& Other)
+    {
+        if(this == &Other)
+            return *this;
+
+        Clear();
+        Reserve(Other.Size);
+
+        for(int i = 0; i < Other.Size; ++i)
+            new (&Data[i]) T(Other.Data[i]);
+
+        Size = Other.Size;
+
+        return *this;
+    }
+
+    T& operator[](int Index)
+    {
+        return Data[Index];
+    }
+
+    const T& operator[](int Index) const
+    {
+        return Data[Index];
+    }
+
+    void PushBack(T BGE_NCP Value)
+    {
+        if(Size == Capacity) {
+            /* Value may live in this vector; copy it before growing */
+            T Copy(Value);
+
+            Grow(Size + 1);
+            new (&Data[Size]) T(std::move(Copy));
+        } else {
+            new (&Data[Size]) T(Value);
+        }
+
+        ++Size;
+    }
+
+    /* Remove the last value. The vector can't be empty */
+    void PopBack()
+    {
+        --Size;
+        Data[Size].~T();
+    }
+
+    /* *
+     * Remove the value at Index by moving the last value into its place.
+     * Doesn't keep the order, but doesn't shift everything after Index.
+     * */
+    void RemoveSwap(int Index)
+    {
+        if(Index != Size - 1)
+            Data[Index] = std::move(Data[Size - 1]);
+
+        PopBack();
+    }
+
+    T& GetLast()
+    {
+        return Data[Size - 1];
+    }
+
+    /* Make room for Count values without growing again */
+    void Reserve(int Count)
+    {
+        if(Count > Capacity)
+            Grow(Count);
+    }
+
+    /* New values are default constructed */
+    void Resize(int Count)
+    {
+        Reserve(Count);
+
+        while(Size < Count)
+            new (&Data[Size++]) T();
+
+        while(Size > Count)
+            PopBack();
+    }
+
+    /* Destruct every value. Keeps its memory */
+    void Clear()
+    {
+        while(Size > 0)
+            PopBack();
+    }
+
+    T* GetData()
+    {
+        return Data;
+    }
+
+    const T* GetData() const
+    {
+        return Data;
+    }
+
+    int GetSize() const
+    {
+        return Size;
+    }
+
+    int GetCapacity() const
+    {
+        return Capacity;
+    }
+
+    bool IsEmpty() const
+    {
+        return Size == 0;
+    }
+
+    /* True while the values are stored inside the vector itself */
+    bool IsInline() const
+    {
+        return Data == (const T*)Inline;
+    }
+
+}; /* SmallVector */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_SMALLVECTOR_H */
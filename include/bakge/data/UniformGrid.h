@@ -0,0 +1,132 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_DATA_UNIFORMGRID_H
+#define BAKGE_DATA_UNIFORMGRID_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Hashed uniform grid broadphase, suited to many moving objects of
+ * similar size spread over an unbounded world.
+ *
+ * Space is divided into cubic cells. Each object is listed in every cell
+ * its box covers, and cells are hashed into a fixed number of buckets, so
+ * only occupied space costs memory. Moving an object touches just the
+ * cells it covers, and costs nothing more while it stays within them.
+ *
+ * The cell size should be about the size of the larger common objects.
+ * Objects covering many cells are instead kept in a separate list tested
+ * by every query.
+ * */
+class BGE_API UniformGrid : public Broadphase
+{
+    struct GridObject
+    {
+        BoundingBox Box;
+        void* Data;
+
+        /* Range of cells the box covers. Empty boxes cover none */
+        int MinCell[3];
+        int MaxCell[3];
+
+        /* Whether the object is listed in LargeObjects instead of cells */
+        bool Large;
+        bool InUse;
+
+        /* Links free objects */
+        int NextFree;
+    };
+
+    struct GridBucket
+    {
+        int* Objects;
+        int Count;
+        int Capacity;
+    };
+
+    GridObject* Objects;
+    int ObjectCapacity;
+    int FreeObjects;
+    int NumObjects;
+
+    GridBucket* Buckets;
+    int NumBuckets;
+    GridBucket LargeObjects;
+
+    Scalar CellSize;
+    Scalar InvCellSize;
+
+    Result ReserveObjects(int Num);
+
+    /* Sets the cell range and Large flag of an object from its box */
+    void PlaceObject(GridObject* Object) const;
+
+    int HashCell(int X, int Y, int Z) const;
+
+    /* Adding skips objects the bucket already lists */
+    static Result BucketAdd(GridBucket* Bucket, int Object);
+    static void BucketRemove(GridBucket* Bucket, int Object);
+
+    Result AddToCells(int Object);
+    void RemoveFromCells(int Object);
+
+
+protected:
+
+    UniformGrid();
+
+
+public:
+
+    virtual ~UniformGrid();
+
+    /* NumBuckets is rounded up to a power of two */
+    BGE_FACTORY UniformGrid* Create(Scalar CellSize, int NumBuckets);
+
+    virtual int Insert(BoundingBox BGE_NCP Box, void* Data);
+    virtual Result Remove(int Handle);
+
+    /* Returns true if the object moved to different cells */
+    virtual bool Update(int Handle, BoundingBox BGE_NCP Box);
+
+    virtual void Clear();
+
+    virtual void* GetData(int Handle) const;
+    virtual BoundingBox BGE_NCP GetBox(int Handle) const;
+    virtual int GetNumObjects() const;
+
+    virtual int Query(BoundingBox BGE_NCP Box, int* Results,
+                                            int MaxResults) const;
+
+    virtual int FindPairs(BroadphasePair* Pairs, int MaxPairs) const;
+
+}; /* UniformGrid */
+
+} /* bakge */
+
+#endif /* BAKGE_DATA_UNIFORMGRID_H */
@@ -45,11 +45,11 @@ public:
      * */
     virtual void Error() = 0;
 
-    /* Run a script from file */
-    virtual Result RunFile(const char* ScriptPath) = 0;
+    /* Run a script from file. Calls Error if the script fails */
+    virtual Result RunFile(const char* ScriptPath);
 
-    /* Run a script from a string */
-    virtual Result RunString(const char* Source) = 0;
+    /* Run a script from a string. Calls Error if the script fails */
+    virtual Result RunString(const char* Source);
 
 
 protected:
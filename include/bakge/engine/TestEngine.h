@@ -67,6 +67,9 @@ class BGE_API TestEngine : public Engine, public EventHandler
     Result Initialize()
     {
 
+        if(Timestep == NULL || Timer == NULL)
+            return BGE_FAILURE;
+
         EngineWindow = Window::Create(600, 400);
         if(EngineWindow == NULL)
             return BGE_FAILURE;
@@ -105,8 +108,13 @@ class BGE_API TestEngine : public Engine, public EventHandler
 
         while(1)
         {
+            BGE_PROFILE_ZONE("Engine::Frame");
+            Timer->BeginFrame();
 
-            Window::PollEvents();
+            {
+                FrameStageScope EventsTime(Timer, FRAME_STAGE_EVENTS);
+                Window::PollEvents();
+            }
 
             if(EngineWindow->IsOpen() == false) {
 
@@ -119,21 +127,50 @@ class BGE_API TestEngine : public Engine, public EventHandler
             }
 
 
-            Update(0);
-            if(UpdateCB != NULL)
-                UpdateCB();
+            {
+                BGE_PROFILE_ZONE("Engine::ServiceNetwork");
+                FrameStageScope NetworkTime(Timer, FRAME_STAGE_NETWORK);
+                ServiceNetwork();
+            }
+
+            {
+                BGE_PROFILE_ZONE("Engine::Update");
+                FrameStageScope UpdateTime(Timer, FRAME_STAGE_UPDATE);
+
+                /* Simulation advances in fixed steps of real time */
+                Timestep->BeginFrame();
+                while(Timestep->Step()) {
+                    Update(Timestep->GetStepSize());
+                    if(UpdateCB != NULL)
+                        UpdateCB();
+                }
+            }
+
+            {
+                BGE_PROFILE_ZONE("Engine::PreRenderStage");
+                FrameStageScope PreRenderTime(Timer, FRAME_STAGE_PRE_RENDER);
+                PreRenderStage();
+                if(PreRenderCB != NULL)
+                    PreRenderCB();
+            }
 
-            PreRenderStage();
-            if(PreRenderCB != NULL)
-                PreRenderCB();
+            {
+                BGE_PROFILE_ZONE("Engine::RenderStage");
+                FrameStageScope RenderTime(Timer, FRAME_STAGE_RENDER);
+                RenderStage();
+                if(RenderCB != NULL)
+                    RenderCB();
+            }
 
-            RenderStage();
-            if(RenderCB != NULL)
-                RenderCB();
+            {
+                BGE_PROFILE_ZONE("Engine::PostRenderStage");
+                FrameStageScope PostRenderTime(Timer, FRAME_STAGE_POST_RENDER);
+                PostRenderStage();
+                if(PostRenderCB != NULL)
+                    PostRenderCB();
+            }
 
-            PostRenderStage();
-            if(PostRenderCB != NULL)
-                PostRenderCB();
+            EndFrame();
         }
 
         return ExitCode;
@@ -67,12 +67,25 @@ public:
     virtual Result Bind() const;
     virtual Result Unbind() const;
 
+    /* Bounds of the vertex positions, in model space */
+    BoundingBox BGE_NCP GetMeshBox() const;
+    BoundingSphere BGE_NCP GetMeshSphere() const;
+
 
 protected:
 
+    BoundingBox MeshBox;
+    BoundingSphere MeshSphere;
+
     Result CreateBuffers();
     Result ClearBuffers();
 
+    /* *
+     * Upload NumPositions tightly packed X, Y, Z vertex positions to the
+     * positions buffer and compute the mesh's bounds from them
+     * */
+    Result SetPositionData(const Scalar* Positions, int NumPositions);
+
 }; /* Mesh */
 
 } /* bakge */
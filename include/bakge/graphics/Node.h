@@ -44,12 +44,14 @@ public:
 
     BGE_FACTORY Node* Create(Scalar X, Scalar Y, Scalar Z);
 
+    BGE_POOLED_DECLARE
+
     virtual Result Bind() const;
     virtual Result Unbind() const;
 
     virtual Result Draw() const;
 
-    void SetPosition(Scalar X, Scalar Y, Scalar Z);
+    virtual void SetPosition(Scalar X, Scalar Y, Scalar Z);
     Vector4 BGE_NCP GetPosition() const;
 
 
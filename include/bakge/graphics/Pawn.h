@@ -43,12 +43,52 @@ public:
 
     virtual Result Draw() const;
 
+    /* Moving, turning or scaling a Pawn updates its bounds */
+    void SetPosition(Scalar X, Scalar Y, Scalar Z);
+
+    void SetFacing(Quaternion BGE_NCP Facing);
+    Quaternion BGE_NCP GetFacing() const;
+
+    void SetScale(Scalar X, Scalar Y, Scalar Z);
+    Vector4 BGE_NCP GetScale() const;
+
+    /* *
+     * Bounds in world space, around the Pawn as it is currently placed.
+     * They are empty until the Pawn is given local bounds.
+     * */
+    BoundingBox GetBoundingBox() const;
+    BoundingSphere BGE_NCP GetBoundingSphere() const;
+
+    /* *
+     * Keep the Pawn's bounding box in a broadphase, updated whenever the
+     * Pawn moves, with the Pawn as its data. Pass NULL to take it out.
+     * The broadphase must outlive the Pawn, or be unset first.
+     * */
+    Result SetBroadphase(Broadphase* Index);
+    Broadphase* GetBroadphase() const;
+    int GetBroadphaseHandle() const;
+
 
 protected:
 
     Quaternion Facing;
     Vector4 Scale;
 
+    /* Bounds in model space, and in world space after placing the Pawn */
+    BoundingBox LocalBox;
+    BoundingSphere LocalSphere;
+    BoundingBox WorldBox;
+    BoundingSphere WorldSphere;
+
+    Broadphase* SpatialIndex;
+    int SpatialHandle;
+
+    void SetLocalBounds(BoundingBox BGE_NCP Box,
+                        BoundingSphere BGE_NCP Sphere);
+
+    /* Recompute world bounds after the Pawn or its local bounds change */
+    void UpdateBounds();
+
 }; /* Pawn */
 
 } /* bakge */
@@ -47,6 +47,9 @@ protected:
 
     Shape();
 
+    /* Also gives the Pawn the mesh's bounds as its local bounds */
+    Result SetPositionData(const Scalar* Positions, int NumPositions);
+
 
 public:
 
@@ -59,6 +62,9 @@ public:
 
     virtual Result Draw() const;
 
+    /* Pawn's bounds, which follow the Shape as it moves */
+    BoundingBox GetBoundingBox() const;
+
 }; /* Shape */
 
 } /* bakge */
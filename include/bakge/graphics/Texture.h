@@ -47,6 +47,8 @@ public:
     BGE_FACTORY Texture* Create(int Width, int Height, GLint Format,
                                             GLenum Type, void* Data);
 
+    BGE_POOLED_DECLARE
+
     Result Bind() const;
     Result Unbind() const;
 
@@ -46,6 +46,8 @@ public:
 
     BGE_FACTORY Cone* Create(Scalar BaseRadius, Scalar TopRadius, Scalar Height);
 
+    BGE_POOLED_DECLARE
+
     BGE_INL void SetTopRadius(Scalar Top)
     {
         TopRadius = Top;
@@ -46,6 +46,8 @@ public:
 
     BGE_FACTORY Cube* Create(Scalar Length, Scalar Width, Scalar Height);
 
+    BGE_POOLED_DECLARE
+
     BGE_INL void SetDimensions(Scalar X, Scalar Y, Scalar Z)
     {
         Dimensions[0] = X;
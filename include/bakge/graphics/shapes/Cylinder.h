@@ -50,6 +50,8 @@ public:
 
     BGE_FACTORY Cylinder* Create(Scalar Radius, Scalar Height);
 
+    BGE_POOLED_DECLARE
+
     BGE_INL void SetHeight(Scalar ConeHeight)
     {
         Height = ConeHeight;
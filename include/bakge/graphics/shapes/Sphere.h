@@ -48,6 +48,8 @@ public:
 
     BGE_FACTORY Sphere* Create(Scalar Radius);
 
+    BGE_POOLED_DECLARE
+
     BGE_INL Scalar BGE_NCP SetRadius(Scalar BGE_NCP R)
     {
         return Radius = R;
@@ -0,0 +1,107 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_BOUNDINGBOX_H
+#define BAKGE_MATH_BOUNDINGBOX_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Axis-aligned bounding box, stored as its minimum and maximum corners
+ * (W = 1). A default constructed box is empty: its minimum is larger
+ * than its maximum, so expanding it by any point gives a box around just
+ * that point.
+ *
+ * Arrays of BoundingBoxes are tightly packed 8 Scalar records so the
+ * batched tests here and in Frustum can stream through them.
+ * */
+class BGE_API BoundingBox
+{
+    Vector4 Min;
+    Vector4 Max;
+
+
+public:
+
+    /* Defaults to an empty box */
+    constexpr BoundingBox() : Min(FLT_MAX, FLT_MAX, FLT_MAX, 1),
+                                Max(-FLT_MAX, -FLT_MAX, -FLT_MAX, 1)
+    {
+    }
+
+    constexpr BoundingBox(Vector4 BGE_NCP Min, Vector4 BGE_NCP Max)
+                : Min(Min[0], Min[1], Min[2], 1), Max(Max[0], Max[1], Max[2], 1)
+    {
+    }
+
+    /* Smallest box around NumPoints tightly packed X, Y, Z positions */
+    static BoundingBox FromPoints(const Scalar* Positions, int NumPoints);
+
+    constexpr Vector4 BGE_NCP GetMin() const
+    {
+        return Min;
+    }
+
+    constexpr Vector4 BGE_NCP GetMax() const
+    {
+        return Max;
+    }
+
+    bool IsEmpty() const;
+
+    Vector4 GetCenter() const;
+
+    /* Half the box's size along each axis */
+    Vector4 GetExtents() const;
+
+    /* Grow the box to contain a point or another box */
+    BoundingBox BGE_NCP Expand(Vector4 BGE_NCP Point);
+    BoundingBox BGE_NCP Expand(BoundingBox BGE_NCP Other);
+
+    bool Contains(Vector4 BGE_NCP Point) const;
+
+    /* Boxes that only touch are considered intersecting */
+    bool Intersects(BoundingBox BGE_NCP Other) const;
+
+    /* *
+     * Test this box against N others, writing true to Results where they
+     * intersect. Returns the number of intersecting boxes.
+     * */
+    size_t Intersects(const BoundingBox* Others, bool* Results,
+                                                    size_t N) const;
+
+    /* *
+     * Box around this box after an affine transform. The result contains
+     * the transformed box but is larger than it when there is rotation.
+     * */
+    BoundingBox Transformed(Matrix BGE_NCP Transform) const;
+
+}; /* BoundingBox */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_BOUNDINGBOX_H */
@@ -0,0 +1,93 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_BOUNDINGSPHERE_H
+#define BAKGE_MATH_BOUNDINGSPHERE_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Bounding sphere packed into 4 Scalars: the center's X, Y, Z and then
+ * the radius. A default constructed sphere is empty, with a radius of -1.
+ *
+ * Spheres are the cheapest bounds to test and don't grow when rotated,
+ * so they suit objects that spin. They are looser than boxes around long
+ * or flat shapes.
+ * */
+class BGE_API BoundingSphere
+{
+    Scalar Val[4];
+
+
+public:
+
+    /* Defaults to an empty sphere */
+    constexpr BoundingSphere() : Val{0, 0, 0, -1}
+    {
+    }
+
+    constexpr BoundingSphere(Vector4 BGE_NCP Center, Scalar Radius)
+                        : Val{Center[0], Center[1], Center[2], Radius}
+    {
+    }
+
+    /* *
+     * Sphere around NumPoints tightly packed X, Y, Z positions. It is
+     * centered on their bounding box, so it is tight for symmetric
+     * shapes but not the smallest possible sphere in general.
+     * */
+    static BoundingSphere FromPoints(const Scalar* Positions, int NumPoints);
+
+    constexpr Vector4 GetCenter() const
+    {
+        return Vector4(Val[0], Val[1], Val[2], 1);
+    }
+
+    constexpr Scalar BGE_NCP GetRadius() const
+    {
+        return Val[3];
+    }
+
+    bool IsEmpty() const;
+
+    bool Contains(Vector4 BGE_NCP Point) const;
+
+    /* Spheres that only touch are considered intersecting */
+    bool Intersects(BoundingSphere BGE_NCP Other) const;
+    bool Intersects(BoundingBox BGE_NCP Box) const;
+
+    /* *
+     * Sphere around this sphere after an affine transform. Non-uniform
+     * scale grows the radius by the largest scale factor.
+     * */
+    BoundingSphere Transformed(Matrix BGE_NCP Transform) const;
+
+}; /* BoundingSphere */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_BOUNDINGSPHERE_H */
@@ -0,0 +1,104 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_DUALQUATERNION_H
+#define BAKGE_MATH_DUALQUATERNION_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * A rigid transform (rotation and translation, no scale) stored as a
+ * unit dual quaternion: a real part holding the rotation and a dual part
+ * holding half the translation times the rotation, both X, Y, Z, W.
+ *
+ * Dual quaternions blend without the volume loss ("candy wrapper") that
+ * blending matrices causes, which makes them the usual choice for
+ * skinning. Blending is a weighted sum followed by a normalize, so arrays
+ * of thousands can be blended per frame with BlendMany.
+ * */
+class BGE_API DualQuaternion
+{
+    Vector4 Real;
+    Vector4 Dual;
+
+
+public:
+
+    /* Defaults to the identity transform */
+    constexpr DualQuaternion() : Real(0, 0, 0, 1), Dual(0, 0, 0, 0)
+    {
+    }
+
+    DualQuaternion(Quaternion BGE_NCP Rotation, Vector4 BGE_NCP Translation);
+
+    /* Scale is dropped; dual quaternions can't represent it */
+    static DualQuaternion FromTransform(Transform BGE_NCP Xform);
+
+    Quaternion GetRotation() const;
+    Vector4 GetTranslation() const;
+
+    Matrix ToMatrix() const;
+
+    /* Composition. The result applies Other first, then this transform */
+    DualQuaternion operator*(DualQuaternion BGE_NCP Other) const;
+    DualQuaternion BGE_NCP operator*=(DualQuaternion BGE_NCP Other);
+
+    /* Transform a point or vector. Translation is scaled by W */
+    Vector4 operator*(Vector4 BGE_NCP Vec) const;
+
+    /* Inverse of a unit dual quaternion */
+    DualQuaternion BGE_NCP Invert();
+    DualQuaternion Inverted() const;
+
+    /* *
+     * Restore unit length after accumulating error. Leaves the dual
+     * quaternion unchanged if its real part is 0.
+     * */
+    DualQuaternion BGE_NCP Normalize();
+    DualQuaternion Normalized() const;
+
+    /* Interpolate from From (T = 0) to To (T = 1) along the shorter arc */
+    static DualQuaternion Blend(DualQuaternion BGE_NCP From,
+                                DualQuaternion BGE_NCP To, Scalar T);
+
+    /* *
+     * Weighted blend of Num transforms, e.g. the joints influencing one
+     * skinned vertex. Weights should sum to 1.
+     * */
+    static DualQuaternion Blend(const DualQuaternion* Joints,
+                                const Scalar* Weights, int Num);
+
+    /* Blend N pairs by the same T. Out can be From or To */
+    static void BlendMany(const DualQuaternion* From,
+                          const DualQuaternion* To, Scalar T,
+                          DualQuaternion* Out, size_t N);
+
+}; /* DualQuaternion */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_DUALQUATERNION_H */
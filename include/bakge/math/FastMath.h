@@ -0,0 +1,343 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_FASTMATH_H
+#define BAKGE_MATH_FASTMATH_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Opt-in approximations of the libm functions used in hot math loops.
+ * Each comes in a scalar form and a ScalarLanes form (see SIMD.h) for
+ * structure-of-arrays kernels. Lane forms give the same results as the
+ * scalar forms, except FastRsqrt's initial estimate can differ between
+ * instruction sets.
+ *
+ * Error bounds are the largest seen by test/fastmath, which sweeps each
+ * domain against double precision libm. They are given in ULPs (units
+ * in the last place of the correctly rounded float result).
+ *
+ *   FastRsqrt     x > 0 (normal)       4 ULP
+ *   FastSin/Cos   |x| <= 8192          2 ULP, or 8e-8 absolute where the
+ *                                      result is under 1/64
+ *   FastAtan2     all finite x, y      3.5 ULP
+ *
+ * Outside those domains results degrade: sin/cos lose accuracy with
+ * larger arguments since the reduction uses a 3-part Pi/4, FastRsqrt of
+ * 0 or a denormal is inf or inaccurate, and FastAtan2(0, 0) returns 0.
+ *
+ * Sin/cos guarantee nothing past |x| = BGE_FAST_SINCOS_LIMIT, where
+ * floats are an eighth apart. Such arguments, infinities and NaN are
+ * clamped to the limit, so they give some value in [-1, 1] instead of
+ * overflowing the quadrant count.
+ * */
+
+/* Largest argument FastSinCos reduces; keeps the quadrant within int */
+#define BGE_FAST_SINCOS_LIMIT 1048576.0f
+
+/* 4 / Pi, and Pi/4 split into 3 parts for Cody-Waite argument reduction */
+#define BGE_FAST_4_OVER_PI 1.27323954473516f
+#define BGE_FAST_PI_4_A 0.78515625f
+#define BGE_FAST_PI_4_B 2.4187564849853515625e-4f
+#define BGE_FAST_PI_4_C 3.77489497744594108e-8f
+
+#define BGE_FAST_PI 3.14159265358979f
+#define BGE_FAST_PI_2 1.57079632679490f
+#define BGE_FAST_PI_4 0.78539816339745f
+#define BGE_FAST_TAN_PI_8 0.41421356237310f
+
+/* Minimax polynomials on [-Pi/4, Pi/4] and atan on [0, tan(Pi/8)] */
+#define BGE_FAST_SIN_P0 -1.9515295891e-4f
+#define BGE_FAST_SIN_P1 8.3321608736e-3f
+#define BGE_FAST_SIN_P2 -1.6666654611e-1f
+#define BGE_FAST_COS_P0 2.443315711809948e-5f
+#define BGE_FAST_COS_P1 -1.388731625493765e-3f
+#define BGE_FAST_COS_P2 4.166664568298827e-2f
+#define BGE_FAST_ATAN_P0 8.05374449538e-2f
+#define BGE_FAST_ATAN_P1 -1.38776856032e-1f
+#define BGE_FAST_ATAN_P2 1.99777106478e-1f
+#define BGE_FAST_ATAN_P3 -3.33329491539e-1f
+
+
+/* 1 / sqrt(X): hardware estimate (or bit trick), refined with Newton */
+BGE_INL Scalar FastRsqrt(Scalar X)
+{
+#if defined(BGE_SIMD_SSE)
+    Scalar Y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(X)));
+
+    return Y * (1.5f - 0.5f * X * Y * Y);
+#else
+    unsigned int Bits;
+    Scalar Y;
+
+    /* Initial guess good to about 4 bits; each step roughly doubles it */
+    memcpy(&Bits, &X, sizeof(Bits));
+    Bits = 0x5F375A86 - (Bits >> 1);
+    memcpy(&Y, &Bits, sizeof(Y));
+
+    Y = Y * (1.5f - 0.5f * X * Y * Y);
+    Y = Y * (1.5f - 0.5f * X * Y * Y);
+    Y = Y * (1.5f - 0.5f * X * Y * Y);
+
+    return Y;
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void FastSinCos(Radians X, Scalar* Sin, Scalar* Cos)
+{
+    Scalar AX = fabsf(X);
+    Scalar Y, R, Z, S, C, Temp;
+    int J;
+
+    /* Written so NaN fails the test and is clamped as well */
+    if(!(AX < BGE_FAST_SINCOS_LIMIT))
+        AX = BGE_FAST_SINCOS_LIMIT;
+
+    /* Nearest even multiple of Pi/4, i.e. nearest multiple of Pi/2 */
+    J = (int)(AX * BGE_FAST_4_OVER_PI);
+    J += J & 1;
+    Y = (Scalar)J;
+
+    R = ((AX - Y * BGE_FAST_PI_4_A) - Y * BGE_FAST_PI_4_B)
+                                        - Y * BGE_FAST_PI_4_C;
+    Z = R * R;
+
+    S = ((BGE_FAST_SIN_P0 * Z + BGE_FAST_SIN_P1) * Z + BGE_FAST_SIN_P2)
+                                                            * Z * R + R;
+    C = ((BGE_FAST_COS_P0 * Z + BGE_FAST_COS_P1) * Z + BGE_FAST_COS_P2)
+                                                * Z * Z - 0.5f * Z + 1;
+
+    /* Quadrant 0, 2, 4 or 6 (in units of Pi/4) */
+    J &= 7;
+
+    if(J == 2 || J == 6) {
+        Temp = S;
+        S = C;
+        C = Temp;
+    }
+
+    if(J >= 4)
+        S = -S;
+
+    if(J == 2 || J == 4)
+        C = -C;
+
+    if(X < 0)
+        S = -S;
+
+    *Sin = S;
+    *Cos = C;
+}
+
+
+BGE_INL Scalar FastSin(Radians X)
+{
+    Scalar S, C;
+
+    FastSinCos(X, &S, &C);
+
+    return S;
+}
+
+
+BGE_INL Scalar FastCos(Radians X)
+{
+    Scalar S, C;
+
+    FastSinCos(X, &S, &C);
+
+    return C;
+}
+
+
+BGE_INL Radians FastAtan2(Scalar Y, Scalar X)
+{
+    Scalar AX = fabsf(X);
+    Scalar AY = fabsf(Y);
+    Scalar Lo = AX < AY ? AX : AY;
+    Scalar Hi = AX < AY ? AY : AX;
+    Scalar T, Z, Offset, A;
+
+    if(Hi == 0)
+        return 0;
+
+    /* atan of a ratio in [0, 1], reduced further to [0, tan(Pi/8)] */
+    T = Lo / Hi;
+    Offset = 0;
+
+    if(T > BGE_FAST_TAN_PI_8) {
+        T = (T - 1) / (T + 1);
+        Offset = BGE_FAST_PI_4;
+    }
+
+    Z = T * T;
+    A = Offset + ((((BGE_FAST_ATAN_P0 * Z + BGE_FAST_ATAN_P1) * Z
+                + BGE_FAST_ATAN_P2) * Z + BGE_FAST_ATAN_P3) * Z * T + T);
+
+    /* Undo the octant folding */
+    if(AY > AX)
+        A = BGE_FAST_PI_2 - A;
+
+    if(X < 0)
+        A = BGE_FAST_PI - A;
+
+    if(Y < 0)
+        A = -A;
+
+    return A;
+}
+
+
+/* Lane forms of the above; same domains and error bounds */
+BGE_INL ScalarLanes LanesRsqrt(ScalarLanes X)
+{
+#if defined(BGE_SIMD_SSE)
+#ifdef BGE_SIMD_AVX
+    ScalarLanes Y = _mm256_rsqrt_ps(X);
+#else
+    ScalarLanes Y = _mm_rsqrt_ps(X);
+#endif /* BGE_SIMD_AVX */
+
+    return LanesMul(Y, LanesSub(LanesSet(1.5f), LanesMul(LanesMul(
+                    LanesMul(LanesSet(0.5f), X), Y), Y)));
+#elif BGE_LANE_WIDTH == 4
+    /* AArch64 NEON. Its estimate is only good to 8 bits; take 2 steps */
+    ScalarLanes Y = vrsqrteq_f32(X);
+
+    Y = vmulq_f32(Y, vrsqrtsq_f32(vmulq_f32(X, Y), Y));
+
+    return vmulq_f32(Y, vrsqrtsq_f32(vmulq_f32(X, Y), Y));
+#else
+    return FastRsqrt(X);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void LanesSinCos(ScalarLanes X, ScalarLanes* Sin, ScalarLanes* Cos)
+{
+    ScalarLanes Zero = LanesSet(0);
+    ScalarLanes AX = LanesAbs(X);
+    ScalarLanes J, R, Z, S, C, Quadrant;
+    LaneMask Swap;
+
+    /* Same clamp as FastSinCos; NaN compares false and is clamped too */
+    AX = LanesSelect(LanesLess(AX, LanesSet(BGE_FAST_SINCOS_LIMIT)), AX,
+                                        LanesSet(BGE_FAST_SINCOS_LIMIT));
+
+    J = LanesTrunc(LanesMul(AX, LanesSet(BGE_FAST_4_OVER_PI)));
+    J = LanesAdd(J, LanesSub(J, LanesMul(LanesSet(2),
+                    LanesTrunc(LanesMul(J, LanesSet(0.5f))))));
+
+    R = LanesSub(LanesSub(LanesSub(AX, LanesMul(J,
+                LanesSet(BGE_FAST_PI_4_A))), LanesMul(J,
+                LanesSet(BGE_FAST_PI_4_B))), LanesMul(J,
+                LanesSet(BGE_FAST_PI_4_C)));
+    Z = LanesMul(R, R);
+
+    S = LanesAdd(LanesMul(LanesMul(LanesAdd(LanesMul(LanesAdd(LanesMul(
+                LanesSet(BGE_FAST_SIN_P0), Z), LanesSet(BGE_FAST_SIN_P1)),
+                Z), LanesSet(BGE_FAST_SIN_P2)), Z), R), R);
+    C = LanesAdd(LanesSub(LanesMul(LanesMul(LanesAdd(LanesMul(LanesAdd(
+                LanesMul(LanesSet(BGE_FAST_COS_P0), Z),
+                LanesSet(BGE_FAST_COS_P1)), Z), LanesSet(BGE_FAST_COS_P2)),
+                Z), Z), LanesMul(LanesSet(0.5f), Z)), LanesSet(1));
+
+    /* J mod 8: quadrant 0, 2, 4 or 6 */
+    Quadrant = LanesSub(J, LanesMul(LanesSet(8),
+                    LanesTrunc(LanesMul(J, LanesSet(0.125f)))));
+
+    Swap = LanesOr(LanesEqual(Quadrant, LanesSet(2)),
+                        LanesEqual(Quadrant, LanesSet(6)));
+
+    *Sin = LanesSelect(Swap, C, S);
+    *Cos = LanesSelect(Swap, S, C);
+
+    *Sin = LanesSelect(LanesLess(LanesSet(3), Quadrant),
+                                LanesSub(Zero, *Sin), *Sin);
+    *Sin = LanesSelect(LanesLess(X, Zero), LanesSub(Zero, *Sin), *Sin);
+    *Cos = LanesSelect(LanesOr(LanesEqual(Quadrant, LanesSet(2)),
+                            LanesEqual(Quadrant, LanesSet(4))),
+                            LanesSub(Zero, *Cos), *Cos);
+}
+
+
+BGE_INL ScalarLanes LanesSin(ScalarLanes X)
+{
+    ScalarLanes S, C;
+
+    LanesSinCos(X, &S, &C);
+
+    return S;
+}
+
+
+BGE_INL ScalarLanes LanesCos(ScalarLanes X)
+{
+    ScalarLanes S, C;
+
+    LanesSinCos(X, &S, &C);
+
+    return C;
+}
+
+
+BGE_INL ScalarLanes LanesAtan2(ScalarLanes Y, ScalarLanes X)
+{
+    ScalarLanes Zero = LanesSet(0);
+    ScalarLanes AX = LanesAbs(X);
+    ScalarLanes AY = LanesAbs(Y);
+    ScalarLanes Hi = LanesMax(AX, AY);
+    ScalarLanes T, Folded, Z, A;
+    LaneMask Big;
+
+    T = LanesDiv(LanesMin(AX, AY), Hi);
+
+    Big = LanesLess(LanesSet(BGE_FAST_TAN_PI_8), T);
+    Folded = LanesDiv(LanesSub(T, LanesSet(1)), LanesAdd(T, LanesSet(1)));
+    T = LanesSelect(Big, Folded, T);
+
+    Z = LanesMul(T, T);
+    A = LanesAdd(LanesMul(LanesMul(LanesAdd(LanesMul(LanesAdd(LanesMul(
+            LanesAdd(LanesMul(LanesSet(BGE_FAST_ATAN_P0), Z),
+            LanesSet(BGE_FAST_ATAN_P1)), Z), LanesSet(BGE_FAST_ATAN_P2)), Z),
+            LanesSet(BGE_FAST_ATAN_P3)), Z), T), T);
+    A = LanesAdd(LanesSelect(Big, LanesSet(BGE_FAST_PI_4), Zero), A);
+
+    A = LanesSelect(LanesLess(AX, AY), LanesSub(LanesSet(BGE_FAST_PI_2), A),
+                                                                        A);
+    A = LanesSelect(LanesLess(X, Zero), LanesSub(LanesSet(BGE_FAST_PI), A),
+                                                                        A);
+    A = LanesSelect(LanesLess(Y, Zero), LanesSub(Zero, A), A);
+
+    /* atan2(0, 0) */
+    return LanesSelect(LanesEqual(Hi, Zero), Zero, A);
+}
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_FASTMATH_H */
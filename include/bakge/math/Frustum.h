@@ -0,0 +1,91 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_FRUSTUM_H
+#define BAKGE_MATH_FRUSTUM_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+enum FRUSTUM_PLANES
+{
+    FRUSTUM_PLANE_LEFT = 0,
+    FRUSTUM_PLANE_RIGHT,
+    FRUSTUM_PLANE_BOTTOM,
+    FRUSTUM_PLANE_TOP,
+    FRUSTUM_PLANE_NEAR,
+    FRUSTUM_PLANE_FAR,
+    NUM_FRUSTUM_PLANES
+};
+
+/* *
+ * View frustum as 6 planes facing inwards. Each plane is stored as its
+ * unit normal in X, Y, Z and distance in W, so a point P is on the inner
+ * side when Dot(Plane, P) + W >= 0.
+ *
+ * Box and sphere tests are conservative: anything that crosses the
+ * frustum is reported as intersecting it, and so are some objects just
+ * outside its corners. Empty bounds never intersect.
+ *
+ * Prefer the batched tests when culling many objects. They test several
+ * objects per instruction and don't branch on the results.
+ * */
+class BGE_API Frustum
+{
+    Vector4 Planes[NUM_FRUSTUM_PLANES];
+
+
+public:
+
+    /* Defaults to a frustum that contains everything */
+    Frustum();
+
+    /* Extract the frustum of a projection * view matrix */
+    Frustum(Matrix BGE_NCP ViewProjection);
+
+    Frustum BGE_NCP SetMatrix(Matrix BGE_NCP ViewProjection);
+
+    Vector4 BGE_NCP GetPlane(FRUSTUM_PLANES Plane) const;
+
+    bool Contains(Vector4 BGE_NCP Point) const;
+
+    bool Intersects(BoundingBox BGE_NCP Box) const;
+    bool Intersects(BoundingSphere BGE_NCP Sphere) const;
+
+    /* *
+     * Test N boxes or spheres, writing true to Results for the ones that
+     * intersect the frustum. Returns how many do.
+     * */
+    size_t Intersects(const BoundingBox* Boxes, bool* Results,
+                                                    size_t N) const;
+    size_t Intersects(const BoundingSphere* Spheres, bool* Results,
+                                                    size_t N) const;
+
+}; /* Frustum */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_FRUSTUM_H */
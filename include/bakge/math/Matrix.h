@@ -40,6 +40,9 @@ namespace bakge
  * matrices for 2D and 3D renderers.
  *
  * Position and/or rotation data can be described with a Node or Pawn object.
+ *
+ * Matrix is a trivially copyable value type with constexpr constructors,
+ * so Val can be memcpy'd or handed to glUniformMatrix4fv directly.
  * */
 class BGE_API Matrix
 {
@@ -50,14 +53,25 @@ public:
 
     static const Matrix Identity;
 
-    Matrix();
-    ~Matrix();
-    Matrix(Scalar A, Scalar B, Scalar C, Scalar D,
-           Scalar E, Scalar F, Scalar G, Scalar H,
-           Scalar I, Scalar J, Scalar K, Scalar L,
-           Scalar M, Scalar N, Scalar O, Scalar P);
+    /* Defaults to the identity matrix */
+    constexpr Matrix() : Val{1, 0, 0, 0,
+                             0, 1, 0, 0,
+                             0, 0, 1, 0,
+                             0, 0, 0, 1}
+    {
+    }
 
-    BGE_INL Scalar BGE_NCP operator[](int BGE_NCP At) const
+
+    constexpr Matrix(Scalar A, Scalar B, Scalar C, Scalar D,
+                     Scalar E, Scalar F, Scalar G, Scalar H,
+                     Scalar I, Scalar J, Scalar K, Scalar L,
+                     Scalar M, Scalar N, Scalar O, Scalar P)
+                     : Val{A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P}
+    {
+    }
+
+
+    constexpr Scalar BGE_NCP operator[](int BGE_NCP At) const
     {
         return Val[At];
     }
@@ -79,6 +93,38 @@ public:
     Matrix BGE_NCP SetLookAt(Vector4 BGE_NCP Position, Vector4 BGE_NCP Target,
                                                     Vector4 BGE_NCP UpVector);
 
+    /* Matrix product. The result applies Other first, then this matrix */
+    Matrix operator*(Matrix BGE_NCP Other) const;
+    Matrix BGE_NCP operator*=(Matrix BGE_NCP Other);
+
+    /* Transform a point or vector. W is used as given */
+    Vector4 operator*(Vector4 BGE_NCP Vec) const;
+
+    /* *
+     * Transform N points or vectors from In into Out. In and Out can be
+     * the same array or overlap. This is the fast path for bulk work;
+     * prefer it to transforming Vector4s one at a time.
+     * */
+    void TransformPoints(const Vector4* In, Vector4* Out, size_t N) const;
+
+    Matrix BGE_NCP Transpose();
+    Matrix Transposed() const;
+
+    /* *
+     * General inverse. Singular matrices can't be inverted; the operation
+     * is cancelled and the matrix is left unchanged.
+     * */
+    Matrix BGE_NCP Invert();
+    Matrix Inverted() const;
+
+    /* *
+     * Cheaper inverse for affine transforms (rotation, scale, shear and
+     * translation, with a bottom row of 0 0 0 1). Don't use it on
+     * projection matrices.
+     * */
+    Matrix BGE_NCP InvertAffine();
+    Matrix InvertedAffine() const;
+
 }; /* Matrix */
 
 } /* bakge */
@@ -42,6 +42,9 @@ namespace bakge
  *
  * Quaternions also see use in animation keyframing, where joints' or bones'
  * rotations are relative to their parent joint.
+ *
+ * Quaternion is a trivially copyable value type with constexpr
+ * constructors. The default is the identity rotation.
  * */
 class BGE_API Quaternion
 {
@@ -51,10 +54,28 @@ class BGE_API Quaternion
 
 public:
 
-    Quaternion();
-    Quaternion(Vector4 BGE_NCP Vec, Scalar BGE_NCP Real);
-    Quaternion(Quaternion BGE_NCP Other);
-    ~Quaternion();
+    constexpr Quaternion() : Vec(0, 0, 0, 0), Real(1)
+    {
+    }
+
+
+    constexpr Quaternion(Vector4 BGE_NCP Vec, Scalar BGE_NCP Real)
+                                            : Vec(Vec), Real(Real)
+    {
+    }
+
+
+    /* Imaginary part in X, Y and Z */
+    constexpr Vector4 BGE_NCP GetVector() const
+    {
+        return Vec;
+    }
+
+
+    constexpr Scalar BGE_NCP GetReal() const
+    {
+        return Real;
+    }
 
     Matrix ToMatrix() const;
 
@@ -88,6 +109,44 @@ public:
     Scalar Length() const;
     Scalar LengthSq() const;
 
+    /* *
+     * Rotate a vector or point without building a matrix. The quaternion
+     * must be unit length. W is passed through unchanged.
+     * */
+    Vector4 Rotate(Vector4 BGE_NCP Vec) const;
+
+    /* *
+     * Rotate N vectors from In into Out by this quaternion. In and Out can
+     * be the same array or overlap. Results match Rotate exactly. For very
+     * large N, ToMatrix followed by Matrix::TransformPoints is cheaper
+     * per vector, at the cost of building the matrix.
+     * */
+    void RotateMany(const Vector4* In, Vector4* Out, size_t N) const;
+
+    /* *
+     * Rotate In[i] by Rotations[i] for N vectors, e.g. every Pawn's facing
+     * each frame. Same aliasing rules as RotateMany. This is the fast path
+     * for per-object rotations; no matrices are built.
+     * */
+    static void RotateMany(const Quaternion* Rotations, const Vector4* In,
+                                                Vector4* Out, size_t N);
+
+    /* *
+     * Spherical linear interpolation from From (T = 0) to To (T = 1) at
+     * constant angular speed. Always takes the shorter arc. Both inputs
+     * should be unit length.
+     * */
+    static Quaternion Slerp(Quaternion BGE_NCP From, Quaternion BGE_NCP To,
+                                                                Scalar T);
+
+    /* *
+     * Normalized linear interpolation. Follows the same path as Slerp but
+     * not at constant speed; much cheaper, and close enough for blending
+     * nearby keyframes.
+     * */
+    static Quaternion Nlerp(Quaternion BGE_NCP From, Quaternion BGE_NCP To,
+                                                                Scalar T);
+
 }; /* Quaternion */
 
 } /* bakge */
@@ -0,0 +1,1632 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_SIMD_H
+#define BAKGE_MATH_SIMD_H
+
+#include <bakge/Bakge.h>
+
+/* *
+ * SIMD instruction set selection. Chosen at compile time from what the
+ * compiler targets; define BGE_NO_SIMD (CMake option BAKGE_USE_SIMD=OFF)
+ * to force the portable scalar kernels everywhere.
+ * */
+#ifndef BGE_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) \
+                      || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BGE_SIMD_SSE
+#include <emmintrin.h>
+#ifdef __AVX__
+#define BGE_SIMD_AVX
+#include <immintrin.h>
+#endif /* __AVX__ */
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BGE_SIMD_NEON
+#include <arm_neon.h>
+#endif /* __SSE2__ */
+#endif /* BGE_NO_SIMD */
+
+#if defined(BGE_SIMD_AVX)
+#define BGE_SIMD_NAME "SSE2+AVX"
+#elif defined(BGE_SIMD_SSE)
+#define BGE_SIMD_NAME "SSE2"
+#elif defined(BGE_SIMD_NEON)
+#define BGE_SIMD_NAME "NEON"
+#else
+#define BGE_SIMD_NAME "Scalar"
+#endif /* BGE_SIMD_AVX */
+
+namespace bakge
+{
+
+/* *
+ * Low-level kernels backing Vector4 and Matrix. They operate on raw
+ * Scalar arrays: 4 components for vectors, 16 column-major components
+ * for matrices. Out may alias any of the inputs.
+ *
+ * Each kernel has a portable reference version, suffixed with Ref, which
+ * is always compiled. The unsuffixed version uses whichever instruction
+ * set was selected above and must give the same results as the reference
+ * version; keep them in sync when changing either one.
+ *
+ * The XYZ kernels leave W untouched (copied from the left operand), to
+ * match Vector4's compound assignment operators.
+ * */
+
+BGE_INL void Vec4AddRef(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+    Out[0] = L[0] + R[0];
+    Out[1] = L[1] + R[1];
+    Out[2] = L[2] + R[2];
+    Out[3] = L[3] + R[3];
+}
+
+
+BGE_INL void Vec4SubRef(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+    Out[0] = L[0] - R[0];
+    Out[1] = L[1] - R[1];
+    Out[2] = L[2] - R[2];
+    Out[3] = L[3] - R[3];
+}
+
+
+BGE_INL void Vec4AddXYZRef(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+    Out[0] = L[0] + R[0];
+    Out[1] = L[1] + R[1];
+    Out[2] = L[2] + R[2];
+    Out[3] = L[3];
+}
+
+
+BGE_INL void Vec4SubXYZRef(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+    Out[0] = L[0] - R[0];
+    Out[1] = L[1] - R[1];
+    Out[2] = L[2] - R[2];
+    Out[3] = L[3];
+}
+
+
+BGE_INL void Vec4ScaleXYZRef(const Scalar* L, Scalar S, Scalar* Out)
+{
+    Out[0] = L[0] * S;
+    Out[1] = L[1] * S;
+    Out[2] = L[2] * S;
+    Out[3] = L[3];
+}
+
+
+BGE_INL Scalar Vec4Dot3Ref(const Scalar* L, const Scalar* R)
+{
+    return L[0] * R[0] + L[1] * R[1] + L[2] * R[2];
+}
+
+
+BGE_INL void Vec4Cross3Ref(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+    Scalar X, Y, Z;
+
+    X = L[1] * R[2] - L[2] * R[1];
+    Y = L[2] * R[0] - L[0] * R[2];
+    Z = L[0] * R[1] - L[1] * R[0];
+
+    Out[0] = X;
+    Out[1] = Y;
+    Out[2] = Z;
+    Out[3] = 0;
+}
+
+
+BGE_INL void Vec4NormalizeXYZRef(const Scalar* L, Scalar* Out)
+{
+    Scalar Len = sqrtf(Vec4Dot3Ref(L, L));
+
+    Out[0] = L[0] / Len;
+    Out[1] = L[1] / Len;
+    Out[2] = L[2] / Len;
+    Out[3] = L[3];
+}
+
+
+BGE_INL void Mat4MultiplyRef(const Scalar* A, const Scalar* B, Scalar* Out)
+{
+    Scalar Temp[16];
+
+    for(int Col = 0; Col < 4; ++Col) {
+        for(int Row = 0; Row < 4; ++Row) {
+            Temp[Col * 4 + Row] = A[Row] * B[Col * 4]
+                                + A[4 + Row] * B[Col * 4 + 1]
+                                + A[8 + Row] * B[Col * 4 + 2]
+                                + A[12 + Row] * B[Col * 4 + 3];
+        }
+    }
+
+    memcpy((void*)Out, (const void*)Temp, sizeof(Temp));
+}
+
+BGE_INL void Mat4TransposeRef(const Scalar* M, Scalar* Out)
+{
+    Scalar Temp[16];
+
+    for(int Col = 0; Col < 4; ++Col) {
+        for(int Row = 0; Row < 4; ++Row)
+            Temp[Row * 4 + Col] = M[Col * 4 + Row];
+    }
+
+    memcpy((void*)Out, (const void*)Temp, sizeof(Temp));
+}
+
+
+/* *
+ * General 4x4 inverse by cofactor expansion. Returns the determinant of M;
+ * if it is 0 the matrix is singular and Out is left untouched.
+ * */
+BGE_INL Scalar Mat4InverseRef(const Scalar* M, Scalar* Out)
+{
+    Scalar Inv[16];
+    Scalar Det;
+
+    Inv[0] = M[5] * M[10] * M[15] - M[5] * M[11] * M[14]
+           - M[9] * M[6] * M[15] + M[9] * M[7] * M[14]
+           + M[13] * M[6] * M[11] - M[13] * M[7] * M[10];
+    Inv[4] = -M[4] * M[10] * M[15] + M[4] * M[11] * M[14]
+           + M[8] * M[6] * M[15] - M[8] * M[7] * M[14]
+           - M[12] * M[6] * M[11] + M[12] * M[7] * M[10];
+    Inv[8] = M[4] * M[9] * M[15] - M[4] * M[11] * M[13]
+           - M[8] * M[5] * M[15] + M[8] * M[7] * M[13]
+           + M[12] * M[5] * M[11] - M[12] * M[7] * M[9];
+    Inv[12] = -M[4] * M[9] * M[14] + M[4] * M[10] * M[13]
+            + M[8] * M[5] * M[14] - M[8] * M[6] * M[13]
+            - M[12] * M[5] * M[10] + M[12] * M[6] * M[9];
+    Inv[1] = -M[1] * M[10] * M[15] + M[1] * M[11] * M[14]
+           + M[9] * M[2] * M[15] - M[9] * M[3] * M[14]
+           - M[13] * M[2] * M[11] + M[13] * M[3] * M[10];
+    Inv[5] = M[0] * M[10] * M[15] - M[0] * M[11] * M[14]
+           - M[8] * M[2] * M[15] + M[8] * M[3] * M[14]
+           + M[12] * M[2] * M[11] - M[12] * M[3] * M[10];
+    Inv[9] = -M[0] * M[9] * M[15] + M[0] * M[11] * M[13]
+           + M[8] * M[1] * M[15] - M[8] * M[3] * M[13]
+           - M[12] * M[1] * M[11] + M[12] * M[3] * M[9];
+    Inv[13] = M[0] * M[9] * M[14] - M[0] * M[10] * M[13]
+            - M[8] * M[1] * M[14] + M[8] * M[2] * M[13]
+            + M[12] * M[1] * M[10] - M[12] * M[2] * M[9];
+    Inv[2] = M[1] * M[6] * M[15] - M[1] * M[7] * M[14]
+           - M[5] * M[2] * M[15] + M[5] * M[3] * M[14]
+           + M[13] * M[2] * M[7] - M[13] * M[3] * M[6];
+    Inv[6] = -M[0] * M[6] * M[15] + M[0] * M[7] * M[14]
+           + M[4] * M[2] * M[15] - M[4] * M[3] * M[14]
+           - M[12] * M[2] * M[7] + M[12] * M[3] * M[6];
+    Inv[10] = M[0] * M[5] * M[15] - M[0] * M[7] * M[13]
+            - M[4] * M[1] * M[15] + M[4] * M[3] * M[13]
+            + M[12] * M[1] * M[7] - M[12] * M[3] * M[5];
+    Inv[14] = -M[0] * M[5] * M[14] + M[0] * M[6] * M[13]
+            + M[4] * M[1] * M[14] - M[4] * M[2] * M[13]
+            - M[12] * M[1] * M[6] + M[12] * M[2] * M[5];
+    Inv[3] = -M[1] * M[6] * M[11] + M[1] * M[7] * M[10]
+           + M[5] * M[2] * M[11] - M[5] * M[3] * M[10]
+           - M[9] * M[2] * M[7] + M[9] * M[3] * M[6];
+    Inv[7] = M[0] * M[6] * M[11] - M[0] * M[7] * M[10]
+           - M[4] * M[2] * M[11] + M[4] * M[3] * M[10]
+           + M[8] * M[2] * M[7] - M[8] * M[3] * M[6];
+    Inv[11] = -M[0] * M[5] * M[11] + M[0] * M[7] * M[9]
+            + M[4] * M[1] * M[11] - M[4] * M[3] * M[9]
+            - M[8] * M[1] * M[7] + M[8] * M[3] * M[5];
+    Inv[15] = M[0] * M[5] * M[10] - M[0] * M[6] * M[9]
+            - M[4] * M[1] * M[10] + M[4] * M[2] * M[9]
+            + M[8] * M[1] * M[6] - M[8] * M[2] * M[5];
+
+    Det = M[0] * Inv[0] + M[1] * Inv[4] + M[2] * Inv[8] + M[3] * Inv[12];
+    if(Det == 0)
+        return 0;
+
+    for(int i = 0; i < 16; ++i)
+        Out[i] = Inv[i] / Det;
+
+    return Det;
+}
+
+
+/* *
+ * Inverse of an affine transform (bottom row 0 0 0 1). The rows of the
+ * inverted 3x3 part are cross products of M's columns, and the inverted
+ * translation is the original one run through them. Returns the
+ * determinant; Out is left untouched if it is 0.
+ * */
+BGE_INL Scalar Mat4InverseAffineRef(const Scalar* M, Scalar* Out)
+{
+    Scalar Rows[3][4];
+    Scalar Det;
+
+    Vec4Cross3Ref(&M[4], &M[8], Rows[0]);
+    Vec4Cross3Ref(&M[8], &M[0], Rows[1]);
+    Vec4Cross3Ref(&M[0], &M[4], Rows[2]);
+
+    Det = Vec4Dot3Ref(&M[0], Rows[0]);
+    if(Det == 0)
+        return 0;
+
+    for(int Row = 0; Row < 3; ++Row) {
+        Vec4ScaleXYZRef(Rows[Row], 1 / Det, Rows[Row]);
+        Out[Row] = Rows[Row][0];
+        Out[4 + Row] = Rows[Row][1];
+        Out[8 + Row] = Rows[Row][2];
+        Out[12 + Row] = -Vec4Dot3Ref(Rows[Row], &M[12]);
+    }
+
+    Out[3] = Out[7] = Out[11] = 0;
+    Out[15] = 1;
+
+    return Det;
+}
+
+
+/* Multiply one 4-component vector by M. W is used as given */
+BGE_INL void Mat4TransformVec4Ref(const Scalar* M, const Scalar* In,
+                                                        Scalar* Out)
+{
+    Scalar X = In[0];
+    Scalar Y = In[1];
+    Scalar Z = In[2];
+    Scalar W = In[3];
+
+    for(int Row = 0; Row < 4; ++Row)
+        Out[Row] = M[Row] * X + M[4 + Row] * Y + M[8 + Row] * Z
+                                            + M[12 + Row] * W;
+}
+
+
+/* *
+ * Multiply Num 4-component vectors by M. In and Out may overlap in any
+ * way (when Out starts inside In the loop runs backwards, like memmove),
+ * but must not overlap M.
+ * */
+BGE_INL void Mat4TransformVec4sRef(const Scalar* M, const Scalar* In,
+                                            Scalar* Out, size_t Num)
+{
+    if(Out > In && Out < In + Num * 4) {
+        for(size_t i = Num; i > 0; --i)
+            Mat4TransformVec4Ref(M, &In[(i - 1) * 4], &Out[(i - 1) * 4]);
+    } else {
+        for(size_t i = 0; i < Num; ++i)
+            Mat4TransformVec4Ref(M, &In[i * 4], &Out[i * 4]);
+    }
+}
+
+#ifdef BGE_SIMD_SSE
+
+/* Reorder lanes of V. Lane indices are listed in X, Y, Z, W order */
+#define BGE_SSE_SWIZZLE(V, X, Y, Z, W) \
+    _mm_shuffle_ps((V), (V), _MM_SHUFFLE(W, Z, Y, X))
+
+/* Selects X, Y and Z lanes; clears W */
+BGE_INL __m128 SSEMaskXYZ()
+{
+    return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+}
+
+
+/* Cross product of the XYZ lanes, W cleared */
+BGE_INL __m128 SSECross3(__m128 L, __m128 R)
+{
+    __m128 Cross = _mm_sub_ps(
+        _mm_mul_ps(BGE_SSE_SWIZZLE(L, 1, 2, 0, 3),
+                   BGE_SSE_SWIZZLE(R, 2, 0, 1, 3)),
+        _mm_mul_ps(BGE_SSE_SWIZZLE(L, 2, 0, 1, 3),
+                   BGE_SSE_SWIZZLE(R, 1, 2, 0, 3)));
+
+    return _mm_and_ps(Cross, SSEMaskXYZ());
+}
+
+
+/* *
+ * Column-major 4x4 times one vector, summed in the same order as
+ * Mat4TransformVec4Ref. Cols holds the matrix's four columns.
+ * */
+BGE_INL __m128 SSETransform(const __m128* Cols, __m128 V)
+{
+    __m128 Res = _mm_mul_ps(Cols[0], BGE_SSE_SWIZZLE(V, 0, 0, 0, 0));
+    Res = _mm_add_ps(Res, _mm_mul_ps(Cols[1], BGE_SSE_SWIZZLE(V, 1, 1, 1, 1)));
+    Res = _mm_add_ps(Res, _mm_mul_ps(Cols[2], BGE_SSE_SWIZZLE(V, 2, 2, 2, 2)));
+    return _mm_add_ps(Res, _mm_mul_ps(Cols[3], BGE_SSE_SWIZZLE(V, 3, 3, 3, 3)));
+}
+
+
+/* *
+ * 2x2 matrix helpers for the block-wise 4x4 inverse. Each register holds
+ * one 2x2 matrix as (m00, m01, m10, m11); Adj is the adjugate.
+ * */
+BGE_INL __m128 SSEMat2Mul(__m128 A, __m128 B)
+{
+    return _mm_add_ps(_mm_mul_ps(A, BGE_SSE_SWIZZLE(B, 0, 3, 0, 3)),
+                      _mm_mul_ps(BGE_SSE_SWIZZLE(A, 1, 0, 3, 2),
+                                 BGE_SSE_SWIZZLE(B, 2, 1, 2, 1)));
+}
+
+
+/* Adj(A) * B */
+BGE_INL __m128 SSEMat2AdjMul(__m128 A, __m128 B)
+{
+    return _mm_sub_ps(_mm_mul_ps(BGE_SSE_SWIZZLE(A, 3, 3, 0, 0), B),
+                      _mm_mul_ps(BGE_SSE_SWIZZLE(A, 1, 1, 2, 2),
+                                 BGE_SSE_SWIZZLE(B, 2, 3, 0, 1)));
+}
+
+
+/* A * Adj(B) */
+BGE_INL __m128 SSEMat2MulAdj(__m128 A, __m128 B)
+{
+    return _mm_sub_ps(_mm_mul_ps(A, BGE_SSE_SWIZZLE(B, 3, 0, 3, 0)),
+                      _mm_mul_ps(BGE_SSE_SWIZZLE(A, 1, 0, 3, 2),
+                                 BGE_SSE_SWIZZLE(B, 2, 1, 2, 1)));
+}
+
+#endif /* BGE_SIMD_SSE */
+
+#ifdef BGE_SIMD_AVX
+
+/* *
+ * Two vectors at once. Cols holds each matrix column in both 128-bit
+ * lanes; In and Out point at two consecutive 4-component vectors.
+ * */
+BGE_INL void AVXTransformPair(const __m256* Cols, const Scalar* In,
+                                                    Scalar* Out)
+{
+    __m256 V = _mm256_loadu_ps(In);
+    __m256 Res = _mm256_mul_ps(Cols[0], _mm256_shuffle_ps(V, V, 0x00));
+    Res = _mm256_add_ps(Res, _mm256_mul_ps(Cols[1],
+                                    _mm256_shuffle_ps(V, V, 0x55)));
+    Res = _mm256_add_ps(Res, _mm256_mul_ps(Cols[2],
+                                    _mm256_shuffle_ps(V, V, 0xAA)));
+    Res = _mm256_add_ps(Res, _mm256_mul_ps(Cols[3],
+                                    _mm256_shuffle_ps(V, V, 0xFF)));
+    _mm256_storeu_ps(Out, Res);
+}
+
+#endif /* BGE_SIMD_AVX */
+
+#ifdef BGE_SIMD_NEON
+
+BGE_INL float32x4_t NEONTransform(const float32x4_t* Cols, const Scalar* In)
+{
+    float32x4_t V = vld1q_f32(In);
+    float32x4_t Res = vmulq_n_f32(Cols[0], vgetq_lane_f32(V, 0));
+    Res = vaddq_f32(Res, vmulq_n_f32(Cols[1], vgetq_lane_f32(V, 1)));
+    Res = vaddq_f32(Res, vmulq_n_f32(Cols[2], vgetq_lane_f32(V, 2)));
+    return vaddq_f32(Res, vmulq_n_f32(Cols[3], vgetq_lane_f32(V, 3)));
+}
+
+#endif /* BGE_SIMD_NEON */
+
+BGE_INL void Vec4Add(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    _mm_storeu_ps(Out, _mm_add_ps(_mm_loadu_ps(L), _mm_loadu_ps(R)));
+#elif defined(BGE_SIMD_NEON)
+    vst1q_f32(Out, vaddq_f32(vld1q_f32(L), vld1q_f32(R)));
+#else
+    Vec4AddRef(L, R, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Vec4Sub(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    _mm_storeu_ps(Out, _mm_sub_ps(_mm_loadu_ps(L), _mm_loadu_ps(R)));
+#elif defined(BGE_SIMD_NEON)
+    vst1q_f32(Out, vsubq_f32(vld1q_f32(L), vld1q_f32(R)));
+#else
+    Vec4SubRef(L, R, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Vec4AddXYZ(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 Right = _mm_and_ps(_mm_loadu_ps(R), SSEMaskXYZ());
+    _mm_storeu_ps(Out, _mm_add_ps(_mm_loadu_ps(L), Right));
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t Sum = vaddq_f32(vld1q_f32(L), vld1q_f32(R));
+    vst1q_f32(Out, vsetq_lane_f32(L[3], Sum, 3));
+#else
+    Vec4AddXYZRef(L, R, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Vec4SubXYZ(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 Right = _mm_and_ps(_mm_loadu_ps(R), SSEMaskXYZ());
+    _mm_storeu_ps(Out, _mm_sub_ps(_mm_loadu_ps(L), Right));
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t Diff = vsubq_f32(vld1q_f32(L), vld1q_f32(R));
+    vst1q_f32(Out, vsetq_lane_f32(L[3], Diff, 3));
+#else
+    Vec4SubXYZRef(L, R, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Vec4ScaleXYZ(const Scalar* L, Scalar S, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    _mm_storeu_ps(Out, _mm_mul_ps(_mm_loadu_ps(L), _mm_set_ps(1, S, S, S)));
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t Scaled = vmulq_n_f32(vld1q_f32(L), S);
+    vst1q_f32(Out, vsetq_lane_f32(L[3], Scaled, 3));
+#else
+    Vec4ScaleXYZRef(L, S, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL Scalar Vec4Dot3(const Scalar* L, const Scalar* R)
+{
+#if defined(BGE_SIMD_SSE)
+    /* Summed as (X + Y) + Z, the same order as the reference kernel */
+    __m128 Prod = _mm_mul_ps(_mm_loadu_ps(L), _mm_loadu_ps(R));
+    __m128 Sum = _mm_add_ss(Prod, _mm_shuffle_ps(Prod, Prod,
+                                            _MM_SHUFFLE(1, 1, 1, 1)));
+    Sum = _mm_add_ss(Sum, _mm_movehl_ps(Prod, Prod));
+    return _mm_cvtss_f32(Sum);
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t Prod = vmulq_f32(vld1q_f32(L), vld1q_f32(R));
+    return (vgetq_lane_f32(Prod, 0) + vgetq_lane_f32(Prod, 1))
+                                    + vgetq_lane_f32(Prod, 2);
+#else
+    return Vec4Dot3Ref(L, R);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Vec4Cross3(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    _mm_storeu_ps(Out, SSECross3(_mm_loadu_ps(L), _mm_loadu_ps(R)));
+#else
+    /* NEON has no cheap 3-lane rotate; the scalar version is as fast */
+    Vec4Cross3Ref(L, R, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Vec4NormalizeXYZ(const Scalar* L, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    /* Divide rather than multiply by reciprocal to match the reference */
+    Scalar Len = sqrtf(Vec4Dot3(L, L));
+    _mm_storeu_ps(Out, _mm_div_ps(_mm_loadu_ps(L),
+                                  _mm_set_ps(1, Len, Len, Len)));
+#else
+    Vec4NormalizeXYZRef(L, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+BGE_INL void Mat4Multiply(const Scalar* A, const Scalar* B, Scalar* Out)
+{
+#if defined(BGE_SIMD_AVX)
+    /* Both 128-bit lanes hold the same column of A */
+    __m256 A0 = _mm256_broadcast_ps((const __m128*)&A[0]);
+    __m256 A1 = _mm256_broadcast_ps((const __m128*)&A[4]);
+    __m256 A2 = _mm256_broadcast_ps((const __m128*)&A[8]);
+    __m256 A3 = _mm256_broadcast_ps((const __m128*)&A[12]);
+
+    /* Two columns of the result per iteration */
+    for(int Col = 0; Col < 16; Col += 8) {
+        __m256 BCols = _mm256_loadu_ps(&B[Col]);
+        __m256 Res = _mm256_mul_ps(A0, _mm256_shuffle_ps(BCols, BCols, 0x00));
+        Res = _mm256_add_ps(Res, _mm256_mul_ps(A1,
+                            _mm256_shuffle_ps(BCols, BCols, 0x55)));
+        Res = _mm256_add_ps(Res, _mm256_mul_ps(A2,
+                            _mm256_shuffle_ps(BCols, BCols, 0xAA)));
+        Res = _mm256_add_ps(Res, _mm256_mul_ps(A3,
+                            _mm256_shuffle_ps(BCols, BCols, 0xFF)));
+        _mm256_storeu_ps(&Out[Col], Res);
+    }
+#elif defined(BGE_SIMD_SSE)
+    __m128 A0 = _mm_loadu_ps(&A[0]);
+    __m128 A1 = _mm_loadu_ps(&A[4]);
+    __m128 A2 = _mm_loadu_ps(&A[8]);
+    __m128 A3 = _mm_loadu_ps(&A[12]);
+
+    for(int Col = 0; Col < 16; Col += 4) {
+        __m128 Res = _mm_mul_ps(A0, _mm_set1_ps(B[Col]));
+        Res = _mm_add_ps(Res, _mm_mul_ps(A1, _mm_set1_ps(B[Col + 1])));
+        Res = _mm_add_ps(Res, _mm_mul_ps(A2, _mm_set1_ps(B[Col + 2])));
+        Res = _mm_add_ps(Res, _mm_mul_ps(A3, _mm_set1_ps(B[Col + 3])));
+        _mm_storeu_ps(&Out[Col], Res);
+    }
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t A0 = vld1q_f32(&A[0]);
+    float32x4_t A1 = vld1q_f32(&A[4]);
+    float32x4_t A2 = vld1q_f32(&A[8]);
+    float32x4_t A3 = vld1q_f32(&A[12]);
+
+    for(int Col = 0; Col < 16; Col += 4) {
+        float32x4_t BCol = vld1q_f32(&B[Col]);
+        float32x4_t Res = vmulq_n_f32(A0, vgetq_lane_f32(BCol, 0));
+        Res = vaddq_f32(Res, vmulq_n_f32(A1, vgetq_lane_f32(BCol, 1)));
+        Res = vaddq_f32(Res, vmulq_n_f32(A2, vgetq_lane_f32(BCol, 2)));
+        Res = vaddq_f32(Res, vmulq_n_f32(A3, vgetq_lane_f32(BCol, 3)));
+        vst1q_f32(&Out[Col], Res);
+    }
+#else
+    Mat4MultiplyRef(A, B, Out);
+#endif /* BGE_SIMD_AVX */
+}
+
+
+BGE_INL void Mat4Transpose(const Scalar* M, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 C0 = _mm_loadu_ps(&M[0]);
+    __m128 C1 = _mm_loadu_ps(&M[4]);
+    __m128 C2 = _mm_loadu_ps(&M[8]);
+    __m128 C3 = _mm_loadu_ps(&M[12]);
+
+    _MM_TRANSPOSE4_PS(C0, C1, C2, C3);
+
+    _mm_storeu_ps(&Out[0], C0);
+    _mm_storeu_ps(&Out[4], C1);
+    _mm_storeu_ps(&Out[8], C2);
+    _mm_storeu_ps(&Out[12], C3);
+#elif defined(BGE_SIMD_NEON)
+    float32x4x4_t Cols = vld4q_f32(M);
+    vst1q_f32(&Out[0], Cols.val[0]);
+    vst1q_f32(&Out[4], Cols.val[1]);
+    vst1q_f32(&Out[8], Cols.val[2]);
+    vst1q_f32(&Out[12], Cols.val[3]);
+#else
+    Mat4TransposeRef(M, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* *
+ * Same contract as Mat4InverseRef. The SSE version inverts block-wise on
+ * 2x2 sub-matrices, so results differ from the reference in the last bits.
+ * */
+BGE_INL Scalar Mat4Inverse(const Scalar* M, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    /* Works on rows or columns alike, since Inv(Transpose(M)) is
+     * Transpose(Inv(M)). Written here in terms of rows */
+    __m128 R0 = _mm_loadu_ps(&M[0]);
+    __m128 R1 = _mm_loadu_ps(&M[4]);
+    __m128 R2 = _mm_loadu_ps(&M[8]);
+    __m128 R3 = _mm_loadu_ps(&M[12]);
+
+    /* 2x2 blocks: | A B |
+     *             | C D | */
+    __m128 A = _mm_movelh_ps(R0, R1);
+    __m128 B = _mm_movehl_ps(R1, R0);
+    __m128 C = _mm_movelh_ps(R2, R3);
+    __m128 D = _mm_movehl_ps(R3, R2);
+
+    /* Determinants of the blocks as (|A|, |B|, |C|, |D|) */
+    __m128 DetSub = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(R0, R2, _MM_SHUFFLE(2, 0, 2, 0)),
+                   _mm_shuffle_ps(R1, R3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(R0, R2, _MM_SHUFFLE(3, 1, 3, 1)),
+                   _mm_shuffle_ps(R1, R3, _MM_SHUFFLE(2, 0, 2, 0))));
+    __m128 DetA = BGE_SSE_SWIZZLE(DetSub, 0, 0, 0, 0);
+    __m128 DetB = BGE_SSE_SWIZZLE(DetSub, 1, 1, 1, 1);
+    __m128 DetC = BGE_SSE_SWIZZLE(DetSub, 2, 2, 2, 2);
+    __m128 DetD = BGE_SSE_SWIZZLE(DetSub, 3, 3, 3, 3);
+
+    __m128 DC = SSEMat2AdjMul(D, C);
+    __m128 AB = SSEMat2AdjMul(A, B);
+
+    /* Adjugates of the inverse's blocks X, Y, Z and W */
+    __m128 X = _mm_sub_ps(_mm_mul_ps(DetD, A), SSEMat2Mul(B, DC));
+    __m128 W = _mm_sub_ps(_mm_mul_ps(DetA, D), SSEMat2Mul(C, AB));
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(DetB, C), SSEMat2MulAdj(D, AB));
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(DetC, B), SSEMat2MulAdj(A, DC));
+
+    /* |M| = |A||D| + |B||C| - tr(Adj(A)B Adj(D)C) */
+    __m128 Trace = _mm_mul_ps(AB, BGE_SSE_SWIZZLE(DC, 0, 2, 1, 3));
+    Trace = _mm_add_ps(Trace, BGE_SSE_SWIZZLE(Trace, 2, 3, 0, 1));
+    Trace = _mm_add_ps(Trace, BGE_SSE_SWIZZLE(Trace, 1, 0, 3, 2));
+    __m128 DetM = _mm_add_ps(_mm_mul_ps(DetA, DetD), _mm_mul_ps(DetB, DetC));
+    DetM = _mm_sub_ps(DetM, Trace);
+
+    Scalar Det = _mm_cvtss_f32(DetM);
+    if(Det == 0)
+        return 0;
+
+    __m128 InvDet = _mm_div_ps(_mm_setr_ps(1, -1, -1, 1), DetM);
+    X = _mm_mul_ps(X, InvDet);
+    Y = _mm_mul_ps(Y, InvDet);
+    Z = _mm_mul_ps(Z, InvDet);
+    W = _mm_mul_ps(W, InvDet);
+
+    /* Undo the adjugate while storing */
+    _mm_storeu_ps(&Out[0], _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(&Out[4], _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(&Out[8], _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(&Out[12], _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+
+    return Det;
+#else
+    return Mat4InverseRef(M, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* Same contract as Mat4InverseAffineRef */
+BGE_INL Scalar Mat4InverseAffine(const Scalar* M, Scalar* Out)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 C0 = _mm_loadu_ps(&M[0]);
+    __m128 C1 = _mm_loadu_ps(&M[4]);
+    __m128 C2 = _mm_loadu_ps(&M[8]);
+    __m128 T = _mm_loadu_ps(&M[12]);
+
+    __m128 R0 = SSECross3(C1, C2);
+    __m128 R1 = SSECross3(C2, C0);
+    __m128 R2 = SSECross3(C0, C1);
+    __m128 R3 = _mm_setzero_ps();
+
+    Scalar Det = Vec4Dot3(&M[0], (const Scalar*)&R0);
+    if(Det == 0)
+        return 0;
+
+    __m128 InvDet = _mm_set1_ps(1 / Det);
+    R0 = _mm_mul_ps(R0, InvDet);
+    R1 = _mm_mul_ps(R1, InvDet);
+    R2 = _mm_mul_ps(R2, InvDet);
+
+    /* Rows of the inverted 3x3 become its columns */
+    _MM_TRANSPOSE4_PS(R0, R1, R2, R3);
+
+    __m128 Move = _mm_mul_ps(R0, BGE_SSE_SWIZZLE(T, 0, 0, 0, 0));
+    Move = _mm_add_ps(Move, _mm_mul_ps(R1, BGE_SSE_SWIZZLE(T, 1, 1, 1, 1)));
+    Move = _mm_add_ps(Move, _mm_mul_ps(R2, BGE_SSE_SWIZZLE(T, 2, 2, 2, 2)));
+
+    _mm_storeu_ps(&Out[0], R0);
+    _mm_storeu_ps(&Out[4], R1);
+    _mm_storeu_ps(&Out[8], R2);
+    /* W of the translation column comes out as 1 - 0 */
+    _mm_storeu_ps(&Out[12], _mm_sub_ps(_mm_setr_ps(0, 0, 0, 1), Move));
+
+    return Det;
+#else
+    return Mat4InverseAffineRef(M, Out);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* Same contract as Mat4TransformVec4sRef, and bit-identical results */
+BGE_INL void Mat4TransformVec4s(const Scalar* M, const Scalar* In,
+                                        Scalar* Out, size_t Num)
+{
+#if defined(BGE_SIMD_SSE)
+    size_t i;
+    __m128 Cols[4];
+
+    Cols[0] = _mm_loadu_ps(&M[0]);
+    Cols[1] = _mm_loadu_ps(&M[4]);
+    Cols[2] = _mm_loadu_ps(&M[8]);
+    Cols[3] = _mm_loadu_ps(&M[12]);
+
+#ifdef BGE_SIMD_AVX
+    __m256 WideCols[4];
+
+    WideCols[0] = _mm256_broadcast_ps((const __m128*)&M[0]);
+    WideCols[1] = _mm256_broadcast_ps((const __m128*)&M[4]);
+    WideCols[2] = _mm256_broadcast_ps((const __m128*)&M[8]);
+    WideCols[3] = _mm256_broadcast_ps((const __m128*)&M[12]);
+#endif /* BGE_SIMD_AVX */
+
+    if(Out > In && Out < In + Num * 4) {
+        i = Num;
+#ifdef BGE_SIMD_AVX
+        for(; i >= 2; i -= 2)
+            AVXTransformPair(WideCols, &In[(i - 2) * 4], &Out[(i - 2) * 4]);
+#endif /* BGE_SIMD_AVX */
+        for(; i > 0; --i)
+            _mm_storeu_ps(&Out[(i - 1) * 4], SSETransform(Cols,
+                                    _mm_loadu_ps(&In[(i - 1) * 4])));
+    } else {
+        i = 0;
+#ifdef BGE_SIMD_AVX
+        for(; i + 2 <= Num; i += 2)
+            AVXTransformPair(WideCols, &In[i * 4], &Out[i * 4]);
+#endif /* BGE_SIMD_AVX */
+        for(; i < Num; ++i)
+            _mm_storeu_ps(&Out[i * 4], SSETransform(Cols,
+                                            _mm_loadu_ps(&In[i * 4])));
+    }
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t Cols[4];
+
+    Cols[0] = vld1q_f32(&M[0]);
+    Cols[1] = vld1q_f32(&M[4]);
+    Cols[2] = vld1q_f32(&M[8]);
+    Cols[3] = vld1q_f32(&M[12]);
+
+    if(Out > In && Out < In + Num * 4) {
+        for(size_t i = Num; i > 0; --i)
+            vst1q_f32(&Out[(i - 1) * 4], NEONTransform(Cols,
+                                                &In[(i - 1) * 4]));
+    } else {
+        for(size_t i = 0; i < Num; ++i)
+            vst1q_f32(&Out[i * 4], NEONTransform(Cols, &In[i * 4]));
+    }
+#else
+    Mat4TransformVec4sRef(M, In, Out, Num);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* *
+ * Rotate a vector by a unit quaternion Q, stored X, Y, Z, W with W the
+ * real part. Uses v' = v + w * t + q x t with t = 2 * (q x v), which is
+ * cheaper than building the rotation matrix. In's W is copied to Out.
+ * */
+BGE_INL void QuatRotateVec4Ref(const Scalar* Q, const Scalar* In,
+                                                    Scalar* Out)
+{
+    Scalar TX, TY, TZ, X, Y, Z;
+
+    TX = (Q[1] * In[2] - Q[2] * In[1]) * 2;
+    TY = (Q[2] * In[0] - Q[0] * In[2]) * 2;
+    TZ = (Q[0] * In[1] - Q[1] * In[0]) * 2;
+
+    X = In[0] + Q[3] * TX + (Q[1] * TZ - Q[2] * TY);
+    Y = In[1] + Q[3] * TY + (Q[2] * TX - Q[0] * TZ);
+    Z = In[2] + Q[3] * TZ + (Q[0] * TY - Q[1] * TX);
+
+    Out[0] = X;
+    Out[1] = Y;
+    Out[2] = Z;
+    Out[3] = In[3];
+}
+
+
+/* Same overlap rules as Mat4TransformVec4sRef */
+BGE_INL void QuatRotateVec4sRef(const Scalar* Q, const Scalar* In,
+                                            Scalar* Out, size_t Num)
+{
+    if(Out > In && Out < In + Num * 4) {
+        for(size_t i = Num; i > 0; --i)
+            QuatRotateVec4Ref(Q, &In[(i - 1) * 4], &Out[(i - 1) * 4]);
+    } else {
+        for(size_t i = 0; i < Num; ++i)
+            QuatRotateVec4Ref(Q, &In[i * 4], &Out[i * 4]);
+    }
+}
+
+#ifdef BGE_SIMD_SSE
+
+/* *
+ * Rotate 4 vectors at once. The block is transposed so each register
+ * holds one component of all 4 vectors, and Q holds each quaternion
+ * component broadcast to every lane. Operation order matches
+ * QuatRotateVec4Ref lane for lane.
+ * */
+BGE_INL void SSEQuatRotate4(const __m128* Q, const Scalar* In, Scalar* Out)
+{
+    __m128 X = _mm_loadu_ps(&In[0]);
+    __m128 Y = _mm_loadu_ps(&In[4]);
+    __m128 Z = _mm_loadu_ps(&In[8]);
+    __m128 W = _mm_loadu_ps(&In[12]);
+    __m128 Two = _mm_set1_ps(2);
+    __m128 TX, TY, TZ;
+
+    _MM_TRANSPOSE4_PS(X, Y, Z, W);
+
+    TX = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(Q[1], Z), _mm_mul_ps(Q[2], Y)), Two);
+    TY = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(Q[2], X), _mm_mul_ps(Q[0], Z)), Two);
+    TZ = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(Q[0], Y), _mm_mul_ps(Q[1], X)), Two);
+
+    X = _mm_add_ps(_mm_add_ps(X, _mm_mul_ps(Q[3], TX)),
+            _mm_sub_ps(_mm_mul_ps(Q[1], TZ), _mm_mul_ps(Q[2], TY)));
+    Y = _mm_add_ps(_mm_add_ps(Y, _mm_mul_ps(Q[3], TY)),
+            _mm_sub_ps(_mm_mul_ps(Q[2], TX), _mm_mul_ps(Q[0], TZ)));
+    Z = _mm_add_ps(_mm_add_ps(Z, _mm_mul_ps(Q[3], TZ)),
+            _mm_sub_ps(_mm_mul_ps(Q[0], TY), _mm_mul_ps(Q[1], TX)));
+
+    _MM_TRANSPOSE4_PS(X, Y, Z, W);
+
+    _mm_storeu_ps(&Out[0], X);
+    _mm_storeu_ps(&Out[4], Y);
+    _mm_storeu_ps(&Out[8], Z);
+    _mm_storeu_ps(&Out[12], W);
+}
+
+#endif /* BGE_SIMD_SSE */
+
+#ifdef BGE_SIMD_NEON
+
+/* NEON version of SSEQuatRotate4. vld4q/vst4q do the transposes */
+BGE_INL void NEONQuatRotate4(const float32x4_t* Q, const Scalar* In,
+                                                        Scalar* Out)
+{
+    float32x4x4_t V = vld4q_f32(In);
+    float32x4_t Two = vdupq_n_f32(2);
+    float32x4_t TX, TY, TZ;
+
+    TX = vmulq_f32(vsubq_f32(vmulq_f32(Q[1], V.val[2]),
+                            vmulq_f32(Q[2], V.val[1])), Two);
+    TY = vmulq_f32(vsubq_f32(vmulq_f32(Q[2], V.val[0]),
+                            vmulq_f32(Q[0], V.val[2])), Two);
+    TZ = vmulq_f32(vsubq_f32(vmulq_f32(Q[0], V.val[1]),
+                            vmulq_f32(Q[1], V.val[0])), Two);
+
+    V.val[0] = vaddq_f32(vaddq_f32(V.val[0], vmulq_f32(Q[3], TX)),
+                vsubq_f32(vmulq_f32(Q[1], TZ), vmulq_f32(Q[2], TY)));
+    V.val[1] = vaddq_f32(vaddq_f32(V.val[1], vmulq_f32(Q[3], TY)),
+                vsubq_f32(vmulq_f32(Q[2], TX), vmulq_f32(Q[0], TZ)));
+    V.val[2] = vaddq_f32(vaddq_f32(V.val[2], vmulq_f32(Q[3], TZ)),
+                vsubq_f32(vmulq_f32(Q[0], TY), vmulq_f32(Q[1], TX)));
+
+    vst4q_f32(Out, V);
+}
+
+#endif /* BGE_SIMD_NEON */
+
+
+/* Same contract as QuatRotateVec4sRef, and bit-identical results */
+BGE_INL void QuatRotateVec4s(const Scalar* Q, const Scalar* In,
+                                        Scalar* Out, size_t Num)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 Lanes[4];
+    size_t i;
+
+    for(int c = 0; c < 4; ++c)
+        Lanes[c] = _mm_set1_ps(Q[c]);
+
+    /* Blocks of 4 are read whole before being written */
+    if(Out > In && Out < In + Num * 4) {
+        for(i = Num; i >= 4; i -= 4)
+            SSEQuatRotate4(Lanes, &In[(i - 4) * 4], &Out[(i - 4) * 4]);
+        QuatRotateVec4sRef(Q, In, Out, i);
+    } else {
+        for(i = 0; i + 4 <= Num; i += 4)
+            SSEQuatRotate4(Lanes, &In[i * 4], &Out[i * 4]);
+        QuatRotateVec4sRef(Q, &In[i * 4], &Out[i * 4], Num - i);
+    }
+#elif defined(BGE_SIMD_NEON)
+    float32x4_t Lanes[4];
+    size_t i;
+
+    for(int c = 0; c < 4; ++c)
+        Lanes[c] = vdupq_n_f32(Q[c]);
+
+    if(Out > In && Out < In + Num * 4) {
+        for(i = Num; i >= 4; i -= 4)
+            NEONQuatRotate4(Lanes, &In[(i - 4) * 4], &Out[(i - 4) * 4]);
+        QuatRotateVec4sRef(Q, In, Out, i);
+    } else {
+        for(i = 0; i + 4 <= Num; i += 4)
+            NEONQuatRotate4(Lanes, &In[i * 4], &Out[i * 4]);
+        QuatRotateVec4sRef(Q, &In[i * 4], &Out[i * 4], Num - i);
+    }
+#else
+    QuatRotateVec4sRef(Q, In, Out, Num);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* *
+ * Rotate each of Num vectors by its own unit quaternion. Q holds Num
+ * quaternions, 4 Scalars each in X, Y, Z, W order. Same overlap rules
+ * as QuatRotateVec4sRef between In and Out.
+ * */
+BGE_INL void QuatRotateEachVec4sRef(const Scalar* Q, const Scalar* In,
+                                            Scalar* Out, size_t Num)
+{
+    if(Out > In && Out < In + Num * 4) {
+        for(size_t i = Num; i > 0; --i)
+            QuatRotateVec4Ref(&Q[(i - 1) * 4], &In[(i - 1) * 4],
+                                                &Out[(i - 1) * 4]);
+    } else {
+        for(size_t i = 0; i < Num; ++i)
+            QuatRotateVec4Ref(&Q[i * 4], &In[i * 4], &Out[i * 4]);
+    }
+}
+
+
+/* Same contract as QuatRotateEachVec4sRef, and bit-identical results */
+BGE_INL void QuatRotateEachVec4s(const Scalar* Q, const Scalar* In,
+                                            Scalar* Out, size_t Num)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 Lanes[4];
+    size_t i;
+
+    if(Out > In && Out < In + Num * 4) {
+        for(i = Num; i >= 4; i -= 4) {
+            Lanes[0] = _mm_loadu_ps(&Q[(i - 4) * 4]);
+            Lanes[1] = _mm_loadu_ps(&Q[(i - 3) * 4]);
+            Lanes[2] = _mm_loadu_ps(&Q[(i - 2) * 4]);
+            Lanes[3] = _mm_loadu_ps(&Q[(i - 1) * 4]);
+            _MM_TRANSPOSE4_PS(Lanes[0], Lanes[1], Lanes[2], Lanes[3]);
+            SSEQuatRotate4(Lanes, &In[(i - 4) * 4], &Out[(i - 4) * 4]);
+        }
+        QuatRotateEachVec4sRef(Q, In, Out, i);
+    } else {
+        for(i = 0; i + 4 <= Num; i += 4) {
+            Lanes[0] = _mm_loadu_ps(&Q[i * 4]);
+            Lanes[1] = _mm_loadu_ps(&Q[i * 4 + 4]);
+            Lanes[2] = _mm_loadu_ps(&Q[i * 4 + 8]);
+            Lanes[3] = _mm_loadu_ps(&Q[i * 4 + 12]);
+            _MM_TRANSPOSE4_PS(Lanes[0], Lanes[1], Lanes[2], Lanes[3]);
+            SSEQuatRotate4(Lanes, &In[i * 4], &Out[i * 4]);
+        }
+        QuatRotateEachVec4sRef(&Q[i * 4], &In[i * 4], &Out[i * 4], Num - i);
+    }
+#elif defined(BGE_SIMD_NEON)
+    float32x4x4_t Lanes;
+    size_t i;
+
+    if(Out > In && Out < In + Num * 4) {
+        for(i = Num; i >= 4; i -= 4) {
+            Lanes = vld4q_f32(&Q[(i - 4) * 4]);
+            NEONQuatRotate4(Lanes.val, &In[(i - 4) * 4], &Out[(i - 4) * 4]);
+        }
+        QuatRotateEachVec4sRef(Q, In, Out, i);
+    } else {
+        for(i = 0; i + 4 <= Num; i += 4) {
+            Lanes = vld4q_f32(&Q[i * 4]);
+            NEONQuatRotate4(Lanes.val, &In[i * 4], &Out[i * 4]);
+        }
+        QuatRotateEachVec4sRef(&Q[i * 4], &In[i * 4], &Out[i * 4], Num - i);
+    }
+#else
+    QuatRotateEachVec4sRef(Q, In, Out, Num);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* Hamilton product of quaternions stored X, Y, Z, W. Out may alias */
+BGE_INL void QuatMultiplyRef(const Scalar* L, const Scalar* R, Scalar* Out)
+{
+    Scalar X, Y, Z, W;
+
+    X = L[3] * R[0] + L[0] * R[3] + L[1] * R[2] - L[2] * R[1];
+    Y = L[3] * R[1] + L[1] * R[3] + L[2] * R[0] - L[0] * R[2];
+    Z = L[3] * R[2] + L[2] * R[3] + L[0] * R[1] - L[1] * R[0];
+    W = L[3] * R[3] - L[0] * R[0] - L[1] * R[1] - L[2] * R[2];
+
+    Out[0] = X;
+    Out[1] = Y;
+    Out[2] = Z;
+    Out[3] = W;
+}
+
+
+/* 4D dot product, summed pairwise so SIMD versions can match it exactly */
+BGE_INL Scalar Vec4Dot4Ref(const Scalar* L, const Scalar* R)
+{
+    return (L[0] * R[0] + L[1] * R[1]) + (L[2] * R[2] + L[3] * R[3]);
+}
+
+
+/* *
+ * Blend Num pairs of Transform records (12 Scalars each: rotation
+ * quaternion X, Y, Z, W, then translation and scale as Vector4s) by T.
+ * The rotation is nlerp'd along the shorter arc; translation and scale
+ * are lerp'd. Out may alias A or B.
+ * */
+BGE_INL void TransformBlendsRef(const Scalar* A, const Scalar* B, Scalar T,
+                                                Scalar* Out, size_t Num)
+{
+    Scalar WA = 1 - T;
+
+    for(size_t i = 0; i < Num; ++i, A += 12, B += 12, Out += 12) {
+        Scalar WB = Vec4Dot4Ref(A, B) < 0 ? -T : T;
+        Scalar Q[4], Inv;
+
+        for(int c = 0; c < 4; ++c)
+            Q[c] = A[c] * WA + B[c] * WB;
+
+        Inv = 1 / sqrtf(Vec4Dot4Ref(Q, Q));
+
+        for(int c = 0; c < 4; ++c)
+            Out[c] = Q[c] * Inv;
+
+        for(int c = 4; c < 12; ++c)
+            Out[c] = A[c] * WA + B[c] * T;
+    }
+}
+
+
+/* *
+ * Blend Num pairs of dual quaternions (8 Scalars each: real then dual
+ * part, both X, Y, Z, W) by T with dual quaternion linear blending: a
+ * weighted sum along the shorter arc, normalized by the real part's
+ * length. Out may alias A or B.
+ * */
+BGE_INL void DualQuatBlendsRef(const Scalar* A, const Scalar* B, Scalar T,
+                                                Scalar* Out, size_t Num)
+{
+    Scalar WA = 1 - T;
+
+    for(size_t i = 0; i < Num; ++i, A += 8, B += 8, Out += 8) {
+        Scalar WB = Vec4Dot4Ref(A, B) < 0 ? -T : T;
+        Scalar Q[8], Inv;
+
+        for(int c = 0; c < 8; ++c)
+            Q[c] = A[c] * WA + B[c] * WB;
+
+        Inv = 1 / sqrtf(Vec4Dot4Ref(Q, Q));
+
+        for(int c = 0; c < 8; ++c)
+            Out[c] = Q[c] * Inv;
+    }
+}
+
+#ifdef BGE_SIMD_SSE
+
+/* *
+ * Sum each of 4 vectors across its lanes: lane j of the result is
+ * (P[j].x + P[j].y) + (P[j].z + P[j].w), the Vec4Dot4Ref order
+ * */
+BGE_INL __m128 SSESum4x4(__m128 P0, __m128 P1, __m128 P2, __m128 P3)
+{
+    _MM_TRANSPOSE4_PS(P0, P1, P2, P3);
+
+    return _mm_add_ps(_mm_add_ps(P0, P1), _mm_add_ps(P2, P3));
+}
+
+
+/* *
+ * Per-record weights for blending 4 quaternions A[j] towards B[j]: lane j
+ * is -T if A[j] and B[j] are on opposite hemispheres, T otherwise
+ * */
+BGE_INL __m128 SSEShortArcWeights(const __m128* A, const __m128* B, Scalar T)
+{
+    __m128 Negative = _mm_cmplt_ps(SSESum4x4(_mm_mul_ps(A[0], B[0]),
+                                    _mm_mul_ps(A[1], B[1]),
+                                    _mm_mul_ps(A[2], B[2]),
+                                    _mm_mul_ps(A[3], B[3])), _mm_setzero_ps());
+
+    return _mm_or_ps(_mm_and_ps(Negative, _mm_set1_ps(-T)),
+                        _mm_andnot_ps(Negative, _mm_set1_ps(T)));
+}
+
+#endif /* BGE_SIMD_SSE */
+
+
+/* *
+ * Same contract as TransformBlendsRef, and bit-identical results. Works
+ * on 4 records at a time so the hemisphere checks are branchless and one
+ * square root and one division cover 4 rotations.
+ * */
+BGE_INL void TransformBlends(const Scalar* A, const Scalar* B, Scalar T,
+                                                Scalar* Out, size_t Num)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 WA = _mm_set1_ps(1 - T);
+    __m128 WT = _mm_set1_ps(T);
+    size_t i = 0;
+
+    for(; i + 4 <= Num; i += 4, A += 48, B += 48, Out += 48) {
+        __m128 RotA[4], RotB[4], Q[4], WB, Inv;
+
+        for(int j = 0; j < 4; ++j) {
+            RotA[j] = _mm_loadu_ps(&A[j * 12]);
+            RotB[j] = _mm_loadu_ps(&B[j * 12]);
+        }
+
+        WB = SSEShortArcWeights(RotA, RotB, T);
+
+        Q[0] = _mm_add_ps(_mm_mul_ps(RotA[0], WA),
+                    _mm_mul_ps(RotB[0], BGE_SSE_SWIZZLE(WB, 0, 0, 0, 0)));
+        Q[1] = _mm_add_ps(_mm_mul_ps(RotA[1], WA),
+                    _mm_mul_ps(RotB[1], BGE_SSE_SWIZZLE(WB, 1, 1, 1, 1)));
+        Q[2] = _mm_add_ps(_mm_mul_ps(RotA[2], WA),
+                    _mm_mul_ps(RotB[2], BGE_SSE_SWIZZLE(WB, 2, 2, 2, 2)));
+        Q[3] = _mm_add_ps(_mm_mul_ps(RotA[3], WA),
+                    _mm_mul_ps(RotB[3], BGE_SSE_SWIZZLE(WB, 3, 3, 3, 3)));
+
+        Inv = _mm_div_ps(_mm_set1_ps(1), _mm_sqrt_ps(SSESum4x4(
+                                    _mm_mul_ps(Q[0], Q[0]),
+                                    _mm_mul_ps(Q[1], Q[1]),
+                                    _mm_mul_ps(Q[2], Q[2]),
+                                    _mm_mul_ps(Q[3], Q[3]))));
+
+        _mm_storeu_ps(&Out[0], _mm_mul_ps(Q[0],
+                                BGE_SSE_SWIZZLE(Inv, 0, 0, 0, 0)));
+        _mm_storeu_ps(&Out[12], _mm_mul_ps(Q[1],
+                                BGE_SSE_SWIZZLE(Inv, 1, 1, 1, 1)));
+        _mm_storeu_ps(&Out[24], _mm_mul_ps(Q[2],
+                                BGE_SSE_SWIZZLE(Inv, 2, 2, 2, 2)));
+        _mm_storeu_ps(&Out[36], _mm_mul_ps(Q[3],
+                                BGE_SSE_SWIZZLE(Inv, 3, 3, 3, 3)));
+
+        /* Translation and scale */
+        for(int j = 0; j < 4; ++j) {
+            const Scalar* LA = &A[j * 12 + 4];
+            const Scalar* LB = &B[j * 12 + 4];
+
+            _mm_storeu_ps(&Out[j * 12 + 4], _mm_add_ps(
+                            _mm_mul_ps(_mm_loadu_ps(&LA[0]), WA),
+                            _mm_mul_ps(_mm_loadu_ps(&LB[0]), WT)));
+            _mm_storeu_ps(&Out[j * 12 + 8], _mm_add_ps(
+                            _mm_mul_ps(_mm_loadu_ps(&LA[4]), WA),
+                            _mm_mul_ps(_mm_loadu_ps(&LB[4]), WT)));
+        }
+    }
+
+    TransformBlendsRef(A, B, T, Out, Num - i);
+#else
+    TransformBlendsRef(A, B, T, Out, Num);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* Same contract as DualQuatBlendsRef, and bit-identical results */
+BGE_INL void DualQuatBlends(const Scalar* A, const Scalar* B, Scalar T,
+                                                Scalar* Out, size_t Num)
+{
+#if defined(BGE_SIMD_SSE)
+    __m128 WA = _mm_set1_ps(1 - T);
+    size_t i = 0;
+
+    for(; i + 4 <= Num; i += 4, A += 32, B += 32, Out += 32) {
+        __m128 RealA[4], RealB[4], Real[4], Dual[4];
+        Scalar Weights[4], Inverses[4];
+
+        for(int j = 0; j < 4; ++j) {
+            RealA[j] = _mm_loadu_ps(&A[j * 8]);
+            RealB[j] = _mm_loadu_ps(&B[j * 8]);
+        }
+
+        _mm_storeu_ps(Weights, SSEShortArcWeights(RealA, RealB, T));
+
+        for(int j = 0; j < 4; ++j) {
+            __m128 W = _mm_set1_ps(Weights[j]);
+
+            Real[j] = _mm_add_ps(_mm_mul_ps(RealA[j], WA),
+                                    _mm_mul_ps(RealB[j], W));
+            Dual[j] = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&A[j * 8 + 4]), WA),
+                                _mm_mul_ps(_mm_loadu_ps(&B[j * 8 + 4]), W));
+        }
+
+        _mm_storeu_ps(Inverses, _mm_div_ps(_mm_set1_ps(1),
+                        _mm_sqrt_ps(SSESum4x4(_mm_mul_ps(Real[0], Real[0]),
+                                              _mm_mul_ps(Real[1], Real[1]),
+                                              _mm_mul_ps(Real[2], Real[2]),
+                                              _mm_mul_ps(Real[3], Real[3])))));
+
+        for(int j = 0; j < 4; ++j) {
+            __m128 Inv = _mm_set1_ps(Inverses[j]);
+
+            _mm_storeu_ps(&Out[j * 8], _mm_mul_ps(Real[j], Inv));
+            _mm_storeu_ps(&Out[j * 8 + 4], _mm_mul_ps(Dual[j], Inv));
+        }
+    }
+
+    DualQuatBlendsRef(A, B, T, Out, Num - i);
+#else
+    DualQuatBlendsRef(A, B, T, Out, Num);
+#endif /* BGE_SIMD_SSE */
+}
+
+
+/* *
+ * Lane-wise helpers for bulk kernels over structure-of-arrays data. A
+ * ScalarLanes value holds BGE_LANE_WIDTH Scalars: 8 with AVX, 4 with
+ * SSE2 or AArch64 NEON and 1 otherwise, so a loop written with these
+ * helpers compiles on every target. LanesLoad and LanesStore require
+ * addresses aligned to BGE_LANE_WIDTH Scalars; the U versions don't.
+ * */
+#if defined(BGE_SIMD_AVX)
+
+#define BGE_LANE_WIDTH 8
+typedef __m256 ScalarLanes;
+
+BGE_INL ScalarLanes LanesLoad(const Scalar* P) { return _mm256_load_ps(P); }
+BGE_INL ScalarLanes LanesLoadU(const Scalar* P) { return _mm256_loadu_ps(P); }
+BGE_INL void LanesStore(Scalar* P, ScalarLanes V) { _mm256_store_ps(P, V); }
+BGE_INL void LanesStoreU(Scalar* P, ScalarLanes V) { _mm256_storeu_ps(P, V); }
+BGE_INL ScalarLanes LanesSet(Scalar S) { return _mm256_set1_ps(S); }
+
+BGE_INL ScalarLanes LanesAdd(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_add_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSub(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_sub_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesMul(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_mul_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesDiv(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_div_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSqrt(ScalarLanes A)
+{
+    return _mm256_sqrt_ps(A);
+}
+
+
+/* *
+ * Comparisons produce a LaneMask with every bit of a lane set where the
+ * comparison holds. LanesSelect picks IfTrue where Mask is set.
+ * */
+typedef __m256 LaneMask;
+
+BGE_INL ScalarLanes LanesMin(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_min_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesMax(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_max_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesAbs(ScalarLanes A)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), A);
+}
+
+
+/* Round towards 0. Lanes must be within int range */
+BGE_INL ScalarLanes LanesTrunc(ScalarLanes A)
+{
+    return _mm256_round_ps(A, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+
+
+BGE_INL LaneMask LanesLess(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_cmp_ps(A, B, _CMP_LT_OQ);
+}
+
+
+BGE_INL LaneMask LanesEqual(ScalarLanes A, ScalarLanes B)
+{
+    return _mm256_cmp_ps(A, B, _CMP_EQ_OQ);
+}
+
+
+BGE_INL LaneMask LanesOr(LaneMask A, LaneMask B)
+{
+    return _mm256_or_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSelect(LaneMask Mask, ScalarLanes IfTrue,
+                                                ScalarLanes IfFalse)
+{
+    return _mm256_blendv_ps(IfFalse, IfTrue, Mask);
+}
+
+#elif defined(BGE_SIMD_SSE)
+
+#define BGE_LANE_WIDTH 4
+typedef __m128 ScalarLanes;
+
+BGE_INL ScalarLanes LanesLoad(const Scalar* P) { return _mm_load_ps(P); }
+BGE_INL ScalarLanes LanesLoadU(const Scalar* P) { return _mm_loadu_ps(P); }
+BGE_INL void LanesStore(Scalar* P, ScalarLanes V) { _mm_store_ps(P, V); }
+BGE_INL void LanesStoreU(Scalar* P, ScalarLanes V) { _mm_storeu_ps(P, V); }
+BGE_INL ScalarLanes LanesSet(Scalar S) { return _mm_set1_ps(S); }
+
+BGE_INL ScalarLanes LanesAdd(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_add_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSub(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_sub_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesMul(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_mul_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesDiv(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_div_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSqrt(ScalarLanes A)
+{
+    return _mm_sqrt_ps(A);
+}
+
+
+/* *
+ * Comparisons produce a LaneMask with every bit of a lane set where the
+ * comparison holds. LanesSelect picks IfTrue where Mask is set.
+ * */
+typedef __m128 LaneMask;
+
+BGE_INL ScalarLanes LanesMin(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_min_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesMax(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_max_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesAbs(ScalarLanes A)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), A);
+}
+
+
+/* Round towards 0. Lanes must be within int range */
+BGE_INL ScalarLanes LanesTrunc(ScalarLanes A)
+{
+    return _mm_cvtepi32_ps(_mm_cvttps_epi32(A));
+}
+
+
+BGE_INL LaneMask LanesLess(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_cmplt_ps(A, B);
+}
+
+
+BGE_INL LaneMask LanesEqual(ScalarLanes A, ScalarLanes B)
+{
+    return _mm_cmpeq_ps(A, B);
+}
+
+
+BGE_INL LaneMask LanesOr(LaneMask A, LaneMask B)
+{
+    return _mm_or_ps(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSelect(LaneMask Mask, ScalarLanes IfTrue,
+                                                ScalarLanes IfFalse)
+{
+    return _mm_or_ps(_mm_and_ps(Mask, IfTrue), _mm_andnot_ps(Mask, IfFalse));
+}
+
+#elif defined(BGE_SIMD_NEON) && defined(__aarch64__)
+
+#define BGE_LANE_WIDTH 4
+typedef float32x4_t ScalarLanes;
+
+BGE_INL ScalarLanes LanesLoad(const Scalar* P) { return vld1q_f32(P); }
+BGE_INL ScalarLanes LanesLoadU(const Scalar* P) { return vld1q_f32(P); }
+BGE_INL void LanesStore(Scalar* P, ScalarLanes V) { vst1q_f32(P, V); }
+BGE_INL void LanesStoreU(Scalar* P, ScalarLanes V) { vst1q_f32(P, V); }
+BGE_INL ScalarLanes LanesSet(Scalar S) { return vdupq_n_f32(S); }
+
+BGE_INL ScalarLanes LanesAdd(ScalarLanes A, ScalarLanes B)
+{
+    return vaddq_f32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSub(ScalarLanes A, ScalarLanes B)
+{
+    return vsubq_f32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesMul(ScalarLanes A, ScalarLanes B)
+{
+    return vmulq_f32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesDiv(ScalarLanes A, ScalarLanes B)
+{
+    return vdivq_f32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSqrt(ScalarLanes A)
+{
+    return vsqrtq_f32(A);
+}
+
+
+/* *
+ * Comparisons produce a LaneMask with every bit of a lane set where the
+ * comparison holds. LanesSelect picks IfTrue where Mask is set.
+ * */
+typedef uint32x4_t LaneMask;
+
+BGE_INL ScalarLanes LanesMin(ScalarLanes A, ScalarLanes B)
+{
+    return vminq_f32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesMax(ScalarLanes A, ScalarLanes B)
+{
+    return vmaxq_f32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesAbs(ScalarLanes A)
+{
+    return vabsq_f32(A);
+}
+
+
+/* Round towards 0 */
+BGE_INL ScalarLanes LanesTrunc(ScalarLanes A)
+{
+    return vrndq_f32(A);
+}
+
+
+BGE_INL LaneMask LanesLess(ScalarLanes A, ScalarLanes B)
+{
+    return vcltq_f32(A, B);
+}
+
+
+BGE_INL LaneMask LanesEqual(ScalarLanes A, ScalarLanes B)
+{
+    return vceqq_f32(A, B);
+}
+
+
+BGE_INL LaneMask LanesOr(LaneMask A, LaneMask B)
+{
+    return vorrq_u32(A, B);
+}
+
+
+BGE_INL ScalarLanes LanesSelect(LaneMask Mask, ScalarLanes IfTrue,
+                                                ScalarLanes IfFalse)
+{
+    return vbslq_f32(Mask, IfTrue, IfFalse);
+}
+
+#else
+
+#define BGE_LANE_WIDTH 1
+typedef Scalar ScalarLanes;
+
+BGE_INL ScalarLanes LanesLoad(const Scalar* P) { return *P; }
+BGE_INL ScalarLanes LanesLoadU(const Scalar* P) { return *P; }
+BGE_INL void LanesStore(Scalar* P, ScalarLanes V) { *P = V; }
+BGE_INL void LanesStoreU(Scalar* P, ScalarLanes V) { *P = V; }
+BGE_INL ScalarLanes LanesSet(Scalar S) { return S; }
+
+BGE_INL ScalarLanes LanesAdd(ScalarLanes A, ScalarLanes B)
+{
+    return A + B;
+}
+
+
+BGE_INL ScalarLanes LanesSub(ScalarLanes A, ScalarLanes B)
+{
+    return A - B;
+}
+
+
+BGE_INL ScalarLanes LanesMul(ScalarLanes A, ScalarLanes B)
+{
+    return A * B;
+}
+
+
+BGE_INL ScalarLanes LanesDiv(ScalarLanes A, ScalarLanes B)
+{
+    return A / B;
+}
+
+
+BGE_INL ScalarLanes LanesSqrt(ScalarLanes A)
+{
+    return sqrtf(A);
+}
+
+
+/* *
+ * Comparisons produce a LaneMask that is true where the comparison
+ * holds. LanesSelect picks IfTrue where Mask is set.
+ * */
+typedef bool LaneMask;
+
+BGE_INL ScalarLanes LanesMin(ScalarLanes A, ScalarLanes B)
+{
+    return A < B ? A : B;
+}
+
+
+BGE_INL ScalarLanes LanesMax(ScalarLanes A, ScalarLanes B)
+{
+    return A > B ? A : B;
+}
+
+
+BGE_INL ScalarLanes LanesAbs(ScalarLanes A)
+{
+    return fabsf(A);
+}
+
+
+/* Round towards 0 */
+BGE_INL ScalarLanes LanesTrunc(ScalarLanes A)
+{
+    return (Scalar)(int)A;
+}
+
+
+BGE_INL LaneMask LanesLess(ScalarLanes A, ScalarLanes B)
+{
+    return A < B;
+}
+
+
+BGE_INL LaneMask LanesEqual(ScalarLanes A, ScalarLanes B)
+{
+    return A == B;
+}
+
+
+BGE_INL LaneMask LanesOr(LaneMask A, LaneMask B)
+{
+    return A || B;
+}
+
+
+BGE_INL ScalarLanes LanesSelect(LaneMask Mask, ScalarLanes IfTrue,
+                                                ScalarLanes IfFalse)
+{
+    return Mask ? IfTrue : IfFalse;
+}
+
+#endif /* BGE_SIMD_AVX */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_SIMD_H */
@@ -0,0 +1,104 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_TRANSFORM_H
+#define BAKGE_MATH_TRANSFORM_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Translation, rotation and scale (TRS) packed into 12 Scalars: the
+ * rotation quaternion as X, Y, Z, W, then translation and scale as
+ * Vector4s with W = 0. Applying a Transform scales first, then rotates,
+ * then translates.
+ *
+ * This is the compact form to store, pass around and blend poses in.
+ * Convert to a Matrix with ToMatrix when it's time to draw. Arrays of
+ * Transforms are tightly packed so BlendMany can stream through them.
+ *
+ * Composing or inverting transforms with non-uniform scale and rotation
+ * can produce shear, which TRS can't represent. Those results are
+ * approximations; with uniform scale they are exact.
+ * */
+class BGE_API Transform
+{
+    Vector4 Rotation;
+    Vector4 Translation;
+    Vector4 Scale;
+
+
+public:
+
+    /* Defaults to the identity transform */
+    constexpr Transform() : Rotation(0, 0, 0, 1), Translation(0, 0, 0, 0),
+                                                        Scale(1, 1, 1, 0)
+    {
+    }
+
+    Transform(Vector4 BGE_NCP Translation, Quaternion BGE_NCP Rotation,
+                                            Vector4 BGE_NCP Scale);
+
+    Vector4 GetTranslation() const;
+    Quaternion GetRotation() const;
+    Vector4 GetScale() const;
+
+    void SetTranslation(Vector4 BGE_NCP Translation);
+    void SetRotation(Quaternion BGE_NCP Rotation);
+    void SetScale(Vector4 BGE_NCP Scale);
+    void SetScale(Scalar Uniform);
+
+    Matrix ToMatrix() const;
+
+    /* Composition. The result applies Other first, then this transform */
+    Transform operator*(Transform BGE_NCP Other) const;
+    Transform BGE_NCP operator*=(Transform BGE_NCP Other);
+
+    /* Transform a point or vector. Translation is scaled by W */
+    Vector4 operator*(Vector4 BGE_NCP Vec) const;
+
+    Transform BGE_NCP Invert();
+    Transform Inverted() const;
+
+    /* *
+     * Interpolate from From (T = 0) to To (T = 1). Rotation is nlerp'd,
+     * translation and scale are lerp'd.
+     * */
+    static Transform Blend(Transform BGE_NCP From, Transform BGE_NCP To,
+                                                            Scalar T);
+
+    /* *
+     * Blend N pairs of transforms by the same T, e.g. crossfading two
+     * animation poses. Out can be From or To.
+     * */
+    static void BlendMany(const Transform* From, const Transform* To,
+                                Scalar T, Transform* Out, size_t N);
+
+}; /* Transform */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_TRANSFORM_H */
@@ -30,6 +30,10 @@
 namespace bakge
 {
 
+/* *
+ * 3-component vector. Like Vector4 it is a trivially copyable value type
+ * with constexpr constructors.
+ * */
 class BGE_API Vector3
 {
     Scalar Val[3];
@@ -37,15 +41,27 @@ class BGE_API Vector3
 
 public:
 
-    Vector3();
-    Vector3(Scalar X, Scalar Y, Scalar Z);
-    Vector3(Vector3 BGE_NCP Other);
-    ~Vector3();
+    constexpr Vector3() : Val{0, 0, 1}
+    {
+    }
+
+
+    constexpr Vector3(Scalar X, Scalar Y, Scalar Z) : Val{X, Y, Z}
+    {
+    }
+
+
+    BGE_INL Scalar& operator[](int BGE_NCP At)
+    {
+        return Val[At];
+    }
+
 
-    Scalar& operator[](int BGE_NCP At);
-    Scalar BGE_NCP operator[](int BGE_NCP At) const;
+    constexpr Scalar BGE_NCP operator[](int BGE_NCP At) const
+    {
+        return Val[At];
+    }
 
-    Vector3 BGE_NCP operator=(Vector3 BGE_NCP Other);
     bool operator==(Vector3 BGE_NCP Other) const;
 
     Vector3 BGE_NCP operator+=(Vector3 BGE_NCP Other);
@@ -41,6 +41,10 @@ namespace bakge
  * check this homogeneous coordinate before proceeding, such as scalar
  * multiplication. Dividing a point by a constant is meaningless. Dividing a
  * vector by a constant reduces its magnitude (length).
+ *
+ * Vector4 is a trivially copyable value type: arrays of them can be copied
+ * with memcpy or uploaded to OpenGL buffers as-is, and the constructors are
+ * constexpr so constants can be built at compile time.
  * */
 class BGE_API Vector4
 {
@@ -52,17 +56,30 @@ public:
     static const Vector4 Origin;
     static const Vector4 ZeroVector;
 
-    Vector4();
-    Vector4(Scalar X, Scalar Y, Scalar Z, Scalar W);
-    Vector4(Vector4 BGE_NCP Other);
-    ~Vector4();
+    /* Defaults to the origin point (0, 0, 0, 1) */
+    constexpr Vector4() : Val{0, 0, 0, 1}
+    {
+    }
+
+
+    constexpr Vector4(Scalar X, Scalar Y, Scalar Z, Scalar W)
+                                        : Val{X, Y, Z, W}
+    {
+    }
 
     Vector4 operator-() const;
 
-    Scalar& operator[](int BGE_NCP At);
-    Scalar BGE_NCP operator[](int BGE_NCP At) const;
+    BGE_INL Scalar& operator[](int BGE_NCP At)
+    {
+        return Val[At];
+    }
+
+
+    constexpr Scalar BGE_NCP operator[](int BGE_NCP At) const
+    {
+        return Val[At];
+    }
 
-    Vector4 BGE_NCP operator=(Vector4 BGE_NCP Other);
     bool operator==(Vector4 BGE_NCP Other) const;
 
     Vector4 BGE_NCP operator+=(Vector4 BGE_NCP Other);
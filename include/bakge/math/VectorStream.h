@@ -0,0 +1,113 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MATH_VECTORSTREAM_H
+#define BAKGE_MATH_VECTORSTREAM_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * A fixed-size run of 4-component vectors stored as structure-of-arrays:
+ * all X components in one array, all Y in another, and so on. Each array
+ * is aligned to a 64 byte cache line and padded to a multiple of 16
+ * Scalars, so bulk operations stream whole SIMD registers with no
+ * shuffling and no scalar tail.
+ *
+ * Use this for large batches of positions, velocities or normals that
+ * are updated together every frame. Convert to and from Vector4 arrays
+ * at the boundaries with FromVectors and ToVectors.
+ *
+ * Operations mirror Vector4's: Add, Subtract, Scale, Normalize, Dot and
+ * Cross work on XYZ and leave W untouched (Cross sets W to 0), while
+ * Transform uses all 4 components like Matrix::TransformPoints.
+ * Operations taking another stream fail if the counts don't match.
+ * */
+class BGE_API VectorStream
+{
+    Byte* Memory;
+    Scalar* Components[4];
+    size_t Count;
+    size_t Stride;
+
+
+protected:
+
+    VectorStream();
+
+
+public:
+
+    ~VectorStream();
+
+    BGE_FACTORY VectorStream* Create(size_t NumVectors);
+
+    BGE_INL size_t GetCount() const
+    {
+        return Count;
+    }
+
+    /* Component arrays. Each holds GetCount() Scalars */
+    BGE_INL Scalar* GetX() { return Components[0]; }
+    BGE_INL Scalar* GetY() { return Components[1]; }
+    BGE_INL Scalar* GetZ() { return Components[2]; }
+    BGE_INL Scalar* GetW() { return Components[3]; }
+    BGE_INL const Scalar* GetX() const { return Components[0]; }
+    BGE_INL const Scalar* GetY() const { return Components[1]; }
+    BGE_INL const Scalar* GetZ() const { return Components[2]; }
+    BGE_INL const Scalar* GetW() const { return Components[3]; }
+
+    /* Read or write a single vector. Slow; use for setup and debugging */
+    Vector4 GetVector(size_t At) const;
+    void SetVector(size_t At, Vector4 BGE_NCP Vec);
+
+    /* Copy N vectors in or out, starting at vector Offset in the stream */
+    Result FromVectors(const Vector4* In, size_t N, size_t Offset = 0);
+    Result ToVectors(Vector4* Out, size_t N, size_t Offset = 0) const;
+
+    Result Add(VectorStream BGE_NCP Other);
+    Result Subtract(VectorStream BGE_NCP Other);
+
+    /* this += Other * Factor. Handy for integrating velocities */
+    Result AddScaled(VectorStream BGE_NCP Other, Scalar Factor);
+
+    void Scale(Scalar Factor);
+    void Normalize();
+
+    /* Out must have room for GetCount() Scalars */
+    Result Dot(VectorStream BGE_NCP Other, Scalar* Out) const;
+
+    /* Stores Left x Right in this stream */
+    Result Cross(VectorStream BGE_NCP Left, VectorStream BGE_NCP Right);
+
+    /* Transform every vector in place */
+    void Transform(Matrix BGE_NCP M);
+
+}; /* VectorStream */
+
+} /* bakge */
+
+#endif /* BAKGE_MATH_VECTORSTREAM_H */
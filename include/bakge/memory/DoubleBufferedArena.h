@@ -0,0 +1,86 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MEMORY_DOUBLEBUFFEREDARENA_H
+#define BAKGE_MEMORY_DOUBLEBUFFEREDARENA_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * A pair of linear arenas for data that has to last into the next frame,
+ * such as results one frame produces for the next to consume. Allocations
+ * come from the current arena. Swapping at the end of a frame makes it
+ * the previous arena, whose memory stays valid for one more frame, and
+ * resets the older one to become current.
+ * */
+class BGE_API DoubleBufferedArena
+{
+    LinearArena* Arenas[2];
+    int Current;
+
+    DoubleBufferedArena();
+
+
+public:
+
+    ~DoubleBufferedArena();
+
+    /* Each of the two arenas gets NumBytes */
+    BGE_FACTORY DoubleBufferedArena* Create(size_t NumBytes);
+
+    BGE_INL void* Allocate(size_t NumBytes,
+                                size_t Alignment = BGE_ARENA_ALIGN)
+    {
+        return Arenas[Current]->Allocate(NumBytes, Alignment);
+    }
+
+    template<class T>
+    BGE_INL T* AllocateArray(int Count)
+    {
+        return Arenas[Current]->AllocateArray<T>(Count);
+    }
+
+    /* Frees the previous frame's memory and starts a new frame */
+    void Swap();
+
+    BGE_INL LinearArena* GetCurrent() const
+    {
+        return Arenas[Current];
+    }
+
+    BGE_INL LinearArena* GetPrevious() const
+    {
+        return Arenas[Current ^ 1];
+    }
+
+    void ReportUsage(const char* Name) const;
+
+}; /* DoubleBufferedArena */
+
+} /* bakge */
+
+#endif /* BAKGE_MEMORY_DOUBLEBUFFEREDARENA_H */
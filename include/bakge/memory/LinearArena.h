@@ -0,0 +1,149 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MEMORY_LINEARARENA_H
+#define BAKGE_MEMORY_LINEARARENA_H
+
+#include <bakge/Bakge.h>
+
+/* Alignment of allocations made without asking for one; fits SIMD types */
+#define BGE_ARENA_ALIGN 16
+
+/* Debug builds fill new allocations and freed memory with these bytes */
+#define BGE_POISON_ALLOCATED 0xCD
+#define BGE_POISON_FREED 0xDD
+
+namespace bakge
+{
+
+/* Defined in src/memory/LinearArena.cpp */
+struct ArenaOverflow;
+
+/* *
+ * Hands out memory from one block by moving an offset forward, and frees
+ * everything at once when reset. Allocating is a few instructions and
+ * freeing single allocations is not possible, which suits scratch memory
+ * whose lifetime is known, such as everything allocated during a frame.
+ *
+ * Allocations that don't fit the block are taken from the heap and freed
+ * on the next reset, so running out of room is slow rather than fatal.
+ * The high water mark counts them too, so it tells how big the arena
+ * should have been.
+ *
+ * Objects are not constructed or destructed. Not thread-safe.
+ * */
+class BGE_API LinearArena
+{
+
+protected:
+
+    Byte* Memory;
+    size_t Capacity;
+    size_t Offset;
+
+    /* Heap blocks used once Memory is full, newest first */
+    ArenaOverflow* Overflow;
+    size_t OverflowBytes;
+
+    size_t HighWater;
+    bool OverflowReported;
+
+    LinearArena();
+
+    Result Reserve(size_t NumBytes);
+
+    void* AllocateOverflow(size_t NumBytes, size_t Alignment);
+
+    /* Frees overflow blocks newer than Oldest, or all of them if NULL */
+    void FreeOverflow(ArenaOverflow* Oldest);
+
+    void UpdateHighWater()
+    {
+        if(Offset + OverflowBytes > HighWater)
+            HighWater = Offset + OverflowBytes;
+    }
+
+
+public:
+
+    virtual ~LinearArena();
+
+    BGE_FACTORY LinearArena* Create(size_t NumBytes);
+
+    /* Alignment must be a power of two */
+    BGE_INL void* Allocate(size_t NumBytes,
+                                size_t Alignment = BGE_ARENA_ALIGN)
+    {
+        size_t Base = (size_t)Memory;
+        size_t Start = ((Base + Offset + Alignment - 1) & ~(Alignment - 1))
+                                                                    - Base;
+
+        if(Start + NumBytes > Capacity)
+            return AllocateOverflow(NumBytes, Alignment);
+
+        Offset = Start + NumBytes;
+        UpdateHighWater();
+
+#ifdef _DEBUG
+        memset((void*)(Memory + Start), BGE_POISON_ALLOCATED, NumBytes);
+#endif /* _DEBUG */
+
+        return (void*)(Memory + Start);
+    }
+
+    /* Room for Count objects of type T, not constructed */
+    template<class T>
+    BGE_INL T* AllocateArray(int Count)
+    {
+        return (T*)Allocate(sizeof(T) * Count, std::alignment_of<T>::value);
+    }
+
+    /* Frees everything allocated from the arena */
+    void Reset();
+
+    /* Bytes allocated since the last reset, including overflow */
+    BGE_INL size_t GetUsed() const
+    {
+        return Offset + OverflowBytes;
+    }
+
+    BGE_INL size_t GetCapacity() const
+    {
+        return Capacity;
+    }
+
+    /* Most bytes ever allocated between two resets */
+    BGE_INL size_t GetHighWater() const
+    {
+        return HighWater;
+    }
+
+    /* Prints usage and the high water mark, prefixed with Name */
+    void ReportUsage(const char* Name) const;
+
+}; /* LinearArena */
+
+} /* bakge */
+
+#endif /* BAKGE_MEMORY_LINEARARENA_H */
@@ -0,0 +1,131 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MEMORY_MEMORYTRACKER_H
+#define BAKGE_MEMORY_MEMORYTRACKER_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* Subsystems memory use is counted by */
+enum MEMORY_TAGS
+{
+    MEMORY_TAG_GENERAL = 0,
+    MEMORY_TAG_MATH,
+    MEMORY_TAG_GRAPHICS,
+    MEMORY_TAG_NETWORK,
+    MEMORY_TAG_SCRIPT,
+    MEMORY_TAG_FILE,
+    NUM_MEMORY_TAGS
+};
+
+
+struct MemoryStats
+{
+    /* Bytes allocated and not yet freed, and the most there have been */
+    size_t LiveBytes;
+    size_t PeakBytes;
+
+    /* Counts since startup, including reallocations */
+    long long NumAllocations;
+    long long NumFrees;
+};
+
+
+/* *
+ * Allocation tracking is compiled in when BGE_TRACK_MEMORY is defined
+ * (the BAKGE_TRACK_MEMORY CMake option). Without it the functions below
+ * are plain malloc, realloc and free, and the Track functions do nothing.
+ *
+ * Memory from TrackedMalloc, TrackedCalloc and TrackedRealloc must be
+ * freed with TrackedFree. Allocators that know their block sizes, like
+ * Lua's, can report to the tracker directly with the Track functions.
+ * */
+#ifdef BGE_TRACK_MEMORY
+
+BGE_FUNC void TrackAllocation(int Tag, size_t NumBytes);
+BGE_FUNC void TrackReallocation(int Tag, size_t OldBytes, size_t NewBytes);
+BGE_FUNC void TrackFree(int Tag, size_t NumBytes);
+
+BGE_FUNC void* TrackedMalloc(size_t NumBytes, int Tag);
+BGE_FUNC void* TrackedCalloc(size_t NumBytes, int Tag);
+BGE_FUNC void* TrackedRealloc(void* Memory, size_t NumBytes, int Tag);
+BGE_FUNC void TrackedFree(void* Memory);
+
+#else
+
+BGE_INL void TrackAllocation(int, size_t)
+{
+}
+
+BGE_INL void TrackReallocation(int, size_t, size_t)
+{
+}
+
+BGE_INL void TrackFree(int, size_t)
+{
+}
+
+BGE_INL void* TrackedMalloc(size_t NumBytes, int)
+{
+    return malloc(NumBytes);
+}
+
+BGE_INL void* TrackedCalloc(size_t NumBytes, int)
+{
+    return calloc(NumBytes, 1);
+}
+
+BGE_INL void* TrackedRealloc(void* Memory, size_t NumBytes, int)
+{
+    return realloc(Memory, NumBytes);
+}
+
+BGE_INL void TrackedFree(void* Memory)
+{
+    free(Memory);
+}
+
+#endif /* BGE_TRACK_MEMORY */
+
+/* Counters for one tag; all zero when tracking is compiled out */
+BGE_FUNC void GetMemoryStats(int Tag, MemoryStats* Stats);
+
+BGE_FUNC const char* GetMemoryTagName(int Tag);
+
+/* *
+ * Prints live and peak bytes and allocation counts for every tag, with
+ * allocations per second since the last report. Deinit prints one too.
+ * */
+BGE_FUNC void ReportMemory();
+
+/* A lua_Alloc that counts the script's memory under MEMORY_TAG_SCRIPT */
+BGE_FUNC void* TrackedLuaAllocator(void* UserData, void* Memory,
+                                        size_t OldBytes, size_t NewBytes);
+
+} /* bakge */
+
+#endif /* BAKGE_MEMORY_MEMORYTRACKER_H */
@@ -0,0 +1,227 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MEMORY_OBJECTPOOL_H
+#define BAKGE_MEMORY_OBJECTPOOL_H
+
+#include <bakge/Bakge.h>
+
+/* Most pools that can have thread-local caches */
+#define BGE_MAX_CACHED_POOLS 32
+
+/* Blocks a thread caches per pool, and how many move to or from a cache */
+#define BGE_POOL_CACHE_SIZE 64
+#define BGE_POOL_CACHE_BATCH 32
+
+/* *
+ * Put in the public section of a class declaration to have new and
+ * delete of that class draw from a pool, and BGE_POOLED_DEFINE in the
+ * class's source file. Factories keep using new and users keep using
+ * delete. Subclasses without pools of their own fall through to the
+ * global heap. The pool's slabs are counted under the memory tag Tag.
+ *
+ * The pool is a function-local static, made the first time it's used
+ * and destroyed with the other statics at exit. Objects of the class
+ * can't be deleted from destructors of statics made before the pool,
+ * since those run after the pool is gone.
+ * */
+#define BGE_POOLED_DECLARE \
+    static bakge::BlockPool& GetPool(); \
+    static void* operator new(size_t Size) noexcept; \
+    static void operator delete(void* Object, size_t Size);
+
+#define BGE_POOLED_DEFINE(Class, ThreadCache, Tag) \
+bakge::BlockPool& Class::GetPool() \
+{ \
+    static bakge::BlockPool Pool(#Class, sizeof(Class), \
+                    std::alignment_of<Class>::value, ThreadCache, Tag); \
+    return Pool; \
+} \
+\
+void* Class::operator new(size_t Size) noexcept \
+{ \
+    if(Size != sizeof(Class)) \
+        return ::operator new(Size, std::nothrow); \
+    return GetPool().Allocate(); \
+} \
+\
+void Class::operator delete(void* Object, size_t Size) \
+{ \
+    if(Object == NULL) \
+        return; \
+    if(Size != sizeof(Class)) \
+        ::operator delete(Object); \
+    else \
+        GetPool().Free(Object); \
+}
+
+namespace bakge
+{
+
+class SpinLock;
+
+/* Defined in src/memory/ObjectPool.cpp */
+struct PoolBlock;
+struct PoolSlab;
+
+/* *
+ * Hands out fixed-size blocks of memory from slabs, keeping freed blocks
+ * on a list to be handed out again. Allocating and freeing are constant
+ * time and blocks allocated together sit next to each other in memory.
+ *
+ * Thread-safe. A pool made with ThreadCache set keeps a small cache of
+ * free blocks for each thread, so threads allocating and freeing often
+ * rarely touch the shared list or its lock.
+ *
+ * Every pool is named. Deinit reports pools that still have blocks
+ * allocated, which are almost always leaked objects.
+ * */
+class BGE_API BlockPool
+{
+    const char* Name;
+    size_t BlockSize;
+    size_t Alignment;
+
+    /* Memory tag slabs are tracked under */
+    int Tag;
+
+    /* Index of this pool in each thread's caches, or -1 */
+    int CacheIndex;
+
+    /* Guards everything below it */
+    SpinLock* Lock;
+    PoolBlock* FreeBlocks;
+    PoolSlab* Slabs;
+    int NextSlabSize;
+    int NumBlocks;
+    int NumFree;
+
+    /* Next pool on the list of all pools */
+    BlockPool* NextPool;
+
+    /* Copies would free the same slabs */
+    BlockPool(const BlockPool&);
+    void operator=(const BlockPool&);
+
+    /* Lock must be held */
+    void Grow(int NumNewBlocks);
+
+
+public:
+
+    BlockPool(const char* Name, size_t BlockSize, size_t Alignment,
+                    bool ThreadCache, int Tag = MEMORY_TAG_GENERAL);
+    ~BlockPool();
+
+    /* NULL if out of memory */
+    void* Allocate();
+    void Free(void* Block);
+
+    /* Grows the pool to hold at least NumBlocks blocks in all */
+    void Reserve(int NumBlocks);
+
+    /* *
+     * Moves a chain of blocks between the shared list and a thread's
+     * cache. Used by the caches; Take returns how many it took.
+     * */
+    int TakeBlocks(PoolBlock** Chain, int Count);
+    void ReturnBlocks(PoolBlock* First, PoolBlock* Last, int Count);
+
+    BGE_INL const char* GetName() const
+    {
+        return Name;
+    }
+
+    BGE_INL size_t GetBlockSize() const
+    {
+        return BlockSize;
+    }
+
+    /* *
+     * Blocks allocated and not yet freed. Free blocks in the caches of
+     * threads other than the calling one are counted as allocated until
+     * those threads exit.
+     * */
+    int GetNumLive() const;
+
+    /* Blocks the pool has memory for */
+    int GetCapacity() const;
+
+    /* *
+     * Prints every pool with blocks still allocated; returns how many.
+     * Blocks sitting in the caches of threads still running are counted
+     * as allocated, so threads that use cached pools must have exited
+     * before Deinit calls this.
+     * */
+    static int ReportLeaks();
+
+}; /* BlockPool */
+
+
+/* *
+ * A block pool holding objects of one type. Create constructs an object
+ * in a block and Destroy destructs it and frees the block.
+ * */
+template<class T>
+class ObjectPool : public BlockPool
+{
+
+public:
+
+    ObjectPool(const char* Name, bool ThreadCache = false,
+                                        int Tag = MEMORY_TAG_GENERAL)
+        : BlockPool(Name, sizeof(T), std::alignment_of<T>::value,
+                                                    ThreadCache, Tag)
+    {
+    }
+
+    ~ObjectPool()
+    {
+    }
+
+    /* A default-constructed object, or NULL if out of memory */
+    T* Create()
+    {
+        void* Block = Allocate();
+
+        if(Block == NULL)
+            return NULL;
+
+        return new (Block) T();
+    }
+
+    void Destroy(T* Object)
+    {
+        if(Object == NULL)
+            return;
+
+        Object->~T();
+        Free((void*)Object);
+    }
+
+}; /* ObjectPool */
+
+} /* bakge */
+
+#endif /* BAKGE_MEMORY_OBJECTPOOL_H */
@@ -0,0 +1,91 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MEMORY_STACKALLOCATOR_H
+#define BAKGE_MEMORY_STACKALLOCATOR_H
+
+#include <bakge/Bakge.h>
+
+/* Size of each thread's scratch stack */
+#define BGE_SCRATCH_STACK_SIZE (64 * 1024)
+
+namespace bakge
+{
+
+/* A point to free a stack allocator back to */
+struct StackMarker
+{
+    size_t Offset;
+    ArenaOverflow* Overflow;
+};
+
+
+/* *
+ * A linear arena that can also free back to a marker, releasing
+ * everything allocated after the marker was taken. Markers must be freed
+ * to in the reverse order they were taken.
+ *
+ * Each thread has a scratch stack for temporary buffers a function needs
+ * only until it returns:
+ *
+ *     StackAllocator* Scratch = StackAllocator::GetScratch();
+ *     StackMarker Marker = Scratch->GetMarker();
+ *     char* Buffer = Scratch->AllocateArray<char>(Length);
+ *     ...
+ *     Scratch->FreeToMarker(Marker);
+ * */
+class BGE_API StackAllocator : public LinearArena
+{
+
+protected:
+
+    StackAllocator();
+
+
+public:
+
+    ~StackAllocator();
+
+    BGE_FACTORY StackAllocator* Create(size_t NumBytes);
+
+    /* The calling thread's scratch stack, created on first use */
+    static StackAllocator* GetScratch();
+
+    BGE_INL StackMarker GetMarker() const
+    {
+        StackMarker Marker;
+
+        Marker.Offset = Offset;
+        Marker.Overflow = Overflow;
+
+        return Marker;
+    }
+
+    void FreeToMarker(StackMarker Marker);
+
+}; /* StackAllocator */
+
+} /* bakge */
+
+#endif /* BAKGE_MEMORY_STACKALLOCATOR_H */
@@ -0,0 +1,65 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MUTEX_ADAPTIVEMUTEX_H
+#define BAKGE_MUTEX_ADAPTIVEMUTEX_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Spins for a short while when the lock is held, then sleeps like a
+ * Mutex. Locks usually held briefly are often freed again before a
+ * sleeping thread could even be woken, while spinning on a lock held
+ * for long wastes processor time; this covers both. With only one
+ * processor the holder can't run while we spin, so it never spins.
+ * */
+class BGE_API AdaptiveMutex : public api::Mutex
+{
+    bakge::Mutex* Handle;
+    int SpinCount;
+
+    AdaptiveMutex();
+
+
+public:
+
+    virtual ~AdaptiveMutex();
+
+    BGE_FACTORY AdaptiveMutex* Create();
+
+    /* Pause at most SpinCount times before sleeping */
+    BGE_FACTORY AdaptiveMutex* Create(int SpinCount);
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+}; /* AdaptiveMutex */
+
+} /* bakge */
+
+#endif /* BAKGE_MUTEX_ADAPTIVEMUTEX_H */
@@ -0,0 +1,95 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MUTEX_SCOPEDLOCK_H
+#define BAKGE_MUTEX_SCOPEDLOCK_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* *
+ * Holds a lock until the end of the scope it is declared in, so every
+ * way out of the scope unlocks it.
+ *
+ *     {
+ *         ScopedLock<Mutex> Guard(SceneLock);
+ *         ...
+ *     }
+ * */
+template<class T>
+class ScopedLock
+{
+    T* Held;
+
+    /* Copies would unlock twice */
+    ScopedLock(const ScopedLock&);
+    void operator=(const ScopedLock&);
+
+
+public:
+
+    ScopedLock(T* Lock)
+    {
+        Held = Lock;
+        Held->Lock();
+    }
+
+    ~ScopedLock()
+    {
+        Held->Unlock();
+    }
+
+}; /* ScopedLock */
+
+
+/* Holds a ReaderWriterLock for reading until the end of the scope */
+template<class T>
+class ScopedSharedLock
+{
+    T* Held;
+
+    ScopedSharedLock(const ScopedSharedLock&);
+    void operator=(const ScopedSharedLock&);
+
+
+public:
+
+    ScopedSharedLock(T* Lock)
+    {
+        Held = Lock;
+        Held->LockShared();
+    }
+
+    ~ScopedSharedLock()
+    {
+        Held->UnlockShared();
+    }
+
+}; /* ScopedSharedLock */
+
+} /* bakge */
+
+#endif /* BAKGE_MUTEX_SCOPEDLOCK_H */
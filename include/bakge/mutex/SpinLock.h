@@ -0,0 +1,74 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_MUTEX_SPINLOCK_H
+#define BAKGE_MUTEX_SPINLOCK_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* Tells the processor this thread is busy-waiting */
+BGE_INL void CpuPause()
+{
+#if defined(_WIN32)
+    YieldProcessor();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__arm__) || defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif /* _WIN32 */
+}
+
+
+/* *
+ * Waits for the lock by spinning instead of sleeping. That's cheapest
+ * when it is only ever held for a few instructions; otherwise waiting
+ * threads burn processor time the holder could use. Waiting threads
+ * yield their time slice after a while, so a holder that gets
+ * descheduled doesn't stall them for good.
+ * */
+class BGE_API SpinLock : public api::Mutex
+{
+    std::atomic<bool> Held;
+
+    SpinLock();
+
+
+public:
+
+    virtual ~SpinLock();
+
+    BGE_FACTORY SpinLock* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+}; /* SpinLock */
+
+} /* bakge */
+
+#endif /* BAKGE_MUTEX_SPINLOCK_H */
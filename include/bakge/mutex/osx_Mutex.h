@@ -28,8 +28,15 @@
 namespace bakge
 {
 
-typedef class BGE_API osx_Mutex : api::Mutex
+typedef class BGE_API osx_Mutex : public api::Mutex
 {
+    friend class osx_ConditionVariable;
+
+    pthread_mutex_t MutexHandle;
+
+    /* Whether the handle was set up, and so has to be destroyed */
+    bool Initialized;
+
     osx_Mutex();
 
 
@@ -37,8 +44,95 @@ public:
 
     virtual ~osx_Mutex();
 
+    BGE_FACTORY osx_Mutex* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
 } Mutex; /* osx_Mutex */
 
+
+/* Can be locked again by the thread holding it; unlock as many times */
+typedef class BGE_API osx_RecursiveMutex : public api::Mutex
+{
+    pthread_mutex_t MutexHandle;
+    bool Initialized;
+
+#ifdef _DEBUG
+    int Depth; /* Only the outermost hold is counted */
+#endif /* _DEBUG */
+
+    osx_RecursiveMutex();
+
+
+public:
+
+    virtual ~osx_RecursiveMutex();
+
+    BGE_FACTORY osx_RecursiveMutex* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+} RecursiveMutex; /* osx_RecursiveMutex */
+
+
+typedef class BGE_API osx_ReaderWriterLock : public api::ReaderWriterLock
+{
+    pthread_rwlock_t LockHandle;
+    bool Initialized;
+
+    osx_ReaderWriterLock();
+
+
+public:
+
+    virtual ~osx_ReaderWriterLock();
+
+    BGE_FACTORY osx_ReaderWriterLock* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+    Result LockShared();
+    bool TryLockShared();
+    Result UnlockShared();
+
+} ReaderWriterLock; /* osx_ReaderWriterLock */
+
+
+typedef class BGE_API osx_ConditionVariable : public api::ConditionVariable
+{
+    pthread_cond_t ConditionHandle;
+    bool Initialized;
+
+    osx_ConditionVariable();
+
+
+public:
+
+    virtual ~osx_ConditionVariable();
+
+    BGE_FACTORY osx_ConditionVariable* Create();
+
+    /* *
+     * Unlocks Held, which the caller must hold, and sleeps until signaled.
+     * Held is locked again before returning. Wakeups can be spurious, so
+     * check the condition waited on in a loop.
+     * */
+    Result Wait(osx_Mutex* Held);
+
+    /* Like Wait, but gives up after Timeout. False if it timed out */
+    bool WaitFor(osx_Mutex* Held, Microseconds Timeout);
+
+    Result Signal();
+    Result Broadcast();
+
+} ConditionVariable; /* osx_ConditionVariable */
+
 } /* bakge */
 
 #endif /* BAKGE_THREAD_OSX_MUTEX_H */
@@ -28,8 +28,13 @@
 namespace bakge
 {
 
-typedef class BGE_API win32_Mutex : api::Mutex
+/* Slim reader-writer locks, held exclusively. Needs Windows Vista */
+typedef class BGE_API win32_Mutex : public api::Mutex
 {
+    friend class win32_ConditionVariable;
+
+    SRWLOCK LockHandle;
+
     win32_Mutex();
 
 
@@ -37,8 +42,96 @@ public:
 
     virtual ~win32_Mutex();
 
+    BGE_FACTORY win32_Mutex* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
 } Mutex; /* win32_Mutex */
 
+
+/* Can be locked again by the thread holding it; unlock as many times */
+typedef class BGE_API win32_RecursiveMutex : public api::Mutex
+{
+    CRITICAL_SECTION Section;
+
+    /* Whether the handle was set up, and so has to be destroyed */
+    bool Initialized;
+
+#ifdef _DEBUG
+    int Depth; /* Only the outermost hold is counted */
+#endif /* _DEBUG */
+
+    win32_RecursiveMutex();
+
+
+public:
+
+    virtual ~win32_RecursiveMutex();
+
+    BGE_FACTORY win32_RecursiveMutex* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+} RecursiveMutex; /* win32_RecursiveMutex */
+
+
+typedef class BGE_API win32_ReaderWriterLock : public api::ReaderWriterLock
+{
+    SRWLOCK LockHandle;
+
+    win32_ReaderWriterLock();
+
+
+public:
+
+    virtual ~win32_ReaderWriterLock();
+
+    BGE_FACTORY win32_ReaderWriterLock* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+    Result LockShared();
+    bool TryLockShared();
+    Result UnlockShared();
+
+} ReaderWriterLock; /* win32_ReaderWriterLock */
+
+
+typedef class BGE_API win32_ConditionVariable
+                                        : public api::ConditionVariable
+{
+    CONDITION_VARIABLE ConditionHandle;
+
+    win32_ConditionVariable();
+
+
+public:
+
+    virtual ~win32_ConditionVariable();
+
+    BGE_FACTORY win32_ConditionVariable* Create();
+
+    /* *
+     * Unlocks Held, which the caller must hold, and sleeps until signaled.
+     * Held is locked again before returning. Wakeups can be spurious, so
+     * check the condition waited on in a loop.
+     * */
+    Result Wait(win32_Mutex* Held);
+
+    /* Like Wait, but gives up after Timeout. False if it timed out */
+    bool WaitFor(win32_Mutex* Held, Microseconds Timeout);
+
+    Result Signal();
+    Result Broadcast();
+
+} ConditionVariable; /* win32_ConditionVariable */
+
 } /* bakge */
 
 #endif /* BAKGE_THREAD_WIN32_MUTEX_H */
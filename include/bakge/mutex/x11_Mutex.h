@@ -28,8 +28,15 @@
 namespace bakge
 {
 
-typedef class BGE_API x11_Mutex : api::Mutex
+typedef class BGE_API x11_Mutex : public api::Mutex
 {
+    friend class x11_ConditionVariable;
+
+    pthread_mutex_t MutexHandle;
+
+    /* Whether the handle was set up, and so has to be destroyed */
+    bool Initialized;
+
     x11_Mutex();
 
 
@@ -37,8 +44,95 @@ public:
 
     virtual ~x11_Mutex();
 
+    BGE_FACTORY x11_Mutex* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
 } Mutex; /* x11_Mutex */
 
+
+/* Can be locked again by the thread holding it; unlock as many times */
+typedef class BGE_API x11_RecursiveMutex : public api::Mutex
+{
+    pthread_mutex_t MutexHandle;
+    bool Initialized;
+
+#ifdef _DEBUG
+    int Depth; /* Only the outermost hold is counted */
+#endif /* _DEBUG */
+
+    x11_RecursiveMutex();
+
+
+public:
+
+    virtual ~x11_RecursiveMutex();
+
+    BGE_FACTORY x11_RecursiveMutex* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+} RecursiveMutex; /* x11_RecursiveMutex */
+
+
+typedef class BGE_API x11_ReaderWriterLock : public api::ReaderWriterLock
+{
+    pthread_rwlock_t LockHandle;
+    bool Initialized;
+
+    x11_ReaderWriterLock();
+
+
+public:
+
+    virtual ~x11_ReaderWriterLock();
+
+    BGE_FACTORY x11_ReaderWriterLock* Create();
+
+    Result Lock();
+    bool TryLock();
+    Result Unlock();
+
+    Result LockShared();
+    bool TryLockShared();
+    Result UnlockShared();
+
+} ReaderWriterLock; /* x11_ReaderWriterLock */
+
+
+typedef class BGE_API x11_ConditionVariable : public api::ConditionVariable
+{
+    pthread_cond_t ConditionHandle;
+    bool Initialized;
+
+    x11_ConditionVariable();
+
+
+public:
+
+    virtual ~x11_ConditionVariable();
+
+    BGE_FACTORY x11_ConditionVariable* Create();
+
+    /* *
+     * Unlocks Held, which the caller must hold, and sleeps until signaled.
+     * Held is locked again before returning. Wakeups can be spurious, so
+     * check the condition waited on in a loop.
+     * */
+    Result Wait(x11_Mutex* Held);
+
+    /* Like Wait, but gives up after Timeout. False if it timed out */
+    bool WaitFor(x11_Mutex* Held, Microseconds Timeout);
+
+    Result Signal();
+    Result Broadcast();
+
+} ConditionVariable; /* x11_ConditionVariable */
+
 } /* bakge */
 
 #endif /* BAKGE_THREAD_X11_MUTEX_H */
@@ -25,19 +25,123 @@
 #ifndef BAKGE_NETWORK_PACKET_H
 #define BAKGE_NETWORK_PACKET_H
 
+/* *
+ * Largest payload a packet holds: an Ethernet frame's 1500 bytes less
+ * the IPv4 and UDP headers, so packets are never fragmented.
+ * */
+#define BGE_PACKET_CAPACITY 1472
+
 namespace bakge
 {
 
+/* Defined in src/network/Packet.cpp */
+struct PacketBuffer;
+
+/* *
+ * A datagram's payload, with a cursor for reading it back in order.
+ * Writes append to the end of the payload.
+ *
+ * Payloads live in pooled, reference-counted buffers. Share makes
+ * another packet over the same buffer without copying it, e.g. to
+ * queue one payload for several destinations; a write to a shared
+ * buffer copies it first. Packets themselves are pooled as well, so
+ * creating and deleting them doesn't touch the heap.
+ * */
 class BGE_API Packet
 {
+    PacketBuffer* Buffer;
+    int Size;
+    int ReadPosition;
+
+    /* Where a received packet came from */
+    Remote Sender;
+
     Packet();
 
+    /* Gives this packet a buffer of its own before it's written to */
+    Result Detach();
+
 
 public:
 
     virtual ~Packet();
 
-    BGE_FACTORY Packet* Create(const Byte* Data);
+    /* An empty packet */
+    BGE_FACTORY Packet* Create();
+
+    /* A packet holding a copy of Size bytes of Data */
+    BGE_FACTORY Packet* Create(const Byte* Data, int Size);
+
+    /* Another packet over the same payload, with its own read cursor */
+    BGE_WUNUSED Packet* Share() const;
+
+    /* Fails without writing anything if the data doesn't fit */
+    Result Write(const void* Data, int NumBytes);
+
+    /* Fails without reading anything if fewer bytes are left */
+    Result Read(void* Data, int NumBytes);
+
+    template<typename T>
+    BGE_INL Result WriteValue(T BGE_NCP Value)
+    {
+        return Write((const void*)&Value, sizeof(T));
+    }
+
+    template<typename T>
+    BGE_INL Result ReadValue(T* Value)
+    {
+        return Read((void*)Value, sizeof(T));
+    }
+
+    /* Moves the read cursor; Position may not pass the end of the data */
+    Result Seek(int Position);
+
+    BGE_INL int GetReadPosition() const
+    {
+        return ReadPosition;
+    }
+
+    BGE_INL int GetRemaining() const
+    {
+        return Size - ReadPosition;
+    }
+
+    const Byte* GetData() const;
+
+    BGE_INL int GetSize() const
+    {
+        return Size;
+    }
+
+    BGE_INL static int GetCapacity()
+    {
+        return BGE_PACKET_CAPACITY;
+    }
+
+    /* *
+     * For filling the packet in place, e.g. straight from a socket.
+     * The payload is unshared first; call SetSize when done.
+     * */
+    Byte* GetWritableData();
+    Result SetSize(int NewSize);
+
+    /* Empties the payload and rewinds the read cursor */
+    void Clear();
+
+    BGE_INL Remote BGE_NCP GetSender() const
+    {
+        return Sender;
+    }
+
+    BGE_INL void SetSender(Remote BGE_NCP From)
+    {
+        Sender = From;
+    }
+
+    /* Packets sharing this one's payload, itself included */
+    int GetNumReferences() const;
+
+    BGE_POOLED_DECLARE
 
 }; /* Packet */
 
@@ -34,7 +34,9 @@ class BGE_API Remote
     int FullAddress;
     int Port;
 
-    char Str[22];
+    /* Formatted when first asked for, not every time the address changes */
+    mutable char Str[22];
+    mutable bool StrValid;
 
 
 public:
@@ -43,6 +45,10 @@ public:
     ~Remote();
 
     Remote BGE_NCP SetAddress(Byte A, Byte B, Byte C, Byte D);
+
+    /* Address as one integer in host byte order, A in the high byte */
+    Remote BGE_NCP SetAddress(int Address);
+
     const char* GetAddressString() const;
     int GetAddress() const;
 
@@ -29,11 +29,16 @@
 #include <OpenGL/gl.h>
 #include <OpenGL/glu.h>
 #include <unistd.h>
+#include <errno.h>
+#include <mach/mach_time.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
+#include <poll.h>
+#include <fcntl.h>
 
 #include <bakge/mutex/osx_Mutex.h>
 #include <bakge/thread/osx_Thread.h>
 #include <bakge/socket/osx_Socket.h>
+#include <bakge/reactor/osx_Reactor.h>
 
 #endif /* BAKGE_PLATFORM_OSX_BAKGE_H */
@@ -34,6 +34,11 @@
 #define WIN32_LEAN_AND_MEAN
 #endif /* WIN32_LEAN_AND_MEAN */
 
+/* WSAPoll needs Vista or later */
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600
+#endif /* _WIN32_WINNT */
+
 #include <windows.h>
 #include <winsock2.h>
 #include <GL/gl.h>
@@ -42,5 +47,6 @@
 #include <bakge/mutex/win32_Mutex.h>
 #include <bakge/thread/win32_Thread.h>
 #include <bakge/socket/win32_Socket.h>
+#include <bakge/reactor/win32_Reactor.h>
 
 #endif /* BAKGE_PLATFORM_WIN32_BAKGE_H */
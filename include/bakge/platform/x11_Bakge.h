@@ -28,13 +28,18 @@
 #include <GL/glu.h>
 #include <sys/time.h>
 #include <time.h>
+#include <errno.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
 
 #include <bakge/mutex/x11_Mutex.h>
 #include <bakge/thread/x11_Thread.h>
 #include <bakge/socket/x11_Socket.h>
+#include <bakge/reactor/x11_Reactor.h>
 
 #endif /* BAKGE_PLATFORM_X11_BAKGE_H */
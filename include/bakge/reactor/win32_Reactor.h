@@ -0,0 +1,70 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_REACTOR_WIN32_REACTOR_H
+#define BAKGE_REACTOR_WIN32_REACTOR_H
+
+namespace bakge
+{
+
+/* *
+ * Waits with WSAPoll, which only takes sockets, so Wake sends a byte
+ * to a loopback UDP socket connected to itself. It is the first
+ * watched socket; the others follow in the order they were added.
+ * */
+typedef class BGE_API win32_Reactor : public api::Reactor
+{
+    WSAPOLLFD* Watched;
+    void** Keys;
+    int NumWatched;
+    int Capacity;
+
+    SOCKET WakeHandle;
+
+    win32_Reactor();
+
+    int FindHandle(SOCKET Handle) const;
+
+
+protected:
+
+    Result Watch(intptr_t Handle, int Events, void* Key);
+    Result Rewatch(intptr_t Handle, int Events, void* Key);
+    Result Unwatch(intptr_t Handle);
+    int Wait(void** ReadyKeys, int* Events, int MaxReady, Seconds Timeout);
+
+
+public:
+
+    virtual ~win32_Reactor();
+
+    BGE_FACTORY win32_Reactor* Create();
+
+    Result Wake();
+
+} Reactor; /* win32_Reactor */
+
+} /* bakge */
+
+#endif /* BAKGE_REACTOR_WIN32_REACTOR_H */
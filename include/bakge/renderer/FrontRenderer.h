@@ -30,9 +30,23 @@
 namespace bakge
 {
 
+/* *
+ * Draws objects in the order they're given. Objects whose bounds are
+ * outside the view frustum set with SetViewProjection are skipped
+ * without being bound. Until it is set nothing is culled.
+ * */
 class BGE_API FrontRenderer : public Renderer
 {
 
+protected:
+
+    Frustum ViewFrustum;
+
+    int NumTested;
+    int NumCulled;
+    int NumDrawn;
+
+
 public:
 
     FrontRenderer();
@@ -45,6 +59,39 @@ public:
 
     virtual Result Draw(Drawable* Obj);
 
+    /* *
+     * Draw N objects. Their bounds are culled in batches, so this is
+     * much cheaper than drawing a large scene one object at a time.
+     * Returns BGE_FAILURE if any visible object failed to bind.
+     * */
+    Result Draw(Drawable** Objs, size_t N);
+
+    /* Cull against the view of these perspective and view matrices */
+    void SetViewProjection(Matrix BGE_NCP Perspective,
+                            Matrix BGE_NCP View);
+
+    /* *
+     * Counters of objects with bounds that were tested against the
+     * frustum, culled, and drawn (including objects without bounds).
+     * They add up until reset, so call ResetCounters every frame.
+     * */
+    void ResetCounters();
+
+    BGE_INL int GetNumTested() const
+    {
+        return NumTested;
+    }
+
+    BGE_INL int GetNumCulled() const
+    {
+        return NumCulled;
+    }
+
+    BGE_INL int GetNumDrawn() const
+    {
+        return NumDrawn;
+    }
+
 }; /* FrontRenderer */
 
 } /* bakge */
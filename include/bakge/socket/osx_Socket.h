@@ -28,7 +28,7 @@
 namespace bakge
 {
 
-typedef class BGE_API osx_Socket : api::Socket
+typedef class BGE_API osx_Socket : public api::Socket
 {
     int SocketHandle;
     struct sockaddr_in SocketIn;
@@ -45,6 +45,18 @@ public:
     BGE_WUNUSED Packet* Receive();
     Result Send(Remote* Destination, Packet* Data);
 
+    Result SetBlocking(bool Block);
+    int GetPort() const;
+
+    BGE_INL intptr_t GetHandle() const
+    {
+        return (intptr_t)SocketHandle;
+    }
+
+    /* Takes queued packets without blocking; still one call per packet */
+    int ReceiveMany(Packet** Packets, int MaxPackets);
+    using api::Socket::SendMany;
+
 } Socket; /* osx_Socket */
 
 } /* bakge */
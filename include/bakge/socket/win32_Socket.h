@@ -28,7 +28,7 @@
 namespace bakge
 {
 
-typedef class BGE_API win32_Socket : api::Socket
+typedef class BGE_API win32_Socket : public api::Socket
 {
     SOCKET SocketHandle;
     struct sockaddr_in ServerAddress;
@@ -45,6 +45,18 @@ public:
     BGE_WUNUSED Packet* Receive();
     Result Send(Remote* Destination, Packet* Data);
 
+    Result SetBlocking(bool Block);
+    int GetPort() const;
+
+    BGE_INL intptr_t GetHandle() const
+    {
+        return (intptr_t)SocketHandle;
+    }
+
+    /* One system call per packet */
+    using api::Socket::ReceiveMany;
+    using api::Socket::SendMany;
+
 } Socket; /* win32_Socket */
 
 } /* bakge */
@@ -28,11 +28,15 @@
 namespace bakge
 {
 
-typedef class BGE_API x11_Socket : api::Socket
+typedef class BGE_API x11_Socket : public api::Socket
 {
     int SocketHandle;
     struct sockaddr_in SocketIn;
 
+    /* Packets made for a batched receive that nothing arrived in */
+    Packet* Spares[BGE_SOCKET_BATCH];
+    int NumSpares;
+
     x11_Socket();
 
 
@@ -45,6 +49,18 @@ public:
     BGE_WUNUSED Packet* Receive();
     Result Send(Remote* Destination, Packet* Data);
 
+    Result SetBlocking(bool Block);
+    int GetPort() const;
+
+    BGE_INL intptr_t GetHandle() const
+    {
+        return (intptr_t)SocketHandle;
+    }
+
+    /* One recvmmsg or sendmmsg per BGE_SOCKET_BATCH packets */
+    int ReceiveMany(Packet** Packets, int MaxPackets);
+    int SendMany(Remote* Destinations, Packet** Packets, int NumPackets);
+
 } Socket; /* x11_Socket */
 
 } /* bakge */
@@ -34,6 +34,9 @@ BGE_FUNC Result Delay(Microseconds BGE_NCP Time);
 
 BGE_FUNC Microseconds GetRunningTime();
 
+/* Monotonic time since Init, in nanoseconds */
+BGE_FUNC Nanoseconds GetRunningNanoseconds();
+
 } /* bakge */
 
 #endif /* BAKGE_SYSTEM_CLOCK_H */
@@ -0,0 +1,138 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_SYSTEM_FIXEDTIMESTEP_H
+#define BAKGE_SYSTEM_FIXEDTIMESTEP_H
+
+#include <bakge/Bakge.h>
+
+/* Step size engines update with unless they choose another */
+#define BGE_DEFAULT_TIMESTEP (1.0 / 60.0)
+
+/* *
+ * Longest frame time fed to the accumulator, in seconds. Anything past
+ * it is dropped, so a stall (breakpoints, window drags) doesn't leave
+ * the simulation with a backlog of steps it can never catch up on.
+ * */
+#define BGE_DEFAULT_MAX_FRAME_TIME 0.25
+
+namespace bakge
+{
+
+struct FrameJitterStats
+{
+    long long NumFrames;
+
+    /* Frame times, measured between calls to BeginFrame */
+    Nanoseconds MinFrameTime;
+    Nanoseconds MaxFrameTime;
+    Nanoseconds MeanFrameTime;
+    Nanoseconds FrameTimeDeviation;
+
+    /* Mean change in frame time from one frame to the next */
+    Nanoseconds MeanJitter;
+
+    /* Fixed steps run, and frame time dropped by the clamp */
+    long long NumSteps;
+    Nanoseconds DroppedTime;
+};
+
+/* *
+ * Decouples simulation from frame rate. Each frame, BeginFrame adds
+ * the time since the last frame to an accumulator, and the engine runs
+ * Update once per whole step in it:
+ *
+ *     Timestep->BeginFrame();
+ *     while(Timestep->Step())
+ *         Update(Timestep->GetStepSize());
+ *
+ * What is left is less than one step. GetAlpha gives it as a fraction
+ * of a step, for blending the last two simulation states when drawing.
+ * */
+class BGE_API FixedTimestep
+{
+    Nanoseconds StepSize;
+    Nanoseconds MaxFrameTime;
+    Nanoseconds Accumulator;
+
+    /* When BeginFrame was last called, and the frame time it measured */
+    Nanoseconds LastFrameStart;
+    Nanoseconds LastFrameTime;
+
+    long long NumFrames;
+    Nanoseconds MinFrameTime;
+    Nanoseconds MaxMeasuredFrameTime;
+    double FrameTimeMean;
+    double FrameTimeSquares;
+    double JitterSum;
+    long long NumSteps;
+    Nanoseconds DroppedTime;
+
+
+protected:
+
+    FixedTimestep();
+
+
+public:
+
+    ~FixedTimestep();
+
+    BGE_FACTORY FixedTimestep* Create(Seconds StepSize);
+
+    /* *
+     * Measures the time since the previous call and adds it to the
+     * accumulator. Returns the number of steps now due. The first
+     * call only starts the clock.
+     * */
+    int BeginFrame();
+
+    /* Like BeginFrame, but with a frame time supplied by the caller */
+    int Advance(Nanoseconds FrameTime);
+
+    /* Takes one step from the accumulator; false once none are left */
+    bool Step();
+
+    /* Fraction of a step left in the accumulator, from 0 up to 1 */
+    double GetAlpha() const;
+
+    Seconds GetStepSize() const;
+    Seconds GetLastFrameTime() const;
+
+    /* *
+     * When the next step falls due, on the GetRunningNanoseconds clock.
+     * Engines can pace frames with PreciseDelayUntil on it.
+     * */
+    Nanoseconds GetNextStepTime() const;
+
+    Result SetMaxFrameTime(Seconds MaxTime);
+
+    void GetJitterStats(FrameJitterStats* Stats) const;
+    void ResetJitterStats();
+
+}; /* FixedTimestep */
+
+} /* bakge */
+
+#endif /* BAKGE_SYSTEM_FIXEDTIMESTEP_H */
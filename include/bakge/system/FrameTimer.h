@@ -0,0 +1,206 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_SYSTEM_FRAMETIMER_H
+#define BAKGE_SYSTEM_FRAMETIMER_H
+
+#include <bakge/Bakge.h>
+
+/* Frames kept for percentiles; older frames roll out of the window */
+#define BGE_FRAME_HISTORY 256
+
+/* Frame rate engines pace to unless they choose another; 0 is unpaced */
+#define BGE_DEFAULT_FRAME_RATE 60
+
+/* A frame this many times the window's mean frame time is a hitch */
+#define BGE_DEFAULT_HITCH_FACTOR 2.0
+
+/* Frames the window needs before hitches are looked for */
+#define BGE_HITCH_MIN_FRAMES 16
+
+namespace bakge
+{
+
+/* Parts of a main loop iteration that are timed */
+enum FRAME_STAGES
+{
+    FRAME_STAGE_FRAME = 0, /* Start of one frame to the start of the next */
+    FRAME_STAGE_EVENTS,
+    FRAME_STAGE_NETWORK,
+    FRAME_STAGE_UPDATE,
+    FRAME_STAGE_PRE_RENDER,
+    FRAME_STAGE_RENDER,
+    FRAME_STAGE_POST_RENDER,
+    FRAME_STAGE_PACING, /* Waiting for the next frame to fall due */
+    NUM_FRAME_STAGES
+};
+
+
+/* Times over the frames in the window, in nanoseconds */
+struct FrameStageStats
+{
+    int NumSamples;
+    Nanoseconds Mean;
+    Nanoseconds P50;
+    Nanoseconds P95;
+    Nanoseconds P99;
+    Nanoseconds Max;
+};
+
+
+/* Lowercase, e.g. "update"; "unknown" if Stage is out of range */
+BGE_FUNC const char* GetFrameStageName(int Stage);
+
+/* Returns NUM_FRAME_STAGES if no stage has that name */
+BGE_FUNC int GetFrameStage(const char* Name);
+
+/* *
+ * Times each stage of every frame, keeping the last BGE_FRAME_HISTORY
+ * frames to take percentiles from, and counts hitches. It also paces
+ * the main loop: Pace sleeps until the next frame falls due at the
+ * target frame rate, using PreciseDelayUntil.
+ *
+ * A main loop calls BeginFrame first, wraps its stages with
+ * FrameStageScope and calls Pace last. Stages entered more than once
+ * in a frame are summed. Use it from the main loop's thread only.
+ * */
+class BGE_API FrameTimer
+{
+    /* Ring of per-frame stage times, oldest overwritten first */
+    Nanoseconds Samples[NUM_FRAME_STAGES][BGE_FRAME_HISTORY];
+    int NumSamples;
+    int NextSample;
+    Nanoseconds WindowFrameTime;
+
+    /* The frame in progress */
+    Nanoseconds FrameStart;
+    Nanoseconds StageStart[NUM_FRAME_STAGES];
+    Nanoseconds StageTime[NUM_FRAME_STAGES];
+
+    long long NumFrames;
+    double HitchFactor;
+    long long NumHitches;
+    long long LastHitchFrame;
+    Nanoseconds LastHitchTime;
+
+    /* Zero when unpaced */
+    Nanoseconds TargetPeriod;
+    Nanoseconds NextDeadline;
+
+
+protected:
+
+    FrameTimer();
+
+
+public:
+
+    ~FrameTimer();
+
+    BGE_FACTORY FrameTimer* Create();
+
+    /* Ends the previous frame, adding its times to the window */
+    void BeginFrame();
+
+    BGE_INL void BeginStage(int Stage)
+    {
+        StageStart[Stage] = GetRunningNanoseconds();
+    }
+
+    BGE_INL void EndStage(int Stage)
+    {
+        StageTime[Stage] += GetRunningNanoseconds() - StageStart[Stage];
+    }
+
+    /* *
+     * Waits until the current frame's deadline. A frame that overran
+     * its deadline isn't waited on, and later deadlines are counted
+     * from it instead of being rushed to catch up.
+     * */
+    void Pace();
+
+    /* Zero turns pacing off */
+    Result SetTargetFrameRate(double FramesPerSecond);
+    double GetTargetFrameRate() const;
+
+    Result SetHitchFactor(double Factor);
+
+    Result GetStageStats(int Stage, FrameStageStats* Stats) const;
+
+    BGE_INL long long GetNumFrames() const
+    {
+        return NumFrames;
+    }
+
+    BGE_INL long long GetNumHitches() const
+    {
+        return NumHitches;
+    }
+
+    /* Index and length of the most recent hitch; -1 and 0 if none */
+    BGE_INL long long GetLastHitchFrame() const
+    {
+        return LastHitchFrame;
+    }
+
+    BGE_INL Nanoseconds GetLastHitchTime() const
+    {
+        return LastHitchTime;
+    }
+
+    /* Prints percentiles for every stage and the hitch count */
+    void Report() const;
+
+    /* Empties the window and clears the hitch count */
+    void Reset();
+
+}; /* FrameTimer */
+
+
+/* Times a stage for the rest of the enclosing scope */
+class FrameStageScope
+{
+    FrameTimer* Timer;
+    int Stage;
+
+
+public:
+
+    BGE_INL FrameStageScope(FrameTimer* StageTimer, int TimedStage)
+    {
+        Timer = StageTimer;
+        Stage = TimedStage;
+        Timer->BeginStage(Stage);
+    }
+
+    BGE_INL ~FrameStageScope()
+    {
+        Timer->EndStage(Stage);
+    }
+
+}; /* FrameStageScope */
+
+} /* bakge */
+
+#endif /* BAKGE_SYSTEM_FRAMETIMER_H */
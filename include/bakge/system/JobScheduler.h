@@ -0,0 +1,171 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_SYSTEM_JOBSCHEDULER_H
+#define BAKGE_SYSTEM_JOBSCHEDULER_H
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+typedef void (*JobCallback)(void* Data);
+
+/* ParallelFor bodies handle indices from Begin up to, not including, End */
+typedef void (*RangeCallback)(int Begin, int End, void* Data);
+
+/* Defined in src/system/JobScheduler.cpp */
+struct ScheduledJob;
+struct JobWorker;
+struct JobSignal;
+
+/* *
+ * Counts unfinished jobs. A job run with a counter adds one to it when
+ * queued and takes one away when it finishes, so a counter reaching zero
+ * means all of its jobs are done. Jobs can also be held back until a
+ * counter reaches zero, which is how dependencies between jobs are made.
+ *
+ * A counter must outlive the jobs using it; Wait on it before it goes.
+ * */
+class BGE_API JobCounter
+{
+    friend class JobScheduler;
+
+    std::atomic<int> Count;
+
+    /* Jobs waiting for Count to reach zero, guarded by WaitingLock */
+    std::atomic_flag WaitingLock;
+    ScheduledJob* Waiting;
+
+
+public:
+
+    JobCounter();
+    ~JobCounter();
+
+    int GetCount() const;
+
+    /* True when no jobs using the counter remain */
+    bool IsDone() const;
+
+}; /* JobCounter */
+
+
+/* *
+ * Runs jobs on a fixed pool of worker threads, created once rather than
+ * per task.
+ *
+ * Each worker keeps its own queue of jobs. It takes jobs from the end it
+ * adds to, so work it splits off stays in its cache, and when it runs out
+ * it steals from the other end of another worker's queue. These queues
+ * are lock-free. Threads other than the workers, like the main thread,
+ * queue jobs through one shared, locked queue, and help run jobs while
+ * they Wait.
+ *
+ * Idle workers sleep until new jobs are queued.
+ * */
+class BGE_API JobScheduler
+{
+    JobWorker* Workers;
+    int NumWorkers;
+
+    /* Sleeping workers and the queue for other threads */
+    JobSignal* Signal;
+    std::atomic<bool> Stopping;
+    std::atomic<int> NumSleeping;
+    std::atomic<unsigned int> WorkEpoch;
+    std::atomic<int> NumInjected;
+
+    static int WorkerEntry(void* Data);
+
+    /* The calling thread's worker, or NULL if it isn't one of ours */
+    JobWorker* GetCurrentWorker() const;
+
+    ScheduledJob* AllocateJob();
+    void FreeJob(ScheduledJob* Job);
+
+    /* Queue a job that is ready to run */
+    void Queue(ScheduledJob* Job);
+    void WakeWorker();
+
+    ScheduledJob* FindJob(JobWorker* Self);
+    void Execute(ScheduledJob* Job);
+    void Finish(JobCounter* Counter);
+    void Sleep(unsigned int Epoch);
+
+    static void RunRange(void* Data);
+    void SplitRange(ScheduledJob* Range);
+
+
+protected:
+
+    JobScheduler();
+
+
+public:
+
+    /* Jobs still queued are not run; Wait for them first */
+    ~JobScheduler();
+
+    /* One worker per processor, less one for the calling thread */
+    BGE_FACTORY JobScheduler* Create();
+
+    /* *
+     * A specific number of workers. With none, jobs only run on threads
+     * that Wait.
+     * */
+    BGE_FACTORY JobScheduler* Create(int NumWorkers);
+
+    /* *
+     * Queue Entry(Data) to run on some worker. Counter, if not NULL,
+     * counts the job until it has finished. Safe to call from any thread.
+     * */
+    Result Run(JobCallback Entry, void* Data, JobCounter* Counter);
+
+    /* Like Run, but the job won't start until Dependency reaches zero */
+    Result RunAfter(JobCounter* Dependency, JobCallback Entry, void* Data,
+                                                    JobCounter* Counter);
+
+    /* Run queued jobs on this thread until Counter reaches zero */
+    void Wait(JobCounter* Counter);
+
+    /* *
+     * Call Body over the indices from Begin to End, split into ranges of
+     * at most Grain indices run across the workers and this thread.
+     * Returns once every index is done. A Grain of 0 or less picks one
+     * giving each thread a few ranges.
+     * */
+    void ParallelFor(int Begin, int End, int Grain, RangeCallback Body,
+                                                            void* Data);
+
+    int GetNumWorkers() const;
+
+    /* Index of the calling worker thread, or -1 for other threads */
+    int GetWorkerIndex() const;
+
+}; /* JobScheduler */
+
+} /* bakge */
+
+#endif /* BAKGE_SYSTEM_JOBSCHEDULER_H */
@@ -0,0 +1,75 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_SYSTEM_PRECISEDELAY_H
+#define BAKGE_SYSTEM_PRECISEDELAY_H
+
+#include <bakge/Bakge.h>
+
+/* Length of each coarse sleep PreciseDelay makes, in microseconds */
+#define BGE_DELAY_SLICE 1000
+
+/* Assumed length of a slice, in nanoseconds, until one is measured */
+#define BGE_DELAY_INITIAL_ESTIMATE 1250000
+
+namespace bakge
+{
+
+struct DelayStats
+{
+    /* Calls to PreciseDelay and PreciseDelayUntil */
+    long long NumDelays;
+
+    /* How late those calls returned */
+    Nanoseconds MeanOvershoot;
+    Nanoseconds MaxOvershoot;
+
+    /* Total time spent spinning at the end of delays */
+    Nanoseconds SpinTime;
+
+    /* Coarse sleeps made, and how far past BGE_DELAY_SLICE they ran */
+    long long NumSlices;
+    Nanoseconds MeanSliceOvershoot;
+    Nanoseconds MaxSliceOvershoot;
+};
+
+/* *
+ * Waits until Time has passed with much less overshoot than Delay.
+ * The wait sleeps in short slices while the time left exceeds what a
+ * slice has been measured to take on this thread, then spins for the
+ * rest. Accuracy is bought with processor time, so keep these for
+ * waits that need it, like frame pacing.
+ * */
+BGE_FUNC Result PreciseDelay(Nanoseconds Time);
+
+/* Waits until GetRunningNanoseconds reaches Deadline */
+BGE_FUNC Result PreciseDelayUntil(Nanoseconds Deadline);
+
+/* Statistics over every thread's precise delays since the last reset */
+BGE_FUNC void GetDelayStats(DelayStats* Stats);
+BGE_FUNC void ResetDelayStats();
+
+} /* bakge */
+
+#endif /* BAKGE_SYSTEM_PRECISEDELAY_H */
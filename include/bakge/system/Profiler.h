@@ -0,0 +1,136 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#ifndef BAKGE_SYSTEM_PROFILER_H
+#define BAKGE_SYSTEM_PROFILER_H
+
+#include <bakge/Bakge.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif /* _MSC_VER */
+
+/* Events each thread can record before new ones are dropped */
+#define BGE_PROFILE_EVENTS_PER_THREAD (64 * 1024)
+
+#define BGE_PROFILE_CONCAT_(A, B) A##B
+#define BGE_PROFILE_CONCAT(A, B) BGE_PROFILE_CONCAT_(A, B)
+
+/* *
+ * BGE_PROFILE_ZONE("Name") times the rest of the enclosing scope while
+ * profiling is on. Zones can nest. Names must be string literals or
+ * otherwise outlive the profile.
+ *
+ * Zones are compiled in when BGE_PROFILE is defined (the BAKGE_PROFILE
+ * CMake option). While profiling is off a zone costs one load and
+ * branch at each end.
+ * */
+#ifdef BGE_PROFILE
+#define BGE_PROFILE_ZONE(Name) \
+    bakge::ProfileZone BGE_PROFILE_CONCAT(ProfileZone, __LINE__)(Name)
+#else
+#define BGE_PROFILE_ZONE(Name)
+#endif /* BGE_PROFILE */
+
+#define BGE_PROFILE_FUNCTION() BGE_PROFILE_ZONE(__FUNCTION__)
+
+namespace bakge
+{
+
+/* Set while profiling; use StartProfiling and StopProfiling */
+BGE_FUNC std::atomic<bool> ProfilerRunning;
+
+/* *
+ * Profile timestamps in processor ticks where those are cheap to read,
+ * otherwise in nanoseconds. Exporting converts them to real time.
+ * */
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+BGE_INL long long ReadProfileClock()
+{
+    return (long long)__rdtsc();
+}
+#elif defined(__i386__) || defined(__x86_64__)
+BGE_INL long long ReadProfileClock()
+{
+    return (long long)__builtin_ia32_rdtsc();
+}
+#else
+BGE_FUNC long long ReadProfileClock();
+#endif /* _MSC_VER */
+
+BGE_INL bool IsProfiling()
+{
+    return ProfilerRunning.load(std::memory_order_relaxed);
+}
+
+/* Adds a finished zone to the calling thread's event buffer */
+BGE_FUNC void RecordProfileZone(const char* Name, long long Start,
+                                                    long long End);
+
+/* *
+ * Starting clears events from any earlier profile. Clear, report or
+ * export only while profiling is stopped.
+ * */
+BGE_FUNC void StartProfiling();
+BGE_FUNC void StopProfiling();
+BGE_FUNC void ClearProfile();
+
+/* Names the calling thread in exported traces; Name is copied */
+BGE_FUNC void SetProfileThreadName(const char* Name);
+
+/* Prints calls, total and self time for every zone name */
+BGE_FUNC void ReportProfile();
+
+/* Writes the profile as JSON for chrome://tracing or Perfetto */
+BGE_FUNC Result WriteChromeTrace(const char* Path);
+
+
+class ProfileZone
+{
+    const char* Name;
+    long long Start;
+
+
+public:
+
+    BGE_INL ProfileZone(const char* ZoneName)
+    {
+        Name = NULL;
+        if(IsProfiling()) {
+            Name = ZoneName;
+            Start = ReadProfileClock();
+        }
+    }
+
+    BGE_INL ~ProfileZone()
+    {
+        if(Name != NULL)
+            RecordProfileZone(Name, Start, ReadProfileClock());
+    }
+
+}; /* ProfileZone */
+
+} /* bakge */
+
+#endif /* BAKGE_SYSTEM_PROFILER_H */
@@ -23,14 +23,28 @@
  * */
 
 #include <bakge/Bakge.h>
+#include <chrono>
 
 namespace bakge
 {
 namespace api
 {
 
+#ifdef _DEBUG
+static uint64_t LockClock()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif /* _DEBUG */
+
+
 Mutex::Mutex()
 {
+#ifdef _DEBUG
+    ResetStats();
+    HoldStart = 0;
+#endif /* _DEBUG */
 }
 
 
@@ -38,5 +52,75 @@ Mutex::~Mutex()
 {
 }
 
+
+#ifdef _DEBUG
+void Mutex::Acquired(bool Contended)
+{
+    AcquiredShared(Contended);
+    HoldStart = LockClock();
+}
+
+
+void Mutex::AcquiredShared(bool Contended)
+{
+    NumAcquired.fetch_add(1, std::memory_order_relaxed);
+    if(Contended)
+        NumContended.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void Mutex::Releasing()
+{
+    uint64_t Held = LockClock() - HoldStart;
+
+    /* Only the holder updates these, so there's no race between threads */
+    HoldTime.fetch_add(Held, std::memory_order_relaxed);
+    if(Held > MaxHoldTime.load(std::memory_order_relaxed))
+        MaxHoldTime.store(Held, std::memory_order_relaxed);
+}
+
+
+LockStats Mutex::GetStats() const
+{
+    LockStats Stats;
+
+    Stats.NumAcquired = NumAcquired.load(std::memory_order_relaxed);
+    Stats.NumContended = NumContended.load(std::memory_order_relaxed);
+    Stats.HoldTime = HoldTime.load(std::memory_order_relaxed);
+    Stats.MaxHoldTime = MaxHoldTime.load(std::memory_order_relaxed);
+
+    return Stats;
+}
+
+
+void Mutex::ResetStats()
+{
+    NumAcquired.store(0);
+    NumContended.store(0);
+    HoldTime.store(0);
+    MaxHoldTime.store(0);
+}
+#endif /* _DEBUG */
+
+
+ReaderWriterLock::ReaderWriterLock()
+{
+}
+
+
+ReaderWriterLock::~ReaderWriterLock()
+{
+}
+
+
+ConditionVariable::ConditionVariable()
+{
+}
+
+
+ConditionVariable::~ConditionVariable()
+{
+}
+
 } /* api */
 } /* bakge */
@@ -0,0 +1,175 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+struct ReactorEntry
+{
+    /* NULL once removed */
+    api::Socket* Sock;
+    int Events;
+    SocketEventCallback Callback;
+    void* UserData;
+
+    ReactorEntry* NextRetired;
+};
+
+namespace api
+{
+
+Reactor::Reactor()
+{
+    Retired = NULL;
+    Dispatching = false;
+}
+
+
+Reactor::~Reactor()
+{
+    for(int Slot = Entries.GetFirst(); Slot >= 0;
+                                Slot = Entries.GetNext(Slot))
+        delete Entries.GetValue(Slot);
+}
+
+
+Result Reactor::Add(Socket* Sock, int Events, SocketEventCallback Callback,
+                                                            void* UserData)
+{
+    ReactorEntry* Entry;
+
+    if(Sock == NULL || Entries.Contains(Sock)) {
+        printf("Socket is NULL or already added to the reactor\n");
+        return BGE_FAILURE;
+    }
+
+    Entry = new ReactorEntry;
+    if(Entry == NULL) {
+        printf("Unable to allocate memory for reactor entry\n");
+        return BGE_FAILURE;
+    }
+
+    Entry->Sock = Sock;
+    Entry->Events = Events;
+    Entry->Callback = Callback;
+    Entry->UserData = UserData;
+    Entry->NextRetired = NULL;
+
+    if(Watch(Sock->GetHandle(), Events, (void*)Entry) != BGE_SUCCESS) {
+        delete Entry;
+        return BGE_FAILURE;
+    }
+
+    Entries.Insert(Sock, Entry);
+
+    return BGE_SUCCESS;
+}
+
+
+Result Reactor::Modify(Socket* Sock, int Events)
+{
+    ReactorEntry** Entry = Entries.Find(Sock);
+
+    if(Entry == NULL)
+        return BGE_FAILURE;
+
+    if(Rewatch(Sock->GetHandle(), Events, (void*)*Entry) != BGE_SUCCESS)
+        return BGE_FAILURE;
+
+    (*Entry)->Events = Events;
+
+    return BGE_SUCCESS;
+}
+
+
+Result Reactor::Remove(Socket* Sock)
+{
+    ReactorEntry** Found = Entries.Find(Sock);
+    ReactorEntry* Entry;
+
+    if(Found == NULL)
+        return BGE_FAILURE;
+
+    Entry = *Found;
+    Entries.Remove(Sock);
+    Unwatch(Sock->GetHandle());
+
+    /* Poll may still be holding the entry in its list of ready sockets */
+    if(Dispatching) {
+        Entry->Sock = NULL;
+        Entry->NextRetired = Retired;
+        Retired = Entry;
+    } else {
+        delete Entry;
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+int Reactor::Poll(SocketEvent* Events, int MaxEvents, Seconds Timeout)
+{
+    void* Keys[BGE_REACTOR_BATCH];
+    int Ready[BGE_REACTOR_BATCH];
+    ReactorEntry* Entry;
+    int NumReady;
+    int NumReported;
+
+    NumReady = Wait(Keys, Ready, BGE_REACTOR_BATCH, Timeout);
+    if(NumReady < 0)
+        return -1;
+
+    NumReported = 0;
+    Dispatching = true;
+
+    for(int i = 0; i < NumReady; ++i) {
+        Entry = (ReactorEntry*)Keys[i];
+        if(Entry->Sock == NULL)
+            continue;
+
+        if(Entry->Callback != NULL) {
+            Entry->Callback(Entry->Sock, Ready[i], Entry->UserData);
+        } else if(Events != NULL && NumReported < MaxEvents) {
+            Events[NumReported].Sock = Entry->Sock;
+            Events[NumReported].Events = Ready[i];
+            Events[NumReported].UserData = Entry->UserData;
+            ++NumReported;
+        }
+    }
+
+    Dispatching = false;
+
+    while(Retired != NULL) {
+        Entry = Retired;
+        Retired = Retired->NextRetired;
+        delete Entry;
+    }
+
+    return NumReported;
+}
+
+} /* api */
+} /* bakge */
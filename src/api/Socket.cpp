@@ -31,6 +31,7 @@ namespace api
 
 Socket::Socket()
 {
+    Blocking = true;
 }
 
 
@@ -38,5 +39,35 @@ Socket::~Socket()
 {
 }
 
+
+int Socket::ReceiveMany(Packet** Packets, int MaxPackets)
+{
+    if(Packets == NULL || MaxPackets < 1)
+        return -1;
+
+    Packets[0] = Receive();
+    if(Packets[0] == NULL)
+        return Blocking ? -1 : 0;
+
+    return 1;
+}
+
+
+int Socket::SendMany(Remote* Destinations, Packet** Packets,
+                                                    int NumPackets)
+{
+    int Sent;
+
+    if(Destinations == NULL || Packets == NULL)
+        return -1;
+
+    for(Sent = 0; Sent < NumPackets; ++Sent) {
+        if(Send(&Destinations[Sent], Packets[Sent]) != BGE_SUCCESS)
+            break;
+    }
+
+    return Sent;
+}
+
 } /* api */
 } /* bakge */
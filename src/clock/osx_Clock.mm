@@ -29,14 +29,18 @@ namespace bakge
 
 Result Delay(Microseconds BGE_NCP Time)
 {
-    NSTimeInterval DelayTime;
+    timespec Remaining;
 
-    DelayTime = Time / 1000000;
-    DelayTime += 0.000001 * (Time % 1000000);
+    Remaining.tv_sec = Time / 1000000;
+    Remaining.tv_nsec = (Time % 1000000) * 1000;
 
-    [NSThread sleepForTimeInterval: DelayTime];
+    /* Resume with what's left if a signal interrupts the sleep */
+    while(nanosleep(&Remaining, &Remaining) != 0) {
+        if(errno != EINTR)
+            return BGE_FAILURE;
+    }
 
-    return BGE_FAILURE;
+    return BGE_SUCCESS;
 }
 
 
@@ -53,4 +57,19 @@ Microseconds GetRunningTime()
     return NowSec * 1000000;
 }
 
+
+Nanoseconds GetRunningNanoseconds()
+{
+    /* Defined in src/utility/osx_Utility.mm */
+    extern uint64_t StartMachTime;
+    extern mach_timebase_info_data_t Timebase;
+    uint64_t Ticks;
+
+    Ticks = mach_absolute_time() - StartMachTime;
+
+    /* Split the conversion so ticks * numer can't overflow */
+    return (Nanoseconds)((Ticks / Timebase.denom) * Timebase.numer
+                   + (Ticks % Timebase.denom) * Timebase.numer / Timebase.denom);
+}
+
 } /* bakge */
@@ -31,6 +31,10 @@ Result Delay(Microseconds BGE_NCP Time)
 {
     Microseconds End = Time + GetRunningTime();
 
+    /* Sleep for the whole milliseconds, then spin for the remainder */
+    if(Time >= 1000)
+        Sleep((DWORD)(Time / 1000));
+
     while(GetRunningTime() < End)
         ;
 
@@ -63,4 +67,27 @@ Microseconds GetRunningTime()
           - (Microseconds)(1000000 * StartCount.QuadPart / ClockFreq.QuadPart);
 }
 
+
+Nanoseconds GetRunningNanoseconds()
+{
+    /* Defined in src/utility/win32_Utility.cpp */
+    extern LARGE_INTEGER ClockFreq;
+    extern LARGE_INTEGER StartCount;
+    LARGE_INTEGER TickCount;
+    long long Ticks;
+
+    /* *
+     * Processors with an invariant TSC keep the performance counter in
+     * sync across cores, so this skips the affinity dance that
+     * GetRunningTime does; it would cost more than the read itself.
+     * */
+    QueryPerformanceCounter(&TickCount);
+
+    /* Split the conversion so ticks * 10^9 can't overflow */
+    Ticks = TickCount.QuadPart - StartCount.QuadPart;
+
+    return (Ticks / ClockFreq.QuadPart) * 1000000000
+         + (Ticks % ClockFreq.QuadPart) * 1000000000 / ClockFreq.QuadPart;
+}
+
 } /* bakge */
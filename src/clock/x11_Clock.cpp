@@ -29,26 +29,18 @@ namespace bakge
 
 Result Delay(Microseconds BGE_NCP Time)
 {
-    pthread_mutex_t WaitLock;
-    timespec Delay;
-    timeval Now;
+    timespec Remaining;
+    int Error;
 
-    if(pthread_mutex_init(&WaitLock, NULL) < 0) {
-        return BGE_FAILURE;
-    }
-
-    /* Implementation inspired by SFML */
-    gettimeofday(&Now, NULL);
+    Remaining.tv_sec = Time / 1000000;
+    Remaining.tv_nsec = (Time % 1000000) * 1000;
 
-    Delay.tv_nsec = (Now.tv_usec + (Time % 1000000)) * 1000;
-    Delay.tv_sec = Now.tv_sec + (Time / 1000000)
-                   + (Delay.tv_nsec / 1000000000L);
-    Delay.tv_nsec %= 1000000000L;
-
-    pthread_mutex_lock(&WaitLock);
-    pthread_mutex_timedlock(&WaitLock, &Delay);
-    pthread_mutex_unlock(&WaitLock);
-    pthread_mutex_destroy(&WaitLock);
+    /* Relative monotonic sleep; resume with what's left if interrupted */
+    while((Error = clock_nanosleep(CLOCK_MONOTONIC, 0, &Remaining,
+                                                    &Remaining)) != 0) {
+        if(Error != EINTR)
+            return BGE_FAILURE;
+    }
 
     return BGE_SUCCESS;
 }
@@ -66,4 +58,16 @@ Microseconds GetRunningTime()
              + ((Time.tv_nsec - StartTime.tv_nsec) / 1000);
 }
 
+
+Nanoseconds GetRunningNanoseconds()
+{
+    extern timespec StartTime; /* Defined in src/utility/x11_Utility.cpp */
+    timespec Time;
+
+    clock_gettime(CLOCK_MONOTONIC, &Time);
+
+    return ((Nanoseconds)(Time.tv_sec - StartTime.tv_sec) * 1000000000)
+             + (Time.tv_nsec - StartTime.tv_nsec);
+}
+
 } /* bakge */
@@ -36,4 +36,10 @@ Drawable::~Drawable()
 {
 }
 
+
+BoundingBox Drawable::GetBoundingBox() const
+{
+    return BoundingBox();
+}
+
 } /* bakge */
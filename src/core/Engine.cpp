@@ -29,11 +29,61 @@ namespace bakge
 
 Engine::Engine()
 {
+    FrameArena = LinearArena::Create(BGE_FRAME_ARENA_SIZE);
+    CrossFrameArena = DoubleBufferedArena::Create(BGE_CROSS_FRAME_ARENA_SIZE);
+    Timestep = FixedTimestep::Create(BGE_DEFAULT_TIMESTEP);
+
+    Timer = FrameTimer::Create();
+    if(Timer != NULL)
+        Timer->SetTargetFrameRate(BGE_DEFAULT_FRAME_RATE);
+
+    Network = Reactor::Create();
 }
 
 
 Engine::~Engine()
 {
+    if(FrameArena != NULL)
+        delete FrameArena;
+
+    if(CrossFrameArena != NULL)
+        delete CrossFrameArena;
+
+    if(Timestep != NULL)
+        delete Timestep;
+
+    if(Timer != NULL)
+        delete Timer;
+
+    if(Network != NULL)
+        delete Network;
+}
+
+
+Result Engine::ServiceNetwork()
+{
+    if(Network == NULL)
+        return BGE_FAILURE;
+
+    if(Network->Poll(NULL, 0, 0) < 0)
+        return BGE_FAILURE;
+
+    return BGE_SUCCESS;
+}
+
+
+Result Engine::EndFrame()
+{
+    if(FrameArena == NULL || CrossFrameArena == NULL)
+        return BGE_FAILURE;
+
+    FrameArena->Reset();
+    CrossFrameArena->Swap();
+
+    if(Timer != NULL)
+        Timer->Pace();
+
+    return BGE_SUCCESS;
 }
 
 } /* bakge */
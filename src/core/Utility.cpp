@@ -91,6 +91,13 @@ Result Deinit()
 
     glfwTerminate();
 
+    /* Anything still allocated from a pool now was leaked */
+    BlockPool::ReportLeaks();
+
+#ifdef BGE_TRACK_MEMORY
+    ReportMemory();
+#endif /* BGE_TRACK_MEMORY */
+
     return BGE_SUCCESS;
 }
 
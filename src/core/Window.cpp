@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Window, false, MEMORY_TAG_GRAPHICS)
+
+
 GLFWwindow* Window::SharedContext = NULL;
 
 void Window::Moved(GLFWwindow* Handle,  int X, int Y)
@@ -254,6 +257,8 @@ bool Window::IsActive()
 
 void Window::PollEvents()
 {
+    BGE_PROFILE_ZONE("Window::PollEvents");
+
     glfwPollEvents();
 }
 
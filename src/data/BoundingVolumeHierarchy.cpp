@@ -0,0 +1,1034 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+/* *
+ * Centroid bins per axis when searching for the cheapest split. Ranges
+ * with fewer objects use one bin per object
+ * */
+#define BVH_BUILD_BINS 16
+
+/* *
+ * Below this depth Build splits ranges in half rather than by cost,
+ * which bounds the tree's height and so the query stacks below
+ * */
+#define BVH_MAX_BUILD_DEPTH 64
+
+#define BVH_STACK_SIZE 256
+
+namespace bakge
+{
+
+/* *
+ * Unlike fminf and fmaxf these don't handle NaN, which lets them compile
+ * to single instructions rather than library calls
+ * */
+static BGE_INL Scalar ScalarMin(Scalar A, Scalar B)
+{
+    return A < B ? A : B;
+}
+
+
+static BGE_INL Scalar ScalarMax(Scalar A, Scalar B)
+{
+    return A > B ? A : B;
+}
+
+
+static BGE_INL BoundingBox Union(BoundingBox BGE_NCP A, BoundingBox BGE_NCP B)
+{
+    Vector4 BGE_NCP AMin = A.GetMin();
+    Vector4 BGE_NCP AMax = A.GetMax();
+    Vector4 BGE_NCP BMin = B.GetMin();
+    Vector4 BGE_NCP BMax = B.GetMax();
+
+    return BoundingBox(Vector4(ScalarMin(AMin[0], BMin[0]),
+                            ScalarMin(AMin[1], BMin[1]),
+                            ScalarMin(AMin[2], BMin[2]), 1),
+                        Vector4(ScalarMax(AMax[0], BMax[0]),
+                            ScalarMax(AMax[1], BMax[1]),
+                            ScalarMax(AMax[2], BMax[2]), 1));
+}
+
+
+static BGE_INL Scalar SurfaceArea(BoundingBox BGE_NCP Box)
+{
+    Vector4 BGE_NCP Min = Box.GetMin();
+    Vector4 BGE_NCP Max = Box.GetMax();
+    Scalar X = Max[0] - Min[0];
+    Scalar Y = Max[1] - Min[1];
+    Scalar Z = Max[2] - Min[2];
+
+    if(X < 0 || Y < 0 || Z < 0)
+        return 0;
+
+    return 2 * (X * Y + Y * Z + Z * X);
+}
+
+
+static BGE_INL bool Overlaps(BoundingBox BGE_NCP A, BoundingBox BGE_NCP B)
+{
+    Vector4 BGE_NCP AMin = A.GetMin();
+    Vector4 BGE_NCP AMax = A.GetMax();
+    Vector4 BGE_NCP BMin = B.GetMin();
+    Vector4 BGE_NCP BMax = B.GetMax();
+
+    return AMin[0] <= BMax[0] && AMax[0] >= BMin[0]
+        && AMin[1] <= BMax[1] && AMax[1] >= BMin[1]
+        && AMin[2] <= BMax[2] && AMax[2] >= BMin[2];
+}
+
+
+static BGE_INL bool Encloses(BoundingBox BGE_NCP Outer,
+                                BoundingBox BGE_NCP Inner)
+{
+    Vector4 BGE_NCP OMin = Outer.GetMin();
+    Vector4 BGE_NCP OMax = Outer.GetMax();
+    Vector4 BGE_NCP IMin = Inner.GetMin();
+    Vector4 BGE_NCP IMax = Inner.GetMax();
+
+    return OMin[0] <= IMin[0] && OMin[1] <= IMin[1] && OMin[2] <= IMin[2]
+        && OMax[0] >= IMax[0] && OMax[1] >= IMax[1] && OMax[2] >= IMax[2];
+}
+
+
+static BGE_INL BoundingBox Grow(BoundingBox BGE_NCP Box, Scalar Margin)
+{
+    Vector4 M(Margin, Margin, Margin, 0);
+
+    return BoundingBox(Box.GetMin() - M, Box.GetMax() + M);
+}
+
+
+/* *
+ * Slab test. Entry receives where the ray enters the box, clamped to
+ * 0 when it starts inside
+ * */
+static BGE_INL bool RayHits(const Scalar* Origin, const Scalar* InvDir,
+            BoundingBox BGE_NCP Box, Scalar MaxDistance, Scalar* Entry)
+{
+    Vector4 BGE_NCP Min = Box.GetMin();
+    Vector4 BGE_NCP Max = Box.GetMax();
+    Scalar TMin = 0;
+    Scalar TMax = MaxDistance;
+
+    for(int i = 0; i < 3; ++i) {
+        Scalar T1 = (Min[i] - Origin[i]) * InvDir[i];
+        Scalar T2 = (Max[i] - Origin[i]) * InvDir[i];
+
+        TMin = ScalarMax(TMin, ScalarMin(T1, T2));
+        TMax = ScalarMin(TMax, ScalarMax(T1, T2));
+    }
+
+    *Entry = TMin;
+
+    return TMin <= TMax;
+}
+
+
+enum FRUSTUM_OVERLAP
+{
+    FRUSTUM_OUTSIDE = 0,
+    FRUSTUM_CROSSING,
+    FRUSTUM_INSIDE
+};
+
+
+static FRUSTUM_OVERLAP Classify(Frustum BGE_NCP View, BoundingBox BGE_NCP Box)
+{
+    Vector4 Center = Box.GetCenter();
+    Vector4 Extents = Box.GetExtents();
+    FRUSTUM_OVERLAP Overlap = FRUSTUM_INSIDE;
+
+    for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        Vector4 BGE_NCP P = View.GetPlane((FRUSTUM_PLANES)i);
+        Scalar Dist = P[0] * Center[0] + P[1] * Center[1]
+                    + P[2] * Center[2] + P[3];
+        Scalar Reach = fabsf(P[0]) * Extents[0] + fabsf(P[1]) * Extents[1]
+                     + fabsf(P[2]) * Extents[2];
+
+        if(Dist + Reach < 0)
+            return FRUSTUM_OUTSIDE;
+
+        if(Dist - Reach < 0)
+            Overlap = FRUSTUM_CROSSING;
+    }
+
+    return Overlap;
+}
+
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+{
+    Nodes = NULL;
+    Capacity = 0;
+    FreeList = -1;
+    Root = -1;
+    NumObjects = 0;
+    Margin = 0;
+}
+
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy()
+{
+    if(Nodes != NULL)
+        free(Nodes);
+}
+
+
+BoundingVolumeHierarchy* BoundingVolumeHierarchy::Create()
+{
+    return new BoundingVolumeHierarchy;
+}
+
+
+Result BoundingVolumeHierarchy::Reserve(int NumNodes)
+{
+    TreeNode* NewNodes;
+
+    if(NumNodes <= Capacity)
+        return BGE_SUCCESS;
+
+    NewNodes = (TreeNode*)realloc(Nodes, sizeof(TreeNode) * NumNodes);
+    if(NewNodes == NULL) {
+        printf("Error allocating bounding volume hierarchy nodes\n");
+        return BGE_FAILURE;
+    }
+
+    Nodes = NewNodes;
+
+    /* Link the new nodes in ahead of the free list, in increasing order */
+    for(int i = Capacity; i < NumNodes; ++i) {
+        Nodes[i].Parent = i + 1 < NumNodes ? i + 1 : FreeList;
+        Nodes[i].Height = -1;
+    }
+
+    FreeList = Capacity;
+    Capacity = NumNodes;
+
+    return BGE_SUCCESS;
+}
+
+
+int BoundingVolumeHierarchy::AllocateNode()
+{
+    int Index;
+
+    if(FreeList == -1) {
+        if(Reserve(Capacity > 0 ? Capacity * 2 : 16) != BGE_SUCCESS)
+            return -1;
+    }
+
+    Index = FreeList;
+    FreeList = Nodes[Index].Parent;
+
+    Nodes[Index].Data = NULL;
+    Nodes[Index].Parent = -1;
+    Nodes[Index].Left = -1;
+    Nodes[Index].Right = -1;
+    Nodes[Index].Height = 0;
+
+    return Index;
+}
+
+
+void BoundingVolumeHierarchy::FreeNode(int Index)
+{
+    Nodes[Index].Parent = FreeList;
+    Nodes[Index].Height = -1;
+    FreeList = Index;
+}
+
+
+void BoundingVolumeHierarchy::Clear()
+{
+    Root = -1;
+    NumObjects = 0;
+    FreeList = Capacity > 0 ? 0 : -1;
+
+    for(int i = 0; i < Capacity; ++i) {
+        Nodes[i].Parent = i + 1 < Capacity ? i + 1 : -1;
+        Nodes[i].Height = -1;
+    }
+}
+
+
+Result BoundingVolumeHierarchy::Build(const BoundingBox* Boxes,
+                        void* const* Data, int Num, int* Handles)
+{
+    int* Indices;
+    Scalar* Centroids;
+
+    if(Num > 0 && Reserve(Num * 2 - 1) != BGE_SUCCESS)
+        return BGE_FAILURE;
+
+    /* After Clear nodes are allocated in order from 0 */
+    Clear();
+
+    if(Num <= 0)
+        return BGE_SUCCESS;
+
+    Indices = new int[Num];
+    Centroids = new Scalar[Num * 3];
+
+    for(int i = 0; i < Num; ++i) {
+        Vector4 Center = Boxes[i].GetCenter();
+
+        Indices[i] = i;
+        Centroids[i * 3] = Center[0];
+        Centroids[i * 3 + 1] = Center[1];
+        Centroids[i * 3 + 2] = Center[2];
+    }
+
+    Root = BuildRange(Indices, Boxes, Centroids, 0, Num, 0);
+    Nodes[Root].Parent = -1;
+    NumObjects = Num;
+
+    /* BuildRange leaves each leaf's object index in its Left link */
+    for(int i = 0; i < Num * 2 - 1; ++i) {
+        if(Nodes[i].Height != 0)
+            continue;
+
+        int Object = Nodes[i].Left;
+
+        Nodes[i].Left = -1;
+        Nodes[i].Data = Data != NULL ? Data[Object] : NULL;
+
+        if(Handles != NULL)
+            Handles[Object] = i;
+    }
+
+    delete[] Indices;
+    delete[] Centroids;
+
+    return BGE_SUCCESS;
+}
+
+
+int BoundingVolumeHierarchy::BuildRange(int* Indices,
+            const BoundingBox* Boxes, const Scalar* Centroids, int Begin,
+                                                    int End, int Depth)
+{
+    /* Build reserves every node up front, so this can't fail */
+    int Index = AllocateNode();
+    int Mid = (Begin + End) / 2;
+    int Left, Right;
+    Scalar CMin[3], CMax[3];
+    Scalar BestCost = FLT_MAX;
+    int BestAxis = -1, BestBin = 0;
+    int NumBins = End - Begin < BVH_BUILD_BINS ? End - Begin : BVH_BUILD_BINS;
+
+    if(End - Begin == 1) {
+        Nodes[Index].Box = Grow(Boxes[Indices[Begin]], Margin);
+        Nodes[Index].Left = Indices[Begin];
+        return Index;
+    }
+
+    for(int a = 0; a < 3; ++a) {
+        CMin[a] = FLT_MAX;
+        CMax[a] = -FLT_MAX;
+    }
+
+    for(int i = Begin; i < End; ++i) {
+        const Scalar* C = &Centroids[Indices[i] * 3];
+
+        for(int a = 0; a < 3; ++a) {
+            CMin[a] = ScalarMin(CMin[a], C[a]);
+            CMax[a] = ScalarMax(CMax[a], C[a]);
+        }
+    }
+
+    /* *
+     * Surface area heuristic: bin the centroids along each axis and pick
+     * the bin boundary minimizing the area-weighted object counts of the
+     * two halves
+     * */
+    for(int a = 0; a < 3 && Depth < BVH_MAX_BUILD_DEPTH; ++a) {
+        BoundingBox BinBoxes[BVH_BUILD_BINS];
+        int BinCounts[BVH_BUILD_BINS];
+        Scalar LeftAreas[BVH_BUILD_BINS];
+        int LeftCounts[BVH_BUILD_BINS];
+        BoundingBox Sweep;
+        int Count = 0;
+        Scalar Extent = CMax[a] - CMin[a];
+        Scalar Scale;
+
+        if(Extent <= 0)
+            continue;
+
+        Scale = NumBins * 0.9999f / Extent;
+
+        for(int b = 0; b < NumBins; ++b) {
+            BinBoxes[b] = BoundingBox();
+            BinCounts[b] = 0;
+        }
+
+        for(int i = Begin; i < End; ++i) {
+            int Object = Indices[i];
+            int Bin = (int)((Centroids[Object * 3 + a] - CMin[a]) * Scale);
+
+            BinBoxes[Bin] = Union(BinBoxes[Bin], Boxes[Object]);
+            ++BinCounts[Bin];
+        }
+
+        for(int b = 0; b < NumBins - 1; ++b) {
+            Sweep = Union(Sweep, BinBoxes[b]);
+            Count += BinCounts[b];
+            LeftAreas[b] = SurfaceArea(Sweep);
+            LeftCounts[b] = Count;
+        }
+
+        Sweep = BoundingBox();
+        Count = 0;
+
+        for(int b = NumBins - 1; b > 0; --b) {
+            Scalar Cost;
+
+            Sweep = Union(Sweep, BinBoxes[b]);
+            Count += BinCounts[b];
+
+            if(LeftCounts[b - 1] == 0 || Count == 0)
+                continue;
+
+            Cost = LeftAreas[b - 1] * LeftCounts[b - 1]
+                    + SurfaceArea(Sweep) * Count;
+
+            if(Cost < BestCost) {
+                BestCost = Cost;
+                BestAxis = a;
+                BestBin = b;
+            }
+        }
+    }
+
+    /* Partition by the chosen boundary, or fall back to halving */
+    if(BestAxis >= 0) {
+        Scalar Scale = NumBins * 0.9999f
+                        / (CMax[BestAxis] - CMin[BestAxis]);
+        int i = Begin, j = End - 1;
+
+        while(i <= j) {
+            Scalar C = Centroids[Indices[i] * 3 + BestAxis];
+
+            if((int)((C - CMin[BestAxis]) * Scale) < BestBin) {
+                ++i;
+            } else {
+                int Swap = Indices[i];
+                Indices[i] = Indices[j];
+                Indices[j--] = Swap;
+            }
+        }
+
+        if(i > Begin && i < End)
+            Mid = i;
+    }
+
+    Left = BuildRange(Indices, Boxes, Centroids, Begin, Mid, Depth + 1);
+    Right = BuildRange(Indices, Boxes, Centroids, Mid, End, Depth + 1);
+
+    Nodes[Left].Parent = Index;
+    Nodes[Right].Parent = Index;
+    Nodes[Index].Left = Left;
+    Nodes[Index].Right = Right;
+    Nodes[Index].Box = Union(Nodes[Left].Box, Nodes[Right].Box);
+    Nodes[Index].Height = 1 + (Nodes[Left].Height > Nodes[Right].Height ?
+                            Nodes[Left].Height : Nodes[Right].Height);
+
+    return Index;
+}
+
+
+int BoundingVolumeHierarchy::Insert(BoundingBox BGE_NCP Box, void* Data)
+{
+    int Leaf = AllocateNode();
+
+    if(Leaf < 0)
+        return -1;
+
+    Nodes[Leaf].Box = Grow(Box, Margin);
+    Nodes[Leaf].Data = Data;
+
+    /* Joining the tree takes a second node, for the leaf's new parent */
+    if(InsertLeaf(Leaf) != BGE_SUCCESS) {
+        FreeNode(Leaf);
+        return -1;
+    }
+
+    ++NumObjects;
+
+    return Leaf;
+}
+
+
+Result BoundingVolumeHierarchy::Remove(int Handle)
+{
+    if(Handle < 0 || Handle >= Capacity || Nodes[Handle].Height != 0) {
+        printf("Invalid bounding volume hierarchy handle %d\n", Handle);
+        return BGE_FAILURE;
+    }
+
+    RemoveLeaf(Handle);
+    FreeNode(Handle);
+    --NumObjects;
+
+    return BGE_SUCCESS;
+}
+
+
+bool BoundingVolumeHierarchy::Update(int Handle, BoundingBox BGE_NCP Box)
+{
+    if(Handle < 0 || Handle >= Capacity || Nodes[Handle].Height != 0) {
+        printf("Invalid bounding volume hierarchy handle %d\n", Handle);
+        return false;
+    }
+
+    if(Encloses(Nodes[Handle].Box, Box))
+        return false;
+
+    /* *
+     * Can't fail: RemoveLeaf frees the parent node InsertLeaf needs, or
+     * the leaf was the only node and becomes the root again
+     * */
+    RemoveLeaf(Handle);
+    Nodes[Handle].Box = Grow(Box, Margin);
+    InsertLeaf(Handle);
+
+    return true;
+}
+
+
+Result BoundingVolumeHierarchy::InsertLeaf(int Leaf)
+{
+    BoundingBox LeafBox = Nodes[Leaf].Box;
+    int Sibling, OldParent, NewParent, Index;
+
+    if(Root == -1) {
+        Root = Leaf;
+        Nodes[Root].Parent = -1;
+        return BGE_SUCCESS;
+    }
+
+    /* *
+     * Walk down to the sibling that adds the least surface area. Joining
+     * a node costs the area of the new parent, plus the growth of every
+     * ancestor above it
+     * */
+    Sibling = Root;
+    while(Nodes[Sibling].Height > 0) {
+        int Left = Nodes[Sibling].Left;
+        int Right = Nodes[Sibling].Right;
+        Scalar Area = SurfaceArea(Nodes[Sibling].Box);
+        Scalar CombinedArea = SurfaceArea(Union(Nodes[Sibling].Box, LeafBox));
+        Scalar Cost = 2 * CombinedArea;
+        Scalar Inherited = 2 * (CombinedArea - Area);
+        Scalar LeftCost, RightCost;
+
+        LeftCost = SurfaceArea(Union(Nodes[Left].Box, LeafBox)) + Inherited;
+        if(Nodes[Left].Height > 0)
+            LeftCost -= SurfaceArea(Nodes[Left].Box);
+
+        RightCost = SurfaceArea(Union(Nodes[Right].Box, LeafBox)) + Inherited;
+        if(Nodes[Right].Height > 0)
+            RightCost -= SurfaceArea(Nodes[Right].Box);
+
+        if(Cost < LeftCost && Cost < RightCost)
+            break;
+
+        Sibling = LeftCost < RightCost ? Left : Right;
+    }
+
+    /* AllocateNode can move Nodes, so no pointers into it are held here */
+    OldParent = Nodes[Sibling].Parent;
+    NewParent = AllocateNode();
+    if(NewParent < 0)
+        return BGE_FAILURE;
+
+    Nodes[NewParent].Parent = OldParent;
+    Nodes[NewParent].Box = Union(LeafBox, Nodes[Sibling].Box);
+    Nodes[NewParent].Height = Nodes[Sibling].Height + 1;
+    Nodes[NewParent].Left = Sibling;
+    Nodes[NewParent].Right = Leaf;
+    Nodes[Sibling].Parent = NewParent;
+    Nodes[Leaf].Parent = NewParent;
+
+    if(OldParent == -1) {
+        Root = NewParent;
+    } else if(Nodes[OldParent].Left == Sibling) {
+        Nodes[OldParent].Left = NewParent;
+    } else {
+        Nodes[OldParent].Right = NewParent;
+    }
+
+    /* Rebalance and refit the ancestors */
+    for(Index = NewParent; Index != -1; Index = Nodes[Index].Parent) {
+        int Left, Right;
+
+        Index = Balance(Index);
+        Left = Nodes[Index].Left;
+        Right = Nodes[Index].Right;
+
+        Nodes[Index].Box = Union(Nodes[Left].Box, Nodes[Right].Box);
+        Nodes[Index].Height = 1 + (Nodes[Left].Height > Nodes[Right].Height
+                            ? Nodes[Left].Height : Nodes[Right].Height);
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+void BoundingVolumeHierarchy::RemoveLeaf(int Leaf)
+{
+    int Parent, GrandParent, Sibling, Index;
+
+    if(Leaf == Root) {
+        Root = -1;
+        return;
+    }
+
+    Parent = Nodes[Leaf].Parent;
+    GrandParent = Nodes[Parent].Parent;
+    Sibling = Nodes[Parent].Left == Leaf ? Nodes[Parent].Right
+                                        : Nodes[Parent].Left;
+
+    FreeNode(Parent);
+
+    if(GrandParent == -1) {
+        Root = Sibling;
+        Nodes[Sibling].Parent = -1;
+        return;
+    }
+
+    /* The sibling takes the parent's place */
+    if(Nodes[GrandParent].Left == Parent)
+        Nodes[GrandParent].Left = Sibling;
+    else
+        Nodes[GrandParent].Right = Sibling;
+
+    Nodes[Sibling].Parent = GrandParent;
+
+    for(Index = GrandParent; Index != -1; Index = Nodes[Index].Parent) {
+        int Left, Right;
+
+        Index = Balance(Index);
+        Left = Nodes[Index].Left;
+        Right = Nodes[Index].Right;
+
+        Nodes[Index].Box = Union(Nodes[Left].Box, Nodes[Right].Box);
+        Nodes[Index].Height = 1 + (Nodes[Left].Height > Nodes[Right].Height
+                            ? Nodes[Left].Height : Nodes[Right].Height);
+    }
+}
+
+
+/* *
+ * If A's subtrees differ in height by more than 1, rotate the taller
+ * child up into A's place. Returns the index of the subtree's new root.
+ * */
+int BoundingVolumeHierarchy::Balance(int IA)
+{
+    TreeNode* A = &Nodes[IA];
+    int IB, IC, Difference;
+    TreeNode *B, *C;
+
+    if(A->Height < 2)
+        return IA;
+
+    IB = A->Left;
+    IC = A->Right;
+    B = &Nodes[IB];
+    C = &Nodes[IC];
+    Difference = C->Height - B->Height;
+
+    /* Rotate C up */
+    if(Difference > 1) {
+        int IF = C->Left;
+        int IG = C->Right;
+        TreeNode* F = &Nodes[IF];
+        TreeNode* G = &Nodes[IG];
+
+        C->Left = IA;
+        C->Parent = A->Parent;
+        A->Parent = IC;
+
+        if(C->Parent == -1)
+            Root = IC;
+        else if(Nodes[C->Parent].Left == IA)
+            Nodes[C->Parent].Left = IC;
+        else
+            Nodes[C->Parent].Right = IC;
+
+        /* A keeps the shorter of C's children */
+        if(F->Height > G->Height) {
+            C->Right = IF;
+            A->Right = IG;
+            G->Parent = IA;
+            A->Box = Union(B->Box, G->Box);
+            C->Box = Union(A->Box, F->Box);
+            A->Height = 1 + (B->Height > G->Height ? B->Height : G->Height);
+            C->Height = 1 + (A->Height > F->Height ? A->Height : F->Height);
+        } else {
+            C->Right = IG;
+            A->Right = IF;
+            F->Parent = IA;
+            A->Box = Union(B->Box, F->Box);
+            C->Box = Union(A->Box, G->Box);
+            A->Height = 1 + (B->Height > F->Height ? B->Height : F->Height);
+            C->Height = 1 + (A->Height > G->Height ? A->Height : G->Height);
+        }
+
+        return IC;
+    }
+
+    /* Rotate B up */
+    if(Difference < -1) {
+        int ID = B->Left;
+        int IE = B->Right;
+        TreeNode* D = &Nodes[ID];
+        TreeNode* E = &Nodes[IE];
+
+        B->Left = IA;
+        B->Parent = A->Parent;
+        A->Parent = IB;
+
+        if(B->Parent == -1)
+            Root = IB;
+        else if(Nodes[B->Parent].Left == IA)
+            Nodes[B->Parent].Left = IB;
+        else
+            Nodes[B->Parent].Right = IB;
+
+        if(D->Height > E->Height) {
+            B->Right = ID;
+            A->Left = IE;
+            E->Parent = IA;
+            A->Box = Union(C->Box, E->Box);
+            B->Box = Union(A->Box, D->Box);
+            A->Height = 1 + (C->Height > E->Height ? C->Height : E->Height);
+            B->Height = 1 + (A->Height > D->Height ? A->Height : D->Height);
+        } else {
+            B->Right = IE;
+            A->Left = ID;
+            D->Parent = IA;
+            A->Box = Union(C->Box, D->Box);
+            B->Box = Union(A->Box, E->Box);
+            A->Height = 1 + (C->Height > D->Height ? C->Height : D->Height);
+            B->Height = 1 + (A->Height > E->Height ? A->Height : E->Height);
+        }
+
+        return IB;
+    }
+
+    return IA;
+}
+
+
+void BoundingVolumeHierarchy::SetMargin(Scalar Distance)
+{
+    Margin = Distance;
+}
+
+
+Scalar BoundingVolumeHierarchy::GetMargin() const
+{
+    return Margin;
+}
+
+
+void* BoundingVolumeHierarchy::GetData(int Handle) const
+{
+    return Nodes[Handle].Data;
+}
+
+
+BoundingBox BGE_NCP BoundingVolumeHierarchy::GetBox(int Handle) const
+{
+    return Nodes[Handle].Box;
+}
+
+
+int BoundingVolumeHierarchy::GetNumObjects() const
+{
+    return NumObjects;
+}
+
+
+int BoundingVolumeHierarchy::GetHeight() const
+{
+    return Root == -1 ? -1 : Nodes[Root].Height;
+}
+
+
+int BoundingVolumeHierarchy::Query(BoundingBox BGE_NCP Box, int* Results,
+                                                int MaxResults) const
+{
+    int Stack[BVH_STACK_SIZE];
+    int Top = 0, Count = 0;
+
+    if(Root == -1 || MaxResults <= 0)
+        return 0;
+
+    Stack[Top++] = Root;
+
+    while(Top > 0) {
+        const TreeNode& N = Nodes[Stack[--Top]];
+
+        if(!Overlaps(N.Box, Box))
+            continue;
+
+        if(N.Height == 0) {
+            Results[Count++] = (int)(&N - Nodes);
+            if(Count == MaxResults)
+                break;
+        } else {
+            Stack[Top++] = N.Right;
+            Stack[Top++] = N.Left;
+        }
+    }
+
+    return Count;
+}
+
+
+int BoundingVolumeHierarchy::Query(BoundingSphere BGE_NCP Sphere,
+                                int* Results, int MaxResults) const
+{
+    int Stack[BVH_STACK_SIZE];
+    int Top = 0, Count = 0;
+
+    if(Root == -1 || MaxResults <= 0)
+        return 0;
+
+    Stack[Top++] = Root;
+
+    while(Top > 0) {
+        const TreeNode& N = Nodes[Stack[--Top]];
+
+        if(!Sphere.Intersects(N.Box))
+            continue;
+
+        if(N.Height == 0) {
+            Results[Count++] = (int)(&N - Nodes);
+            if(Count == MaxResults)
+                break;
+        } else {
+            Stack[Top++] = N.Right;
+            Stack[Top++] = N.Left;
+        }
+    }
+
+    return Count;
+}
+
+
+int BoundingVolumeHierarchy::Query(Frustum BGE_NCP View, int* Results,
+                                                int MaxResults) const
+{
+    int Stack[BVH_STACK_SIZE];
+    int Top = 0, Count = 0;
+
+    if(Root == -1 || MaxResults <= 0)
+        return 0;
+
+    Stack[Top++] = Root;
+
+    while(Top > 0 && Count < MaxResults) {
+        int Index = Stack[--Top];
+        FRUSTUM_OVERLAP Overlap = Classify(View, Nodes[Index].Box);
+        int Inner[BVH_STACK_SIZE];
+        int InnerTop = 0;
+
+        if(Overlap == FRUSTUM_OUTSIDE)
+            continue;
+
+        if(Overlap == FRUSTUM_CROSSING && Nodes[Index].Height > 0) {
+            Stack[Top++] = Nodes[Index].Right;
+            Stack[Top++] = Nodes[Index].Left;
+            continue;
+        }
+
+        /* Everything below a node inside the frustum is too; skip tests */
+        Inner[InnerTop++] = Index;
+        while(InnerTop > 0 && Count < MaxResults) {
+            const TreeNode& N = Nodes[Inner[--InnerTop]];
+
+            if(N.Height == 0) {
+                Results[Count++] = (int)(&N - Nodes);
+            } else {
+                Inner[InnerTop++] = N.Right;
+                Inner[InnerTop++] = N.Left;
+            }
+        }
+    }
+
+    return Count;
+}
+
+
+int BoundingVolumeHierarchy::FindPairs(BroadphasePair* Pairs,
+                                            int MaxPairs) const
+{
+    int Stack[BVH_STACK_SIZE];
+    int Count = 0;
+
+    if(Root == -1 || MaxPairs <= 0)
+        return 0;
+
+    /* Each leaf looks for the higher-numbered leaves its box overlaps */
+    for(int Leaf = 0; Leaf < Capacity; ++Leaf) {
+        BoundingBox BGE_NCP Box = Nodes[Leaf].Box;
+        int Top = 0;
+
+        if(Nodes[Leaf].Height != 0)
+            continue;
+
+        Stack[Top++] = Root;
+
+        while(Top > 0) {
+            int Index = Stack[--Top];
+            const TreeNode& N = Nodes[Index];
+
+            if(!Overlaps(N.Box, Box))
+                continue;
+
+            if(N.Height > 0) {
+                Stack[Top++] = N.Right;
+                Stack[Top++] = N.Left;
+            } else if(Index > Leaf) {
+                Pairs[Count].A = Leaf;
+                Pairs[Count].B = Index;
+                if(++Count == MaxPairs)
+                    return Count;
+            }
+        }
+    }
+
+    return Count;
+}
+
+
+int BoundingVolumeHierarchy::Raycast(Vector4 BGE_NCP Origin,
+                Vector4 BGE_NCP Direction, Scalar MaxDistance, int* Results,
+                                                int MaxResults) const
+{
+    int Stack[BVH_STACK_SIZE];
+    int Top = 0, Count = 0;
+    Scalar O[3], InvDir[3], Entry;
+
+    if(Root == -1 || MaxResults <= 0)
+        return 0;
+
+    /* Zero components become huge rather than infinite, avoiding 0 * inf */
+    for(int i = 0; i < 3; ++i) {
+        O[i] = Origin[i];
+        InvDir[i] = Direction[i] != 0 ? 1 / Direction[i] : FLT_MAX;
+    }
+
+    Stack[Top++] = Root;
+
+    while(Top > 0) {
+        const TreeNode& N = Nodes[Stack[--Top]];
+
+        if(!RayHits(O, InvDir, N.Box, MaxDistance, &Entry))
+            continue;
+
+        if(N.Height == 0) {
+            Results[Count++] = (int)(&N - Nodes);
+            if(Count == MaxResults)
+                break;
+        } else {
+            Stack[Top++] = N.Right;
+            Stack[Top++] = N.Left;
+        }
+    }
+
+    return Count;
+}
+
+
+int BoundingVolumeHierarchy::RaycastClosest(Vector4 BGE_NCP Origin,
+                Vector4 BGE_NCP Direction, Scalar MaxDistance,
+                                            Scalar* Distance) const
+{
+    int Stack[BVH_STACK_SIZE];
+    Scalar StackEntries[BVH_STACK_SIZE];
+    int Top = 0, Closest = -1;
+    Scalar O[3], InvDir[3], Best = MaxDistance;
+
+    if(Root == -1)
+        return -1;
+
+    for(int i = 0; i < 3; ++i) {
+        O[i] = Origin[i];
+        InvDir[i] = Direction[i] != 0 ? 1 / Direction[i] : FLT_MAX;
+    }
+
+    if(!RayHits(O, InvDir, Nodes[Root].Box, Best, &StackEntries[0]))
+        return -1;
+
+    Stack[Top++] = Root;
+
+    /* Visit nearer children first so far subtrees can be skipped */
+    while(Top > 0) {
+        const TreeNode& N = Nodes[Stack[--Top]];
+        Scalar LeftEntry, RightEntry;
+        bool HitsLeft, HitsRight;
+
+        if(StackEntries[Top] > Best)
+            continue;
+
+        if(N.Height == 0) {
+            Closest = (int)(&N - Nodes);
+            Best = StackEntries[Top];
+            continue;
+        }
+
+        HitsLeft = RayHits(O, InvDir, Nodes[N.Left].Box, Best, &LeftEntry);
+        HitsRight = RayHits(O, InvDir, Nodes[N.Right].Box, Best,
+                                                            &RightEntry);
+
+        if(HitsLeft && HitsRight && LeftEntry < RightEntry) {
+            StackEntries[Top] = RightEntry;
+            Stack[Top++] = N.Right;
+            HitsRight = false;
+        }
+
+        if(HitsLeft) {
+            StackEntries[Top] = LeftEntry;
+            Stack[Top++] = N.Left;
+        }
+
+        if(HitsRight) {
+            StackEntries[Top] = RightEntry;
+            Stack[Top++] = N.Right;
+        }
+    }
+
+    if(Closest >= 0 && Distance != NULL)
+        *Distance = Best;
+
+    return Closest;
+}
+
+} /* bakge */
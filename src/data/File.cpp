@@ -38,7 +38,7 @@ File::~File()
 {
     Close();
 
-    free(Path);
+    TrackedFree(Path);
 }
 
 
@@ -48,7 +48,7 @@ File* File::Open(const char* Path)
 
     /* Since strncpy doesn't guarantee null-termination, do it ourselves */
     int Len = strlen(Path);
-    F->Path = (char*)malloc(Len + 1);
+    F->Path = (char*)TrackedMalloc(Len + 1, MEMORY_TAG_FILE);
     strncpy(F->Path, Path, Len);
     F->Path[Len] = '\0';
 
@@ -0,0 +1,560 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+#define LOOSEOCTREE_MAX_DEPTH 16
+
+/* Enough for a depth first walk pushing all eight children per level */
+#define LOOSEOCTREE_STACK_SIZE (LOOSEOCTREE_MAX_DEPTH * 7 + 8)
+
+namespace bakge
+{
+
+static BGE_INL bool Overlaps(BoundingBox BGE_NCP A, BoundingBox BGE_NCP B)
+{
+    Vector4 BGE_NCP AMin = A.GetMin();
+    Vector4 BGE_NCP AMax = A.GetMax();
+    Vector4 BGE_NCP BMin = B.GetMin();
+    Vector4 BGE_NCP BMax = B.GetMax();
+
+    return AMin[0] <= BMax[0] && AMax[0] >= BMin[0]
+        && AMin[1] <= BMax[1] && AMax[1] >= BMin[1]
+        && AMin[2] <= BMax[2] && AMax[2] >= BMin[2];
+}
+
+
+/* Whether Box touches a node's loose bounds, twice the size of its cell */
+static BGE_INL bool OverlapsLoose(const Scalar* Center, Scalar HalfSize,
+                                                BoundingBox BGE_NCP Box)
+{
+    Vector4 BGE_NCP Min = Box.GetMin();
+    Vector4 BGE_NCP Max = Box.GetMax();
+    Scalar Reach = HalfSize * 2;
+
+    return Center[0] - Reach <= Max[0] && Center[0] + Reach >= Min[0]
+        && Center[1] - Reach <= Max[1] && Center[1] + Reach >= Min[1]
+        && Center[2] - Reach <= Max[2] && Center[2] + Reach >= Min[2];
+}
+
+
+LooseOctree::LooseOctree()
+{
+    Nodes = NULL;
+    NodeCapacity = 0;
+    FreeNodes = -1;
+    Objects = NULL;
+    ObjectCapacity = 0;
+    FreeObjects = -1;
+    NumObjects = 0;
+    MaxDepth = 0;
+}
+
+
+LooseOctree::~LooseOctree()
+{
+    free(Nodes);
+    free(Objects);
+}
+
+
+LooseOctree* LooseOctree::Create(Vector4 BGE_NCP Center, Scalar HalfSize,
+                                                            int MaxDepth)
+{
+    LooseOctree* L;
+
+    if(HalfSize <= 0) {
+        printf("Loose octree size must be positive\n");
+        return NULL;
+    }
+
+    if(MaxDepth < 0 || MaxDepth > LOOSEOCTREE_MAX_DEPTH) {
+        printf("Loose octree depth must be between 0 and %d\n",
+                                            LOOSEOCTREE_MAX_DEPTH);
+        return NULL;
+    }
+
+    L = new LooseOctree;
+    L->MaxDepth = MaxDepth;
+
+    /* The root is always node 0 */
+    if(L->ReserveNodes(64) != BGE_SUCCESS) {
+        delete L;
+        return NULL;
+    }
+
+    L->AllocateNode(-1, 0);
+    L->Nodes[0].Center[0] = Center[0];
+    L->Nodes[0].Center[1] = Center[1];
+    L->Nodes[0].Center[2] = Center[2];
+    L->Nodes[0].HalfSize = HalfSize;
+    L->Nodes[0].Depth = 0;
+
+    return L;
+}
+
+
+Result LooseOctree::ReserveNodes(int NumNodes)
+{
+    OctreeNode* NewNodes;
+
+    if(NumNodes <= NodeCapacity)
+        return BGE_SUCCESS;
+
+    NewNodes = (OctreeNode*)realloc(Nodes, sizeof(OctreeNode) * NumNodes);
+    if(NewNodes == NULL) {
+        printf("Error allocating loose octree nodes\n");
+        return BGE_FAILURE;
+    }
+
+    Nodes = NewNodes;
+
+    for(int i = NodeCapacity; i < NumNodes; ++i) {
+        Nodes[i].Parent = i + 1 < NumNodes ? i + 1 : FreeNodes;
+        Nodes[i].Depth = -1;
+    }
+
+    FreeNodes = NodeCapacity;
+    NodeCapacity = NumNodes;
+
+    return BGE_SUCCESS;
+}
+
+
+Result LooseOctree::ReserveObjects(int Num)
+{
+    OctreeObject* NewObjects;
+
+    if(Num <= ObjectCapacity)
+        return BGE_SUCCESS;
+
+    NewObjects = (OctreeObject*)realloc(Objects, sizeof(OctreeObject) * Num);
+    if(NewObjects == NULL) {
+        printf("Error allocating loose octree objects\n");
+        return BGE_FAILURE;
+    }
+
+    Objects = NewObjects;
+
+    for(int i = ObjectCapacity; i < Num; ++i) {
+        Objects[i].Next = i + 1 < Num ? i + 1 : FreeObjects;
+        Objects[i].Node = -1;
+    }
+
+    FreeObjects = ObjectCapacity;
+    ObjectCapacity = Num;
+
+    return BGE_SUCCESS;
+}
+
+
+int LooseOctree::AllocateNode(int Parent, int Octant)
+{
+    int Index;
+
+    if(FreeNodes == -1) {
+        if(ReserveNodes(NodeCapacity * 2) != BGE_SUCCESS)
+            return -1;
+    }
+
+    Index = FreeNodes;
+    FreeNodes = Nodes[Index].Parent;
+
+    OctreeNode& N = Nodes[Index];
+
+    N.Parent = Parent;
+    N.FirstObject = -1;
+    N.NumObjects = 0;
+
+    for(int i = 0; i < 8; ++i)
+        N.Children[i] = -1;
+
+    if(Parent != -1) {
+        const OctreeNode& P = Nodes[Parent];
+        Scalar Quarter = P.HalfSize * 0.5f;
+
+        /* Octant bits pick the positive half along x, y and z */
+        N.Center[0] = P.Center[0] + (Octant & 1 ? Quarter : -Quarter);
+        N.Center[1] = P.Center[1] + (Octant & 2 ? Quarter : -Quarter);
+        N.Center[2] = P.Center[2] + (Octant & 4 ? Quarter : -Quarter);
+        N.HalfSize = Quarter;
+        N.Depth = P.Depth + 1;
+
+        Nodes[Parent].Children[Octant] = Index;
+    }
+
+    return Index;
+}
+
+
+void LooseOctree::FreeNode(int Index)
+{
+    Nodes[Index].Depth = -1;
+    Nodes[Index].Parent = FreeNodes;
+    FreeNodes = Index;
+}
+
+
+int LooseOctree::FindNode(BoundingBox BGE_NCP Box, bool Create)
+{
+    Vector4 BGE_NCP Min = Box.GetMin();
+    Vector4 BGE_NCP Max = Box.GetMax();
+    Scalar Center[3], Extent = 0;
+    int Depth = 0, Index = 0;
+    Scalar Size;
+
+    if(Box.IsEmpty())
+        return 0;
+
+    for(int i = 0; i < 3; ++i) {
+        Scalar Half = (Max[i] - Min[i]) * 0.5f;
+
+        Center[i] = Min[i] + Half;
+        if(Half > Extent)
+            Extent = Half;
+
+        /* Objects centered outside the tree stay in the root */
+        if(Center[i] < Nodes[0].Center[i] - Nodes[0].HalfSize
+                || Center[i] > Nodes[0].Center[i] + Nodes[0].HalfSize)
+            return 0;
+    }
+
+    /* Deepest level whose cells are still as wide as the object */
+    Size = Nodes[0].HalfSize * 0.5f;
+    while(Depth < MaxDepth && Extent <= Size) {
+        Size *= 0.5f;
+        ++Depth;
+    }
+
+    for(int d = 0; d < Depth; ++d) {
+        const Scalar* C = Nodes[Index].Center;
+        int Octant = (Center[0] >= C[0]) | (Center[1] >= C[1]) << 1
+                                        | (Center[2] >= C[2]) << 2;
+        int Child = Nodes[Index].Children[Octant];
+
+        if(Child == -1) {
+            if(!Create)
+                return -1;
+
+            /* Without memory for the node the object can live further up */
+            Child = AllocateNode(Index, Octant);
+            if(Child == -1)
+                return Index;
+        }
+
+        Index = Child;
+    }
+
+    return Index;
+}
+
+
+void LooseOctree::Link(int Object, int Node)
+{
+    OctreeObject& O = Objects[Object];
+
+    O.Node = Node;
+    O.Prev = -1;
+    O.Next = Nodes[Node].FirstObject;
+
+    if(O.Next != -1)
+        Objects[O.Next].Prev = Object;
+
+    Nodes[Node].FirstObject = Object;
+
+    for(int i = Node; i != -1; i = Nodes[i].Parent)
+        ++Nodes[i].NumObjects;
+}
+
+
+void LooseOctree::Unlink(int Object)
+{
+    OctreeObject& O = Objects[Object];
+    int Node = O.Node;
+
+    if(O.Prev != -1) {
+        Objects[O.Prev].Next = O.Next;
+    } else {
+        Nodes[Node].FirstObject = O.Next;
+    }
+
+    if(O.Next != -1)
+        Objects[O.Next].Prev = O.Prev;
+
+    /* Nodes left with nothing in or below them are freed, except the root */
+    while(Node != -1) {
+        int Parent = Nodes[Node].Parent;
+
+        if(--Nodes[Node].NumObjects == 0 && Parent != -1) {
+            for(int i = 0; i < 8; ++i) {
+                if(Nodes[Parent].Children[i] == Node)
+                    Nodes[Parent].Children[i] = -1;
+            }
+
+            FreeNode(Node);
+        }
+
+        Node = Parent;
+    }
+}
+
+
+int LooseOctree::Insert(BoundingBox BGE_NCP Box, void* Data)
+{
+    int Object;
+
+    if(FreeObjects == -1) {
+        if(ReserveObjects(ObjectCapacity > 0 ? ObjectCapacity * 2 : 64)
+                                                        != BGE_SUCCESS)
+            return -1;
+    }
+
+    Object = FreeObjects;
+    FreeObjects = Objects[Object].Next;
+
+    Objects[Object].Box = Box;
+    Objects[Object].Data = Data;
+
+    Link(Object, FindNode(Box, true));
+    ++NumObjects;
+
+    return Object;
+}
+
+
+Result LooseOctree::Remove(int Handle)
+{
+    if(Handle < 0 || Handle >= ObjectCapacity || Objects[Handle].Node == -1) {
+        printf("Invalid loose octree handle %d\n", Handle);
+        return BGE_FAILURE;
+    }
+
+    Unlink(Handle);
+
+    Objects[Handle].Node = -1;
+    Objects[Handle].Next = FreeObjects;
+    FreeObjects = Handle;
+    --NumObjects;
+
+    return BGE_SUCCESS;
+}
+
+
+bool LooseOctree::Update(int Handle, BoundingBox BGE_NCP Box)
+{
+    if(Handle < 0 || Handle >= ObjectCapacity || Objects[Handle].Node == -1) {
+        printf("Invalid loose octree handle %d\n", Handle);
+        return false;
+    }
+
+    Objects[Handle].Box = Box;
+
+    if(FindNode(Box, false) == Objects[Handle].Node)
+        return false;
+
+    /* Unlink first, as it may free nodes on the way to the new one */
+    Unlink(Handle);
+    Link(Handle, FindNode(Box, true));
+
+    return true;
+}
+
+
+void LooseOctree::Clear()
+{
+    FreeNodes = -1;
+    for(int i = NodeCapacity - 1; i > 0; --i)
+        FreeNode(i);
+
+    Nodes[0].FirstObject = -1;
+    Nodes[0].NumObjects = 0;
+    for(int i = 0; i < 8; ++i)
+        Nodes[0].Children[i] = -1;
+
+    FreeObjects = -1;
+    for(int i = ObjectCapacity - 1; i >= 0; --i) {
+        Objects[i].Node = -1;
+        Objects[i].Next = FreeObjects;
+        FreeObjects = i;
+    }
+
+    NumObjects = 0;
+}
+
+
+void* LooseOctree::GetData(int Handle) const
+{
+    return Objects[Handle].Data;
+}
+
+
+BoundingBox BGE_NCP LooseOctree::GetBox(int Handle) const
+{
+    return Objects[Handle].Box;
+}
+
+
+int LooseOctree::GetNumObjects() const
+{
+    return NumObjects;
+}
+
+
+int LooseOctree::Query(BoundingBox BGE_NCP Box, int* Results,
+                                        int MaxResults) const
+{
+    int Stack[LOOSEOCTREE_STACK_SIZE];
+    int Top = 0, Count = 0;
+
+    if(MaxResults <= 0)
+        return 0;
+
+    Stack[Top++] = 0;
+
+    while(Top > 0) {
+        int Index = Stack[--Top];
+        const OctreeNode& N = Nodes[Index];
+
+        /* The root also holds objects from outside it, so always look */
+        if(Index != 0 && !OverlapsLoose(N.Center, N.HalfSize, Box))
+            continue;
+
+        for(int i = N.FirstObject; i != -1; i = Objects[i].Next) {
+            if(Overlaps(Objects[i].Box, Box)) {
+                Results[Count++] = i;
+                if(Count == MaxResults)
+                    return Count;
+            }
+        }
+
+        for(int i = 0; i < 8; ++i) {
+            if(N.Children[i] != -1)
+                Stack[Top++] = N.Children[i];
+        }
+    }
+
+    return Count;
+}
+
+
+int LooseOctree::PairWithSubtree(int Object, int Node, BroadphasePair* Pairs,
+                                            int Count, int MaxPairs) const
+{
+    BoundingBox BGE_NCP Box = Objects[Object].Box;
+    int Depth = Nodes[Objects[Object].Node].Depth;
+    int Stack[LOOSEOCTREE_STACK_SIZE];
+    int Top = 0;
+
+    Stack[Top++] = Node;
+
+    while(Top > 0) {
+        int Index = Stack[--Top];
+        const OctreeNode& N = Nodes[Index];
+
+        if(Index != 0 && !OverlapsLoose(N.Center, N.HalfSize, Box))
+            continue;
+
+        for(int i = N.FirstObject; i != -1; i = Objects[i].Next) {
+            /* Objects at the same depth find each other; report it once */
+            if(N.Depth == Depth && i <= Object)
+                continue;
+
+            if(Overlaps(Objects[i].Box, Box)) {
+                Pairs[Count].A = Object < i ? Object : i;
+                Pairs[Count].B = Object < i ? i : Object;
+                if(++Count == MaxPairs)
+                    return Count;
+            }
+        }
+
+        for(int i = 0; i < 8; ++i) {
+            if(N.Children[i] != -1)
+                Stack[Top++] = N.Children[i];
+        }
+    }
+
+    return Count;
+}
+
+
+int LooseOctree::PairNeighbourhood(int Node, const int* Neighbours,
+                    BroadphasePair* Pairs, int Count, int MaxPairs) const
+{
+    const OctreeNode& N = Nodes[Node];
+    int ChildNeighbours[27];
+
+    /* *
+     * An object's partners at its depth or below have their centers
+     * within one cell of its own, so they are in the subtrees of the 27
+     * nodes around its node. Partners further up find it the same way.
+     * */
+    for(int i = N.FirstObject; i != -1; i = Objects[i].Next) {
+        for(int n = 0; n < 27 && Count < MaxPairs; ++n) {
+            if(Neighbours[n] != -1)
+                Count = PairWithSubtree(i, Neighbours[n], Pairs, Count,
+                                                            MaxPairs);
+        }
+    }
+
+    for(int c = 0; c < 8 && Count < MaxPairs; ++c) {
+        if(N.Children[c] == -1)
+            continue;
+
+        /* A child's neighbours are children of its parent's neighbours */
+        for(int n = 0; n < 27; ++n) {
+            int X = (c & 1) + n % 3 - 1;
+            int Y = (c >> 1 & 1) + n / 3 % 3 - 1;
+            int Z = (c >> 2 & 1) + n / 9 - 1;
+            int Parent = Neighbours[(X + 2) / 2 + (Y + 2) / 2 * 3
+                                                + (Z + 2) / 2 * 9];
+
+            ChildNeighbours[n] = Parent == -1 ? -1 : Nodes[Parent].Children[
+                                    (X & 1) | (Y & 1) << 1 | (Z & 1) << 2];
+        }
+
+        Count = PairNeighbourhood(N.Children[c], ChildNeighbours, Pairs,
+                                                        Count, MaxPairs);
+    }
+
+    return Count;
+}
+
+
+int LooseOctree::FindPairs(BroadphasePair* Pairs, int MaxPairs) const
+{
+    int Neighbours[27];
+
+    if(MaxPairs <= 0)
+        return 0;
+
+    /* The root has no neighbours, and holds objects from outside it */
+    for(int n = 0; n < 27; ++n)
+        Neighbours[n] = -1;
+
+    Neighbours[13] = 0;
+
+    return PairNeighbourhood(0, Neighbours, Pairs, 0, MaxPairs);
+}
+
+} /* bakge */
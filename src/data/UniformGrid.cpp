@@ -0,0 +1,521 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+/* Objects covering more cells than this go in the large object list */
+#define UNIFORMGRID_MAX_OBJECT_CELLS 64
+
+/* Cell coordinates are clamped to this far either side of the origin */
+#define UNIFORMGRID_MAX_CELL (1 << 20)
+
+namespace bakge
+{
+
+static BGE_INL bool Overlaps(BoundingBox BGE_NCP A, BoundingBox BGE_NCP B)
+{
+    Vector4 BGE_NCP AMin = A.GetMin();
+    Vector4 BGE_NCP AMax = A.GetMax();
+    Vector4 BGE_NCP BMin = B.GetMin();
+    Vector4 BGE_NCP BMax = B.GetMax();
+
+    return AMin[0] <= BMax[0] && AMax[0] >= BMin[0]
+        && AMin[1] <= BMax[1] && AMax[1] >= BMin[1]
+        && AMin[2] <= BMax[2] && AMax[2] >= BMin[2];
+}
+
+
+static BGE_INL int Cell(Scalar Coordinate, Scalar InvCellSize)
+{
+    Scalar C = floorf(Coordinate * InvCellSize);
+
+    if(C < -UNIFORMGRID_MAX_CELL)
+        return -UNIFORMGRID_MAX_CELL;
+
+    if(C > UNIFORMGRID_MAX_CELL)
+        return UNIFORMGRID_MAX_CELL;
+
+    return (int)C;
+}
+
+
+static BGE_INL int MaxInt(int A, int B)
+{
+    return A > B ? A : B;
+}
+
+
+UniformGrid::UniformGrid()
+{
+    Objects = NULL;
+    ObjectCapacity = 0;
+    FreeObjects = -1;
+    NumObjects = 0;
+    Buckets = NULL;
+    NumBuckets = 0;
+    LargeObjects.Objects = NULL;
+    LargeObjects.Count = 0;
+    LargeObjects.Capacity = 0;
+    CellSize = 1;
+    InvCellSize = 1;
+}
+
+
+UniformGrid::~UniformGrid()
+{
+    for(int i = 0; i < NumBuckets; ++i)
+        free(Buckets[i].Objects);
+
+    free(Buckets);
+    free(LargeObjects.Objects);
+    free(Objects);
+}
+
+
+UniformGrid* UniformGrid::Create(Scalar CellSize, int NumBuckets)
+{
+    UniformGrid* G;
+    int Size = 1;
+
+    if(CellSize <= 0) {
+        printf("Uniform grid cell size must be positive\n");
+        return NULL;
+    }
+
+    if(NumBuckets <= 0 || NumBuckets > (1 << 30)) {
+        printf("Invalid number of uniform grid buckets %d\n", NumBuckets);
+        return NULL;
+    }
+
+    while(Size < NumBuckets)
+        Size <<= 1;
+
+    G = new UniformGrid;
+    G->CellSize = CellSize;
+    G->InvCellSize = 1 / CellSize;
+
+    G->Buckets = (GridBucket*)calloc(Size, sizeof(GridBucket));
+    if(G->Buckets == NULL) {
+        printf("Error allocating uniform grid buckets\n");
+        delete G;
+        return NULL;
+    }
+
+    G->NumBuckets = Size;
+
+    return G;
+}
+
+
+Result UniformGrid::ReserveObjects(int Num)
+{
+    GridObject* NewObjects;
+
+    if(Num <= ObjectCapacity)
+        return BGE_SUCCESS;
+
+    NewObjects = (GridObject*)realloc(Objects, sizeof(GridObject) * Num);
+    if(NewObjects == NULL) {
+        printf("Error allocating uniform grid objects\n");
+        return BGE_FAILURE;
+    }
+
+    Objects = NewObjects;
+
+    for(int i = ObjectCapacity; i < Num; ++i) {
+        Objects[i].NextFree = i + 1 < Num ? i + 1 : FreeObjects;
+        Objects[i].InUse = false;
+    }
+
+    FreeObjects = ObjectCapacity;
+    ObjectCapacity = Num;
+
+    return BGE_SUCCESS;
+}
+
+
+void UniformGrid::PlaceObject(GridObject* Object) const
+{
+    Vector4 BGE_NCP Min = Object->Box.GetMin();
+    Vector4 BGE_NCP Max = Object->Box.GetMax();
+    double NumCells = 1;
+
+    if(Object->Box.IsEmpty()) {
+        for(int i = 0; i < 3; ++i) {
+            Object->MinCell[i] = 0;
+            Object->MaxCell[i] = -1;
+        }
+
+        Object->Large = false;
+        return;
+    }
+
+    for(int i = 0; i < 3; ++i) {
+        Object->MinCell[i] = Cell(Min[i], InvCellSize);
+        Object->MaxCell[i] = Cell(Max[i], InvCellSize);
+        /* Three clamped spans multiplied can overflow a long long */
+        NumCells *= Object->MaxCell[i] - Object->MinCell[i] + 1;
+    }
+
+    Object->Large = NumCells > UNIFORMGRID_MAX_OBJECT_CELLS;
+}
+
+
+int UniformGrid::HashCell(int X, int Y, int Z) const
+{
+    /* Large primes from Teschner et al., "Optimized Spatial Hashing" */
+    unsigned int Hash = (unsigned int)X * 73856093u
+                        ^ (unsigned int)Y * 19349663u
+                        ^ (unsigned int)Z * 83492791u;
+
+    return (int)(Hash & (unsigned int)(NumBuckets - 1));
+}
+
+
+Result UniformGrid::BucketAdd(GridBucket* Bucket, int Object)
+{
+    for(int i = 0; i < Bucket->Count; ++i) {
+        if(Bucket->Objects[i] == Object)
+            return BGE_SUCCESS;
+    }
+
+    if(Bucket->Count == Bucket->Capacity) {
+        int NewCapacity = Bucket->Capacity > 0 ? Bucket->Capacity * 2 : 4;
+        int* NewObjects = (int*)realloc(Bucket->Objects,
+                                        sizeof(int) * NewCapacity);
+
+        if(NewObjects == NULL) {
+            printf("Error allocating uniform grid bucket\n");
+            return BGE_FAILURE;
+        }
+
+        Bucket->Objects = NewObjects;
+        Bucket->Capacity = NewCapacity;
+    }
+
+    Bucket->Objects[Bucket->Count++] = Object;
+
+    return BGE_SUCCESS;
+}
+
+
+void UniformGrid::BucketRemove(GridBucket* Bucket, int Object)
+{
+    for(int i = 0; i < Bucket->Count; ++i) {
+        if(Bucket->Objects[i] == Object) {
+            Bucket->Objects[i] = Bucket->Objects[--Bucket->Count];
+            return;
+        }
+    }
+}
+
+
+Result UniformGrid::AddToCells(int Object)
+{
+    const GridObject& O = Objects[Object];
+
+    if(O.Large)
+        return BucketAdd(&LargeObjects, Object);
+
+    for(int z = O.MinCell[2]; z <= O.MaxCell[2]; ++z) {
+        for(int y = O.MinCell[1]; y <= O.MaxCell[1]; ++y) {
+            for(int x = O.MinCell[0]; x <= O.MaxCell[0]; ++x) {
+                if(BucketAdd(&Buckets[HashCell(x, y, z)], Object)
+                                                    != BGE_SUCCESS)
+                    return BGE_FAILURE;
+            }
+        }
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+void UniformGrid::RemoveFromCells(int Object)
+{
+    const GridObject& O = Objects[Object];
+
+    if(O.Large) {
+        BucketRemove(&LargeObjects, Object);
+        return;
+    }
+
+    for(int z = O.MinCell[2]; z <= O.MaxCell[2]; ++z) {
+        for(int y = O.MinCell[1]; y <= O.MaxCell[1]; ++y) {
+            for(int x = O.MinCell[0]; x <= O.MaxCell[0]; ++x)
+                BucketRemove(&Buckets[HashCell(x, y, z)], Object);
+        }
+    }
+}
+
+
+int UniformGrid::Insert(BoundingBox BGE_NCP Box, void* Data)
+{
+    int Object;
+
+    if(FreeObjects == -1) {
+        if(ReserveObjects(ObjectCapacity > 0 ? ObjectCapacity * 2 : 64)
+                                                        != BGE_SUCCESS)
+            return -1;
+    }
+
+    Object = FreeObjects;
+
+    GridObject& O = Objects[Object];
+
+    O.Box = Box;
+    O.Data = Data;
+    PlaceObject(&O);
+
+    if(AddToCells(Object) != BGE_SUCCESS) {
+        RemoveFromCells(Object);
+        return -1;
+    }
+
+    FreeObjects = O.NextFree;
+    O.InUse = true;
+    ++NumObjects;
+
+    return Object;
+}
+
+
+Result UniformGrid::Remove(int Handle)
+{
+    if(Handle < 0 || Handle >= ObjectCapacity || !Objects[Handle].InUse) {
+        printf("Invalid uniform grid handle %d\n", Handle);
+        return BGE_FAILURE;
+    }
+
+    RemoveFromCells(Handle);
+
+    Objects[Handle].InUse = false;
+    Objects[Handle].NextFree = FreeObjects;
+    FreeObjects = Handle;
+    --NumObjects;
+
+    return BGE_SUCCESS;
+}
+
+
+bool UniformGrid::Update(int Handle, BoundingBox BGE_NCP Box)
+{
+    GridObject Moved;
+
+    if(Handle < 0 || Handle >= ObjectCapacity || !Objects[Handle].InUse) {
+        printf("Invalid uniform grid handle %d\n", Handle);
+        return false;
+    }
+
+    Moved = Objects[Handle];
+    Moved.Box = Box;
+    PlaceObject(&Moved);
+
+    if(memcmp(Moved.MinCell, Objects[Handle].MinCell, sizeof(int) * 3) == 0
+            && memcmp(Moved.MaxCell, Objects[Handle].MaxCell,
+                                            sizeof(int) * 3) == 0) {
+        Objects[Handle].Box = Box;
+        return false;
+    }
+
+    RemoveFromCells(Handle);
+    Objects[Handle] = Moved;
+
+    if(AddToCells(Handle) != BGE_SUCCESS)
+        printf("Uniform grid lost track of object %d\n", Handle);
+
+    return true;
+}
+
+
+void UniformGrid::Clear()
+{
+    for(int i = 0; i < NumBuckets; ++i)
+        Buckets[i].Count = 0;
+
+    LargeObjects.Count = 0;
+
+    FreeObjects = -1;
+    for(int i = ObjectCapacity - 1; i >= 0; --i) {
+        Objects[i].InUse = false;
+        Objects[i].NextFree = FreeObjects;
+        FreeObjects = i;
+    }
+
+    NumObjects = 0;
+}
+
+
+void* UniformGrid::GetData(int Handle) const
+{
+    return Objects[Handle].Data;
+}
+
+
+BoundingBox BGE_NCP UniformGrid::GetBox(int Handle) const
+{
+    return Objects[Handle].Box;
+}
+
+
+int UniformGrid::GetNumObjects() const
+{
+    return NumObjects;
+}
+
+
+int UniformGrid::Query(BoundingBox BGE_NCP Box, int* Results,
+                                        int MaxResults) const
+{
+    GridObject Area;
+    double NumCells = 1;
+    int Count = 0;
+
+    if(MaxResults <= 0)
+        return 0;
+
+    Area.Box = Box;
+    PlaceObject(&Area);
+
+    for(int i = 0; i < 3; ++i)
+        NumCells *= Area.MaxCell[i] - Area.MinCell[i] + 1;
+
+    /* Boxes covering more cells than there are buckets just test everything */
+    if(NumCells > NumBuckets) {
+        for(int i = 0; i < ObjectCapacity; ++i) {
+            if(Objects[i].InUse && Overlaps(Objects[i].Box, Box)) {
+                Results[Count++] = i;
+                if(Count == MaxResults)
+                    break;
+            }
+        }
+
+        return Count;
+    }
+
+    for(int i = 0; i < LargeObjects.Count; ++i) {
+        int Object = LargeObjects.Objects[i];
+
+        if(Overlaps(Objects[Object].Box, Box)) {
+            Results[Count++] = Object;
+            if(Count == MaxResults)
+                return Count;
+        }
+    }
+
+    for(int z = Area.MinCell[2]; z <= Area.MaxCell[2]; ++z) {
+        for(int y = Area.MinCell[1]; y <= Area.MaxCell[1]; ++y) {
+            for(int x = Area.MinCell[0]; x <= Area.MaxCell[0]; ++x) {
+                const GridBucket& B = Buckets[HashCell(x, y, z)];
+
+                for(int i = 0; i < B.Count; ++i) {
+                    const GridObject& O = Objects[B.Objects[i]];
+
+                    if(!Overlaps(O.Box, Box))
+                        continue;
+
+                    /* *
+                     * An object can be met in several cells. Only report it
+                     * in the cell holding the corner of the overlap
+                     * */
+                    if(x != MaxInt(O.MinCell[0], Area.MinCell[0])
+                            || y != MaxInt(O.MinCell[1], Area.MinCell[1])
+                            || z != MaxInt(O.MinCell[2], Area.MinCell[2]))
+                        continue;
+
+                    Results[Count++] = B.Objects[i];
+                    if(Count == MaxResults)
+                        return Count;
+                }
+            }
+        }
+    }
+
+    return Count;
+}
+
+
+int UniformGrid::FindPairs(BroadphasePair* Pairs, int MaxPairs) const
+{
+    int Count = 0;
+
+    if(MaxPairs <= 0)
+        return 0;
+
+    /* *
+     * Two overlapping objects both cover the cell holding the corner of
+     * their overlap, so they share that cell's bucket. Only report them
+     * from that bucket.
+     * */
+    for(int b = 0; b < NumBuckets; ++b) {
+        const GridBucket& B = Buckets[b];
+
+        for(int i = 0; i < B.Count; ++i) {
+            const GridObject& First = Objects[B.Objects[i]];
+
+            for(int j = i + 1; j < B.Count; ++j) {
+                const GridObject& Second = Objects[B.Objects[j]];
+
+                if(!Overlaps(First.Box, Second.Box))
+                    continue;
+
+                if(HashCell(MaxInt(First.MinCell[0], Second.MinCell[0]),
+                            MaxInt(First.MinCell[1], Second.MinCell[1]),
+                            MaxInt(First.MinCell[2], Second.MinCell[2])) != b)
+                    continue;
+
+                Pairs[Count].A = B.Objects[i] < B.Objects[j] ?
+                                        B.Objects[i] : B.Objects[j];
+                Pairs[Count].B = B.Objects[i] < B.Objects[j] ?
+                                        B.Objects[j] : B.Objects[i];
+                if(++Count == MaxPairs)
+                    return Count;
+            }
+        }
+    }
+
+    /* Large objects are tested against everything else */
+    for(int i = 0; i < LargeObjects.Count; ++i) {
+        int Large = LargeObjects.Objects[i];
+
+        for(int Object = 0; Object < ObjectCapacity; ++Object) {
+            const GridObject& O = Objects[Object];
+
+            if(!O.InUse || Object == Large || (O.Large && Object < Large))
+                continue;
+
+            if(!Overlaps(O.Box, Objects[Large].Box))
+                continue;
+
+            Pairs[Count].A = Large < Object ? Large : Object;
+            Pairs[Count].B = Large < Object ? Object : Large;
+            if(++Count == MaxPairs)
+                return Count;
+        }
+    }
+
+    return Count;
+}
+
+} /* bakge */
@@ -27,13 +27,143 @@
 namespace bakge
 {
 
+static void SetMilliseconds(lua_State* L, const char* Name, Nanoseconds Time)
+{
+    lua_pushnumber(L, Time / 1e6);
+    lua_setfield(L, -2, Name);
+}
+
+
+/* *
+ * bakge.frame_stats([stage]) returns a table with the number of
+ * samples and the mean, p50, p95, p99 and max times, in milliseconds,
+ * of one stage ("frame" if none is given).
+ * */
+static int LuaFrameStats(lua_State* L)
+{
+    FrameTimer* Timer = (FrameTimer*)lua_touserdata(L, lua_upvalueindex(1));
+    FrameStageStats Stats;
+    const char* Name;
+    int Stage;
+
+    Name = luaL_optstring(L, 1, "frame");
+    Stage = GetFrameStage(Name);
+    if(Stage == NUM_FRAME_STAGES)
+        return luaL_error(L, "unknown frame stage '%s'", Name);
+
+    Timer->GetStageStats(Stage, &Stats);
+
+    lua_createtable(L, 0, 6);
+    lua_pushinteger(L, Stats.NumSamples);
+    lua_setfield(L, -2, "samples");
+    SetMilliseconds(L, "mean", Stats.Mean);
+    SetMilliseconds(L, "p50", Stats.P50);
+    SetMilliseconds(L, "p95", Stats.P95);
+    SetMilliseconds(L, "p99", Stats.P99);
+    SetMilliseconds(L, "max", Stats.Max);
+
+    return 1;
+}
+
+
+/* bakge.frame_hitches() returns the hitch count, last hitch's frame and ms */
+static int LuaFrameHitches(lua_State* L)
+{
+    FrameTimer* Timer = (FrameTimer*)lua_touserdata(L, lua_upvalueindex(1));
+
+    lua_pushnumber(L, (lua_Number)Timer->GetNumHitches());
+    lua_pushnumber(L, (lua_Number)Timer->GetLastHitchFrame());
+    lua_pushnumber(L, Timer->GetLastHitchTime() / 1e6);
+
+    return 3;
+}
+
+
+/* bakge.set_frame_rate(fps) paces the main loop; 0 turns pacing off */
+static int LuaSetFrameRate(lua_State* L)
+{
+    FrameTimer* Timer = (FrameTimer*)lua_touserdata(L, lua_upvalueindex(1));
+
+    if(Timer->SetTargetFrameRate(luaL_checknumber(L, 1)) != BGE_SUCCESS)
+        return luaL_error(L, "invalid frame rate");
+
+    return 0;
+}
+
+
+static int LuaGetFrameRate(lua_State* L)
+{
+    FrameTimer* Timer = (FrameTimer*)lua_touserdata(L, lua_upvalueindex(1));
+
+    lua_pushnumber(L, Timer->GetTargetFrameRate());
+
+    return 1;
+}
+
+
+/* Adds a function with the timer as its upvalue to the table on top */
+static void SetTimerFunction(lua_State* L, FrameTimer* Timer,
+                                const char* Name, lua_CFunction Function)
+{
+    lua_pushlightuserdata(L, Timer);
+    lua_pushcclosure(L, Function, 1);
+    lua_setfield(L, -2, Name);
+}
+
+
 ScriptedEngine::ScriptedEngine()
 {
+    /* Script memory is counted under MEMORY_TAG_SCRIPT */
+    L = lua_newstate(TrackedLuaAllocator, NULL);
+    if(L == NULL) {
+        printf("Error creating Lua state\n");
+        return;
+    }
+
+    luaL_openlibs(L);
+
+    /* Frame timing functions go in the global table "bakge" */
+    if(Timer != NULL) {
+        lua_newtable(L);
+        SetTimerFunction(L, Timer, "frame_stats", LuaFrameStats);
+        SetTimerFunction(L, Timer, "frame_hitches", LuaFrameHitches);
+        SetTimerFunction(L, Timer, "set_frame_rate", LuaSetFrameRate);
+        SetTimerFunction(L, Timer, "get_frame_rate", LuaGetFrameRate);
+        lua_setglobal(L, "bakge");
+    }
 }
 
 
 ScriptedEngine::~ScriptedEngine()
 {
+    if(L != NULL)
+        lua_close(L);
+}
+
+
+Result ScriptedEngine::RunFile(const char* ScriptPath)
+{
+    BGE_PROFILE_ZONE("ScriptedEngine::RunFile");
+
+    if(L == NULL || luaL_dofile(L, ScriptPath) != 0) {
+        Error();
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result ScriptedEngine::RunString(const char* Source)
+{
+    BGE_PROFILE_ZONE("ScriptedEngine::RunString");
+
+    if(L == NULL || luaL_dostring(L, Source) != 0) {
+        Error();
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
 }
 
 } /* bakge */
@@ -191,4 +191,36 @@ Result Mesh::ClearBuffers()
     return BGE_SUCCESS;
 }
 
+
+BoundingBox BGE_NCP Mesh::GetMeshBox() const
+{
+    return MeshBox;
+}
+
+
+BoundingSphere BGE_NCP Mesh::GetMeshSphere() const
+{
+    return MeshSphere;
+}
+
+
+Result Mesh::SetPositionData(const Scalar* Positions, int NumPositions)
+{
+#ifdef _DEBUG
+    if(MeshBuffers[MESH_BUFFER_POSITIONS] == 0) {
+        printf("Mesh buffers have not been created\n");
+        return BGE_FAILURE;
+    }
+#endif /* _DEBUG */
+
+    glBindBuffer(GL_ARRAY_BUFFER, MeshBuffers[MESH_BUFFER_POSITIONS]);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Positions[0]) * 3 * NumPositions,
+                                                Positions, GL_STATIC_DRAW);
+
+    MeshBox = BoundingBox::FromPoints(Positions, NumPositions);
+    MeshSphere = BoundingSphere::FromPoints(Positions, NumPositions);
+
+    return BGE_SUCCESS;
+}
+
 } /* bakge */
@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Node, true, MEMORY_TAG_GRAPHICS)
+
+
 Node::Node()
 {
     glGenBuffers(1, &PositionBuffer);
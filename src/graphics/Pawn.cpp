@@ -29,11 +29,15 @@ namespace bakge
 
 Pawn::Pawn()
 {
+    Scale = Vector4(1, 1, 1, 0);
+    SpatialIndex = NULL;
+    SpatialHandle = -1;
 }
 
 
 Pawn::~Pawn()
 {
+    SetBroadphase(NULL);
 }
 
 
@@ -91,4 +95,106 @@ Result Pawn::Draw() const
     return BGE_SUCCESS;
 }
 
+
+void Pawn::SetPosition(Scalar X, Scalar Y, Scalar Z)
+{
+    Node::SetPosition(X, Y, Z);
+    UpdateBounds();
+}
+
+
+void Pawn::SetFacing(Quaternion BGE_NCP Facing)
+{
+    this->Facing = Facing;
+    UpdateBounds();
+}
+
+
+Quaternion BGE_NCP Pawn::GetFacing() const
+{
+    return Facing;
+}
+
+
+void Pawn::SetScale(Scalar X, Scalar Y, Scalar Z)
+{
+    Scale = Vector4(X, Y, Z, 0);
+    UpdateBounds();
+}
+
+
+Vector4 BGE_NCP Pawn::GetScale() const
+{
+    return Scale;
+}
+
+
+BoundingBox Pawn::GetBoundingBox() const
+{
+    return WorldBox;
+}
+
+
+BoundingSphere BGE_NCP Pawn::GetBoundingSphere() const
+{
+    return WorldSphere;
+}
+
+
+Result Pawn::SetBroadphase(Broadphase* Index)
+{
+    if(SpatialIndex != NULL) {
+        SpatialIndex->Remove(SpatialHandle);
+        SpatialIndex = NULL;
+        SpatialHandle = -1;
+    }
+
+    if(Index == NULL)
+        return BGE_SUCCESS;
+
+    SpatialHandle = Index->Insert(WorldBox, this);
+    if(SpatialHandle < 0) {
+        printf("Unable to add Pawn to broadphase\n");
+        return BGE_FAILURE;
+    }
+
+    SpatialIndex = Index;
+
+    return BGE_SUCCESS;
+}
+
+
+Broadphase* Pawn::GetBroadphase() const
+{
+    return SpatialIndex;
+}
+
+
+int Pawn::GetBroadphaseHandle() const
+{
+    return SpatialHandle;
+}
+
+
+void Pawn::SetLocalBounds(BoundingBox BGE_NCP Box,
+                            BoundingSphere BGE_NCP Sphere)
+{
+    LocalBox = Box;
+    LocalSphere = Sphere;
+    UpdateBounds();
+}
+
+
+void Pawn::UpdateBounds()
+{
+    Matrix ToWorld;
+
+    ToWorld = Transform(Position, Facing, Scale).ToMatrix();
+    WorldBox = LocalBox.Transformed(ToWorld);
+    WorldSphere = LocalSphere.Transformed(ToWorld);
+
+    if(SpatialIndex != NULL)
+        SpatialIndex->Update(SpatialHandle, WorldBox);
+}
+
 } /* bakge */
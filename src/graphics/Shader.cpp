@@ -66,6 +66,8 @@ Shader* Shader::LoadFromString(GLenum Type, const char* Source,
     Shader* S;
     GLint Status, Length;
     char* Info;
+    StackAllocator* Scratch;
+    StackMarker Marker;
 
     /* Allocate memory for the new Shader */
     S = new Shader;
@@ -101,10 +103,18 @@ Shader* Shader::LoadFromString(GLenum Type, const char* Source,
     /* Print out any warnings or errors in the info log */
     glGetShaderiv(S->Handle, GL_INFO_LOG_LENGTH, &Length);
     if(Length > 1) {
-        Info =  new char[Length];
+        Scratch = StackAllocator::GetScratch();
+        if(Scratch == NULL) {
+            printf("Unable to get scratch memory for shader info log\n");
+            delete S;
+            return NULL;
+        }
+
+        Marker = Scratch->GetMarker();
+        Info = Scratch->AllocateArray<char>(Length);
         glGetShaderInfoLog(S->Handle, Length, &Length, Info);
         printf("%s", Info);
-        delete[] Info;
+        Scratch->FreeToMarker(Marker);
         /* Don't return shader if compilation failed */
         if(Status == GL_FALSE) {
             delete S;
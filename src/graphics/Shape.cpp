@@ -96,4 +96,21 @@ Result Shape::Draw() const
     return BGE_SUCCESS;
 }
 
+
+BoundingBox Shape::GetBoundingBox() const
+{
+    return Pawn::GetBoundingBox();
+}
+
+
+Result Shape::SetPositionData(const Scalar* Positions, int NumPositions)
+{
+    if(Mesh::SetPositionData(Positions, NumPositions) != BGE_SUCCESS)
+        return BGE_FAILURE;
+
+    SetLocalBounds(MeshBox, MeshSphere);
+
+    return BGE_SUCCESS;
+}
+
 } /* bakge */
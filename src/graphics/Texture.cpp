@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Texture, false, MEMORY_TAG_GRAPHICS)
+
+
 Texture::Texture()
 {
     Location = GL_TEXTURE0;
@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Cone, true, MEMORY_TAG_GRAPHICS)
+
+
 Cone::Cone()
 {
     Radius = 0.5f;
@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Cube, true, MEMORY_TAG_GRAPHICS)
+
+
 Cube::Cube()
 {
     Dimensions[0] = 1.0f;
@@ -60,10 +63,20 @@ Cube* Cube::Create(Scalar Length, Scalar Width, Scalar Height)
     C->NumFaces = 6;
     C->NumVertices = 4 * 6; /* 4 vertices per face */
     C->NumIndices = 36; /* 2 triangles per face, 3 vertices per triangle */
-    Scalar* Vertices = new Scalar[72];
-    Scalar* Normals = new Scalar[72];
-    Scalar* TexCoords = new Scalar[48];
-    unsigned int* Indices = new unsigned int[36];
+
+    /* The buffers are only needed until they are uploaded */
+    StackAllocator* Scratch = StackAllocator::GetScratch();
+    if(Scratch == NULL) {
+        printf("Unable to get scratch memory for cube\n");
+        delete C;
+        return NULL;
+    }
+
+    StackMarker Marker = Scratch->GetMarker();
+    Scalar* Vertices = Scratch->AllocateArray<Scalar>(72);
+    Scalar* Normals = Scratch->AllocateArray<Scalar>(72);
+    Scalar* TexCoords = Scratch->AllocateArray<Scalar>(48);
+    unsigned int* Indices = Scratch->AllocateArray<unsigned int>(36);
 
     /* *
      *       H__________G
@@ -319,9 +332,7 @@ Cube* Cube::Create(Scalar Length, Scalar Width, Scalar Height)
     Normals[69] = -1.0f;
     TexCoords[47] = 1;
 
-    glBindBuffer(GL_ARRAY_BUFFER, C->MeshBuffers[MESH_BUFFER_POSITIONS]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertices[0]) * 72, Vertices,
-                                                        GL_STATIC_DRAW);
+    C->SetPositionData(Vertices, 24);
 
     glBindBuffer(GL_ARRAY_BUFFER, C->MeshBuffers[MESH_BUFFER_NORMALS]);
     glBufferData(GL_ARRAY_BUFFER, sizeof(Normals[0]) * 72, Normals,
@@ -337,10 +348,7 @@ Cube* Cube::Create(Scalar Length, Scalar Width, Scalar Height)
 
     C->Unbind();
 
-    delete[] Vertices;
-    delete[] Normals;
-    delete[] Indices;
-    delete[] TexCoords;
+    Scratch->FreeToMarker(Marker);
 
     return C;
 }
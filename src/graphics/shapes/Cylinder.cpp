@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Cylinder, true, MEMORY_TAG_GRAPHICS)
+
+
 Cylinder::Cylinder()
 {
     Radius = 0.5f;
@@ -27,6 +27,9 @@
 namespace bakge
 {
 
+BGE_POOLED_DEFINE(Sphere, true, MEMORY_TAG_GRAPHICS)
+
+
 Sphere::Sphere()
 {
     Radius = 1.0f;
@@ -0,0 +1,164 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* Batched tests read arrays of BoundingBoxes as packed Scalars */
+static_assert(sizeof(BoundingBox) == sizeof(Scalar) * 8,
+                            "BoundingBox must be 8 packed Scalars");
+
+BoundingBox BoundingBox::FromPoints(const Scalar* Positions, int NumPoints)
+{
+    BoundingBox Box;
+
+    for(int i = 0; i < NumPoints; ++i) {
+        const Scalar* P = &Positions[i * 3];
+
+        for(int j = 0; j < 3; ++j) {
+            if(P[j] < Box.Min[j])
+                Box.Min[j] = P[j];
+
+            if(P[j] > Box.Max[j])
+                Box.Max[j] = P[j];
+        }
+    }
+
+    return Box;
+}
+
+
+bool BoundingBox::IsEmpty() const
+{
+    return Min[0] > Max[0] || Min[1] > Max[1] || Min[2] > Max[2];
+}
+
+
+Vector4 BoundingBox::GetCenter() const
+{
+    return Vector4((Min[0] + Max[0]) * 0.5f, (Min[1] + Max[1]) * 0.5f,
+                                        (Min[2] + Max[2]) * 0.5f, 1);
+}
+
+
+Vector4 BoundingBox::GetExtents() const
+{
+    return Vector4((Max[0] - Min[0]) * 0.5f, (Max[1] - Min[1]) * 0.5f,
+                                        (Max[2] - Min[2]) * 0.5f, 0);
+}
+
+
+BoundingBox BGE_NCP BoundingBox::Expand(Vector4 BGE_NCP Point)
+{
+    for(int i = 0; i < 3; ++i) {
+        if(Point[i] < Min[i])
+            Min[i] = Point[i];
+
+        if(Point[i] > Max[i])
+            Max[i] = Point[i];
+    }
+
+    return *this;
+}
+
+
+BoundingBox BGE_NCP BoundingBox::Expand(BoundingBox BGE_NCP Other)
+{
+    for(int i = 0; i < 3; ++i) {
+        if(Other.Min[i] < Min[i])
+            Min[i] = Other.Min[i];
+
+        if(Other.Max[i] > Max[i])
+            Max[i] = Other.Max[i];
+    }
+
+    return *this;
+}
+
+
+bool BoundingBox::Contains(Vector4 BGE_NCP Point) const
+{
+    return Point[0] >= Min[0] && Point[0] <= Max[0]
+        && Point[1] >= Min[1] && Point[1] <= Max[1]
+        && Point[2] >= Min[2] && Point[2] <= Max[2];
+}
+
+
+bool BoundingBox::Intersects(BoundingBox BGE_NCP Other) const
+{
+    return Min[0] <= Other.Max[0] && Max[0] >= Other.Min[0]
+        && Min[1] <= Other.Max[1] && Max[1] >= Other.Min[1]
+        && Min[2] <= Other.Max[2] && Max[2] >= Other.Min[2];
+}
+
+
+size_t BoundingBox::Intersects(const BoundingBox* Others, bool* Results,
+                                                        size_t N) const
+{
+    size_t Count = 0;
+
+    /* *
+     * Non-short-circuiting & keeps the loop free of branches, so it
+     * doesn't stall on boxes that are hit or missed at random
+     * */
+    for(size_t i = 0; i < N; ++i) {
+        const Scalar* O = &Others[i].Min[0];
+        bool Hit = (Min[0] <= O[4]) & (Max[0] >= O[0])
+                 & (Min[1] <= O[5]) & (Max[1] >= O[1])
+                 & (Min[2] <= O[6]) & (Max[2] >= O[2]);
+
+        Results[i] = Hit;
+        Count += Hit;
+    }
+
+    return Count;
+}
+
+
+BoundingBox BoundingBox::Transformed(Matrix BGE_NCP Transform) const
+{
+    Vector4 Center, Extents, NewExtents;
+
+    if(IsEmpty())
+        return *this;
+
+    Center = Transform * GetCenter();
+    Extents = GetExtents();
+
+    /* *
+     * Each new extent is the sum of the old extents projected onto that
+     * axis, i.e. the absolute value of the upper 3x3 times Extents
+     * */
+    for(int Row = 0; Row < 3; ++Row) {
+        NewExtents[Row] = fabsf(Transform[Row]) * Extents[0]
+                        + fabsf(Transform[4 + Row]) * Extents[1]
+                        + fabsf(Transform[8 + Row]) * Extents[2];
+    }
+
+    return BoundingBox(Center - NewExtents, Center + NewExtents);
+}
+
+} /* bakge */
@@ -0,0 +1,137 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* Batched tests read arrays of BoundingSpheres as packed Scalars */
+static_assert(sizeof(BoundingSphere) == sizeof(Scalar) * 4,
+                            "BoundingSphere must be 4 packed Scalars");
+
+BoundingSphere BoundingSphere::FromPoints(const Scalar* Positions,
+                                                        int NumPoints)
+{
+    Vector4 Center;
+    Scalar MaxDistSq = 0;
+
+    if(NumPoints <= 0)
+        return BoundingSphere();
+
+    Center = BoundingBox::FromPoints(Positions, NumPoints).GetCenter();
+
+    for(int i = 0; i < NumPoints; ++i) {
+        const Scalar* P = &Positions[i * 3];
+        Scalar DX = P[0] - Center[0];
+        Scalar DY = P[1] - Center[1];
+        Scalar DZ = P[2] - Center[2];
+        Scalar DistSq = DX * DX + DY * DY + DZ * DZ;
+
+        if(DistSq > MaxDistSq)
+            MaxDistSq = DistSq;
+    }
+
+    return BoundingSphere(Center, sqrtf(MaxDistSq));
+}
+
+
+bool BoundingSphere::IsEmpty() const
+{
+    return Val[3] < 0;
+}
+
+
+bool BoundingSphere::Contains(Vector4 BGE_NCP Point) const
+{
+    Scalar DX = Point[0] - Val[0];
+    Scalar DY = Point[1] - Val[1];
+    Scalar DZ = Point[2] - Val[2];
+
+    return DX * DX + DY * DY + DZ * DZ <= Val[3] * Val[3] && Val[3] >= 0;
+}
+
+
+bool BoundingSphere::Intersects(BoundingSphere BGE_NCP Other) const
+{
+    Scalar DX = Other.Val[0] - Val[0];
+    Scalar DY = Other.Val[1] - Val[1];
+    Scalar DZ = Other.Val[2] - Val[2];
+    Scalar Radii = Val[3] + Other.Val[3];
+
+    if(IsEmpty() || Other.IsEmpty())
+        return false;
+
+    return DX * DX + DY * DY + DZ * DZ <= Radii * Radii;
+}
+
+
+bool BoundingSphere::Intersects(BoundingBox BGE_NCP Box) const
+{
+    Vector4 BGE_NCP Min = Box.GetMin();
+    Vector4 BGE_NCP Max = Box.GetMax();
+    Scalar DistSq = 0;
+
+    if(IsEmpty() || Box.IsEmpty())
+        return false;
+
+    /* Distance from the center to the closest point in the box */
+    for(int i = 0; i < 3; ++i) {
+        Scalar D = 0;
+
+        if(Val[i] < Min[i])
+            D = Min[i] - Val[i];
+        else if(Val[i] > Max[i])
+            D = Val[i] - Max[i];
+
+        DistSq += D * D;
+    }
+
+    return DistSq <= Val[3] * Val[3];
+}
+
+
+BoundingSphere BoundingSphere::Transformed(Matrix BGE_NCP Transform) const
+{
+    Scalar MaxScaleSq = 0;
+
+    if(IsEmpty())
+        return *this;
+
+    /* The longest basis vector is the largest scale factor */
+    for(int Col = 0; Col < 3; ++Col) {
+        Scalar X = Transform[Col * 4];
+        Scalar Y = Transform[Col * 4 + 1];
+        Scalar Z = Transform[Col * 4 + 2];
+        Scalar ScaleSq = X * X + Y * Y + Z * Z;
+
+        if(ScaleSq > MaxScaleSq)
+            MaxScaleSq = ScaleSq;
+    }
+
+    return BoundingSphere(Transform * GetCenter(),
+                                    Val[3] * sqrtf(MaxScaleSq));
+}
+
+} /* bakge */
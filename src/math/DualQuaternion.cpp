@@ -0,0 +1,224 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* BlendMany hands arrays of DualQuaternions to the kernels as packed Scalars */
+static_assert(sizeof(DualQuaternion) == sizeof(Scalar) * 8,
+                            "DualQuaternion must be 8 packed Scalars");
+
+DualQuaternion::DualQuaternion(Quaternion BGE_NCP Rotation,
+                                Vector4 BGE_NCP Translation)
+{
+    Vector4 BGE_NCP Vec = Rotation.GetVector();
+    Vector4 Offset(Translation[0], Translation[1], Translation[2], 0);
+
+    Real = Vector4(Vec[0], Vec[1], Vec[2], Rotation.GetReal());
+
+    /* Dual = 0.5 * Translation * Real */
+    QuatMultiplyRef(&Offset[0], &Real[0], &Dual[0]);
+
+    for(int i = 0; i < 4; ++i)
+        Dual[i] *= 0.5f;
+}
+
+
+DualQuaternion DualQuaternion::FromTransform(Transform BGE_NCP Xform)
+{
+    return DualQuaternion(Xform.GetRotation(), Xform.GetTranslation());
+}
+
+
+Quaternion DualQuaternion::GetRotation() const
+{
+    return Quaternion(Vector4(Real[0], Real[1], Real[2], 0), Real[3]);
+}
+
+
+Vector4 DualQuaternion::GetTranslation() const
+{
+    Vector4 Conjugate(-Real[0], -Real[1], -Real[2], Real[3]);
+    Vector4 Offset;
+
+    /* Translation = 2 * Dual * conjugate(Real) */
+    QuatMultiplyRef(&Dual[0], &Conjugate[0], &Offset[0]);
+
+    return Vector4(Offset[0] * 2, Offset[1] * 2, Offset[2] * 2, 0);
+}
+
+
+Matrix DualQuaternion::ToMatrix() const
+{
+    Matrix M = GetRotation().ToMatrix();
+    Vector4 Offset = GetTranslation();
+
+    M[12] = Offset[0];
+    M[13] = Offset[1];
+    M[14] = Offset[2];
+
+    return M;
+}
+
+
+DualQuaternion DualQuaternion::operator*(DualQuaternion BGE_NCP Other) const
+{
+    DualQuaternion Composed;
+    Vector4 Cross;
+
+    /* (R1, D1)(R2, D2) = (R1 R2, R1 D2 + D1 R2) */
+    QuatMultiplyRef(&Real[0], &Other.Real[0], &Composed.Real[0]);
+    QuatMultiplyRef(&Real[0], &Other.Dual[0], &Composed.Dual[0]);
+    QuatMultiplyRef(&Dual[0], &Other.Real[0], &Cross[0]);
+    Vec4Add(&Composed.Dual[0], &Cross[0], &Composed.Dual[0]);
+
+    return Composed;
+}
+
+
+DualQuaternion BGE_NCP DualQuaternion::operator*=(DualQuaternion BGE_NCP Other)
+{
+    *this = *this * Other;
+
+    return *this;
+}
+
+
+Vector4 DualQuaternion::operator*(Vector4 BGE_NCP Vec) const
+{
+    Vector4 Moved;
+
+    QuatRotateVec4Ref(&Real[0], &Vec[0], &Moved[0]);
+    Moved += GetTranslation() * Vec[3];
+
+    return Moved;
+}
+
+
+DualQuaternion BGE_NCP DualQuaternion::Invert()
+{
+    Real = Vector4(-Real[0], -Real[1], -Real[2], Real[3]);
+    Dual = Vector4(-Dual[0], -Dual[1], -Dual[2], Dual[3]);
+
+    return *this;
+}
+
+
+DualQuaternion DualQuaternion::Inverted() const
+{
+    return DualQuaternion(*this).Invert();
+}
+
+
+DualQuaternion BGE_NCP DualQuaternion::Normalize()
+{
+    Scalar Len = sqrtf(Vec4Dot4Ref(&Real[0], &Real[0]));
+    Scalar Along;
+
+    /* Don't divide by 0 */
+    if(ScalarCompare(Len, 0))
+        return *this;
+
+    for(int i = 0; i < 4; ++i) {
+        Real[i] /= Len;
+        Dual[i] /= Len;
+    }
+
+    /* A unit dual quaternion's parts are orthogonal */
+    Along = Vec4Dot4Ref(&Real[0], &Dual[0]);
+
+    for(int i = 0; i < 4; ++i)
+        Dual[i] -= Real[i] * Along;
+
+    return *this;
+}
+
+
+DualQuaternion DualQuaternion::Normalized() const
+{
+    return DualQuaternion(*this).Normalize();
+}
+
+
+DualQuaternion DualQuaternion::Blend(DualQuaternion BGE_NCP From,
+                                    DualQuaternion BGE_NCP To, Scalar T)
+{
+    DualQuaternion Blended;
+
+    DualQuatBlends(&From.Real[0], &To.Real[0], T, &Blended.Real[0], 1);
+
+    return Blended;
+}
+
+
+DualQuaternion DualQuaternion::Blend(const DualQuaternion* Joints,
+                                    const Scalar* Weights, int Num)
+{
+    DualQuaternion Blended;
+    Scalar Len;
+
+    if(Num <= 0)
+        return Blended;
+
+    Blended.Real = Vector4(0, 0, 0, 0);
+
+    for(int i = 0; i < Num; ++i) {
+        Scalar Weight = Weights[i];
+
+        /* Keep every joint on the same side as the first */
+        if(Vec4Dot4Ref(&Joints[0].Real[0], &Joints[i].Real[0]) < 0)
+            Weight = -Weight;
+
+        for(int c = 0; c < 4; ++c) {
+            Blended.Real[c] += Joints[i].Real[c] * Weight;
+            Blended.Dual[c] += Joints[i].Dual[c] * Weight;
+        }
+    }
+
+    Len = sqrtf(Vec4Dot4Ref(&Blended.Real[0], &Blended.Real[0]));
+    if(ScalarCompare(Len, 0))
+        return DualQuaternion();
+
+    for(int c = 0; c < 4; ++c) {
+        Blended.Real[c] /= Len;
+        Blended.Dual[c] /= Len;
+    }
+
+    return Blended;
+}
+
+
+void DualQuaternion::BlendMany(const DualQuaternion* From,
+                                const DualQuaternion* To, Scalar T,
+                                DualQuaternion* Out, size_t N)
+{
+    if(N == 0)
+        return;
+
+    DualQuatBlends(&From[0].Real[0], &To[0].Real[0], T, &Out[0].Real[0], N);
+}
+
+} /* bakge */
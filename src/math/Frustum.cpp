@@ -0,0 +1,349 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+/* Objects staged in structure-of-arrays form per pass of a batched test */
+#define FRUSTUM_BATCH_SIZE 64
+
+namespace bakge
+{
+
+Frustum::Frustum()
+{
+    /* A zero normal puts every point at distance W from the plane */
+    for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i)
+        Planes[i] = Vector4(0, 0, 0, FLT_MAX);
+}
+
+
+Frustum::Frustum(Matrix BGE_NCP ViewProjection)
+{
+    SetMatrix(ViewProjection);
+}
+
+
+Frustum BGE_NCP Frustum::SetMatrix(Matrix BGE_NCP ViewProjection)
+{
+    Matrix BGE_NCP M = ViewProjection;
+
+    /* *
+     * Gribb & Hartmann: a point is inside clip space when -w <= x <= w
+     * and likewise for y and z, so each plane is the fourth row of the
+     * matrix plus or minus one of the others. Rows are strided by 4 in
+     * column-major storage.
+     * */
+    for(int i = 0; i < 3; ++i) {
+        Planes[i * 2] = Vector4(M[3] + M[i], M[7] + M[4 + i],
+                                M[11] + M[8 + i], M[15] + M[12 + i]);
+        Planes[i * 2 + 1] = Vector4(M[3] - M[i], M[7] - M[4 + i],
+                                M[11] - M[8 + i], M[15] - M[12 + i]);
+    }
+
+    /* Normalize so plane equations give true distances, needed for spheres */
+    for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        Vector4& P = Planes[i];
+        Scalar Length = sqrtf(P[0] * P[0] + P[1] * P[1] + P[2] * P[2]);
+
+        if(Length == 0)
+            continue;
+
+        P = Vector4(P[0] / Length, P[1] / Length, P[2] / Length,
+                                                    P[3] / Length);
+    }
+
+    return *this;
+}
+
+
+Vector4 BGE_NCP Frustum::GetPlane(FRUSTUM_PLANES Plane) const
+{
+    return Planes[Plane];
+}
+
+
+bool Frustum::Contains(Vector4 BGE_NCP Point) const
+{
+    for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        Vector4 BGE_NCP P = Planes[i];
+
+        if(P[0] * Point[0] + P[1] * Point[1] + P[2] * Point[2] + P[3] < 0)
+            return false;
+    }
+
+    return true;
+}
+
+
+bool Frustum::Intersects(BoundingBox BGE_NCP Box) const
+{
+    Vector4 Center, Extents;
+
+    if(Box.IsEmpty())
+        return false;
+
+    Center = Box.GetCenter();
+    Extents = Box.GetExtents();
+
+    /* *
+     * The box is outside a plane when even its corner furthest along the
+     * plane's normal is behind it
+     * */
+    for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        Vector4 BGE_NCP P = Planes[i];
+        Scalar Dist = P[0] * Center[0] + P[1] * Center[1]
+                    + P[2] * Center[2] + P[3];
+        Scalar Radius = fabsf(P[0]) * Extents[0] + fabsf(P[1]) * Extents[1]
+                      + fabsf(P[2]) * Extents[2];
+
+        if(Dist + Radius < 0)
+            return false;
+    }
+
+    return true;
+}
+
+
+bool Frustum::Intersects(BoundingSphere BGE_NCP Sphere) const
+{
+    Vector4 Center;
+    Scalar Radius;
+
+    if(Sphere.IsEmpty())
+        return false;
+
+    Center = Sphere.GetCenter();
+    Radius = Sphere.GetRadius();
+
+    for(int i = 0; i < NUM_FRUSTUM_PLANES; ++i) {
+        Vector4 BGE_NCP P = Planes[i];
+        Scalar Dist = P[0] * Center[0] + P[1] * Center[1]
+                    + P[2] * Center[2] + P[3];
+
+        if(Dist + Radius < 0)
+            return false;
+    }
+
+    return true;
+}
+
+
+/* *
+ * Both batched tests stage a batch of objects as structure-of-arrays,
+ * then test BGE_LANE_WIDTH objects at a time against each plane. Empty
+ * objects are masked out of the results rather than left to the planes,
+ * which can't reject anything when they don't depend on position (like
+ * the default ones).
+ * */
+struct PlaneLanes
+{
+    ScalarLanes X[NUM_FRUSTUM_PLANES];
+    ScalarLanes Y[NUM_FRUSTUM_PLANES];
+    ScalarLanes Z[NUM_FRUSTUM_PLANES];
+    ScalarLanes W[NUM_FRUSTUM_PLANES];
+
+    /* Absolute normals, to find how far a box reaches along them */
+    ScalarLanes AbsX[NUM_FRUSTUM_PLANES];
+    ScalarLanes AbsY[NUM_FRUSTUM_PLANES];
+    ScalarLanes AbsZ[NUM_FRUSTUM_PLANES];
+};
+
+
+static void BroadcastPlanes(const Vector4* Planes, PlaneLanes* Lanes)
+{
+    for(int p = 0; p < NUM_FRUSTUM_PLANES; ++p) {
+        Lanes->X[p] = LanesSet(Planes[p][0]);
+        Lanes->Y[p] = LanesSet(Planes[p][1]);
+        Lanes->Z[p] = LanesSet(Planes[p][2]);
+        Lanes->W[p] = LanesSet(Planes[p][3]);
+        Lanes->AbsX[p] = LanesSet(fabsf(Planes[p][0]));
+        Lanes->AbsY[p] = LanesSet(fabsf(Planes[p][1]));
+        Lanes->AbsZ[p] = LanesSet(fabsf(Planes[p][2]));
+    }
+}
+
+
+static BGE_INL ScalarLanes PlaneDistance(PlaneLanes BGE_NCP P, int Plane,
+                        ScalarLanes X, ScalarLanes Y, ScalarLanes Z)
+{
+    return LanesAdd(LanesAdd(LanesMul(P.X[Plane], X),
+                                LanesMul(P.Y[Plane], Y)),
+                    LanesAdd(LanesMul(P.Z[Plane], Z), P.W[Plane]));
+}
+
+
+/* Copy staged 1 or 0 visibility out to Results and count the 1s */
+static size_t StoreResults(const Scalar* Visible, bool* Results, size_t N)
+{
+    size_t Count = 0;
+
+    for(size_t i = 0; i < N; ++i) {
+        Results[i] = Visible[i] != 0;
+        Count += Results[i];
+    }
+
+    return Count;
+}
+
+
+size_t Frustum::Intersects(const BoundingBox* Boxes, bool* Results,
+                                                    size_t N) const
+{
+    Scalar CX[FRUSTUM_BATCH_SIZE], CY[FRUSTUM_BATCH_SIZE];
+    Scalar CZ[FRUSTUM_BATCH_SIZE], EX[FRUSTUM_BATCH_SIZE];
+    Scalar EY[FRUSTUM_BATCH_SIZE], EZ[FRUSTUM_BATCH_SIZE];
+    Scalar Keep[FRUSTUM_BATCH_SIZE];
+    Scalar Visible[FRUSTUM_BATCH_SIZE];
+    ScalarLanes Zero = LanesSet(0);
+    ScalarLanes One = LanesSet(1);
+    PlaneLanes P;
+    size_t Count = 0;
+
+    BroadcastPlanes(Planes, &P);
+
+    for(size_t Start = 0; Start < N; Start += FRUSTUM_BATCH_SIZE) {
+        size_t Num = N - Start;
+        size_t Padded;
+
+        if(Num > FRUSTUM_BATCH_SIZE)
+            Num = FRUSTUM_BATCH_SIZE;
+
+        for(size_t i = 0; i < Num; ++i) {
+            Vector4 BGE_NCP Min = Boxes[Start + i].GetMin();
+            Vector4 BGE_NCP Max = Boxes[Start + i].GetMax();
+
+            CX[i] = (Min[0] + Max[0]) * 0.5f;
+            CY[i] = (Min[1] + Max[1]) * 0.5f;
+            CZ[i] = (Min[2] + Max[2]) * 0.5f;
+            EX[i] = (Max[0] - Min[0]) * 0.5f;
+            EY[i] = (Max[1] - Min[1]) * 0.5f;
+            EZ[i] = (Max[2] - Min[2]) * 0.5f;
+
+            /* Same test as IsEmpty; zero extents keep the math finite */
+            Keep[i] = Boxes[Start + i].IsEmpty() ? 0 : 1;
+            if(Keep[i] == 0)
+                EX[i] = EY[i] = EZ[i] = 0;
+        }
+
+        /* Fill out the last group of lanes; their results are ignored */
+        Padded = (Num + BGE_LANE_WIDTH - 1) & ~(size_t)(BGE_LANE_WIDTH - 1);
+        for(size_t i = Num; i < Padded; ++i) {
+            CX[i] = CY[i] = CZ[i] = 0;
+            EX[i] = EY[i] = EZ[i] = 0;
+            Keep[i] = 0;
+        }
+
+        for(size_t i = 0; i < Padded; i += BGE_LANE_WIDTH) {
+            ScalarLanes X = LanesLoadU(&CX[i]);
+            ScalarLanes Y = LanesLoadU(&CY[i]);
+            ScalarLanes Z = LanesLoadU(&CZ[i]);
+            ScalarLanes RX = LanesLoadU(&EX[i]);
+            ScalarLanes RY = LanesLoadU(&EY[i]);
+            ScalarLanes RZ = LanesLoadU(&EZ[i]);
+            ScalarLanes Kept = LanesLoadU(&Keep[i]);
+            LaneMask Outside = LanesLess(One, Zero); /* All false */
+
+            /* Boxes reach furthest along a normal at one of their corners */
+            for(int p = 0; p < NUM_FRUSTUM_PLANES; ++p) {
+                ScalarLanes Reach = LanesAdd(LanesAdd(
+                                            LanesMul(P.AbsX[p], RX),
+                                            LanesMul(P.AbsY[p], RY)),
+                                            LanesMul(P.AbsZ[p], RZ));
+                ScalarLanes Dist = PlaneDistance(P, p, X, Y, Z);
+
+                Outside = LanesOr(Outside, LanesLess(LanesAdd(Dist, Reach),
+                                                                    Zero));
+            }
+
+            LanesStoreU(&Visible[i], LanesSelect(Outside, Zero, Kept));
+        }
+
+        Count += StoreResults(Visible, &Results[Start], Num);
+    }
+
+    return Count;
+}
+
+
+size_t Frustum::Intersects(const BoundingSphere* Spheres, bool* Results,
+                                                    size_t N) const
+{
+    Scalar CX[FRUSTUM_BATCH_SIZE], CY[FRUSTUM_BATCH_SIZE];
+    Scalar CZ[FRUSTUM_BATCH_SIZE], R[FRUSTUM_BATCH_SIZE];
+    Scalar Keep[FRUSTUM_BATCH_SIZE];
+    Scalar Visible[FRUSTUM_BATCH_SIZE];
+    ScalarLanes Zero = LanesSet(0);
+    ScalarLanes One = LanesSet(1);
+    PlaneLanes P;
+    size_t Count = 0;
+
+    BroadcastPlanes(Planes, &P);
+
+    for(size_t Start = 0; Start < N; Start += FRUSTUM_BATCH_SIZE) {
+        size_t Num = N - Start;
+        size_t Padded;
+
+        if(Num > FRUSTUM_BATCH_SIZE)
+            Num = FRUSTUM_BATCH_SIZE;
+
+        for(size_t i = 0; i < Num; ++i) {
+            Vector4 Center = Spheres[Start + i].GetCenter();
+            Scalar Radius = Spheres[Start + i].GetRadius();
+
+            CX[i] = Center[0];
+            CY[i] = Center[1];
+            CZ[i] = Center[2];
+            Keep[i] = Spheres[Start + i].IsEmpty() ? 0 : 1;
+            R[i] = Keep[i] != 0 ? Radius : 0;
+        }
+
+        Padded = (Num + BGE_LANE_WIDTH - 1) & ~(size_t)(BGE_LANE_WIDTH - 1);
+        for(size_t i = Num; i < Padded; ++i)
+            CX[i] = CY[i] = CZ[i] = R[i] = Keep[i] = 0;
+
+        for(size_t i = 0; i < Padded; i += BGE_LANE_WIDTH) {
+            ScalarLanes X = LanesLoadU(&CX[i]);
+            ScalarLanes Y = LanesLoadU(&CY[i]);
+            ScalarLanes Z = LanesLoadU(&CZ[i]);
+            ScalarLanes Radius = LanesLoadU(&R[i]);
+            ScalarLanes Kept = LanesLoadU(&Keep[i]);
+            LaneMask Outside = LanesLess(One, Zero); /* All false */
+
+            for(int p = 0; p < NUM_FRUSTUM_PLANES; ++p) {
+                ScalarLanes Dist = PlaneDistance(P, p, X, Y, Z);
+
+                Outside = LanesOr(Outside, LanesLess(LanesAdd(Dist, Radius),
+                                                                    Zero));
+            }
+
+            LanesStoreU(&Visible[i], LanesSelect(Outside, Zero, Kept));
+        }
+
+        Count += StoreResults(Visible, &Results[Start], Num);
+    }
+
+    return Count;
+}
+
+} /* bakge */
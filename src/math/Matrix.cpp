@@ -27,41 +27,8 @@
 namespace bakge
 {
 
-const Matrix Matrix::Identity;
-
-Matrix::Matrix()
-{
-    SetIdentity();
-}
-
-
-Matrix::~Matrix()
-{
-}
-
-
-Matrix::Matrix(Scalar A, Scalar B, Scalar C, Scalar D,
-           Scalar E, Scalar F, Scalar G, Scalar H,
-           Scalar I, Scalar J, Scalar K, Scalar L,
-           Scalar M, Scalar N, Scalar O, Scalar P)
-{
-    Val[0] = A;
-    Val[1] = B;
-    Val[2] = C;
-    Val[3] = D;
-    Val[4] = E;
-    Val[5] = F;
-    Val[6] = G;
-    Val[7] = H;
-    Val[8] = I;
-    Val[9] = J;
-    Val[10] = K;
-    Val[11] = L;
-    Val[12] = M;
-    Val[13] = N;
-    Val[14] = O;
-    Val[15] = P;
-}
+/* constexpr guarantees this is initialized at compile time */
+constexpr Matrix Matrix::Identity = Matrix();
 
 
 Matrix BGE_NCP Matrix::SetLookAt(Vector4 BGE_NCP Position,
@@ -119,16 +86,103 @@ Matrix BGE_NCP Matrix::SetPerspective(Scalar FOV, Scalar Aspect,
     SetIdentity();
 
     S = 1 / tan(FOV * 0.5f * BGE_RAD_PER_DEG);
-    Clip1 = -FarClip / (FarClip - NearClip);
-    Clip2 = (-FarClip * NearClip) / (FarClip - NearClip);
+    Clip1 = (FarClip + NearClip) / (NearClip - FarClip);
+    Clip2 = (2 * FarClip * NearClip) / (NearClip - FarClip);
 
+    /* Column-major, mapping -NearClip..-FarClip to OpenGL's -1..1 depth */
     Val[0] = S / Aspect;
     Val[5] = S;
     Val[10] = Clip1;
-    Val[11] = Clip2;
-    Val[14] = -1;
+    Val[11] = -1;
+    Val[14] = Clip2;
+    Val[15] = 0;
+
+    return *this;
+}
+
+
+Matrix Matrix::operator*(Matrix BGE_NCP Other) const
+{
+    Matrix Product;
+
+    Mat4Multiply(Val, Other.Val, Product.Val);
+
+    return Product;
+}
+
+
+Matrix BGE_NCP Matrix::operator*=(Matrix BGE_NCP Other)
+{
+    Mat4Multiply(Val, Other.Val, Val);
 
     return *this;
 }
 
+
+Vector4 Matrix::operator*(Vector4 BGE_NCP Vec) const
+{
+    Vector4 Transformed;
+
+    Mat4TransformVec4s(Val, &Vec[0], &Transformed[0], 1);
+
+    return Transformed;
+}
+
+
+void Matrix::TransformPoints(const Vector4* In, Vector4* Out, size_t N) const
+{
+    if(N == 0)
+        return;
+
+    Mat4TransformVec4s(Val, &In[0][0], &Out[0][0], N);
+}
+
+
+Matrix BGE_NCP Matrix::Transpose()
+{
+    Mat4Transpose(Val, Val);
+
+    return *this;
+}
+
+
+Matrix Matrix::Transposed() const
+{
+    Matrix Trans;
+
+    Mat4Transpose(Val, Trans.Val);
+
+    return Trans;
+}
+
+
+Matrix BGE_NCP Matrix::Invert()
+{
+    if(Mat4Inverse(Val, Val) == 0)
+        printf("Singular matrix. Cancelling operation\n");
+
+    return *this;
+}
+
+
+Matrix Matrix::Inverted() const
+{
+    return Matrix(*this).Invert();
+}
+
+
+Matrix BGE_NCP Matrix::InvertAffine()
+{
+    if(Mat4InverseAffine(Val, Val) == 0)
+        printf("Singular matrix. Cancelling operation\n");
+
+    return *this;
+}
+
+
+Matrix Matrix::InvertedAffine() const
+{
+    return Matrix(*this).InvertAffine();
+}
+
 } /* bakge */
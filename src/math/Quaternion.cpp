@@ -27,30 +27,6 @@
 namespace bakge
 {
 
-Quaternion::Quaternion()
-{
-}
-
-
-Quaternion::Quaternion(Vector4 BGE_NCP Vec, Scalar BGE_NCP Real)
-{
-    this->Vec = Vec;
-    this->Real = Real;
-}
-
-
-Quaternion::Quaternion(Quaternion BGE_NCP Other)
-{
-    Vec = Other.Vec;
-    Real = Other.Real;
-}
-
-
-Quaternion::~Quaternion()
-{
-}
-
-
 Matrix Quaternion::ToMatrix() const
 {
     return Matrix(
@@ -265,13 +241,109 @@ Quaternion Quaternion::Normalized() const
 
 Scalar Quaternion::Length() const
 {
-    return sqrt(LengthSq());
+    return sqrtf(LengthSq());
 }
 
 
 Scalar Quaternion::LengthSq() const
 {
-    return Scalar(Real * Real + pow(Vec.Length(), 2));
+    return Real * Real + Vec.LengthSquared();
+}
+
+
+Vector4 Quaternion::Rotate(Vector4 BGE_NCP Vec) const
+{
+    Scalar Q[4] = { this->Vec[0], this->Vec[1], this->Vec[2], Real };
+    Vector4 Rotated;
+
+    QuatRotateVec4Ref(Q, &Vec[0], &Rotated[0]);
+
+    return Rotated;
+}
+
+
+void Quaternion::RotateMany(const Vector4* In, Vector4* Out, size_t N) const
+{
+    Scalar Q[4] = { Vec[0], Vec[1], Vec[2], Real };
+
+    if(N == 0)
+        return;
+
+    QuatRotateVec4s(Q, &In[0][0], &Out[0][0], N);
+}
+
+
+void Quaternion::RotateMany(const Quaternion* Rotations, const Vector4* In,
+                                                    Vector4* Out, size_t N)
+{
+    /* Quaternions are repacked as X, Y, Z, W for the kernel in batches */
+    Scalar Packed[64][4];
+    size_t Start, Batch;
+    bool Backwards;
+
+    /* Like memmove: if Out trails In, work from the end */
+    Backwards = Out > In && Out < In + N;
+
+    for(size_t Done = 0; Done < N; Done += Batch) {
+        Batch = N - Done < 64 ? N - Done : 64;
+        Start = Backwards ? N - Done - Batch : Done;
+
+        for(size_t i = 0; i < Batch; ++i) {
+            Quaternion BGE_NCP Q = Rotations[Start + i];
+
+            Packed[i][0] = Q.Vec[0];
+            Packed[i][1] = Q.Vec[1];
+            Packed[i][2] = Q.Vec[2];
+            Packed[i][3] = Q.Real;
+        }
+
+        QuatRotateEachVec4s(&Packed[0][0], &In[Start][0], &Out[Start][0],
+                                                                    Batch);
+    }
+}
+
+
+Quaternion Quaternion::Slerp(Quaternion BGE_NCP From, Quaternion BGE_NCP To,
+                                                                Scalar T)
+{
+    Quaternion End = To;
+    Scalar CosTheta, Theta, SinTheta;
+
+    /* 4D dot product; the cosine of the angle between From and To */
+    CosTheta = Dot(From.Vec, To.Vec) + From.Real * To.Real;
+
+    /* Q and -Q are the same rotation. Pick the one on the shorter arc */
+    if(CosTheta < 0) {
+        End = -To;
+        CosTheta = -CosTheta;
+    }
+
+    /* *
+     * Nearly parallel inputs make sin(Theta) vanish. Nlerp is accurate
+     * there and avoids the division
+     * */
+    if(CosTheta > 0.9995f)
+        return Nlerp(From, End, T);
+
+    Theta = acosf(CosTheta);
+    SinTheta = sinf(Theta);
+
+    return From * (sinf((1 - T) * Theta) / SinTheta)
+                    + End * (sinf(T * Theta) / SinTheta);
+}
+
+
+Quaternion Quaternion::Nlerp(Quaternion BGE_NCP From, Quaternion BGE_NCP To,
+                                                                Scalar T)
+{
+    Quaternion Blend;
+
+    if(Dot(From.Vec, To.Vec) + From.Real * To.Real < 0)
+        Blend = From * (1 - T) - To * T;
+    else
+        Blend = From * (1 - T) + To * T;
+
+    return Blend.Normalize();
 }
 
 } /* bakge */
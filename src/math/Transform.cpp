@@ -0,0 +1,202 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* BlendMany hands arrays of Transforms to the kernels as packed Scalars */
+static_assert(sizeof(Transform) == sizeof(Scalar) * 12,
+                            "Transform must be 12 packed Scalars");
+
+Transform::Transform(Vector4 BGE_NCP Translation, Quaternion BGE_NCP Rotation,
+                                                    Vector4 BGE_NCP Scale)
+{
+    SetTranslation(Translation);
+    SetRotation(Rotation);
+    SetScale(Scale);
+}
+
+
+Vector4 Transform::GetTranslation() const
+{
+    return Translation;
+}
+
+
+Quaternion Transform::GetRotation() const
+{
+    return Quaternion(Vector4(Rotation[0], Rotation[1], Rotation[2], 0),
+                                                            Rotation[3]);
+}
+
+
+Vector4 Transform::GetScale() const
+{
+    return Scale;
+}
+
+
+void Transform::SetTranslation(Vector4 BGE_NCP Translation)
+{
+    this->Translation = Vector4(Translation[0], Translation[1],
+                                            Translation[2], 0);
+}
+
+
+void Transform::SetRotation(Quaternion BGE_NCP Rotation)
+{
+    Vector4 BGE_NCP Vec = Rotation.GetVector();
+
+    this->Rotation = Vector4(Vec[0], Vec[1], Vec[2], Rotation.GetReal());
+}
+
+
+void Transform::SetScale(Vector4 BGE_NCP Scale)
+{
+    this->Scale = Vector4(Scale[0], Scale[1], Scale[2], 0);
+}
+
+
+void Transform::SetScale(Scalar Uniform)
+{
+    Scale = Vector4(Uniform, Uniform, Uniform, 0);
+}
+
+
+Matrix Transform::ToMatrix() const
+{
+    Matrix M = GetRotation().ToMatrix();
+
+    /* Scale each basis column, then place the translation */
+    for(int Col = 0; Col < 3; ++Col) {
+        for(int Row = 0; Row < 3; ++Row)
+            M[Col * 4 + Row] *= Scale[Col];
+    }
+
+    M[12] = Translation[0];
+    M[13] = Translation[1];
+    M[14] = Translation[2];
+
+    return M;
+}
+
+
+Transform Transform::operator*(Transform BGE_NCP Other) const
+{
+    Transform Composed;
+    Vector4 Scaled(Other.Translation[0] * Scale[0],
+                   Other.Translation[1] * Scale[1],
+                   Other.Translation[2] * Scale[2], 0);
+
+    /* Other's translation is carried through this scale and rotation */
+    QuatRotateVec4Ref(&Rotation[0], &Scaled[0], &Composed.Translation[0]);
+    Composed.Translation += Translation;
+
+    QuatMultiplyRef(&Rotation[0], &Other.Rotation[0],
+                                    &Composed.Rotation[0]);
+
+    Composed.Scale = Vector4(Scale[0] * Other.Scale[0],
+                             Scale[1] * Other.Scale[1],
+                             Scale[2] * Other.Scale[2], 0);
+
+    return Composed;
+}
+
+
+Transform BGE_NCP Transform::operator*=(Transform BGE_NCP Other)
+{
+    *this = *this * Other;
+
+    return *this;
+}
+
+
+Vector4 Transform::operator*(Vector4 BGE_NCP Vec) const
+{
+    Vector4 Scaled(Vec[0] * Scale[0], Vec[1] * Scale[1], Vec[2] * Scale[2],
+                                                                    Vec[3]);
+    Vector4 Moved;
+
+    QuatRotateVec4Ref(&Rotation[0], &Scaled[0], &Moved[0]);
+    Moved += Translation * Vec[3];
+
+    return Moved;
+}
+
+
+Transform BGE_NCP Transform::Invert()
+{
+    Vector4 Moved;
+
+    if(ScalarCompare(Scale[0], 0) || ScalarCompare(Scale[1], 0)
+                                  || ScalarCompare(Scale[2], 0)) {
+        printf("Division by 0. Cancelling operation\n");
+        return *this;
+    }
+
+    Scale = Vector4(1 / Scale[0], 1 / Scale[1], 1 / Scale[2], 0);
+
+    /* Conjugate; the inverse of a unit quaternion */
+    Rotation = Vector4(-Rotation[0], -Rotation[1], -Rotation[2],
+                                                        Rotation[3]);
+
+    QuatRotateVec4Ref(&Rotation[0], &Translation[0], &Moved[0]);
+    Translation = Vector4(-Moved[0] * Scale[0], -Moved[1] * Scale[1],
+                                            -Moved[2] * Scale[2], 0);
+
+    return *this;
+}
+
+
+Transform Transform::Inverted() const
+{
+    return Transform(*this).Invert();
+}
+
+
+Transform Transform::Blend(Transform BGE_NCP From, Transform BGE_NCP To,
+                                                            Scalar T)
+{
+    Transform Blended;
+
+    TransformBlends(&From.Rotation[0], &To.Rotation[0], T,
+                                    &Blended.Rotation[0], 1);
+
+    return Blended;
+}
+
+
+void Transform::BlendMany(const Transform* From, const Transform* To,
+                                    Scalar T, Transform* Out, size_t N)
+{
+    if(N == 0)
+        return;
+
+    TransformBlends(&From[0].Rotation[0], &To[0].Rotation[0], T,
+                                            &Out[0].Rotation[0], N);
+}
+
+} /* bakge */
@@ -27,56 +27,6 @@
 namespace bakge
 {
 
-Vector3::Vector3()
-{
-    Val[0] = 0;
-    Val[1] = 0;
-    Val[2] = 1.0;
-}
-
-
-Vector3::Vector3(Vector3 BGE_NCP Other)
-{
-    *this = Other;
-}
-
-
-Vector3::Vector3(Scalar X, Scalar Y, Scalar Z)
-{
-    Val[0] = X;
-    Val[1] = Y;
-    Val[2] = Z;
-}
-
-
-Vector3::~Vector3()
-{
-}
-
-
-Scalar& Vector3::operator[](int BGE_NCP At)
-{
-    return Val[At];
-}
-
-
-Scalar BGE_NCP Vector3::operator[](int BGE_NCP At) const
-{
-    return Val[At];
-}
-
-
-Vector3 BGE_NCP Vector3::operator=(Vector3 BGE_NCP Other)
-{
-    Val[0] = Other[0];
-    Val[1] = Other[1];
-    Val[2] = Other[2];
-
-    /* Cascading assignment */
-    return *this;
-}
-
-
 bool Vector3::operator==(Vector3 BGE_NCP Other) const
 {
     return ScalarCompare(Val[0], Other.Val[0])
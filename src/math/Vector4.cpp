@@ -27,40 +27,9 @@
 namespace bakge
 {
 
-const Vector4 Vector4::Origin;
-const Vector4 Vector4::ZeroVector(0, 0, 0, 0);
-
-Vector4::Vector4()
-{
-    Val[0] = 0;
-    Val[1] = 0;
-    Val[2] = 0;
-    Val[3] = 1.0;
-}
-
-
-Vector4::Vector4(Scalar X, Scalar Y, Scalar Z, Scalar W)
-{
-    Val[0] = X;
-    Val[1] = Y;
-    Val[2] = Z;
-    Val[3] = W;
-}
-
-
-Vector4::Vector4(Vector4 BGE_NCP Other)
-{
-    Val[0] = Other[0];
-    Val[1] = Other[1];
-    Val[2] = Other[2];
-    Val[3] = Other[3];
-}
-
-
-Vector4::~Vector4()
-{
-}
-
+/* constexpr guarantees these are initialized at compile time */
+constexpr Vector4 Vector4::Origin = Vector4();
+constexpr Vector4 Vector4::ZeroVector = Vector4(0, 0, 0, 0);
 
 Vector4 Vector4::operator-() const
 {
@@ -87,34 +56,9 @@ Vector4 UnitVector(Scalar X, Scalar Y, Scalar Z)
 }
 
 
-Scalar& Vector4::operator[](int BGE_NCP At)
-{
-    return Val[At];
-}
-
-
-Scalar BGE_NCP Vector4::operator[](int BGE_NCP At) const
-{
-    return Val[At];
-}
-
-
-Vector4 BGE_NCP Vector4::operator=(Vector4 BGE_NCP Other)
-{
-    Val[0] = Other[0];
-    Val[1] = Other[1];
-    Val[2] = Other[2];
-    Val[3] = Other[3];
-
-    return *this;
-}
-
-
 Vector4 BGE_NCP Vector4::operator+=(Vector4 BGE_NCP Other)
 {
-    Val[0] += Other[0];
-    Val[1] += Other[1];
-    Val[2] += Other[2];
+    Vec4AddXYZ(Val, Other.Val, Val);
 
     return *this;
 }
@@ -122,9 +66,7 @@ Vector4 BGE_NCP Vector4::operator+=(Vector4 BGE_NCP Other)
 
 Vector4 BGE_NCP Vector4::operator-=(Vector4 BGE_NCP Other)
 {
-    Val[0] -= Other[0];
-    Val[1] -= Other[1];
-    Val[2] -= Other[2];
+    Vec4SubXYZ(Val, Other.Val, Val);
 
     return *this;
 }
@@ -132,9 +74,7 @@ Vector4 BGE_NCP Vector4::operator-=(Vector4 BGE_NCP Other)
 
 Vector4 BGE_NCP Vector4::operator*=(Scalar BGE_NCP Value)
 {
-    Val[0] *= Value;
-    Val[1] *= Value;
-    Val[2] *= Value;
+    Vec4ScaleXYZ(Val, Value, Val);
 
     return *this;
 }
@@ -165,10 +105,7 @@ bool Vector4::operator==(Vector4 BGE_NCP Other) const
 
 Vector4 BGE_NCP Vector4::Normalize()
 {
-    Scalar Len = Length();
-    Val[0] /= Len;
-    Val[1] /= Len;
-    Val[2] /= Len;
+    Vec4NormalizeXYZ(Val, Val);
 
     return *this;
 }
@@ -176,16 +113,18 @@ Vector4 BGE_NCP Vector4::Normalize()
 
 Vector4 Vector4::Normalized() const
 {
-    Scalar Len;
+    Vector4 Unit;
 
-    Len = Length();
-    return Vector4(Val[0] / Len, Val[1] / Len, Val[2] / Len, 0);
+    Vec4NormalizeXYZ(Val, Unit.Val);
+    Unit.Val[3] = 0;
+
+    return Unit;
 }
 
 
 Scalar Vector4::LengthSquared() const
 {
-    return Scalar(Val[0] * Val[0] + Val[1] * Val[1] + Val[2] * Val[2]);
+    return Vec4Dot3(Val, Val);
 }
 
 
@@ -197,38 +136,47 @@ Scalar Vector4::Length() const
 
 Scalar Dot(Vector4 BGE_NCP Left, Vector4 BGE_NCP Right)
 {
-    return Left[0] * Right[0] + Left[1] * Right[1] + Left[2] * Right[2];
+    return Vec4Dot3(&Left[0], &Right[0]);
 }
 
 
 Vector4 Cross(Vector4 BGE_NCP Left, Vector4 BGE_NCP Right)
 {
-    return Vector4(
-        Left[1] * Right[2] - Left[2] * Right[1],
-        Left[2] * Right[0] - Left[0] * Right[2],
-        Left[0] * Right[1] - Left[1] * Right[0],
-        0
-    );
+    Vector4 Product;
+
+    Vec4Cross3(&Left[0], &Right[0], &Product[0]);
+
+    return Product;
 }
 
 
 Vector4 Vector4::operator+(Vector4 BGE_NCP Other) const
 {
-    return Vector4(Val[0] + Other[0], Val[1] + Other[1], Val[2] + Other[2],
-                                                        Val[3] + Other[3]);
+    Vector4 Sum;
+
+    Vec4Add(Val, Other.Val, Sum.Val);
+
+    return Sum;
 }
 
 
 Vector4 Vector4::operator-(Vector4 BGE_NCP Other) const
 {
-    return Vector4(Val[0] - Other[0], Val[1] - Other[1], Val[2] - Other[2],
-                                                        Val[3] - Other[3]);
+    Vector4 Difference;
+
+    Vec4Sub(Val, Other.Val, Difference.Val);
+
+    return Difference;
 }
 
 
 Vector4 Vector4::operator*(Scalar BGE_NCP Value) const
 {
-    return Vector4(Val[0] * Value, Val[1] * Value, Val[2] * Value, Val[3]);
+    Vector4 Scaled;
+
+    Vec4ScaleXYZ(Val, Value, Scaled.Val);
+
+    return Scaled;
 }
 
 
@@ -0,0 +1,359 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+VectorStream::VectorStream()
+{
+    Memory = NULL;
+    Count = 0;
+    Stride = 0;
+
+    for(int i = 0; i < 4; ++i)
+        Components[i] = NULL;
+}
+
+
+VectorStream::~VectorStream()
+{
+    if(Memory != NULL)
+        TrackedFree(Memory);
+}
+
+
+VectorStream* VectorStream::Create(size_t NumVectors)
+{
+    VectorStream* V;
+    Byte* Aligned;
+
+    if(NumVectors == 0) {
+        printf("Vector stream must hold at least 1 vector\n");
+        return NULL;
+    }
+
+    V = new VectorStream;
+    if(V == NULL) {
+        printf("Error allocating new vector stream\n");
+        return NULL;
+    }
+
+    /* Pad each array to a whole number of 64 byte cache lines */
+    V->Count = NumVectors;
+    V->Stride = (NumVectors + 15) & ~(size_t)15;
+
+    /* One block for all 4 arrays, with slack to align its start */
+    V->Memory = (Byte*)TrackedCalloc(V->Stride * 4 * sizeof(Scalar) + 63,
+                                                        MEMORY_TAG_MATH);
+    if(V->Memory == NULL) {
+        printf("Error allocating vector stream memory\n");
+        delete V;
+        return NULL;
+    }
+
+    Aligned = (Byte*)(((size_t)V->Memory + 63) & ~(size_t)63);
+
+    for(int i = 0; i < 4; ++i)
+        V->Components[i] = (Scalar*)Aligned + V->Stride * i;
+
+    return V;
+}
+
+
+Vector4 VectorStream::GetVector(size_t At) const
+{
+    return Vector4(Components[0][At], Components[1][At], Components[2][At],
+                                                        Components[3][At]);
+}
+
+
+void VectorStream::SetVector(size_t At, Vector4 BGE_NCP Vec)
+{
+    Components[0][At] = Vec[0];
+    Components[1][At] = Vec[1];
+    Components[2][At] = Vec[2];
+    Components[3][At] = Vec[3];
+}
+
+
+Result VectorStream::FromVectors(const Vector4* In, size_t N, size_t Offset)
+{
+    Scalar* X = Components[0] + Offset;
+    Scalar* Y = Components[1] + Offset;
+    Scalar* Z = Components[2] + Offset;
+    Scalar* W = Components[3] + Offset;
+    size_t i = 0;
+
+    if(Offset > Count || N > Count - Offset)
+        return BGE_FAILURE;
+
+#ifdef BGE_SIMD_SSE
+    /* Transpose 4 vectors at a time */
+    for(; i + 4 <= N; i += 4) {
+        __m128 R0 = _mm_loadu_ps(&In[i][0]);
+        __m128 R1 = _mm_loadu_ps(&In[i + 1][0]);
+        __m128 R2 = _mm_loadu_ps(&In[i + 2][0]);
+        __m128 R3 = _mm_loadu_ps(&In[i + 3][0]);
+
+        _MM_TRANSPOSE4_PS(R0, R1, R2, R3);
+
+        _mm_storeu_ps(X + i, R0);
+        _mm_storeu_ps(Y + i, R1);
+        _mm_storeu_ps(Z + i, R2);
+        _mm_storeu_ps(W + i, R3);
+    }
+#endif /* BGE_SIMD_SSE */
+
+    for(; i < N; ++i) {
+        X[i] = In[i][0];
+        Y[i] = In[i][1];
+        Z[i] = In[i][2];
+        W[i] = In[i][3];
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result VectorStream::ToVectors(Vector4* Out, size_t N, size_t Offset) const
+{
+    const Scalar* X = Components[0] + Offset;
+    const Scalar* Y = Components[1] + Offset;
+    const Scalar* Z = Components[2] + Offset;
+    const Scalar* W = Components[3] + Offset;
+    size_t i = 0;
+
+    if(Offset > Count || N > Count - Offset)
+        return BGE_FAILURE;
+
+#ifdef BGE_SIMD_SSE
+    for(; i + 4 <= N; i += 4) {
+        __m128 R0 = _mm_loadu_ps(X + i);
+        __m128 R1 = _mm_loadu_ps(Y + i);
+        __m128 R2 = _mm_loadu_ps(Z + i);
+        __m128 R3 = _mm_loadu_ps(W + i);
+
+        _MM_TRANSPOSE4_PS(R0, R1, R2, R3);
+
+        _mm_storeu_ps(&Out[i][0], R0);
+        _mm_storeu_ps(&Out[i + 1][0], R1);
+        _mm_storeu_ps(&Out[i + 2][0], R2);
+        _mm_storeu_ps(&Out[i + 3][0], R3);
+    }
+#endif /* BGE_SIMD_SSE */
+
+    for(; i < N; ++i)
+        Out[i] = Vector4(X[i], Y[i], Z[i], W[i]);
+
+    return BGE_SUCCESS;
+}
+
+
+/* *
+ * The kernels below run over the whole padded Stride rather than Count.
+ * Padding is private to the stream, so this is safe and saves a scalar
+ * remainder loop in every operation.
+ * */
+Result VectorStream::Add(VectorStream BGE_NCP Other)
+{
+    if(Other.Count != Count)
+        return BGE_FAILURE;
+
+    for(int c = 0; c < 3; ++c) {
+        Scalar* L = Components[c];
+        const Scalar* R = Other.Components[c];
+
+        for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH)
+            LanesStore(L + i, LanesAdd(LanesLoad(L + i), LanesLoad(R + i)));
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result VectorStream::Subtract(VectorStream BGE_NCP Other)
+{
+    if(Other.Count != Count)
+        return BGE_FAILURE;
+
+    for(int c = 0; c < 3; ++c) {
+        Scalar* L = Components[c];
+        const Scalar* R = Other.Components[c];
+
+        for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH)
+            LanesStore(L + i, LanesSub(LanesLoad(L + i), LanesLoad(R + i)));
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result VectorStream::AddScaled(VectorStream BGE_NCP Other, Scalar Factor)
+{
+    ScalarLanes F = LanesSet(Factor);
+
+    if(Other.Count != Count)
+        return BGE_FAILURE;
+
+    for(int c = 0; c < 3; ++c) {
+        Scalar* L = Components[c];
+        const Scalar* R = Other.Components[c];
+
+        for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH)
+            LanesStore(L + i, LanesAdd(LanesLoad(L + i),
+                                        LanesMul(LanesLoad(R + i), F)));
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+void VectorStream::Scale(Scalar Factor)
+{
+    ScalarLanes F = LanesSet(Factor);
+
+    for(int c = 0; c < 3; ++c) {
+        Scalar* L = Components[c];
+
+        for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH)
+            LanesStore(L + i, LanesMul(LanesLoad(L + i), F));
+    }
+}
+
+
+void VectorStream::Normalize()
+{
+    Scalar* X = Components[0];
+    Scalar* Y = Components[1];
+    Scalar* Z = Components[2];
+
+    for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH) {
+        ScalarLanes VX = LanesLoad(X + i);
+        ScalarLanes VY = LanesLoad(Y + i);
+        ScalarLanes VZ = LanesLoad(Z + i);
+        ScalarLanes Len;
+
+        Len = LanesSqrt(LanesAdd(LanesAdd(LanesMul(VX, VX), LanesMul(VY, VY)),
+                                                        LanesMul(VZ, VZ)));
+
+        LanesStore(X + i, LanesDiv(VX, Len));
+        LanesStore(Y + i, LanesDiv(VY, Len));
+        LanesStore(Z + i, LanesDiv(VZ, Len));
+    }
+}
+
+
+Result VectorStream::Dot(VectorStream BGE_NCP Other, Scalar* Out) const
+{
+    const Scalar* LX = Components[0];
+    const Scalar* LY = Components[1];
+    const Scalar* LZ = Components[2];
+    const Scalar* RX = Other.Components[0];
+    const Scalar* RY = Other.Components[1];
+    const Scalar* RZ = Other.Components[2];
+    size_t i = 0;
+
+    if(Other.Count != Count)
+        return BGE_FAILURE;
+
+    /* Out belongs to the caller and isn't padded, so stop at Count */
+    for(; i + BGE_LANE_WIDTH <= Count; i += BGE_LANE_WIDTH) {
+        ScalarLanes D;
+
+        D = LanesAdd(LanesAdd(LanesMul(LanesLoad(LX + i), LanesLoad(RX + i)),
+                              LanesMul(LanesLoad(LY + i), LanesLoad(RY + i))),
+                              LanesMul(LanesLoad(LZ + i), LanesLoad(RZ + i)));
+
+        LanesStoreU(Out + i, D);
+    }
+
+    for(; i < Count; ++i)
+        Out[i] = LX[i] * RX[i] + LY[i] * RY[i] + LZ[i] * RZ[i];
+
+    return BGE_SUCCESS;
+}
+
+
+Result VectorStream::Cross(VectorStream BGE_NCP Left,
+                                        VectorStream BGE_NCP Right)
+{
+    ScalarLanes Zero = LanesSet(0);
+
+    if(Left.Count != Count || Right.Count != Count)
+        return BGE_FAILURE;
+
+    /* Each lane is read fully before it is written, so aliasing is fine */
+    for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH) {
+        ScalarLanes LX = LanesLoad(Left.Components[0] + i);
+        ScalarLanes LY = LanesLoad(Left.Components[1] + i);
+        ScalarLanes LZ = LanesLoad(Left.Components[2] + i);
+        ScalarLanes RX = LanesLoad(Right.Components[0] + i);
+        ScalarLanes RY = LanesLoad(Right.Components[1] + i);
+        ScalarLanes RZ = LanesLoad(Right.Components[2] + i);
+
+        LanesStore(Components[0] + i, LanesSub(LanesMul(LY, RZ),
+                                                LanesMul(LZ, RY)));
+        LanesStore(Components[1] + i, LanesSub(LanesMul(LZ, RX),
+                                                LanesMul(LX, RZ)));
+        LanesStore(Components[2] + i, LanesSub(LanesMul(LX, RY),
+                                                LanesMul(LY, RX)));
+        LanesStore(Components[3] + i, Zero);
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+void VectorStream::Transform(Matrix BGE_NCP M)
+{
+    const Scalar* Mat = &M[0];
+
+    /* *
+     * Matrix elements are broadcast inside the loop rather than hoisted:
+     * 16 hoisted registers plus the inputs don't fit in SSE's register
+     * file, and the spills cost more than the broadcasts.
+     * */
+    for(size_t i = 0; i < Stride; i += BGE_LANE_WIDTH) {
+        ScalarLanes X = LanesLoad(Components[0] + i);
+        ScalarLanes Y = LanesLoad(Components[1] + i);
+        ScalarLanes Z = LanesLoad(Components[2] + i);
+        ScalarLanes W = LanesLoad(Components[3] + i);
+
+        for(int Row = 0; Row < 4; ++Row) {
+            ScalarLanes R;
+
+            R = LanesAdd(LanesAdd(LanesAdd(
+                            LanesMul(LanesSet(Mat[Row]), X),
+                            LanesMul(LanesSet(Mat[4 + Row]), Y)),
+                            LanesMul(LanesSet(Mat[8 + Row]), Z)),
+                            LanesMul(LanesSet(Mat[12 + Row]), W));
+
+            LanesStore(Components[Row] + i, R);
+        }
+    }
+}
+
+} /* bakge */
@@ -0,0 +1,84 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+DoubleBufferedArena::DoubleBufferedArena()
+{
+    Arenas[0] = NULL;
+    Arenas[1] = NULL;
+    Current = 0;
+}
+
+
+DoubleBufferedArena::~DoubleBufferedArena()
+{
+    if(Arenas[0] != NULL)
+        delete Arenas[0];
+
+    if(Arenas[1] != NULL)
+        delete Arenas[1];
+}
+
+
+DoubleBufferedArena* DoubleBufferedArena::Create(size_t NumBytes)
+{
+    DoubleBufferedArena* A = new DoubleBufferedArena;
+
+    A->Arenas[0] = LinearArena::Create(NumBytes);
+    A->Arenas[1] = LinearArena::Create(NumBytes);
+    if(A->Arenas[0] == NULL || A->Arenas[1] == NULL) {
+        printf("Error creating double-buffered arena\n");
+        delete A;
+        return NULL;
+    }
+
+    return A;
+}
+
+
+void DoubleBufferedArena::Swap()
+{
+    Current ^= 1;
+    Arenas[Current]->Reset();
+}
+
+
+void DoubleBufferedArena::ReportUsage(const char* Name) const
+{
+    LinearArena* Now = Arenas[Current];
+    LinearArena* Last = Arenas[Current ^ 1];
+
+    printf("%s: %lu bytes used this frame, %lu last frame, high water marks "
+                "%lu and %lu bytes of %lu\n", Name,
+                (unsigned long)Now->GetUsed(), (unsigned long)Last->GetUsed(),
+                (unsigned long)Now->GetHighWater(),
+                (unsigned long)Last->GetHighWater(),
+                (unsigned long)Now->GetCapacity());
+}
+
+} /* bakge */
@@ -0,0 +1,159 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+struct ArenaOverflow
+{
+    ArenaOverflow* Next;
+    size_t Size;
+};
+
+
+LinearArena::LinearArena()
+{
+    Memory = NULL;
+    Capacity = 0;
+    Offset = 0;
+    Overflow = NULL;
+    OverflowBytes = 0;
+    HighWater = 0;
+    OverflowReported = false;
+}
+
+
+LinearArena::~LinearArena()
+{
+    FreeOverflow(NULL);
+
+    if(Memory != NULL)
+        TrackedFree(Memory);
+}
+
+
+LinearArena* LinearArena::Create(size_t NumBytes)
+{
+    LinearArena* A = new LinearArena;
+
+    if(A->Reserve(NumBytes) != BGE_SUCCESS) {
+        delete A;
+        return NULL;
+    }
+
+    return A;
+}
+
+
+Result LinearArena::Reserve(size_t NumBytes)
+{
+    Memory = (Byte*)TrackedMalloc(NumBytes, MEMORY_TAG_GENERAL);
+    if(Memory == NULL) {
+        printf("Unable to allocate %lu byte arena\n",
+                                        (unsigned long)NumBytes);
+        return BGE_FAILURE;
+    }
+
+    Capacity = NumBytes;
+
+#ifdef _DEBUG
+    memset((void*)Memory, BGE_POISON_FREED, Capacity);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+void* LinearArena::AllocateOverflow(size_t NumBytes, size_t Alignment)
+{
+    ArenaOverflow* Block;
+    size_t Start;
+
+    Block = (ArenaOverflow*)TrackedMalloc(sizeof(ArenaOverflow) + NumBytes
+                                            + Alignment, MEMORY_TAG_GENERAL);
+    if(Block == NULL) {
+        printf("Unable to allocate %lu bytes of arena overflow\n",
+                                                (unsigned long)NumBytes);
+        return NULL;
+    }
+
+    Block->Next = Overflow;
+    Block->Size = NumBytes;
+    Overflow = Block;
+    OverflowBytes += NumBytes;
+    UpdateHighWater();
+
+#ifdef _DEBUG
+    if(!OverflowReported) {
+        printf("Arena of %lu bytes is full, allocating from the heap\n",
+                                                (unsigned long)Capacity);
+        OverflowReported = true;
+    }
+#endif /* _DEBUG */
+
+    Start = (size_t)(Block + 1);
+    Start = (Start + Alignment - 1) & ~(Alignment - 1);
+
+#ifdef _DEBUG
+    memset((void*)Start, BGE_POISON_ALLOCATED, NumBytes);
+#endif /* _DEBUG */
+
+    return (void*)Start;
+}
+
+
+void LinearArena::FreeOverflow(ArenaOverflow* Oldest)
+{
+    ArenaOverflow* Next;
+
+    while(Overflow != Oldest) {
+        Next = Overflow->Next;
+        OverflowBytes -= Overflow->Size;
+        TrackedFree(Overflow);
+        Overflow = Next;
+    }
+}
+
+
+void LinearArena::Reset()
+{
+#ifdef _DEBUG
+    memset((void*)Memory, BGE_POISON_FREED, Offset);
+#endif /* _DEBUG */
+
+    Offset = 0;
+    FreeOverflow(NULL);
+}
+
+
+void LinearArena::ReportUsage(const char* Name) const
+{
+    printf("%s: %lu of %lu bytes used, high water mark %lu bytes\n", Name,
+                    (unsigned long)GetUsed(), (unsigned long)Capacity,
+                                            (unsigned long)HighWater);
+}
+
+} /* bakge */
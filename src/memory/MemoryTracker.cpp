@@ -0,0 +1,263 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+static const char* MemoryTagNames[NUM_MEMORY_TAGS] = {
+    "general",
+    "math",
+    "graphics",
+    "network",
+    "script",
+    "file"
+};
+
+#ifdef BGE_TRACK_MEMORY
+
+/* Counters for one tag, on its own cache line */
+struct TagCounters
+{
+    std::atomic<size_t> LiveBytes;
+    std::atomic<size_t> PeakBytes;
+    std::atomic<long long> NumAllocations;
+    std::atomic<long long> NumFrees;
+
+    char Padding[BGE_CACHE_LINE - sizeof(size_t) * 2
+                                        - sizeof(long long) * 2];
+};
+
+/* Zero-initialized before any constructor can allocate */
+static TagCounters Counters[NUM_MEMORY_TAGS];
+
+
+/* *
+ * Sits in front of each block from TrackedMalloc so TrackedFree knows
+ * its size and tag. Sized to keep the block 16-byte aligned.
+ * */
+struct TrackedHeader
+{
+    size_t NumBytes;
+    size_t Tag;
+};
+
+
+static void AddLive(TagCounters& C, size_t NumBytes)
+{
+    size_t Live;
+    size_t Peak;
+
+    Live = C.LiveBytes.fetch_add(NumBytes, std::memory_order_relaxed)
+                                                            + NumBytes;
+    Peak = C.PeakBytes.load(std::memory_order_relaxed);
+    while(Live > Peak) {
+        if(C.PeakBytes.compare_exchange_weak(Peak, Live,
+                                        std::memory_order_relaxed))
+            break;
+    }
+}
+
+
+void TrackAllocation(int Tag, size_t NumBytes)
+{
+    TagCounters& C = Counters[Tag];
+
+    AddLive(C, NumBytes);
+    C.NumAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void TrackReallocation(int Tag, size_t OldBytes, size_t NewBytes)
+{
+    TagCounters& C = Counters[Tag];
+
+    if(NewBytes > OldBytes)
+        AddLive(C, NewBytes - OldBytes);
+    else
+        C.LiveBytes.fetch_sub(OldBytes - NewBytes,
+                                        std::memory_order_relaxed);
+
+    C.NumAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void TrackFree(int Tag, size_t NumBytes)
+{
+    TagCounters& C = Counters[Tag];
+
+    C.LiveBytes.fetch_sub(NumBytes, std::memory_order_relaxed);
+    C.NumFrees.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void* TrackedMalloc(size_t NumBytes, int Tag)
+{
+    TrackedHeader* Header;
+
+    Header = (TrackedHeader*)malloc(sizeof(TrackedHeader) + NumBytes);
+    if(Header == NULL)
+        return NULL;
+
+    Header->NumBytes = NumBytes;
+    Header->Tag = (size_t)Tag;
+    TrackAllocation(Tag, NumBytes);
+
+    return (void*)(Header + 1);
+}
+
+
+void* TrackedCalloc(size_t NumBytes, int Tag)
+{
+    void* Memory = TrackedMalloc(NumBytes, Tag);
+
+    if(Memory != NULL)
+        memset(Memory, 0, NumBytes);
+
+    return Memory;
+}
+
+
+void* TrackedRealloc(void* Memory, size_t NumBytes, int Tag)
+{
+    TrackedHeader* Header;
+    size_t OldBytes;
+
+    if(Memory == NULL)
+        return TrackedMalloc(NumBytes, Tag);
+
+    Header = (TrackedHeader*)Memory - 1;
+    OldBytes = Header->NumBytes;
+
+    Header = (TrackedHeader*)realloc((void*)Header,
+                                    sizeof(TrackedHeader) + NumBytes);
+    if(Header == NULL)
+        return NULL;
+
+    Header->NumBytes = NumBytes;
+    TrackReallocation((int)Header->Tag, OldBytes, NumBytes);
+
+    return (void*)(Header + 1);
+}
+
+
+void TrackedFree(void* Memory)
+{
+    TrackedHeader* Header;
+
+    if(Memory == NULL)
+        return;
+
+    Header = (TrackedHeader*)Memory - 1;
+    TrackFree((int)Header->Tag, Header->NumBytes);
+    free((void*)Header);
+}
+
+#endif /* BGE_TRACK_MEMORY */
+
+
+void GetMemoryStats(int Tag, MemoryStats* Stats)
+{
+#ifdef BGE_TRACK_MEMORY
+    TagCounters& C = Counters[Tag];
+
+    Stats->LiveBytes = C.LiveBytes.load(std::memory_order_relaxed);
+    Stats->PeakBytes = C.PeakBytes.load(std::memory_order_relaxed);
+    Stats->NumAllocations = C.NumAllocations.load(
+                                        std::memory_order_relaxed);
+    Stats->NumFrees = C.NumFrees.load(std::memory_order_relaxed);
+#else
+    (void)Tag;
+    memset((void*)Stats, 0, sizeof(MemoryStats));
+#endif /* BGE_TRACK_MEMORY */
+}
+
+
+const char* GetMemoryTagName(int Tag)
+{
+    if(Tag < 0 || Tag >= NUM_MEMORY_TAGS)
+        return "unknown";
+
+    return MemoryTagNames[Tag];
+}
+
+
+void ReportMemory()
+{
+#ifdef BGE_TRACK_MEMORY
+    static long long LastAllocations[NUM_MEMORY_TAGS];
+    static Microseconds LastReport = 0;
+    Microseconds Now = GetRunningTime();
+    double Elapsed = (Now - LastReport) / 1000000.0;
+    MemoryStats Stats;
+
+    printf("%-10s %12s %12s %12s %12s %12s\n", "Memory", "Live bytes",
+                        "Peak bytes", "Allocations", "Frees", "Allocs/s");
+
+    for(int i = 0; i < NUM_MEMORY_TAGS; ++i) {
+        GetMemoryStats(i, &Stats);
+        printf("%-10s %12lu %12lu %12lld %12lld %12.0f\n",
+                    GetMemoryTagName(i), (unsigned long)Stats.LiveBytes,
+                    (unsigned long)Stats.PeakBytes, Stats.NumAllocations,
+                    Stats.NumFrees, Elapsed > 0 ? (Stats.NumAllocations
+                                    - LastAllocations[i]) / Elapsed : 0);
+        LastAllocations[i] = Stats.NumAllocations;
+    }
+
+    LastReport = Now;
+#else
+    printf("Memory tracking is off; build with BAKGE_TRACK_MEMORY\n");
+#endif /* BGE_TRACK_MEMORY */
+}
+
+
+void* TrackedLuaAllocator(void*, void* Memory, size_t OldBytes,
+                                                        size_t NewBytes)
+{
+    void* Resized;
+
+    if(NewBytes == 0) {
+        if(Memory != NULL) {
+            TrackFree(MEMORY_TAG_SCRIPT, OldBytes);
+            free(Memory);
+        }
+
+        return NULL;
+    }
+
+    Resized = realloc(Memory, NewBytes);
+    if(Resized == NULL)
+        return NULL;
+
+    /* For new blocks Lua passes a type code as the old size */
+    if(Memory == NULL)
+        TrackAllocation(MEMORY_TAG_SCRIPT, NewBytes);
+    else
+        TrackReallocation(MEMORY_TAG_SCRIPT, OldBytes, NewBytes);
+
+    return Resized;
+}
+
+} /* bakge */
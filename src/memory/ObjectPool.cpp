@@ -0,0 +1,381 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+struct PoolBlock
+{
+    PoolBlock* Next;
+};
+
+
+struct PoolSlab
+{
+    PoolSlab* Next;
+};
+
+
+struct PoolCache
+{
+    PoolBlock* Head;
+    int Count;
+};
+
+
+/* Pools with thread-local caches, by cache index */
+static BlockPool* CachedPools[BGE_MAX_CACHED_POOLS];
+static std::atomic<int> NumCachedPools(0);
+
+/* Every pool, for leak reports */
+static BlockPool* AllPools = NULL;
+static std::atomic_flag AllPoolsLock = ATOMIC_FLAG_INIT;
+
+
+/* *
+ * Each thread's caches. Plain data, so using them needs no check for
+ * whether they have been constructed yet
+ * */
+static thread_local PoolCache ThreadCaches[BGE_MAX_CACHED_POOLS];
+
+
+/* Hands a thread's cached blocks back to their pools when it exits */
+struct CacheFlusher
+{
+    bool Armed;
+
+    CacheFlusher()
+    {
+        Armed = false;
+    }
+
+    ~CacheFlusher()
+    {
+        int NumPools = NumCachedPools.load(std::memory_order_acquire);
+        PoolCache* Cache;
+        PoolBlock* Last;
+
+        for(int i = 0; i < NumPools && i < BGE_MAX_CACHED_POOLS; ++i) {
+            Cache = &ThreadCaches[i];
+            if(Cache->Count == 0 || CachedPools[i] == NULL)
+                continue;
+
+            Last = Cache->Head;
+            while(Last->Next != NULL)
+                Last = Last->Next;
+
+            CachedPools[i]->ReturnBlocks(Cache->Head, Last, Cache->Count);
+            Cache->Head = NULL;
+            Cache->Count = 0;
+        }
+    }
+};
+
+/* Constructed, and so destructed, once a thread first fills a cache */
+static thread_local CacheFlusher Flusher;
+
+
+BlockPool::BlockPool(const char* PoolName, size_t ObjectSize,
+                size_t ObjectAlignment, bool ThreadCache, int MemoryTag)
+{
+    Name = PoolName;
+    Tag = MemoryTag;
+
+    /* Free blocks hold a pointer to the next one */
+    Alignment = ObjectAlignment;
+    if(Alignment < std::alignment_of<PoolBlock>::value)
+        Alignment = std::alignment_of<PoolBlock>::value;
+
+    BlockSize = ObjectSize;
+    if(BlockSize < sizeof(PoolBlock))
+        BlockSize = sizeof(PoolBlock);
+
+    BlockSize = (BlockSize + Alignment - 1) & ~(Alignment - 1);
+
+    Lock = SpinLock::Create();
+    FreeBlocks = NULL;
+    Slabs = NULL;
+    NextSlabSize = BGE_POOL_FIRST_SLAB;
+    NumBlocks = 0;
+    NumFree = 0;
+
+    CacheIndex = -1;
+    if(ThreadCache) {
+        CacheIndex = NumCachedPools.fetch_add(1);
+        if(CacheIndex < BGE_MAX_CACHED_POOLS) {
+            CachedPools[CacheIndex] = this;
+        } else {
+            printf("Too many cached pools; %s pool won't be cached\n",
+                                                                    Name);
+            CacheIndex = -1;
+        }
+    }
+
+    while(AllPoolsLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    NextPool = AllPools;
+    AllPools = this;
+
+    AllPoolsLock.clear(std::memory_order_release);
+}
+
+
+BlockPool::~BlockPool()
+{
+    BlockPool** Link;
+    PoolSlab* Next;
+
+    while(AllPoolsLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    for(Link = &AllPools; *Link != NULL; Link = &(*Link)->NextPool) {
+        if(*Link == this) {
+            *Link = NextPool;
+            break;
+        }
+    }
+
+    AllPoolsLock.clear(std::memory_order_release);
+
+    if(CacheIndex >= 0)
+        CachedPools[CacheIndex] = NULL;
+
+    while(Slabs != NULL) {
+        Next = Slabs->Next;
+        TrackedFree(Slabs);
+        Slabs = Next;
+    }
+
+    if(Lock != NULL)
+        delete Lock;
+}
+
+
+void BlockPool::Grow(int NumNewBlocks)
+{
+    PoolSlab* Slab;
+    size_t Start;
+    PoolBlock* Block;
+
+    /* Room for the slab header, alignment padding and the blocks */
+    Slab = (PoolSlab*)TrackedMalloc(sizeof(PoolSlab) + Alignment
+                                        + BlockSize * NumNewBlocks, Tag);
+    if(Slab == NULL) {
+        printf("Unable to grow %s pool\n", Name);
+        return;
+    }
+
+    Slab->Next = Slabs;
+    Slabs = Slab;
+    NumBlocks += NumNewBlocks;
+    NumFree += NumNewBlocks;
+
+    Start = (size_t)(Slab + 1);
+    Start = (Start + Alignment - 1) & ~(Alignment - 1);
+
+    /* Thread the new blocks onto the free list, first block first */
+    for(int i = NumNewBlocks - 1; i >= 0; --i) {
+        Block = (PoolBlock*)(Start + BlockSize * i);
+        Block->Next = FreeBlocks;
+        FreeBlocks = Block;
+    }
+}
+
+
+int BlockPool::TakeBlocks(PoolBlock** Chain, int Count)
+{
+    PoolBlock* Last;
+    int Taken;
+
+    Lock->Lock();
+
+    if(FreeBlocks == NULL) {
+        Grow(NextSlabSize);
+        if(NextSlabSize < BGE_POOL_MAX_SLAB)
+            NextSlabSize *= 2;
+    }
+
+    if(FreeBlocks == NULL) {
+        Lock->Unlock();
+        return 0;
+    }
+
+    Last = FreeBlocks;
+    for(Taken = 1; Taken < Count && Last->Next != NULL; ++Taken)
+        Last = Last->Next;
+
+    *Chain = FreeBlocks;
+    FreeBlocks = Last->Next;
+    Last->Next = NULL;
+    NumFree -= Taken;
+
+    Lock->Unlock();
+
+    return Taken;
+}
+
+
+void BlockPool::ReturnBlocks(PoolBlock* First, PoolBlock* Last, int Count)
+{
+    Lock->Lock();
+
+    Last->Next = FreeBlocks;
+    FreeBlocks = First;
+    NumFree += Count;
+
+    Lock->Unlock();
+}
+
+
+void* BlockPool::Allocate()
+{
+    PoolBlock* Block;
+
+    if(CacheIndex >= 0) {
+        PoolCache& Cache = ThreadCaches[CacheIndex];
+
+        if(Cache.Count == 0) {
+            Flusher.Armed = true;
+            Cache.Count = TakeBlocks(&Cache.Head, BGE_POOL_CACHE_BATCH);
+            if(Cache.Count == 0)
+                return NULL;
+        }
+
+        Block = Cache.Head;
+        Cache.Head = Block->Next;
+        --Cache.Count;
+    } else if(TakeBlocks(&Block, 1) == 0) {
+        return NULL;
+    }
+
+#ifdef _DEBUG
+    memset((void*)Block, BGE_POISON_ALLOCATED, BlockSize);
+#endif /* _DEBUG */
+
+    return (void*)Block;
+}
+
+
+void BlockPool::Free(void* Memory)
+{
+    PoolBlock* Block = (PoolBlock*)Memory;
+    PoolBlock* Last;
+
+    if(Block == NULL)
+        return;
+
+#ifdef _DEBUG
+    memset(Memory, BGE_POISON_FREED, BlockSize);
+#endif /* _DEBUG */
+
+    if(CacheIndex < 0) {
+        ReturnBlocks(Block, Block, 1);
+        return;
+    }
+
+    PoolCache& Cache = ThreadCaches[CacheIndex];
+
+    if(Cache.Count == 0)
+        Flusher.Armed = true;
+
+    Block->Next = Cache.Head;
+    Cache.Head = Block;
+    if(++Cache.Count <= BGE_POOL_CACHE_SIZE)
+        return;
+
+    /* Cache is full, hand a batch back so other threads can use it */
+    Last = Block;
+    for(int i = 1; i < BGE_POOL_CACHE_BATCH; ++i)
+        Last = Last->Next;
+
+    Cache.Head = Last->Next;
+    Cache.Count -= BGE_POOL_CACHE_BATCH;
+    ReturnBlocks(Block, Last, BGE_POOL_CACHE_BATCH);
+}
+
+
+void BlockPool::Reserve(int NumReserved)
+{
+    Lock->Lock();
+
+    if(NumBlocks < NumReserved)
+        Grow(NumReserved - NumBlocks);
+
+    Lock->Unlock();
+}
+
+
+int BlockPool::GetNumLive() const
+{
+    int Live;
+
+    Lock->Lock();
+    Live = NumBlocks - NumFree;
+    Lock->Unlock();
+
+    if(CacheIndex >= 0)
+        Live -= ThreadCaches[CacheIndex].Count;
+
+    return Live;
+}
+
+
+int BlockPool::GetCapacity() const
+{
+    int Capacity;
+
+    Lock->Lock();
+    Capacity = NumBlocks;
+    Lock->Unlock();
+
+    return Capacity;
+}
+
+
+int BlockPool::ReportLeaks()
+{
+    int NumLeaking = 0;
+    int Live;
+
+    while(AllPoolsLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    for(BlockPool* Pool = AllPools; Pool != NULL; Pool = Pool->NextPool) {
+        Live = Pool->GetNumLive();
+        if(Live > 0) {
+            printf("%s pool: %d objects were never freed\n", Pool->Name,
+                                                                    Live);
+            ++NumLeaking;
+        }
+    }
+
+    AllPoolsLock.clear(std::memory_order_release);
+
+    return NumLeaking;
+}
+
+} /* bakge */
@@ -0,0 +1,98 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+/* Deletes a thread's scratch stack when the thread exits */
+struct ScratchStack
+{
+    StackAllocator* Stack;
+
+    ScratchStack()
+    {
+        Stack = NULL;
+    }
+
+    ~ScratchStack()
+    {
+        if(Stack != NULL)
+            delete Stack;
+    }
+};
+
+static thread_local ScratchStack Scratch;
+
+
+StackAllocator::StackAllocator()
+{
+}
+
+
+StackAllocator::~StackAllocator()
+{
+}
+
+
+StackAllocator* StackAllocator::Create(size_t NumBytes)
+{
+    StackAllocator* S = new StackAllocator;
+
+    if(S->Reserve(NumBytes) != BGE_SUCCESS) {
+        delete S;
+        return NULL;
+    }
+
+    return S;
+}
+
+
+StackAllocator* StackAllocator::GetScratch()
+{
+    if(Scratch.Stack == NULL)
+        Scratch.Stack = Create(BGE_SCRATCH_STACK_SIZE);
+
+    return Scratch.Stack;
+}
+
+
+void StackAllocator::FreeToMarker(StackMarker Marker)
+{
+#ifdef _DEBUG
+    if(Marker.Offset > Offset) {
+        printf("Stack allocator freed to a marker above its top\n");
+        return;
+    }
+
+    memset((void*)(Memory + Marker.Offset), BGE_POISON_FREED,
+                                            Offset - Marker.Offset);
+#endif /* _DEBUG */
+
+    Offset = Marker.Offset;
+    FreeOverflow(Marker.Overflow);
+}
+
+} /* bakge */
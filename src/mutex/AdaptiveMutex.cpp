@@ -0,0 +1,134 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+/* Pauses spent spinning before sleeping, unless told otherwise */
+#define ADAPTIVEMUTEX_DEFAULT_SPIN_COUNT 2000
+
+/* Most pauses between attempts, so waiters don't hammer the lock */
+#define ADAPTIVEMUTEX_MAX_BACKOFF 64
+
+namespace bakge
+{
+
+AdaptiveMutex::AdaptiveMutex()
+{
+    Handle = NULL;
+    SpinCount = 0;
+}
+
+
+AdaptiveMutex::~AdaptiveMutex()
+{
+    if(Handle != NULL)
+        delete Handle;
+}
+
+
+AdaptiveMutex* AdaptiveMutex::Create()
+{
+    return Create(ADAPTIVEMUTEX_DEFAULT_SPIN_COUNT);
+}
+
+
+AdaptiveMutex* AdaptiveMutex::Create(int SpinCount)
+{
+    AdaptiveMutex* M = new AdaptiveMutex;
+
+    M->Handle = bakge::Mutex::Create();
+    if(M->Handle == NULL) {
+        printf("Error creating adaptive mutex\n");
+        delete M;
+        return NULL;
+    }
+
+    if(GetNumProcessors() > 1 && SpinCount > 0)
+        M->SpinCount = SpinCount;
+
+    return M;
+}
+
+
+Result AdaptiveMutex::Lock()
+{
+    int Backoff = 1;
+
+    if(Handle->TryLock()) {
+#ifdef _DEBUG
+        Acquired(false);
+#endif /* _DEBUG */
+        return BGE_SUCCESS;
+    }
+
+    /* Back off exponentially between attempts */
+    for(int Spun = 0; Spun < SpinCount; Spun += Backoff) {
+        for(int i = 0; i < Backoff; ++i)
+            CpuPause();
+
+        if(Handle->TryLock()) {
+#ifdef _DEBUG
+            Acquired(true);
+#endif /* _DEBUG */
+            return BGE_SUCCESS;
+        }
+
+        if(Backoff < ADAPTIVEMUTEX_MAX_BACKOFF)
+            Backoff *= 2;
+    }
+
+    if(Handle->Lock() != BGE_SUCCESS)
+        return BGE_FAILURE;
+
+#ifdef _DEBUG
+    Acquired(true);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+bool AdaptiveMutex::TryLock()
+{
+    if(!Handle->TryLock())
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result AdaptiveMutex::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    return Handle->Unlock();
+}
+
+} /* bakge */
@@ -0,0 +1,110 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+#include <thread>
+
+/* Pauses before a waiting thread starts yielding its time slice */
+#define SPINLOCK_MAX_PAUSES 1024
+
+namespace bakge
+{
+
+SpinLock::SpinLock()
+{
+    Held.store(false);
+}
+
+
+SpinLock::~SpinLock()
+{
+}
+
+
+SpinLock* SpinLock::Create()
+{
+    return new SpinLock;
+}
+
+
+Result SpinLock::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+#endif /* _DEBUG */
+    int Pauses = 0;
+
+    while(Held.exchange(true, std::memory_order_acquire)) {
+#ifdef _DEBUG
+        Contended = true;
+#endif /* _DEBUG */
+
+        /* *
+         * Only read while it's held, so waiting threads share the cache
+         * line instead of stealing it from each other
+         * */
+        while(Held.load(std::memory_order_relaxed)) {
+            if(Pauses < SPINLOCK_MAX_PAUSES) {
+                CpuPause();
+                ++Pauses;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+#ifdef _DEBUG
+    Acquired(Contended);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+bool SpinLock::TryLock()
+{
+    if(Held.load(std::memory_order_relaxed)
+            || Held.exchange(true, std::memory_order_acquire))
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result SpinLock::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    Held.store(false, std::memory_order_release);
+
+    return BGE_SUCCESS;
+}
+
+} /* bakge */
@@ -23,17 +23,400 @@
  * */
 
 #include <bakge/Bakge.h>
+#include <errno.h>
 
 namespace bakge
 {
 
 osx_Mutex::osx_Mutex()
 {
+    Initialized = false;
 }
 
 
 osx_Mutex::~osx_Mutex()
 {
+    if(Initialized)
+        pthread_mutex_destroy(&MutexHandle);
+}
+
+
+osx_Mutex* osx_Mutex::Create()
+{
+    osx_Mutex* M = new osx_Mutex;
+
+    if(pthread_mutex_init(&M->MutexHandle, NULL) != 0) {
+        printf("Error creating mutex\n");
+        delete M;
+        return NULL;
+    }
+
+    M->Initialized = true;
+
+    return M;
+}
+
+
+Result osx_Mutex::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    /* Try first so we know whether we had to wait */
+    if(pthread_mutex_trylock(&MutexHandle) != 0) {
+        Contended = true;
+        if(pthread_mutex_lock(&MutexHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    Acquired(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_mutex_lock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool osx_Mutex::TryLock()
+{
+    if(pthread_mutex_trylock(&MutexHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result osx_Mutex::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    if(pthread_mutex_unlock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+osx_RecursiveMutex::osx_RecursiveMutex()
+{
+    Initialized = false;
+
+#ifdef _DEBUG
+    Depth = 0;
+#endif /* _DEBUG */
+}
+
+
+osx_RecursiveMutex::~osx_RecursiveMutex()
+{
+    if(Initialized)
+        pthread_mutex_destroy(&MutexHandle);
+}
+
+
+osx_RecursiveMutex* osx_RecursiveMutex::Create()
+{
+    osx_RecursiveMutex* M = new osx_RecursiveMutex;
+    pthread_mutexattr_t Attributes;
+    int Error;
+
+    pthread_mutexattr_init(&Attributes);
+    pthread_mutexattr_settype(&Attributes, PTHREAD_MUTEX_RECURSIVE);
+    Error = pthread_mutex_init(&M->MutexHandle, &Attributes);
+    pthread_mutexattr_destroy(&Attributes);
+
+    if(Error != 0) {
+        printf("Error creating recursive mutex\n");
+        delete M;
+        return NULL;
+    }
+
+    M->Initialized = true;
+
+    return M;
+}
+
+
+Result osx_RecursiveMutex::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(pthread_mutex_trylock(&MutexHandle) != 0) {
+        Contended = true;
+        if(pthread_mutex_lock(&MutexHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    if(Depth++ == 0)
+        Acquired(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_mutex_lock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool osx_RecursiveMutex::TryLock()
+{
+    if(pthread_mutex_trylock(&MutexHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    if(Depth++ == 0)
+        Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result osx_RecursiveMutex::Unlock()
+{
+#ifdef _DEBUG
+    if(--Depth == 0)
+        Releasing();
+#endif /* _DEBUG */
+
+    if(pthread_mutex_unlock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+osx_ReaderWriterLock::osx_ReaderWriterLock()
+{
+    Initialized = false;
+}
+
+
+osx_ReaderWriterLock::~osx_ReaderWriterLock()
+{
+    if(Initialized)
+        pthread_rwlock_destroy(&LockHandle);
+}
+
+
+osx_ReaderWriterLock* osx_ReaderWriterLock::Create()
+{
+    osx_ReaderWriterLock* L = new osx_ReaderWriterLock;
+    pthread_rwlockattr_t Attributes;
+    int Error;
+
+    pthread_rwlockattr_init(&Attributes);
+    Error = pthread_rwlock_init(&L->LockHandle, &Attributes);
+    pthread_rwlockattr_destroy(&Attributes);
+
+    if(Error != 0) {
+        printf("Error creating reader-writer lock\n");
+        delete L;
+        return NULL;
+    }
+
+    L->Initialized = true;
+
+    return L;
+}
+
+
+Result osx_ReaderWriterLock::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(pthread_rwlock_trywrlock(&LockHandle) != 0) {
+        Contended = true;
+        if(pthread_rwlock_wrlock(&LockHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    Acquired(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_rwlock_wrlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool osx_ReaderWriterLock::TryLock()
+{
+    if(pthread_rwlock_trywrlock(&LockHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result osx_ReaderWriterLock::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    if(pthread_rwlock_unlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+Result osx_ReaderWriterLock::LockShared()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(pthread_rwlock_tryrdlock(&LockHandle) != 0) {
+        Contended = true;
+        if(pthread_rwlock_rdlock(&LockHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    AcquiredShared(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_rwlock_rdlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool osx_ReaderWriterLock::TryLockShared()
+{
+    if(pthread_rwlock_tryrdlock(&LockHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    AcquiredShared(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result osx_ReaderWriterLock::UnlockShared()
+{
+    if(pthread_rwlock_unlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+osx_ConditionVariable::osx_ConditionVariable()
+{
+    Initialized = false;
+}
+
+
+osx_ConditionVariable::~osx_ConditionVariable()
+{
+    if(Initialized)
+        pthread_cond_destroy(&ConditionHandle);
+}
+
+
+osx_ConditionVariable* osx_ConditionVariable::Create()
+{
+    osx_ConditionVariable* C = new osx_ConditionVariable;
+
+    if(pthread_cond_init(&C->ConditionHandle, NULL) != 0) {
+        printf("Error creating condition variable\n");
+        delete C;
+        return NULL;
+    }
+
+    C->Initialized = true;
+
+    return C;
+}
+
+
+Result osx_ConditionVariable::Wait(osx_Mutex* Held)
+{
+    int Error;
+
+#ifdef _DEBUG
+    Held->Releasing();
+#endif /* _DEBUG */
+
+    Error = pthread_cond_wait(&ConditionHandle, &Held->MutexHandle);
+
+#ifdef _DEBUG
+    Held->Acquired(false);
+#endif /* _DEBUG */
+
+    if(Error != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+bool osx_ConditionVariable::WaitFor(osx_Mutex* Held, Microseconds Timeout)
+{
+    timespec Relative;
+    int Error;
+
+    Relative.tv_sec = Timeout / 1000000;
+    Relative.tv_nsec = (Timeout % 1000000) * 1000;
+
+#ifdef _DEBUG
+    Held->Releasing();
+#endif /* _DEBUG */
+
+    /* OS X can't time condition variables against a monotonic clock */
+    Error = pthread_cond_timedwait_relative_np(&ConditionHandle,
+                                        &Held->MutexHandle, &Relative);
+
+#ifdef _DEBUG
+    Held->Acquired(false);
+#endif /* _DEBUG */
+
+    return Error != ETIMEDOUT;
+}
+
+
+Result osx_ConditionVariable::Signal()
+{
+    if(pthread_cond_signal(&ConditionHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+Result osx_ConditionVariable::Broadcast()
+{
+    if(pthread_cond_broadcast(&ConditionHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
 }
 
 } /* bakge */
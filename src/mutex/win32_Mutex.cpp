@@ -24,16 +24,330 @@
 
 #include <bakge/Bakge.h>
 
+/* Spins before a contended critical section sleeps, as the heap's does */
+#define WIN32_CRITICAL_SECTION_SPIN_COUNT 4000
+
 namespace bakge
 {
 
 win32_Mutex::win32_Mutex()
 {
+    InitializeSRWLock(&LockHandle);
 }
 
 
 win32_Mutex::~win32_Mutex()
 {
+    /* Slim locks need no cleanup */
+}
+
+
+win32_Mutex* win32_Mutex::Create()
+{
+    return new win32_Mutex;
+}
+
+
+Result win32_Mutex::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    /* Try first so we know whether we had to wait */
+    if(TryAcquireSRWLockExclusive(&LockHandle) == 0) {
+        Contended = true;
+        AcquireSRWLockExclusive(&LockHandle);
+    }
+
+    Acquired(Contended);
+#else
+    AcquireSRWLockExclusive(&LockHandle);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+bool win32_Mutex::TryLock()
+{
+    if(TryAcquireSRWLockExclusive(&LockHandle) == 0)
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result win32_Mutex::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    ReleaseSRWLockExclusive(&LockHandle);
+
+    return BGE_SUCCESS;
+}
+
+
+win32_RecursiveMutex::win32_RecursiveMutex()
+{
+    Initialized = false;
+
+#ifdef _DEBUG
+    Depth = 0;
+#endif /* _DEBUG */
+}
+
+
+win32_RecursiveMutex::~win32_RecursiveMutex()
+{
+    if(Initialized)
+        DeleteCriticalSection(&Section);
+}
+
+
+win32_RecursiveMutex* win32_RecursiveMutex::Create()
+{
+    win32_RecursiveMutex* M = new win32_RecursiveMutex;
+
+    if(InitializeCriticalSectionAndSpinCount(&M->Section,
+                            WIN32_CRITICAL_SECTION_SPIN_COUNT) == 0) {
+        printf("Error creating recursive mutex\n");
+        delete M;
+        return NULL;
+    }
+
+    M->Initialized = true;
+
+    return M;
+}
+
+
+Result win32_RecursiveMutex::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(TryEnterCriticalSection(&Section) == 0) {
+        Contended = true;
+        EnterCriticalSection(&Section);
+    }
+
+    if(Depth++ == 0)
+        Acquired(Contended);
+#else
+    EnterCriticalSection(&Section);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+bool win32_RecursiveMutex::TryLock()
+{
+    if(TryEnterCriticalSection(&Section) == 0)
+        return false;
+
+#ifdef _DEBUG
+    if(Depth++ == 0)
+        Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result win32_RecursiveMutex::Unlock()
+{
+#ifdef _DEBUG
+    if(--Depth == 0)
+        Releasing();
+#endif /* _DEBUG */
+
+    LeaveCriticalSection(&Section);
+
+    return BGE_SUCCESS;
+}
+
+
+win32_ReaderWriterLock::win32_ReaderWriterLock()
+{
+    InitializeSRWLock(&LockHandle);
+}
+
+
+win32_ReaderWriterLock::~win32_ReaderWriterLock()
+{
+}
+
+
+win32_ReaderWriterLock* win32_ReaderWriterLock::Create()
+{
+    return new win32_ReaderWriterLock;
+}
+
+
+Result win32_ReaderWriterLock::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(TryAcquireSRWLockExclusive(&LockHandle) == 0) {
+        Contended = true;
+        AcquireSRWLockExclusive(&LockHandle);
+    }
+
+    Acquired(Contended);
+#else
+    AcquireSRWLockExclusive(&LockHandle);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+bool win32_ReaderWriterLock::TryLock()
+{
+    if(TryAcquireSRWLockExclusive(&LockHandle) == 0)
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result win32_ReaderWriterLock::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    ReleaseSRWLockExclusive(&LockHandle);
+
+    return BGE_SUCCESS;
+}
+
+
+Result win32_ReaderWriterLock::LockShared()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(TryAcquireSRWLockShared(&LockHandle) == 0) {
+        Contended = true;
+        AcquireSRWLockShared(&LockHandle);
+    }
+
+    AcquiredShared(Contended);
+#else
+    AcquireSRWLockShared(&LockHandle);
+#endif /* _DEBUG */
+
+    return BGE_SUCCESS;
+}
+
+
+bool win32_ReaderWriterLock::TryLockShared()
+{
+    if(TryAcquireSRWLockShared(&LockHandle) == 0)
+        return false;
+
+#ifdef _DEBUG
+    AcquiredShared(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result win32_ReaderWriterLock::UnlockShared()
+{
+    ReleaseSRWLockShared(&LockHandle);
+
+    return BGE_SUCCESS;
+}
+
+
+win32_ConditionVariable::win32_ConditionVariable()
+{
+    InitializeConditionVariable(&ConditionHandle);
+}
+
+
+win32_ConditionVariable::~win32_ConditionVariable()
+{
+}
+
+
+win32_ConditionVariable* win32_ConditionVariable::Create()
+{
+    return new win32_ConditionVariable;
+}
+
+
+Result win32_ConditionVariable::Wait(win32_Mutex* Held)
+{
+    BOOL Woken;
+
+#ifdef _DEBUG
+    Held->Releasing();
+#endif /* _DEBUG */
+
+    Woken = SleepConditionVariableSRW(&ConditionHandle, &Held->LockHandle,
+                                                            INFINITE, 0);
+
+#ifdef _DEBUG
+    Held->Acquired(false);
+#endif /* _DEBUG */
+
+    if(Woken == 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+bool win32_ConditionVariable::WaitFor(win32_Mutex* Held,
+                                            Microseconds Timeout)
+{
+    BOOL Woken;
+
+#ifdef _DEBUG
+    Held->Releasing();
+#endif /* _DEBUG */
+
+    /* Round up, so short timeouts don't become a poll */
+    Woken = SleepConditionVariableSRW(&ConditionHandle, &Held->LockHandle,
+                                        (DWORD)((Timeout + 999) / 1000), 0);
+
+#ifdef _DEBUG
+    Held->Acquired(false);
+#endif /* _DEBUG */
+
+    return Woken != 0 || GetLastError() != ERROR_TIMEOUT;
+}
+
+
+Result win32_ConditionVariable::Signal()
+{
+    WakeConditionVariable(&ConditionHandle);
+
+    return BGE_SUCCESS;
+}
+
+
+Result win32_ConditionVariable::Broadcast()
+{
+    WakeAllConditionVariable(&ConditionHandle);
+
+    return BGE_SUCCESS;
 }
 
 } /* bakge */
@@ -23,17 +23,417 @@
  * */
 
 #include <bakge/Bakge.h>
+#include <errno.h>
 
 namespace bakge
 {
 
 x11_Mutex::x11_Mutex()
 {
+    Initialized = false;
 }
 
 
 x11_Mutex::~x11_Mutex()
 {
+    if(Initialized)
+        pthread_mutex_destroy(&MutexHandle);
+}
+
+
+x11_Mutex* x11_Mutex::Create()
+{
+    x11_Mutex* M = new x11_Mutex;
+
+    if(pthread_mutex_init(&M->MutexHandle, NULL) != 0) {
+        printf("Error creating mutex\n");
+        delete M;
+        return NULL;
+    }
+
+    M->Initialized = true;
+
+    return M;
+}
+
+
+Result x11_Mutex::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    /* Try first so we know whether we had to wait */
+    if(pthread_mutex_trylock(&MutexHandle) != 0) {
+        Contended = true;
+        if(pthread_mutex_lock(&MutexHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    Acquired(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_mutex_lock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool x11_Mutex::TryLock()
+{
+    if(pthread_mutex_trylock(&MutexHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result x11_Mutex::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    if(pthread_mutex_unlock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+x11_RecursiveMutex::x11_RecursiveMutex()
+{
+    Initialized = false;
+
+#ifdef _DEBUG
+    Depth = 0;
+#endif /* _DEBUG */
+}
+
+
+x11_RecursiveMutex::~x11_RecursiveMutex()
+{
+    if(Initialized)
+        pthread_mutex_destroy(&MutexHandle);
+}
+
+
+x11_RecursiveMutex* x11_RecursiveMutex::Create()
+{
+    x11_RecursiveMutex* M = new x11_RecursiveMutex;
+    pthread_mutexattr_t Attributes;
+    int Error;
+
+    pthread_mutexattr_init(&Attributes);
+    pthread_mutexattr_settype(&Attributes, PTHREAD_MUTEX_RECURSIVE);
+    Error = pthread_mutex_init(&M->MutexHandle, &Attributes);
+    pthread_mutexattr_destroy(&Attributes);
+
+    if(Error != 0) {
+        printf("Error creating recursive mutex\n");
+        delete M;
+        return NULL;
+    }
+
+    M->Initialized = true;
+
+    return M;
+}
+
+
+Result x11_RecursiveMutex::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(pthread_mutex_trylock(&MutexHandle) != 0) {
+        Contended = true;
+        if(pthread_mutex_lock(&MutexHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    if(Depth++ == 0)
+        Acquired(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_mutex_lock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool x11_RecursiveMutex::TryLock()
+{
+    if(pthread_mutex_trylock(&MutexHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    if(Depth++ == 0)
+        Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result x11_RecursiveMutex::Unlock()
+{
+#ifdef _DEBUG
+    if(--Depth == 0)
+        Releasing();
+#endif /* _DEBUG */
+
+    if(pthread_mutex_unlock(&MutexHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+x11_ReaderWriterLock::x11_ReaderWriterLock()
+{
+    Initialized = false;
+}
+
+
+x11_ReaderWriterLock::~x11_ReaderWriterLock()
+{
+    if(Initialized)
+        pthread_rwlock_destroy(&LockHandle);
+}
+
+
+x11_ReaderWriterLock* x11_ReaderWriterLock::Create()
+{
+    x11_ReaderWriterLock* L = new x11_ReaderWriterLock;
+    pthread_rwlockattr_t Attributes;
+    int Error;
+
+    pthread_rwlockattr_init(&Attributes);
+#ifdef __GLIBC__
+    /* glibc favours readers by default, which can starve writers */
+    pthread_rwlockattr_setkind_np(&Attributes,
+                        PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif /* __GLIBC__ */
+    Error = pthread_rwlock_init(&L->LockHandle, &Attributes);
+    pthread_rwlockattr_destroy(&Attributes);
+
+    if(Error != 0) {
+        printf("Error creating reader-writer lock\n");
+        delete L;
+        return NULL;
+    }
+
+    L->Initialized = true;
+
+    return L;
+}
+
+
+Result x11_ReaderWriterLock::Lock()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(pthread_rwlock_trywrlock(&LockHandle) != 0) {
+        Contended = true;
+        if(pthread_rwlock_wrlock(&LockHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    Acquired(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_rwlock_wrlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool x11_ReaderWriterLock::TryLock()
+{
+    if(pthread_rwlock_trywrlock(&LockHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    Acquired(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result x11_ReaderWriterLock::Unlock()
+{
+#ifdef _DEBUG
+    Releasing();
+#endif /* _DEBUG */
+
+    if(pthread_rwlock_unlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+Result x11_ReaderWriterLock::LockShared()
+{
+#ifdef _DEBUG
+    bool Contended = false;
+
+    if(pthread_rwlock_tryrdlock(&LockHandle) != 0) {
+        Contended = true;
+        if(pthread_rwlock_rdlock(&LockHandle) != 0)
+            return BGE_FAILURE;
+    }
+
+    AcquiredShared(Contended);
+
+    return BGE_SUCCESS;
+#else
+    if(pthread_rwlock_rdlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+#endif /* _DEBUG */
+}
+
+
+bool x11_ReaderWriterLock::TryLockShared()
+{
+    if(pthread_rwlock_tryrdlock(&LockHandle) != 0)
+        return false;
+
+#ifdef _DEBUG
+    AcquiredShared(false);
+#endif /* _DEBUG */
+
+    return true;
+}
+
+
+Result x11_ReaderWriterLock::UnlockShared()
+{
+    if(pthread_rwlock_unlock(&LockHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+x11_ConditionVariable::x11_ConditionVariable()
+{
+    Initialized = false;
+}
+
+
+x11_ConditionVariable::~x11_ConditionVariable()
+{
+    if(Initialized)
+        pthread_cond_destroy(&ConditionHandle);
+}
+
+
+x11_ConditionVariable* x11_ConditionVariable::Create()
+{
+    x11_ConditionVariable* C = new x11_ConditionVariable;
+    pthread_condattr_t Attributes;
+    int Error;
+
+    /* Time out against the monotonic clock, like GetRunningTime */
+    pthread_condattr_init(&Attributes);
+    pthread_condattr_setclock(&Attributes, CLOCK_MONOTONIC);
+    Error = pthread_cond_init(&C->ConditionHandle, &Attributes);
+    pthread_condattr_destroy(&Attributes);
+
+    if(Error != 0) {
+        printf("Error creating condition variable\n");
+        delete C;
+        return NULL;
+    }
+
+    C->Initialized = true;
+
+    return C;
+}
+
+
+Result x11_ConditionVariable::Wait(x11_Mutex* Held)
+{
+    int Error;
+
+#ifdef _DEBUG
+    Held->Releasing();
+#endif /* _DEBUG */
+
+    Error = pthread_cond_wait(&ConditionHandle, &Held->MutexHandle);
+
+#ifdef _DEBUG
+    Held->Acquired(false);
+#endif /* _DEBUG */
+
+    if(Error != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+bool x11_ConditionVariable::WaitFor(x11_Mutex* Held, Microseconds Timeout)
+{
+    timespec Deadline;
+    int Error;
+
+    clock_gettime(CLOCK_MONOTONIC, &Deadline);
+    Deadline.tv_sec += Timeout / 1000000;
+    Deadline.tv_nsec += (Timeout % 1000000) * 1000;
+    if(Deadline.tv_nsec >= 1000000000L) {
+        Deadline.tv_sec += 1;
+        Deadline.tv_nsec -= 1000000000L;
+    }
+
+#ifdef _DEBUG
+    Held->Releasing();
+#endif /* _DEBUG */
+
+    Error = pthread_cond_timedwait(&ConditionHandle, &Held->MutexHandle,
+                                                                &Deadline);
+
+#ifdef _DEBUG
+    Held->Acquired(false);
+#endif /* _DEBUG */
+
+    return Error != ETIMEDOUT;
+}
+
+
+Result x11_ConditionVariable::Signal()
+{
+    if(pthread_cond_signal(&ConditionHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
+}
+
+
+Result x11_ConditionVariable::Broadcast()
+{
+    if(pthread_cond_broadcast(&ConditionHandle) != 0)
+        return BGE_FAILURE;
+    else
+        return BGE_SUCCESS;
 }
 
 } /* bakge */
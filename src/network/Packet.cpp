@@ -27,19 +27,227 @@
 namespace bakge
 {
 
+struct PacketBuffer
+{
+    std::atomic<int> References;
+    Byte Data[BGE_PACKET_CAPACITY];
+};
+
+
+/* *
+ * Buffers are placement-constructed without value-initialization, so
+ * the payload isn't zeroed every time one is handed out.
+ * */
+static BlockPool& GetBufferPool()
+{
+    static BlockPool Pool("PacketBuffer", sizeof(PacketBuffer),
+                            std::alignment_of<PacketBuffer>::value, true,
+                                                    MEMORY_TAG_NETWORK);
+    return Pool;
+}
+
+
+static PacketBuffer* AcquireBuffer()
+{
+    void* Block = GetBufferPool().Allocate();
+    PacketBuffer* Buffer;
+
+    if(Block == NULL)
+        return NULL;
+
+    Buffer = new (Block) PacketBuffer;
+    Buffer->References.store(1, std::memory_order_relaxed);
+
+    return Buffer;
+}
+
+
+static void ReleaseBuffer(PacketBuffer* Buffer)
+{
+    if(Buffer->References.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Buffer->~PacketBuffer();
+        GetBufferPool().Free((void*)Buffer);
+    }
+}
+
+
+BGE_POOLED_DEFINE(Packet, true, MEMORY_TAG_NETWORK)
+
+
 Packet::Packet()
 {
+    Buffer = NULL;
+    Size = 0;
+    ReadPosition = 0;
 }
 
 
 Packet::~Packet()
 {
+    if(Buffer != NULL)
+        ReleaseBuffer(Buffer);
+}
+
+
+Packet* Packet::Create()
+{
+    Packet* P = new Packet;
+
+    if(P == NULL) {
+        printf("Unable to allocate memory for packet\n");
+        return NULL;
+    }
+
+    P->Buffer = AcquireBuffer();
+    if(P->Buffer == NULL) {
+        printf("Unable to allocate packet buffer\n");
+        delete P;
+        return NULL;
+    }
+
+    return P;
+}
+
+
+Packet* Packet::Create(const Byte* Data, int Size)
+{
+    Packet* P;
+
+    if(Size < 0 || Size > BGE_PACKET_CAPACITY || (Data == NULL && Size > 0)) {
+        printf("Invalid packet data\n");
+        return NULL;
+    }
+
+    P = Create();
+    if(P == NULL)
+        return NULL;
+
+    /* memcpy wants valid pointers even for 0 bytes */
+    if(Size > 0)
+        memcpy((void*)P->Buffer->Data, (const void*)Data, Size);
+
+    P->Size = Size;
+
+    return P;
+}
+
+
+Packet* Packet::Share() const
+{
+    Packet* P = new Packet;
+
+    if(P == NULL) {
+        printf("Unable to allocate memory for packet\n");
+        return NULL;
+    }
+
+    Buffer->References.fetch_add(1, std::memory_order_relaxed);
+    P->Buffer = Buffer;
+    P->Size = Size;
+    P->Sender = Sender;
+
+    return P;
+}
+
+
+Result Packet::Detach()
+{
+    PacketBuffer* Copy;
+
+    if(Buffer->References.load(std::memory_order_acquire) == 1)
+        return BGE_SUCCESS;
+
+    Copy = AcquireBuffer();
+    if(Copy == NULL) {
+        printf("Unable to allocate packet buffer\n");
+        return BGE_FAILURE;
+    }
+
+    memcpy((void*)Copy->Data, (const void*)Buffer->Data, Size);
+    ReleaseBuffer(Buffer);
+    Buffer = Copy;
+
+    return BGE_SUCCESS;
+}
+
+
+Result Packet::Write(const void* Data, int NumBytes)
+{
+    if(NumBytes < 0 || NumBytes > BGE_PACKET_CAPACITY - Size)
+        return BGE_FAILURE;
+
+    if(Detach() != BGE_SUCCESS)
+        return BGE_FAILURE;
+
+    memcpy((void*)(Buffer->Data + Size), Data, NumBytes);
+    Size += NumBytes;
+
+    return BGE_SUCCESS;
+}
+
+
+Result Packet::Read(void* Data, int NumBytes)
+{
+    if(NumBytes < 0 || NumBytes > Size - ReadPosition)
+        return BGE_FAILURE;
+
+    memcpy(Data, (const void*)(Buffer->Data + ReadPosition), NumBytes);
+    ReadPosition += NumBytes;
+
+    return BGE_SUCCESS;
+}
+
+
+Result Packet::Seek(int Position)
+{
+    if(Position < 0 || Position > Size)
+        return BGE_FAILURE;
+
+    ReadPosition = Position;
+
+    return BGE_SUCCESS;
+}
+
+
+const Byte* Packet::GetData() const
+{
+    return Buffer->Data;
+}
+
+
+Byte* Packet::GetWritableData()
+{
+    if(Detach() != BGE_SUCCESS)
+        return NULL;
+
+    return Buffer->Data;
+}
+
+
+Result Packet::SetSize(int NewSize)
+{
+    if(NewSize < 0 || NewSize > BGE_PACKET_CAPACITY)
+        return BGE_FAILURE;
+
+    Size = NewSize;
+    if(ReadPosition > Size)
+        ReadPosition = Size;
+
+    return BGE_SUCCESS;
+}
+
+
+void Packet::Clear()
+{
+    /* A shared payload is left to its other packets; writes copy it */
+    Size = 0;
+    ReadPosition = 0;
 }
 
 
-Packet* Packet::Create(const Byte* Data)
+int Packet::GetNumReferences() const
 {
-    return NULL;
+    return Buffer->References.load(std::memory_order_relaxed);
 }
 
 } /* bakge */
@@ -35,7 +35,8 @@ Remote::Remote()
     IP[3] = 0;
     Port = 0;
     FullAddress = 0;
-    Str[22] = '\0';
+    Str[0] = '\0';
+    StrValid = false;
 }
 
 
@@ -50,22 +51,34 @@ Remote::~Remote()
 
 Remote BGE_NCP Remote::SetAddress(Byte A, Byte B, Byte C, Byte D)
 {
-    memset((void*)Str, 0, 21);
-    snprintf(Str, 21, "%d.%d.%d.%d:%d", A, B, C, D, Port);
-
     IP[0] = A;
     IP[1] = B;
     IP[2] = C;
     IP[3] = D;
 
     FullAddress = (IP[0] << 24) | (IP[1] << 16) | (IP[2] << 8) | IP[3];
+    StrValid = false;
 
     return *this;
 }
 
 
+Remote BGE_NCP Remote::SetAddress(int Address)
+{
+    return SetAddress((Byte)(Address >> 24), (Byte)(Address >> 16),
+                                    (Byte)(Address >> 8), (Byte)Address);
+}
+
+
 const char* Remote::GetAddressString() const
 {
+    if(!StrValid) {
+        memset((void*)Str, 0, sizeof(Str));
+        snprintf(Str, sizeof(Str), "%d.%d.%d.%d:%d", IP[0], IP[1], IP[2],
+                                                            IP[3], Port);
+        StrValid = true;
+    }
+
     return Str;
 }
 
@@ -79,8 +92,7 @@ int Remote::GetAddress() const
 Remote BGE_NCP Remote::SetPort(int P)
 {
     Port = P;
-    memset((void*)Str, 0, 21);
-    snprintf(Str, 21, "%d.%d.%d.%d:%d", IP[0], IP[1], IP[2], IP[3], Port);
+    StrValid = false;
     return *this;
 }
 
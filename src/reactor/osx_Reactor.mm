@@ -0,0 +1,252 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+static short ToPollEvents(int Events)
+{
+    short Flags = 0;
+
+    if(Events & BGE_SOCKET_READABLE)
+        Flags |= POLLIN;
+
+    if(Events & BGE_SOCKET_WRITABLE)
+        Flags |= POLLOUT;
+
+    return Flags;
+}
+
+
+osx_Reactor::osx_Reactor()
+{
+    Watched = NULL;
+    Keys = NULL;
+    NumWatched = 0;
+    Capacity = 0;
+    WakeHandles[0] = -1;
+    WakeHandles[1] = -1;
+}
+
+
+osx_Reactor::~osx_Reactor()
+{
+    if(WakeHandles[0] >= 0)
+        close(WakeHandles[0]);
+
+    if(WakeHandles[1] >= 0)
+        close(WakeHandles[1]);
+
+    if(Watched != NULL)
+        TrackedFree(Watched);
+
+    if(Keys != NULL)
+        TrackedFree(Keys);
+}
+
+
+osx_Reactor* osx_Reactor::Create()
+{
+    osx_Reactor* R = new osx_Reactor;
+
+    if(R == NULL) {
+        printf("Unable to allocate memory for reactor\n");
+        return NULL;
+    }
+
+    if(pipe(R->WakeHandles) < 0) {
+        perror("pipe()");
+        delete R;
+        return NULL;
+    }
+
+    /* Wake must never block, even with the pipe full */
+    for(int i = 0; i < 2; ++i) {
+        fcntl(R->WakeHandles[i], F_SETFL,
+                    fcntl(R->WakeHandles[i], F_GETFL) | O_NONBLOCK);
+        fcntl(R->WakeHandles[i], F_SETFD, FD_CLOEXEC);
+    }
+
+    if(R->Watch(R->WakeHandles[0], BGE_SOCKET_READABLE, NULL)
+                                                    != BGE_SUCCESS) {
+        delete R;
+        return NULL;
+    }
+
+    return R;
+}
+
+
+int osx_Reactor::FindHandle(int Handle) const
+{
+    for(int i = 0; i < NumWatched; ++i) {
+        if(Watched[i].fd == Handle)
+            return i;
+    }
+
+    return -1;
+}
+
+
+Result osx_Reactor::Watch(intptr_t Handle, int Events, void* Key)
+{
+    struct pollfd* NewWatched;
+    void** NewKeys;
+    int NewCapacity;
+
+    if(NumWatched == Capacity) {
+        NewCapacity = Capacity > 0 ? Capacity * 2 : 16;
+
+        NewWatched = (struct pollfd*)TrackedRealloc(Watched,
+                    NewCapacity * sizeof(struct pollfd), MEMORY_TAG_NETWORK);
+        if(NewWatched == NULL) {
+            printf("Unable to allocate memory for reactor\n");
+            return BGE_FAILURE;
+        }
+
+        Watched = NewWatched;
+
+        NewKeys = (void**)TrackedRealloc(Keys, NewCapacity * sizeof(void*),
+                                                    MEMORY_TAG_NETWORK);
+        if(NewKeys == NULL) {
+            printf("Unable to allocate memory for reactor\n");
+            return BGE_FAILURE;
+        }
+
+        Keys = NewKeys;
+        Capacity = NewCapacity;
+    }
+
+    Watched[NumWatched].fd = (int)Handle;
+    Watched[NumWatched].events = ToPollEvents(Events);
+    Watched[NumWatched].revents = 0;
+    Keys[NumWatched] = Key;
+    ++NumWatched;
+
+    return BGE_SUCCESS;
+}
+
+
+Result osx_Reactor::Rewatch(intptr_t Handle, int Events, void* Key)
+{
+    int i = FindHandle((int)Handle);
+
+    if(i < 0)
+        return BGE_FAILURE;
+
+    Watched[i].events = ToPollEvents(Events);
+    Keys[i] = Key;
+
+    return BGE_SUCCESS;
+}
+
+
+Result osx_Reactor::Unwatch(intptr_t Handle)
+{
+    int i = FindHandle((int)Handle);
+
+    if(i < 0)
+        return BGE_FAILURE;
+
+    /* Order doesn't matter past the wake pipe, so fill the gap from the end */
+    --NumWatched;
+    Watched[i] = Watched[NumWatched];
+    Keys[i] = Keys[NumWatched];
+
+    return BGE_SUCCESS;
+}
+
+
+int osx_Reactor::Wait(void** ReadyKeys, int* Events, int MaxReady,
+                                                    Seconds Timeout)
+{
+    char Drain[64];
+    int Milliseconds;
+    int NumReady;
+    int NumKeys;
+
+    /* Round up so short waits don't turn into busy polling */
+    if(Timeout < 0)
+        Milliseconds = -1;
+    else
+        Milliseconds = (int)ceil(Timeout * 1000);
+
+    NumReady = poll(Watched, (nfds_t)NumWatched, Milliseconds);
+    if(NumReady < 0) {
+        if(errno == EINTR)
+            return 0;
+
+        perror("poll()");
+        return -1;
+    }
+
+    if(Watched[0].revents & POLLIN) {
+        /* Reset the wakeup so the next Wait blocks again */
+        while(read(WakeHandles[0], Drain, sizeof(Drain)) > 0)
+            ;
+
+        --NumReady;
+    }
+
+    NumKeys = 0;
+    for(int i = 1; i < NumWatched && NumKeys < NumReady
+                                    && NumKeys < MaxReady; ++i) {
+        if(Watched[i].revents == 0)
+            continue;
+
+        ReadyKeys[NumKeys] = Keys[i];
+        Events[NumKeys] = 0;
+
+        if(Watched[i].revents & POLLIN)
+            Events[NumKeys] |= BGE_SOCKET_READABLE;
+
+        if(Watched[i].revents & POLLOUT)
+            Events[NumKeys] |= BGE_SOCKET_WRITABLE;
+
+        if(Watched[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+            Events[NumKeys] |= BGE_SOCKET_ERROR;
+
+        ++NumKeys;
+    }
+
+    return NumKeys;
+}
+
+
+Result osx_Reactor::Wake()
+{
+    char One = 1;
+
+    /* A full pipe already has a wakeup waiting in it */
+    if(write(WakeHandles[1], &One, 1) < 0 && errno != EAGAIN) {
+        perror("write()");
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+} /* bakge */
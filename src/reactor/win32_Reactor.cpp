@@ -0,0 +1,262 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+static SHORT ToPollEvents(int Events)
+{
+    SHORT Flags = 0;
+
+    if(Events & BGE_SOCKET_READABLE)
+        Flags |= POLLRDNORM;
+
+    if(Events & BGE_SOCKET_WRITABLE)
+        Flags |= POLLWRNORM;
+
+    return Flags;
+}
+
+
+win32_Reactor::win32_Reactor()
+{
+    Watched = NULL;
+    Keys = NULL;
+    NumWatched = 0;
+    Capacity = 0;
+    WakeHandle = INVALID_SOCKET;
+}
+
+
+win32_Reactor::~win32_Reactor()
+{
+    if(WakeHandle != INVALID_SOCKET)
+        closesocket(WakeHandle);
+
+    if(Watched != NULL)
+        TrackedFree(Watched);
+
+    if(Keys != NULL)
+        TrackedFree(Keys);
+}
+
+
+win32_Reactor* win32_Reactor::Create()
+{
+    win32_Reactor* R = new win32_Reactor;
+    struct sockaddr_in Address;
+    int AddressSize = sizeof(Address);
+    u_long NonBlocking = 1;
+
+    if(R == NULL) {
+        printf("Unable to allocate memory for reactor\n");
+        return NULL;
+    }
+
+    R->WakeHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if(R->WakeHandle == INVALID_SOCKET) {
+        printf("Unable to attach wakeup socket\n");
+        delete R;
+        return NULL;
+    }
+
+    memset((void*)&Address, 0, sizeof(Address));
+    Address.sin_family = AF_INET;
+    Address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Address.sin_port = 0;
+
+    /* Bind to any free loopback port, then send to that same port */
+    if(bind(R->WakeHandle, (struct sockaddr*)&Address, sizeof(Address))
+                                                        == SOCKET_ERROR
+        || getsockname(R->WakeHandle, (struct sockaddr*)&Address,
+                                            &AddressSize) == SOCKET_ERROR
+        || connect(R->WakeHandle, (struct sockaddr*)&Address,
+                                    sizeof(Address)) == SOCKET_ERROR
+        || ioctlsocket(R->WakeHandle, FIONBIO, &NonBlocking)
+                                                    == SOCKET_ERROR) {
+        printf("Unable to set up wakeup socket (%d)\n", WSAGetLastError());
+        delete R;
+        return NULL;
+    }
+
+    if(R->Watch((intptr_t)R->WakeHandle, BGE_SOCKET_READABLE, NULL)
+                                                        != BGE_SUCCESS) {
+        delete R;
+        return NULL;
+    }
+
+    return R;
+}
+
+
+int win32_Reactor::FindHandle(SOCKET Handle) const
+{
+    for(int i = 0; i < NumWatched; ++i) {
+        if(Watched[i].fd == Handle)
+            return i;
+    }
+
+    return -1;
+}
+
+
+Result win32_Reactor::Watch(intptr_t Handle, int Events, void* Key)
+{
+    WSAPOLLFD* NewWatched;
+    void** NewKeys;
+    int NewCapacity;
+
+    if(NumWatched == Capacity) {
+        NewCapacity = Capacity > 0 ? Capacity * 2 : 16;
+
+        NewWatched = (WSAPOLLFD*)TrackedRealloc(Watched,
+                        NewCapacity * sizeof(WSAPOLLFD), MEMORY_TAG_NETWORK);
+        if(NewWatched == NULL) {
+            printf("Unable to allocate memory for reactor\n");
+            return BGE_FAILURE;
+        }
+
+        Watched = NewWatched;
+
+        NewKeys = (void**)TrackedRealloc(Keys, NewCapacity * sizeof(void*),
+                                                    MEMORY_TAG_NETWORK);
+        if(NewKeys == NULL) {
+            printf("Unable to allocate memory for reactor\n");
+            return BGE_FAILURE;
+        }
+
+        Keys = NewKeys;
+        Capacity = NewCapacity;
+    }
+
+    Watched[NumWatched].fd = (SOCKET)Handle;
+    Watched[NumWatched].events = ToPollEvents(Events);
+    Watched[NumWatched].revents = 0;
+    Keys[NumWatched] = Key;
+    ++NumWatched;
+
+    return BGE_SUCCESS;
+}
+
+
+Result win32_Reactor::Rewatch(intptr_t Handle, int Events, void* Key)
+{
+    int i = FindHandle((SOCKET)Handle);
+
+    if(i < 0)
+        return BGE_FAILURE;
+
+    Watched[i].events = ToPollEvents(Events);
+    Keys[i] = Key;
+
+    return BGE_SUCCESS;
+}
+
+
+Result win32_Reactor::Unwatch(intptr_t Handle)
+{
+    int i = FindHandle((SOCKET)Handle);
+
+    if(i < 0)
+        return BGE_FAILURE;
+
+    /* Order doesn't matter past the wakeup, so fill the gap from the end */
+    --NumWatched;
+    Watched[i] = Watched[NumWatched];
+    Keys[i] = Keys[NumWatched];
+
+    return BGE_SUCCESS;
+}
+
+
+int win32_Reactor::Wait(void** ReadyKeys, int* Events, int MaxReady,
+                                                    Seconds Timeout)
+{
+    char Drain[64];
+    int Milliseconds;
+    int NumReady;
+    int NumKeys;
+
+    /* Round up so short waits don't turn into busy polling */
+    if(Timeout < 0)
+        Milliseconds = -1;
+    else
+        Milliseconds = (int)ceil(Timeout * 1000);
+
+    NumReady = WSAPoll(Watched, (ULONG)NumWatched, Milliseconds);
+    if(NumReady == SOCKET_ERROR) {
+        printf("Error polling sockets (%d)\n", WSAGetLastError());
+        return -1;
+    }
+
+    if(Watched[0].revents & POLLRDNORM) {
+        /* Reset the wakeup so the next Wait blocks again */
+        while(recv(WakeHandle, Drain, sizeof(Drain), 0) > 0)
+            ;
+
+        --NumReady;
+    }
+
+    NumKeys = 0;
+    for(int i = 1; i < NumWatched && NumKeys < NumReady
+                                    && NumKeys < MaxReady; ++i) {
+        if(Watched[i].revents == 0)
+            continue;
+
+        ReadyKeys[NumKeys] = Keys[i];
+        Events[NumKeys] = 0;
+
+        if(Watched[i].revents & POLLRDNORM)
+            Events[NumKeys] |= BGE_SOCKET_READABLE;
+
+        if(Watched[i].revents & POLLWRNORM)
+            Events[NumKeys] |= BGE_SOCKET_WRITABLE;
+
+        if(Watched[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+            Events[NumKeys] |= BGE_SOCKET_ERROR;
+
+        ++NumKeys;
+    }
+
+    return NumKeys;
+}
+
+
+Result win32_Reactor::Wake()
+{
+    char One = 1;
+
+    /* A wakeup already queued is as good as this one */
+    if(send(WakeHandle, &One, 1, 0) == SOCKET_ERROR
+                    && WSAGetLastError() != WSAEWOULDBLOCK) {
+        printf("Error waking reactor (%d)\n", WSAGetLastError());
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+} /* bakge */
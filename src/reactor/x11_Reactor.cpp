@@ -0,0 +1,217 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+static uint32_t ToEpollEvents(int Events)
+{
+    uint32_t Flags = 0;
+
+    if(Events & BGE_SOCKET_READABLE)
+        Flags |= EPOLLIN;
+
+    if(Events & BGE_SOCKET_WRITABLE)
+        Flags |= EPOLLOUT;
+
+    return Flags;
+}
+
+
+x11_Reactor::x11_Reactor()
+{
+    EpollHandle = -1;
+    WakeHandle = -1;
+}
+
+
+x11_Reactor::~x11_Reactor()
+{
+    if(WakeHandle >= 0)
+        close(WakeHandle);
+
+    if(EpollHandle >= 0)
+        close(EpollHandle);
+}
+
+
+x11_Reactor* x11_Reactor::Create()
+{
+    x11_Reactor* R = new x11_Reactor;
+    struct epoll_event Event;
+
+    if(R == NULL) {
+        printf("Unable to allocate memory for reactor\n");
+        return NULL;
+    }
+
+    R->EpollHandle = epoll_create1(EPOLL_CLOEXEC);
+    if(R->EpollHandle < 0) {
+        perror("epoll_create1()");
+        delete R;
+        return NULL;
+    }
+
+    R->WakeHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(R->WakeHandle < 0) {
+        perror("eventfd()");
+        delete R;
+        return NULL;
+    }
+
+    /* Sockets are keyed by their entries; the wakeup by NULL */
+    memset((void*)&Event, 0, sizeof(Event));
+    Event.events = EPOLLIN;
+    Event.data.ptr = NULL;
+
+    if(epoll_ctl(R->EpollHandle, EPOLL_CTL_ADD, R->WakeHandle, &Event) < 0) {
+        perror("epoll_ctl()");
+        delete R;
+        return NULL;
+    }
+
+    return R;
+}
+
+
+Result x11_Reactor::Watch(intptr_t Handle, int Events, void* Key)
+{
+    struct epoll_event Event;
+
+    memset((void*)&Event, 0, sizeof(Event));
+    Event.events = ToEpollEvents(Events);
+    Event.data.ptr = Key;
+
+    if(epoll_ctl(EpollHandle, EPOLL_CTL_ADD, (int)Handle, &Event) < 0) {
+        perror("epoll_ctl()");
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result x11_Reactor::Rewatch(intptr_t Handle, int Events, void* Key)
+{
+    struct epoll_event Event;
+
+    memset((void*)&Event, 0, sizeof(Event));
+    Event.events = ToEpollEvents(Events);
+    Event.data.ptr = Key;
+
+    if(epoll_ctl(EpollHandle, EPOLL_CTL_MOD, (int)Handle, &Event) < 0) {
+        perror("epoll_ctl()");
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result x11_Reactor::Unwatch(intptr_t Handle)
+{
+    /* Older kernels want an event even though removing ignores it */
+    struct epoll_event Event;
+
+    memset((void*)&Event, 0, sizeof(Event));
+
+    if(epoll_ctl(EpollHandle, EPOLL_CTL_DEL, (int)Handle, &Event) < 0)
+        return BGE_FAILURE;
+
+    return BGE_SUCCESS;
+}
+
+
+int x11_Reactor::Wait(void** Keys, int* Events, int MaxReady,
+                                                    Seconds Timeout)
+{
+    struct epoll_event Ready[BGE_REACTOR_BATCH];
+    uint64_t Count;
+    int Milliseconds;
+    int NumReady;
+    int NumKeys;
+
+    /* Round up so short waits don't turn into busy polling */
+    if(Timeout < 0)
+        Milliseconds = -1;
+    else
+        Milliseconds = (int)ceil(Timeout * 1000);
+
+    if(MaxReady > BGE_REACTOR_BATCH)
+        MaxReady = BGE_REACTOR_BATCH;
+
+    NumReady = epoll_wait(EpollHandle, Ready, MaxReady, Milliseconds);
+    if(NumReady < 0) {
+        if(errno == EINTR)
+            return 0;
+
+        perror("epoll_wait()");
+        return -1;
+    }
+
+    NumKeys = 0;
+    for(int i = 0; i < NumReady; ++i) {
+        if(Ready[i].data.ptr == NULL) {
+            /* Reset the wakeup so the next Wait blocks again */
+            if(read(WakeHandle, &Count, sizeof(Count)) < 0 && errno != EAGAIN)
+                perror("read()");
+
+            continue;
+        }
+
+        Keys[NumKeys] = Ready[i].data.ptr;
+        Events[NumKeys] = 0;
+
+        if(Ready[i].events & EPOLLIN)
+            Events[NumKeys] |= BGE_SOCKET_READABLE;
+
+        if(Ready[i].events & EPOLLOUT)
+            Events[NumKeys] |= BGE_SOCKET_WRITABLE;
+
+        if(Ready[i].events & (EPOLLERR | EPOLLHUP))
+            Events[NumKeys] |= BGE_SOCKET_ERROR;
+
+        ++NumKeys;
+    }
+
+    return NumKeys;
+}
+
+
+Result x11_Reactor::Wake()
+{
+    uint64_t One = 1;
+
+    /* Fails only if the counter is about to overflow, which still wakes */
+    if(write(WakeHandle, &One, sizeof(One)) < 0 && errno != EAGAIN) {
+        perror("write()");
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+} /* bakge */
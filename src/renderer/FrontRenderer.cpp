@@ -24,11 +24,15 @@
 
 #include <bakge/Bakge.h>
 
+/* Objects whose bounds are gathered and culled together */
+#define FRONTRENDERER_CULL_BATCH 64
+
 namespace bakge
 {
 
 FrontRenderer::FrontRenderer()
 {
+    ResetCounters();
 }
 
 
@@ -61,13 +65,86 @@ Result FrontRenderer::Unbind() const
 
 Result FrontRenderer::Draw(Drawable* Obj)
 {
+    BoundingBox Box = Obj->GetBoundingBox();
+
+    if(!Box.IsEmpty()) {
+        ++NumTested;
+        if(!ViewFrustum.Intersects(Box)) {
+            ++NumCulled;
+            return BGE_SUCCESS;
+        }
+    }
+
     if(Obj->Bind() != BGE_SUCCESS)
         return BGE_FAILURE;
 
     Obj->Draw();
     Obj->Unbind();
+    ++NumDrawn;
 
     return BGE_SUCCESS;
 }
 
+
+Result FrontRenderer::Draw(Drawable** Objs, size_t N)
+{
+    BoundingBox Boxes[FRONTRENDERER_CULL_BATCH];
+    bool Visible[FRONTRENDERER_CULL_BATCH];
+    Result Errors = BGE_SUCCESS;
+
+    for(size_t Start = 0; Start < N; Start += FRONTRENDERER_CULL_BATCH) {
+        size_t Num = N - Start;
+
+        if(Num > FRONTRENDERER_CULL_BATCH)
+            Num = FRONTRENDERER_CULL_BATCH;
+
+        for(size_t i = 0; i < Num; ++i)
+            Boxes[i] = Objs[Start + i]->GetBoundingBox();
+
+        ViewFrustum.Intersects(Boxes, Visible, Num);
+
+        for(size_t i = 0; i < Num; ++i) {
+            Drawable* Obj = Objs[Start + i];
+
+            /* *
+             * The frustum rejects empty boxes, but those objects have no
+             * bounds and are always drawn
+             * */
+            if(!Boxes[i].IsEmpty()) {
+                ++NumTested;
+                if(!Visible[i]) {
+                    ++NumCulled;
+                    continue;
+                }
+            }
+
+            if(Obj->Bind() != BGE_SUCCESS) {
+                Errors = BGE_FAILURE;
+                continue;
+            }
+
+            Obj->Draw();
+            Obj->Unbind();
+            ++NumDrawn;
+        }
+    }
+
+    return Errors;
+}
+
+
+void FrontRenderer::SetViewProjection(Matrix BGE_NCP Perspective,
+                                        Matrix BGE_NCP View)
+{
+    ViewFrustum.SetMatrix(Perspective * View);
+}
+
+
+void FrontRenderer::ResetCounters()
+{
+    NumTested = 0;
+    NumCulled = 0;
+    NumDrawn = 0;
+}
+
 } /* bakge */
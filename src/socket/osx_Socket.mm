@@ -27,6 +27,37 @@
 namespace bakge
 {
 
+/* *
+ * Receives one datagram into a packet buffer. BSD sockets can't report
+ * the full length of datagrams that didn't fit, but flag them, so they
+ * can still be dropped instead of passed on cut short.
+ * */
+static ssize_t ReceiveDatagram(int Handle, Byte* Data, int Flags,
+                            struct sockaddr_in* From, bool* Truncated)
+{
+    struct msghdr Message;
+    struct iovec Vector;
+    ssize_t Received;
+
+    Vector.iov_base = Data;
+    Vector.iov_len = BGE_PACKET_CAPACITY;
+
+    memset((void*)&Message, 0, sizeof(Message));
+    Message.msg_name = From;
+    Message.msg_namelen = sizeof(*From);
+    Message.msg_iov = &Vector;
+    Message.msg_iovlen = 1;
+
+    do {
+        Received = recvmsg(Handle, &Message, Flags);
+    } while(Received < 0 && errno == EINTR);
+
+    *Truncated = Received >= 0 && (Message.msg_flags & MSG_TRUNC) != 0;
+
+    return Received;
+}
+
+
 osx_Socket::osx_Socket()
 {
     SocketHandle = 0;
@@ -49,11 +80,9 @@ osx_Socket* osx_Socket::Create(int Port)
     if(Sock->SocketHandle < 0) {
         printf("Unable to attach socket\n");
         delete Sock;
-        return Sock;
+        return NULL;
     }
 
-    printf("Socket %d\n", Sock->SocketHandle);
-
     memset((void*)&(Sock->SocketIn), 0, sizeof(Sock->SocketIn));
     Sock->SocketIn.sin_family = AF_INET;
     Sock->SocketIn.sin_port = htons(Port);
@@ -72,36 +101,160 @@ osx_Socket* osx_Socket::Create(int Port)
 
 Packet* osx_Socket::Receive()
 {
-    struct sockaddr_in ReceiveSocketIn;
-    Byte* Data = new Byte[512];
-    int Size = sizeof(ReceiveSocketIn);
-
-    printf("Waiting for packet...\n");
-    if(recvfrom(SocketHandle, Data, 512, 0, (struct sockaddr*)&ReceiveSocketIn,
-                                                    (socklen_t*)&Size) < 0) {
-        printf("Error receiving packet\n");
+    struct sockaddr_in From;
+    ssize_t Received;
+    bool Truncated;
+    Packet* Pack;
+    Byte* Data;
+    Remote Sender;
+
+    /* Receive straight into a pooled packet buffer */
+    Pack = Packet::Create();
+    if(Pack == NULL)
         return NULL;
+
+    Data = Pack->GetWritableData();
+
+    for(;;) {
+        Received = ReceiveDatagram(SocketHandle, Data, 0, &From,
+                                                        &Truncated);
+        if(!Truncated)
+            break;
+
+        printf("Dropped packet over %d bytes\n", BGE_PACKET_CAPACITY);
     }
 
-    delete[] Data;
+    if(Received < 0) {
+        /* Nothing has arrived on a non-blocking socket */
+        if(errno != EAGAIN && errno != EWOULDBLOCK)
+            perror("recvmsg()");
+
+        delete Pack;
+        return NULL;
+    }
+
+    Pack->SetSize((int)Received);
+
+    Sender.SetAddress((int)ntohl(From.sin_addr.s_addr));
+    Sender.SetPort(ntohs(From.sin_port));
+    Pack->SetSender(Sender);
 
-    return Packet::Create(NULL);
+    return Pack;
 }
 
 
 Result osx_Socket::Send(Remote* Destination, Packet* Data)
 {
     struct sockaddr_in Dest;
+    ssize_t Sent;
+
+    if(Destination == NULL || Data == NULL)
+        return BGE_FAILURE;
+
     memset((void*)&Dest, 0, sizeof(Dest));
 
     Dest.sin_addr.s_addr = htonl(Destination->GetAddress());
     Dest.sin_port = htons(Destination->GetPort());
     Dest.sin_family = PF_INET;
 
-    sendto(SocketHandle, NULL, 0, 0, (struct sockaddr*)&Dest,
-                                                sizeof(Dest));
+    do {
+        Sent = sendto(SocketHandle, Data->GetData(), Data->GetSize(), 0,
+                                (struct sockaddr*)&Dest, sizeof(Dest));
+    } while(Sent < 0 && errno == EINTR);
+
+    if(Sent != Data->GetSize()) {
+        if(Sent >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            perror("sendto()");
+
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result osx_Socket::SetBlocking(bool Block)
+{
+    int Flags;
+
+    Flags = fcntl(SocketHandle, F_GETFL, 0);
+    if(Flags < 0) {
+        perror("fcntl()");
+        return BGE_FAILURE;
+    }
+
+    Flags = Block ? (Flags & ~O_NONBLOCK) : (Flags | O_NONBLOCK);
+    if(fcntl(SocketHandle, F_SETFL, Flags) < 0) {
+        perror("fcntl()");
+        return BGE_FAILURE;
+    }
+
+    Blocking = Block;
 
     return BGE_SUCCESS;
 }
 
+
+int osx_Socket::GetPort() const
+{
+    struct sockaddr_in Bound;
+    socklen_t BoundSize = sizeof(Bound);
+
+    if(getsockname(SocketHandle, (struct sockaddr*)&Bound, &BoundSize) < 0)
+        return 0;
+
+    return ntohs(Bound.sin_port);
+}
+
+
+int osx_Socket::ReceiveMany(Packet** Packets, int MaxPackets)
+{
+    struct sockaddr_in From;
+    ssize_t Received;
+    bool Truncated;
+    Remote Sender;
+    int Count;
+
+    if(Packets == NULL || MaxPackets < 1)
+        return -1;
+
+    /* There's no recvmmsg; wait for one, then take the queued ones */
+    Packets[0] = Receive();
+    if(Packets[0] == NULL)
+        return Blocking ? -1 : 0;
+
+    for(Count = 1; Count < MaxPackets; ++Count) {
+        Packets[Count] = Packet::Create();
+        if(Packets[Count] == NULL)
+            break;
+
+        Received = ReceiveDatagram(SocketHandle,
+                            Packets[Count]->GetWritableData(), MSG_DONTWAIT,
+                            &From, &Truncated);
+        if(Received < 0) {
+            if(errno != EAGAIN && errno != EWOULDBLOCK)
+                perror("recvmsg()");
+
+            delete Packets[Count];
+            Packets[Count] = NULL;
+            break;
+        }
+
+        /* Drop it and try the next one in the same slot */
+        if(Truncated) {
+            printf("Dropped packet over %d bytes\n", BGE_PACKET_CAPACITY);
+            delete Packets[Count--];
+            continue;
+        }
+
+        Packets[Count]->SetSize((int)Received);
+
+        Sender.SetAddress((int)ntohl(From.sin_addr.s_addr));
+        Sender.SetPort(ntohs(From.sin_port));
+        Packets[Count]->SetSender(Sender);
+    }
+
+    return Count;
+}
+
 } /* bakge */
@@ -63,36 +63,94 @@ win32_Socket* win32_Socket::Create(int Port)
 
 Packet* win32_Socket::Receive()
 {
-    struct sockaddr_in Receive;
-    char* Data = new char[512];
-    int Size = sizeof(Receive);
-
-    printf("Waiting for packet...\n");
-    if(recvfrom(SocketHandle, Data, 512, 0, (struct sockaddr*)&Receive,
-                                                        &Size) < 0) {
-        printf("Error receiving packet\n");
+    struct sockaddr_in From;
+    int FromSize = sizeof(From);
+    int Received;
+    Packet* Pack;
+    Byte* Data;
+    Remote Sender;
+
+    /* Receive straight into a pooled packet buffer */
+    Pack = Packet::Create();
+    if(Pack == NULL)
+        return NULL;
+
+    Data = Pack->GetWritableData();
+
+    Received = recvfrom(SocketHandle, (char*)Data, BGE_PACKET_CAPACITY, 0,
+                                    (struct sockaddr*)&From, &FromSize);
+    if(Received == SOCKET_ERROR) {
+        /* Nothing has arrived on a non-blocking socket */
+        if(WSAGetLastError() != WSAEWOULDBLOCK)
+            printf("Error receiving packet (%d)\n", WSAGetLastError());
+
+        delete Pack;
         return NULL;
     }
 
-    delete[] Data;
+    Pack->SetSize(Received);
+
+    Sender.SetAddress((int)ntohl(From.sin_addr.s_addr));
+    Sender.SetPort(ntohs(From.sin_port));
+    Pack->SetSender(Sender);
 
-    return Packet::Create(NULL);
+    return Pack;
 }
 
 
 Result win32_Socket::Send(Remote* Destination, Packet* Data)
 {
     struct sockaddr_in Dest;
+    int Sent;
+
+    if(Destination == NULL || Data == NULL)
+        return BGE_FAILURE;
+
     memset((void*)&Dest, 0, sizeof(Dest));
 
     Dest.sin_addr.s_addr = htonl(Destination->GetAddress());
     Dest.sin_port = htons(Destination->GetPort());
     Dest.sin_family = PF_INET;
 
-    sendto(SocketHandle, NULL, 0, 0, (struct sockaddr*)&Dest,
-                                                sizeof(Dest));
+    Sent = sendto(SocketHandle, (const char*)Data->GetData(),
+                    Data->GetSize(), 0, (struct sockaddr*)&Dest,
+                                                    sizeof(Dest));
+    if(Sent != Data->GetSize()) {
+        if(Sent != SOCKET_ERROR || WSAGetLastError() != WSAEWOULDBLOCK)
+            printf("Error sending packet (%d)\n", WSAGetLastError());
+
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+
+Result win32_Socket::SetBlocking(bool Block)
+{
+    u_long NonBlocking = Block ? 0 : 1;
+
+    if(ioctlsocket(SocketHandle, FIONBIO, &NonBlocking) == SOCKET_ERROR) {
+        printf("Error setting socket mode (%d)\n", WSAGetLastError());
+        return BGE_FAILURE;
+    }
+
+    Blocking = Block;
 
     return BGE_SUCCESS;
 }
 
+
+int win32_Socket::GetPort() const
+{
+    struct sockaddr_in Bound;
+    int BoundSize = sizeof(Bound);
+
+    if(getsockname(SocketHandle, (struct sockaddr*)&Bound,
+                                &BoundSize) == SOCKET_ERROR)
+        return 0;
+
+    return ntohs(Bound.sin_port);
+}
+
 } /* bakge */
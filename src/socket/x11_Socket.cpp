@@ -30,6 +30,7 @@ namespace bakge
 x11_Socket::x11_Socket()
 {
     SocketHandle = 0;
+    NumSpares = 0;
 }
 
 
@@ -38,6 +39,9 @@ x11_Socket::~x11_Socket()
     if(SocketHandle >= 0) {
         close(SocketHandle);
     }
+
+    while(NumSpares > 0)
+        delete Spares[--NumSpares];
 }
 
 
@@ -49,11 +53,9 @@ x11_Socket* x11_Socket::Create(int Port)
     if(Sock->SocketHandle < 0) {
         printf("Unable to attach socket\n");
         delete Sock;
-        return Sock;
+        return NULL;
     }
 
-    printf("Socket %d\n", Sock->SocketHandle);
-
     memset((void*)&(Sock->SocketIn), 0, sizeof(Sock->SocketIn));
     Sock->SocketIn.sin_family = AF_INET;
     Sock->SocketIn.sin_port = htons(Port);
@@ -72,36 +74,259 @@ x11_Socket* x11_Socket::Create(int Port)
 
 Packet* x11_Socket::Receive()
 {
-    struct sockaddr_in ReceiveSocketIn;
-    Byte* Data = new Byte[512];
-    int Size = sizeof(ReceiveSocketIn);
-
-    printf("Waiting for packet...\n");
-    if(recvfrom(SocketHandle, Data, 512, 0, (struct sockaddr*)&ReceiveSocketIn,
-                                                    (socklen_t*)&Size) < 0) {
-        printf("Error receiving packet\n");
+    struct sockaddr_in From;
+    socklen_t FromSize;
+    ssize_t Received;
+    Packet* Pack;
+    Byte* Data;
+    Remote Sender;
+
+    /* Receive straight into a pooled packet buffer */
+    Pack = Packet::Create();
+    if(Pack == NULL)
         return NULL;
+
+    Data = Pack->GetWritableData();
+
+    /* *
+     * MSG_TRUNC returns a datagram's full length, so ones cut short to
+     * fit the buffer can be told apart and dropped
+     * */
+    for(;;) {
+        FromSize = sizeof(From);
+        Received = recvfrom(SocketHandle, Data, BGE_PACKET_CAPACITY,
+                        MSG_TRUNC, (struct sockaddr*)&From, &FromSize);
+
+        if(Received > BGE_PACKET_CAPACITY) {
+            printf("Dropped %d byte packet; packets hold at most %d\n",
+                                    (int)Received, BGE_PACKET_CAPACITY);
+            continue;
+        }
+
+        if(Received >= 0 || errno != EINTR)
+            break;
     }
 
-    delete[] Data;
+    if(Received < 0) {
+        /* Nothing has arrived on a non-blocking socket */
+        if(errno != EAGAIN && errno != EWOULDBLOCK)
+            perror("recvfrom()");
 
-    return Packet::Create(NULL);
+        delete Pack;
+        return NULL;
+    }
+
+    Pack->SetSize((int)Received);
+
+    Sender.SetAddress((int)ntohl(From.sin_addr.s_addr));
+    Sender.SetPort(ntohs(From.sin_port));
+    Pack->SetSender(Sender);
+
+    return Pack;
 }
 
 
 Result x11_Socket::Send(Remote* Destination, Packet* Data)
 {
     struct sockaddr_in Dest;
+    ssize_t Sent;
+
+    if(Destination == NULL || Data == NULL)
+        return BGE_FAILURE;
+
     memset((void*)&Dest, 0, sizeof(Dest));
 
     Dest.sin_addr.s_addr = htonl(Destination->GetAddress());
     Dest.sin_port = htons(Destination->GetPort());
     Dest.sin_family = PF_INET;
 
-    sendto(SocketHandle, NULL, 0, 0, (struct sockaddr*)&Dest,
-                                                sizeof(Dest));
+    do {
+        Sent = sendto(SocketHandle, Data->GetData(), Data->GetSize(), 0,
+                                (struct sockaddr*)&Dest, sizeof(Dest));
+    } while(Sent < 0 && errno == EINTR);
+
+    if(Sent != Data->GetSize()) {
+        if(Sent >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            perror("sendto()");
+
+        return BGE_FAILURE;
+    }
 
     return BGE_SUCCESS;
 }
 
+
+Result x11_Socket::SetBlocking(bool Block)
+{
+    int Flags;
+
+    Flags = fcntl(SocketHandle, F_GETFL, 0);
+    if(Flags < 0) {
+        perror("fcntl()");
+        return BGE_FAILURE;
+    }
+
+    Flags = Block ? (Flags & ~O_NONBLOCK) : (Flags | O_NONBLOCK);
+    if(fcntl(SocketHandle, F_SETFL, Flags) < 0) {
+        perror("fcntl()");
+        return BGE_FAILURE;
+    }
+
+    Blocking = Block;
+
+    return BGE_SUCCESS;
+}
+
+
+int x11_Socket::GetPort() const
+{
+    struct sockaddr_in Bound;
+    socklen_t BoundSize = sizeof(Bound);
+
+    if(getsockname(SocketHandle, (struct sockaddr*)&Bound, &BoundSize) < 0)
+        return 0;
+
+    return ntohs(Bound.sin_port);
+}
+
+
+int x11_Socket::ReceiveMany(Packet** Packets, int MaxPackets)
+{
+    struct mmsghdr Messages[BGE_SOCKET_BATCH];
+    struct iovec Vectors[BGE_SOCKET_BATCH];
+    struct sockaddr_in From[BGE_SOCKET_BATCH];
+    Remote Sender;
+    int NumBuffers;
+    int Received;
+    int Kept;
+    int i;
+
+    if(Packets == NULL || MaxPackets < 1)
+        return -1;
+
+    if(MaxPackets > BGE_SOCKET_BATCH)
+        MaxPackets = BGE_SOCKET_BATCH;
+
+    /* Every message gets a packet buffer to land in */
+    for(NumBuffers = 0; NumBuffers < MaxPackets; ++NumBuffers) {
+        if(NumSpares > 0)
+            Packets[NumBuffers] = Spares[--NumSpares];
+        else
+            Packets[NumBuffers] = Packet::Create();
+
+        if(Packets[NumBuffers] == NULL)
+            break;
+
+        Vectors[NumBuffers].iov_base = Packets[NumBuffers]->GetWritableData();
+        Vectors[NumBuffers].iov_len = BGE_PACKET_CAPACITY;
+
+        memset((void*)&Messages[NumBuffers], 0, sizeof(struct mmsghdr));
+        Messages[NumBuffers].msg_hdr.msg_name = &From[NumBuffers];
+        Messages[NumBuffers].msg_hdr.msg_namelen = sizeof(From[NumBuffers]);
+        Messages[NumBuffers].msg_hdr.msg_iov = &Vectors[NumBuffers];
+        Messages[NumBuffers].msg_hdr.msg_iovlen = 1;
+    }
+
+    if(NumBuffers == 0)
+        return -1;
+
+    /* Block for the first datagram only, then take what's queued */
+    do {
+        Received = recvmmsg(SocketHandle, Messages, NumBuffers,
+                                                MSG_WAITFORONE, NULL);
+    } while(Received < 0 && errno == EINTR);
+
+    if(Received < 0) {
+        /* Nothing has arrived on a non-blocking socket */
+        if(errno == EAGAIN || errno == EWOULDBLOCK) {
+            Received = 0;
+        } else {
+            perror("recvmmsg()");
+            Received = -1;
+        }
+    }
+
+    /* Keep datagrams that fit, moving them down over any that didn't */
+    for(i = 0, Kept = 0; i < Received; ++i) {
+        if(Messages[i].msg_hdr.msg_flags & MSG_TRUNC) {
+            printf("Dropped packet over %d bytes\n", BGE_PACKET_CAPACITY);
+            Spares[NumSpares++] = Packets[i];
+            continue;
+        }
+
+        Packets[Kept] = Packets[i];
+        Packets[Kept]->SetSize((int)Messages[i].msg_len);
+
+        Sender.SetAddress((int)ntohl(From[i].sin_addr.s_addr));
+        Sender.SetPort(ntohs(From[i].sin_port));
+        Packets[Kept]->SetSender(Sender);
+        ++Kept;
+    }
+
+    /* Keep unfilled packets for the next call */
+    for(i = Received < 0 ? 0 : Received; i < NumBuffers; ++i)
+        Spares[NumSpares++] = Packets[i];
+
+    for(i = Kept; i < NumBuffers; ++i)
+        Packets[i] = NULL;
+
+    if(Received < 0)
+        return -1;
+
+    return Kept;
+}
+
+
+int x11_Socket::SendMany(Remote* Destinations, Packet** Packets,
+                                                    int NumPackets)
+{
+    struct mmsghdr Messages[BGE_SOCKET_BATCH];
+    struct iovec Vectors[BGE_SOCKET_BATCH];
+    struct sockaddr_in To[BGE_SOCKET_BATCH];
+    Remote* Destination;
+    int Total;
+    int Count;
+    int Sent;
+
+    if(Destinations == NULL || Packets == NULL)
+        return -1;
+
+    for(Total = 0; Total < NumPackets; Total += Sent) {
+        Count = NumPackets - Total;
+        if(Count > BGE_SOCKET_BATCH)
+            Count = BGE_SOCKET_BATCH;
+
+        for(int i = 0; i < Count; ++i) {
+            Destination = &Destinations[Total + i];
+
+            memset((void*)&To[i], 0, sizeof(To[i]));
+            To[i].sin_addr.s_addr = htonl(Destination->GetAddress());
+            To[i].sin_port = htons(Destination->GetPort());
+            To[i].sin_family = PF_INET;
+
+            Vectors[i].iov_base = (void*)Packets[Total + i]->GetData();
+            Vectors[i].iov_len = Packets[Total + i]->GetSize();
+
+            memset((void*)&Messages[i], 0, sizeof(struct mmsghdr));
+            Messages[i].msg_hdr.msg_name = &To[i];
+            Messages[i].msg_hdr.msg_namelen = sizeof(To[i]);
+            Messages[i].msg_hdr.msg_iov = &Vectors[i];
+            Messages[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        do {
+            Sent = sendmmsg(SocketHandle, Messages, Count, 0);
+        } while(Sent < 0 && errno == EINTR);
+
+        if(Sent <= 0) {
+            if(Sent == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+                perror("sendmmsg()");
+
+            break;
+        }
+    }
+
+    return Total;
+}
+
 } /* bakge */
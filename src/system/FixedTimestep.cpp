@@ -0,0 +1,208 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+FixedTimestep::FixedTimestep()
+{
+    StepSize = 0;
+    MaxFrameTime = (Nanoseconds)(BGE_DEFAULT_MAX_FRAME_TIME * 1000000000);
+    Accumulator = 0;
+    LastFrameStart = -1;
+    LastFrameTime = 0;
+
+    ResetJitterStats();
+}
+
+
+FixedTimestep::~FixedTimestep()
+{
+}
+
+
+FixedTimestep* FixedTimestep::Create(Seconds StepSize)
+{
+    FixedTimestep* T;
+
+    if(StepSize <= 0) {
+        printf("Timestep must be greater than zero\n");
+        return NULL;
+    }
+
+    T = new FixedTimestep;
+    if(T == NULL) {
+        printf("Unable to allocate memory for fixed timestep\n");
+        return NULL;
+    }
+
+    T->StepSize = (Nanoseconds)(StepSize * 1000000000);
+    if(T->StepSize < 1)
+        T->StepSize = 1;
+
+    return T;
+}
+
+
+int FixedTimestep::BeginFrame()
+{
+    Nanoseconds Now;
+    Nanoseconds FrameTime;
+
+    Now = GetRunningNanoseconds();
+
+    if(LastFrameStart < 0) {
+        LastFrameStart = Now;
+        return 0;
+    }
+
+    FrameTime = Now - LastFrameStart;
+    LastFrameStart = Now;
+
+    return Advance(FrameTime);
+}
+
+
+int FixedTimestep::Advance(Nanoseconds FrameTime)
+{
+    double Difference;
+
+    if(FrameTime < 0)
+        FrameTime = 0;
+
+    /* Welford's running mean and sum of squared differences */
+    ++NumFrames;
+    Difference = FrameTime - FrameTimeMean;
+    FrameTimeMean += Difference / NumFrames;
+    FrameTimeSquares += Difference * (FrameTime - FrameTimeMean);
+
+    if(FrameTime < MinFrameTime || NumFrames == 1)
+        MinFrameTime = FrameTime;
+
+    if(FrameTime > MaxMeasuredFrameTime)
+        MaxMeasuredFrameTime = FrameTime;
+
+    if(NumFrames > 1)
+        JitterSum += llabs(FrameTime - LastFrameTime);
+
+    LastFrameTime = FrameTime;
+
+    if(FrameTime > MaxFrameTime) {
+        DroppedTime += FrameTime - MaxFrameTime;
+        FrameTime = MaxFrameTime;
+    }
+
+    Accumulator += FrameTime;
+
+    return (int)(Accumulator / StepSize);
+}
+
+
+bool FixedTimestep::Step()
+{
+    if(Accumulator < StepSize)
+        return false;
+
+    Accumulator -= StepSize;
+    ++NumSteps;
+
+    return true;
+}
+
+
+double FixedTimestep::GetAlpha() const
+{
+    return (double)Accumulator / StepSize;
+}
+
+
+Seconds FixedTimestep::GetStepSize() const
+{
+    return StepSize / 1000000000.0;
+}
+
+
+Seconds FixedTimestep::GetLastFrameTime() const
+{
+    return LastFrameTime / 1000000000.0;
+}
+
+
+Nanoseconds FixedTimestep::GetNextStepTime() const
+{
+    return LastFrameStart + StepSize - Accumulator;
+}
+
+
+Result FixedTimestep::SetMaxFrameTime(Seconds MaxTime)
+{
+    if(MaxTime * 1000000000 < StepSize) {
+        printf("Maximum frame time must be at least one step\n");
+        return BGE_FAILURE;
+    }
+
+    MaxFrameTime = (Nanoseconds)(MaxTime * 1000000000);
+
+    return BGE_SUCCESS;
+}
+
+
+void FixedTimestep::GetJitterStats(FrameJitterStats* Stats) const
+{
+    memset((void*)Stats, 0, sizeof(FrameJitterStats));
+
+    Stats->NumFrames = NumFrames;
+    Stats->NumSteps = NumSteps;
+    Stats->DroppedTime = DroppedTime;
+
+    if(NumFrames == 0)
+        return;
+
+    Stats->MinFrameTime = MinFrameTime;
+    Stats->MaxFrameTime = MaxMeasuredFrameTime;
+    Stats->MeanFrameTime = (Nanoseconds)FrameTimeMean;
+
+    if(NumFrames > 1) {
+        Stats->FrameTimeDeviation = (Nanoseconds)sqrt(FrameTimeSquares
+                                                    / (NumFrames - 1));
+        Stats->MeanJitter = (Nanoseconds)(JitterSum / (NumFrames - 1));
+    }
+}
+
+
+void FixedTimestep::ResetJitterStats()
+{
+    NumFrames = 0;
+    MinFrameTime = 0;
+    MaxMeasuredFrameTime = 0;
+    FrameTimeMean = 0;
+    FrameTimeSquares = 0;
+    JitterSum = 0;
+    NumSteps = 0;
+    DroppedTime = 0;
+}
+
+} /* bakge */
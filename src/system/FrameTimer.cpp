@@ -0,0 +1,276 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+static const char* FrameStageNames[NUM_FRAME_STAGES] = {
+    "frame",
+    "events",
+    "network",
+    "update",
+    "prerender",
+    "render",
+    "postrender",
+    "pacing"
+};
+
+
+const char* GetFrameStageName(int Stage)
+{
+    if(Stage < 0 || Stage >= NUM_FRAME_STAGES)
+        return "unknown";
+
+    return FrameStageNames[Stage];
+}
+
+
+int GetFrameStage(const char* Name)
+{
+    int Stage;
+
+    for(Stage = 0; Stage < NUM_FRAME_STAGES; ++Stage) {
+        if(strcmp(Name, FrameStageNames[Stage]) == 0)
+            break;
+    }
+
+    return Stage;
+}
+
+
+static int CompareTimes(const void* A, const void* B)
+{
+    Nanoseconds TimeA = *(const Nanoseconds*)A;
+    Nanoseconds TimeB = *(const Nanoseconds*)B;
+
+    return (TimeA > TimeB) - (TimeA < TimeB);
+}
+
+
+FrameTimer::FrameTimer()
+{
+    TargetPeriod = 0;
+    HitchFactor = BGE_DEFAULT_HITCH_FACTOR;
+
+    Reset();
+}
+
+
+FrameTimer::~FrameTimer()
+{
+}
+
+
+FrameTimer* FrameTimer::Create()
+{
+    FrameTimer* T;
+
+    T = new FrameTimer;
+    if(T == NULL) {
+        printf("Unable to allocate memory for frame timer\n");
+        return NULL;
+    }
+
+    return T;
+}
+
+
+void FrameTimer::BeginFrame()
+{
+    Nanoseconds Now;
+    Nanoseconds FrameTime;
+
+    Now = GetRunningNanoseconds();
+
+    if(FrameStart >= 0) {
+        FrameTime = Now - FrameStart;
+        StageTime[FRAME_STAGE_FRAME] = FrameTime;
+
+        /* Compare against the window before this frame joins it */
+        if(NumSamples >= BGE_HITCH_MIN_FRAMES && FrameTime
+                            > HitchFactor * WindowFrameTime / NumSamples) {
+            ++NumHitches;
+            LastHitchFrame = NumFrames;
+            LastHitchTime = FrameTime;
+        }
+
+        if(NumSamples == BGE_FRAME_HISTORY)
+            WindowFrameTime -= Samples[FRAME_STAGE_FRAME][NextSample];
+        else
+            ++NumSamples;
+
+        WindowFrameTime += FrameTime;
+
+        for(int i = 0; i < NUM_FRAME_STAGES; ++i)
+            Samples[i][NextSample] = StageTime[i];
+
+        NextSample = (NextSample + 1) % BGE_FRAME_HISTORY;
+        ++NumFrames;
+    }
+
+    memset((void*)StageTime, 0, sizeof(StageTime));
+    FrameStart = Now;
+}
+
+
+void FrameTimer::Pace()
+{
+    Nanoseconds Now;
+
+    if(TargetPeriod == 0)
+        return;
+
+    BeginStage(FRAME_STAGE_PACING);
+
+    Now = StageStart[FRAME_STAGE_PACING];
+
+    if(NextDeadline < 0)
+        NextDeadline = (FrameStart >= 0 ? FrameStart : Now) + TargetPeriod;
+
+    if(Now < NextDeadline) {
+        PreciseDelayUntil(NextDeadline);
+        NextDeadline += TargetPeriod;
+    } else {
+        /* Overran; start counting again rather than rushing frames */
+        NextDeadline = Now + TargetPeriod;
+    }
+
+    EndStage(FRAME_STAGE_PACING);
+}
+
+
+Result FrameTimer::SetTargetFrameRate(double FramesPerSecond)
+{
+    if(FramesPerSecond < 0) {
+        printf("Target frame rate can't be negative\n");
+        return BGE_FAILURE;
+    }
+
+    if(FramesPerSecond == 0)
+        TargetPeriod = 0;
+    else
+        TargetPeriod = (Nanoseconds)(1000000000 / FramesPerSecond);
+
+    NextDeadline = -1;
+
+    return BGE_SUCCESS;
+}
+
+
+double FrameTimer::GetTargetFrameRate() const
+{
+    if(TargetPeriod == 0)
+        return 0;
+
+    return 1000000000.0 / TargetPeriod;
+}
+
+
+Result FrameTimer::SetHitchFactor(double Factor)
+{
+    if(Factor <= 1) {
+        printf("Hitch factor must be greater than one\n");
+        return BGE_FAILURE;
+    }
+
+    HitchFactor = Factor;
+
+    return BGE_SUCCESS;
+}
+
+
+Result FrameTimer::GetStageStats(int Stage, FrameStageStats* Stats) const
+{
+    Nanoseconds Sorted[BGE_FRAME_HISTORY];
+    Nanoseconds Total;
+    int N;
+
+    memset((void*)Stats, 0, sizeof(FrameStageStats));
+
+    if(Stage < 0 || Stage >= NUM_FRAME_STAGES)
+        return BGE_FAILURE;
+
+    N = NumSamples;
+    Stats->NumSamples = N;
+    if(N == 0)
+        return BGE_SUCCESS;
+
+    memcpy(Sorted, Samples[Stage], N * sizeof(Nanoseconds));
+    qsort(Sorted, N, sizeof(Nanoseconds), CompareTimes);
+
+    Total = 0;
+    for(int i = 0; i < N; ++i)
+        Total += Sorted[i];
+
+    /* Nearest-rank percentiles */
+    Stats->Mean = Total / N;
+    Stats->P50 = Sorted[(N * 50 + 99) / 100 - 1];
+    Stats->P95 = Sorted[(N * 95 + 99) / 100 - 1];
+    Stats->P99 = Sorted[(N * 99 + 99) / 100 - 1];
+    Stats->Max = Sorted[N - 1];
+
+    return BGE_SUCCESS;
+}
+
+
+void FrameTimer::Report() const
+{
+    FrameStageStats Stats;
+
+    printf("%-10s %9s %9s %9s %9s %9s (ms over %d frames)\n", "Stage",
+                        "Mean", "P50", "P95", "P99", "Max", NumSamples);
+
+    for(int i = 0; i < NUM_FRAME_STAGES; ++i) {
+        GetStageStats(i, &Stats);
+        printf("%-10s %9.3f %9.3f %9.3f %9.3f %9.3f\n", GetFrameStageName(i),
+                    Stats.Mean / 1e6, Stats.P50 / 1e6, Stats.P95 / 1e6,
+                    Stats.P99 / 1e6, Stats.Max / 1e6);
+    }
+
+    printf("%lld hitches in %lld frames\n", NumHitches, NumFrames);
+}
+
+
+void FrameTimer::Reset()
+{
+    memset((void*)Samples, 0, sizeof(Samples));
+    NumSamples = 0;
+    NextSample = 0;
+    WindowFrameTime = 0;
+
+    FrameStart = -1;
+    memset((void*)StageStart, 0, sizeof(StageStart));
+    memset((void*)StageTime, 0, sizeof(StageTime));
+
+    NumFrames = 0;
+    NumHitches = 0;
+    LastHitchFrame = -1;
+    LastHitchTime = 0;
+
+    NextDeadline = -1;
+}
+
+} /* bakge */
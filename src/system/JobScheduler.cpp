@@ -0,0 +1,692 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+#include <thread>
+
+/* Jobs each worker can have queued, and allocate before reusing the first */
+#define JOBSCHEDULER_QUEUE_SIZE 4096
+#define JOBSCHEDULER_QUEUE_MASK (JOBSCHEDULER_QUEUE_SIZE - 1)
+
+/* Times an idle worker looks for jobs before going to sleep */
+#define JOBSCHEDULER_SPIN_COUNT 64
+
+namespace bakge
+{
+
+struct ScheduledJob
+{
+    JobCallback Entry;
+    void* Data;
+    JobCounter* Counter;
+
+    /* Links jobs waiting on a counter, or queued by other threads */
+    ScheduledJob* Next;
+
+    /* ParallelFor ranges */
+    JobScheduler* Owner;
+    RangeCallback Body;
+    void* BodyData;
+    int Begin;
+    int End;
+    int Grain;
+
+    /* Jobs from a worker's ring are reused; others were made with new */
+    bool FromRing;
+    std::atomic<bool> InUse;
+};
+
+
+/* *
+ * Work-stealing deque after Chase and Lev, "Dynamic Circular Work-Stealing
+ * Deque", with the memory orderings of Le et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models". The owning worker pushes and pops
+ * at the bottom; other threads steal from the top.
+ * */
+struct JobWorker
+{
+    std::atomic<long long> Top;
+    char TopPadding[BGE_CACHE_LINE];
+    std::atomic<long long> Bottom;
+    char BottomPadding[BGE_CACHE_LINE];
+
+    std::atomic<ScheduledJob*> Slots[JOBSCHEDULER_QUEUE_SIZE];
+
+    /* Ring of jobs this worker hands out */
+    ScheduledJob Jobs[JOBSCHEDULER_QUEUE_SIZE];
+    unsigned int NextJob;
+
+    JobScheduler* Owner;
+    Thread* Handle;
+    int Index;
+
+    /* Where to start looking for jobs to steal */
+    unsigned int NextVictim;
+};
+
+
+struct JobSignal
+{
+    Mutex* Lock;
+    ConditionVariable* Wake;
+
+    /* Jobs queued by threads that aren't workers, oldest first */
+    ScheduledJob* Head;
+    ScheduledJob* Tail;
+};
+
+
+static thread_local JobWorker* CurrentWorker = NULL;
+
+
+static bool PushJob(JobWorker* W, ScheduledJob* Job)
+{
+    long long B = W->Bottom.load(std::memory_order_relaxed);
+    long long T = W->Top.load(std::memory_order_acquire);
+
+    if(B - T >= JOBSCHEDULER_QUEUE_SIZE)
+        return false;
+
+    W->Slots[B & JOBSCHEDULER_QUEUE_MASK].store(Job,
+                                        std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    W->Bottom.store(B + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+
+static ScheduledJob* PopJob(JobWorker* W)
+{
+    long long B = W->Bottom.load(std::memory_order_relaxed) - 1;
+    long long T;
+    ScheduledJob* Job;
+
+    W->Bottom.store(B, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    T = W->Top.load(std::memory_order_relaxed);
+
+    if(T > B) {
+        /* Empty */
+        W->Bottom.store(B + 1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    Job = W->Slots[B & JOBSCHEDULER_QUEUE_MASK].load(
+                                        std::memory_order_relaxed);
+
+    /* The last job could be stolen at the same time; whoever moves Top wins */
+    if(T == B) {
+        if(!W->Top.compare_exchange_strong(T, T + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+            Job = NULL;
+
+        W->Bottom.store(B + 1, std::memory_order_relaxed);
+    }
+
+    return Job;
+}
+
+
+static ScheduledJob* StealJob(JobWorker* W)
+{
+    long long T = W->Top.load(std::memory_order_acquire);
+    long long B;
+    ScheduledJob* Job;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    B = W->Bottom.load(std::memory_order_acquire);
+
+    if(T >= B)
+        return NULL;
+
+    Job = W->Slots[T & JOBSCHEDULER_QUEUE_MASK].load(
+                                        std::memory_order_relaxed);
+
+    /* Lost to the owner or another thief */
+    if(!W->Top.compare_exchange_strong(T, T + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed))
+        return NULL;
+
+    return Job;
+}
+
+
+JobCounter::JobCounter()
+{
+    Count.store(0);
+    WaitingLock.clear();
+    Waiting = NULL;
+}
+
+
+JobCounter::~JobCounter()
+{
+#ifdef _DEBUG
+    if(Count.load() != 0)
+        printf("Job counter destroyed with %d jobs left\n", Count.load());
+#endif /* _DEBUG */
+}
+
+
+int JobCounter::GetCount() const
+{
+    return Count.load(std::memory_order_acquire);
+}
+
+
+bool JobCounter::IsDone() const
+{
+    return Count.load(std::memory_order_acquire) == 0;
+}
+
+
+JobScheduler::JobScheduler()
+{
+    Workers = NULL;
+    NumWorkers = 0;
+    Signal = NULL;
+    Stopping.store(false);
+    NumSleeping.store(0);
+    WorkEpoch.store(0);
+    NumInjected.store(0);
+}
+
+
+JobScheduler::~JobScheduler()
+{
+    ScheduledJob* Job;
+
+    Stopping.store(true);
+
+    if(Signal != NULL && Signal->Lock != NULL && Signal->Wake != NULL) {
+        Signal->Lock->Lock();
+        Signal->Lock->Unlock();
+        Signal->Wake->Broadcast();
+    }
+
+    /* Deleting a thread waits for it to exit */
+    for(int i = 0; i < NumWorkers; ++i) {
+        if(Workers[i].Handle != NULL)
+            delete Workers[i].Handle;
+    }
+
+    if(Signal != NULL) {
+        while(Signal->Head != NULL) {
+            Job = Signal->Head;
+            Signal->Head = Job->Next;
+            FreeJob(Job);
+        }
+
+        if(Signal->Lock != NULL)
+            delete Signal->Lock;
+
+        if(Signal->Wake != NULL)
+            delete Signal->Wake;
+
+        delete Signal;
+    }
+
+    delete[] Workers;
+}
+
+
+JobScheduler* JobScheduler::Create()
+{
+    return Create(GetNumProcessors() - 1);
+}
+
+
+JobScheduler* JobScheduler::Create(int NumWorkers)
+{
+    JobScheduler* S;
+
+    if(NumWorkers < 0)
+        NumWorkers = 0;
+
+    S = new JobScheduler;
+    S->Signal = new JobSignal;
+    S->Signal->Head = NULL;
+    S->Signal->Tail = NULL;
+    S->Signal->Lock = Mutex::Create();
+    S->Signal->Wake = ConditionVariable::Create();
+    if(S->Signal->Lock == NULL || S->Signal->Wake == NULL) {
+        printf("Error creating job scheduler\n");
+        delete S;
+        return NULL;
+    }
+
+    if(NumWorkers > 0)
+        S->Workers = new JobWorker[NumWorkers];
+
+    for(int i = 0; i < NumWorkers; ++i) {
+        JobWorker& W = S->Workers[i];
+
+        W.Top.store(0);
+        W.Bottom.store(0);
+        W.NextJob = 0;
+        W.Owner = S;
+        W.Handle = NULL;
+        W.Index = i;
+        W.NextVictim = i + 1;
+
+        for(int j = 0; j < JOBSCHEDULER_QUEUE_SIZE; ++j)
+            W.Jobs[j].InUse.store(false);
+    }
+
+    /* All workers must be set up before any can try stealing */
+    S->NumWorkers = NumWorkers;
+
+    for(int i = 0; i < NumWorkers; ++i) {
+        S->Workers[i].Handle = Thread::Create(WorkerEntry, &S->Workers[i]);
+        if(S->Workers[i].Handle == NULL) {
+            printf("Error creating job scheduler worker thread\n");
+            delete S;
+            return NULL;
+        }
+    }
+
+    return S;
+}
+
+
+int JobScheduler::WorkerEntry(void* Data)
+{
+    JobWorker* Self = (JobWorker*)Data;
+    JobScheduler* S = Self->Owner;
+    ScheduledJob* Job;
+    int Idle = 0;
+
+    CurrentWorker = Self;
+
+    while(!S->Stopping.load(std::memory_order_acquire)) {
+        /* Read before looking, so jobs queued meanwhile prevent sleeping */
+        unsigned int Epoch = S->WorkEpoch.load();
+
+        Job = S->FindJob(Self);
+        if(Job != NULL) {
+            S->Execute(Job);
+            Idle = 0;
+            continue;
+        }
+
+        if(++Idle < JOBSCHEDULER_SPIN_COUNT) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        S->Sleep(Epoch);
+        Idle = 0;
+    }
+
+    CurrentWorker = NULL;
+
+    return 0;
+}
+
+
+JobWorker* JobScheduler::GetCurrentWorker() const
+{
+    if(CurrentWorker != NULL && CurrentWorker->Owner == this)
+        return CurrentWorker;
+
+    return NULL;
+}
+
+
+ScheduledJob* JobScheduler::AllocateJob()
+{
+    JobWorker* Self = GetCurrentWorker();
+    ScheduledJob* Job;
+
+    if(Self != NULL) {
+        Job = &Self->Jobs[Self->NextJob++ & JOBSCHEDULER_QUEUE_MASK];
+
+        /* Jobs last a while when held back, so their slot may be taken */
+        if(!Job->InUse.load(std::memory_order_acquire)) {
+            Job->InUse.store(true, std::memory_order_relaxed);
+            Job->FromRing = true;
+            return Job;
+        }
+    }
+
+    Job = new ScheduledJob;
+    Job->FromRing = false;
+
+    return Job;
+}
+
+
+void JobScheduler::FreeJob(ScheduledJob* Job)
+{
+    if(Job->FromRing) {
+        Job->InUse.store(false, std::memory_order_release);
+    } else {
+        delete Job;
+    }
+}
+
+
+void JobScheduler::Queue(ScheduledJob* Job)
+{
+    JobWorker* Self = GetCurrentWorker();
+
+    if(Self != NULL) {
+        /* With a full queue, running the job now is as good as any */
+        if(!PushJob(Self, Job)) {
+            Execute(Job);
+            return;
+        }
+    } else {
+        Job->Next = NULL;
+
+        Signal->Lock->Lock();
+        if(Signal->Tail != NULL) {
+            Signal->Tail->Next = Job;
+        } else {
+            Signal->Head = Job;
+        }
+        Signal->Tail = Job;
+        NumInjected.fetch_add(1);
+        Signal->Lock->Unlock();
+    }
+
+    WakeWorker();
+}
+
+
+void JobScheduler::WakeWorker()
+{
+    WorkEpoch.fetch_add(1);
+
+    /* *
+     * Sleepers check the epoch with the lock held, so once we've held it
+     * each has either seen the new epoch or is waiting to be woken
+     * */
+    if(NumSleeping.load() > 0) {
+        Signal->Lock->Lock();
+        Signal->Lock->Unlock();
+        Signal->Wake->Signal();
+    }
+}
+
+
+void JobScheduler::Sleep(unsigned int Epoch)
+{
+    Signal->Lock->Lock();
+
+    NumSleeping.fetch_add(1);
+
+    while(WorkEpoch.load() == Epoch && !Stopping.load())
+        Signal->Wake->Wait(Signal->Lock);
+
+    NumSleeping.fetch_sub(1);
+
+    Signal->Lock->Unlock();
+}
+
+
+ScheduledJob* JobScheduler::FindJob(JobWorker* Self)
+{
+    ScheduledJob* Job;
+    unsigned int Start;
+
+    if(Self != NULL) {
+        Job = PopJob(Self);
+        if(Job != NULL)
+            return Job;
+    }
+
+    if(NumInjected.load(std::memory_order_relaxed) > 0) {
+        Signal->Lock->Lock();
+        Job = Signal->Head;
+        if(Job != NULL) {
+            Signal->Head = Job->Next;
+            if(Signal->Head == NULL)
+                Signal->Tail = NULL;
+            NumInjected.fetch_sub(1);
+        }
+        Signal->Lock->Unlock();
+
+        if(Job != NULL)
+            return Job;
+    }
+
+    if(NumWorkers == 0)
+        return NULL;
+
+    /* Other threads all start from the first worker */
+    Start = Self != NULL ? Self->NextVictim++ : 0;
+
+    for(int i = 0; i < NumWorkers; ++i) {
+        JobWorker* Victim = &Workers[(Start + i) % NumWorkers];
+
+        if(Victim == Self)
+            continue;
+
+        Job = StealJob(Victim);
+        if(Job != NULL)
+            return Job;
+    }
+
+    return NULL;
+}
+
+
+void JobScheduler::Execute(ScheduledJob* Job)
+{
+    JobCounter* Counter = Job->Counter;
+
+    Job->Entry(Job->Data);
+    FreeJob(Job);
+    Finish(Counter);
+}
+
+
+void JobScheduler::Finish(JobCounter* Counter)
+{
+    ScheduledJob* Ready;
+
+    if(Counter == NULL)
+        return;
+
+    /* *
+     * Decrement with the lock held so Wait, which takes the lock before
+     * returning, can't let the counter go while we're still using it
+     * */
+    while(Counter->WaitingLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    Ready = NULL;
+
+    /* Last one out releases the jobs held back by the counter */
+    if(Counter->Count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        Ready = Counter->Waiting;
+        Counter->Waiting = NULL;
+    }
+
+    Counter->WaitingLock.clear(std::memory_order_release);
+
+    while(Ready != NULL) {
+        ScheduledJob* Next = Ready->Next;
+
+        Queue(Ready);
+        Ready = Next;
+    }
+}
+
+
+Result JobScheduler::Run(JobCallback Entry, void* Data, JobCounter* Counter)
+{
+    ScheduledJob* Job = AllocateJob();
+
+    Job->Entry = Entry;
+    Job->Data = Data;
+    Job->Counter = Counter;
+
+    if(Counter != NULL)
+        Counter->Count.fetch_add(1, std::memory_order_relaxed);
+
+    Queue(Job);
+
+    return BGE_SUCCESS;
+}
+
+
+Result JobScheduler::RunAfter(JobCounter* Dependency, JobCallback Entry,
+                                        void* Data, JobCounter* Counter)
+{
+    ScheduledJob* Job;
+
+    if(Dependency == NULL)
+        return Run(Entry, Data, Counter);
+
+    Job = AllocateJob();
+    Job->Entry = Entry;
+    Job->Data = Data;
+    Job->Counter = Counter;
+
+    if(Counter != NULL)
+        Counter->Count.fetch_add(1, std::memory_order_relaxed);
+
+    while(Dependency->WaitingLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    if(Dependency->Count.load(std::memory_order_acquire) > 0) {
+        Job->Next = Dependency->Waiting;
+        Dependency->Waiting = Job;
+        Dependency->WaitingLock.clear(std::memory_order_release);
+        return BGE_SUCCESS;
+    }
+
+    Dependency->WaitingLock.clear(std::memory_order_release);
+    Queue(Job);
+
+    return BGE_SUCCESS;
+}
+
+
+void JobScheduler::Wait(JobCounter* Counter)
+{
+    JobWorker* Self = GetCurrentWorker();
+    ScheduledJob* Job;
+
+    while(Counter->Count.load(std::memory_order_acquire) > 0) {
+        Job = FindJob(Self);
+        if(Job != NULL) {
+            Execute(Job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    /* The last job to finish may still hold the lock */
+    while(Counter->WaitingLock.test_and_set(std::memory_order_acquire))
+        ;
+    Counter->WaitingLock.clear(std::memory_order_release);
+}
+
+
+void JobScheduler::RunRange(void* Data)
+{
+    ScheduledJob* Range = (ScheduledJob*)Data;
+
+    Range->Owner->SplitRange(Range);
+}
+
+
+void JobScheduler::SplitRange(ScheduledJob* Range)
+{
+    int Begin = Range->Begin;
+    int End = Range->End;
+
+    /* *
+     * Queue the upper half and keep going with the lower, so idle threads
+     * steal the biggest pieces left
+     * */
+    while(End - Begin > Range->Grain) {
+        int Mid = Begin + (End - Begin) / 2;
+        ScheduledJob* Half = AllocateJob();
+
+        Half->Entry = RunRange;
+        Half->Data = Half;
+        Half->Counter = Range->Counter;
+        Half->Owner = this;
+        Half->Body = Range->Body;
+        Half->BodyData = Range->BodyData;
+        Half->Begin = Mid;
+        Half->End = End;
+        Half->Grain = Range->Grain;
+
+        Range->Counter->Count.fetch_add(1, std::memory_order_relaxed);
+        Queue(Half);
+
+        End = Mid;
+    }
+
+    Range->Body(Begin, End, Range->BodyData);
+}
+
+
+void JobScheduler::ParallelFor(int Begin, int End, int Grain,
+                                RangeCallback Body, void* Data)
+{
+    ScheduledJob Range;
+    JobCounter Done;
+
+    if(End <= Begin)
+        return;
+
+    if(Grain <= 0) {
+        Grain = (End - Begin) / ((NumWorkers + 1) * 4);
+        if(Grain < 1)
+            Grain = 1;
+    }
+
+    Range.Counter = &Done;
+    Range.Body = Body;
+    Range.BodyData = Data;
+    Range.Begin = Begin;
+    Range.End = End;
+    Range.Grain = Grain;
+
+    SplitRange(&Range);
+    Wait(&Done);
+}
+
+
+int JobScheduler::GetNumWorkers() const
+{
+    return NumWorkers;
+}
+
+
+int JobScheduler::GetWorkerIndex() const
+{
+    JobWorker* Self = GetCurrentWorker();
+
+    return Self != NULL ? Self->Index : -1;
+}
+
+} /* bakge */
@@ -0,0 +1,170 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <bakge/Bakge.h>
+
+/* Samples after which the slice estimate becomes a moving average */
+#define BGE_DELAY_ESTIMATOR_WINDOW 64
+
+namespace bakge
+{
+
+/* *
+ * How long a slice takes on this thread. Each thread learns its own,
+ * as threads can be scheduled with different timer slack.
+ * */
+struct SliceEstimator
+{
+    long long Count;
+    double Mean;
+    double Variance;
+};
+
+static thread_local SliceEstimator Estimator = { 0, 0, 0 };
+
+static std::atomic<long long> NumDelays(0);
+static std::atomic<long long> TotalOvershoot(0);
+static std::atomic<long long> MaxOvershoot(0);
+static std::atomic<long long> TotalSpin(0);
+static std::atomic<long long> NumSlices(0);
+static std::atomic<long long> TotalSliceOvershoot(0);
+static std::atomic<long long> MaxSliceOvershoot(0);
+
+
+static void StoreMax(std::atomic<long long>& Max, long long Value)
+{
+    long long Current = Max.load(std::memory_order_relaxed);
+
+    while(Value > Current && !Max.compare_exchange_weak(Current, Value,
+                                                std::memory_order_relaxed))
+        ;
+}
+
+
+static Nanoseconds EstimateSlice()
+{
+    if(Estimator.Count < 2)
+        return BGE_DELAY_INITIAL_ESTIMATE;
+
+    /* Leave a standard deviation of margin for slow wakeups */
+    return (Nanoseconds)(Estimator.Mean + sqrt(Estimator.Variance));
+}
+
+
+static void MeasureSlice(Nanoseconds Elapsed)
+{
+    double Rate;
+    double Difference;
+
+    if(Estimator.Count < BGE_DELAY_ESTIMATOR_WINDOW)
+        ++Estimator.Count;
+
+    /* Running mean and variance that keep adapting once the window fills */
+    Rate = 1.0 / Estimator.Count;
+    Difference = Elapsed - Estimator.Mean;
+    Estimator.Mean += Rate * Difference;
+    Estimator.Variance = (1 - Rate) * (Estimator.Variance
+                            + Rate * Difference * Difference);
+
+    NumSlices.fetch_add(1, std::memory_order_relaxed);
+    TotalSliceOvershoot.fetch_add(Elapsed - BGE_DELAY_SLICE * 1000,
+                                            std::memory_order_relaxed);
+    StoreMax(MaxSliceOvershoot, Elapsed - BGE_DELAY_SLICE * 1000);
+}
+
+
+Result PreciseDelay(Nanoseconds Time)
+{
+    return PreciseDelayUntil(GetRunningNanoseconds() + Time);
+}
+
+
+Result PreciseDelayUntil(Nanoseconds Deadline)
+{
+    Nanoseconds Now;
+    Nanoseconds Before;
+    Nanoseconds SpinStart;
+
+    Now = GetRunningNanoseconds();
+
+    /* Sleep while even a slow slice would end before the deadline */
+    while(Deadline - Now > EstimateSlice()) {
+        Before = Now;
+        if(Delay(BGE_DELAY_SLICE) != BGE_SUCCESS)
+            break;
+
+        Now = GetRunningNanoseconds();
+        MeasureSlice(Now - Before);
+    }
+
+    SpinStart = Now;
+    while(Now < Deadline) {
+        CpuPause();
+        Now = GetRunningNanoseconds();
+    }
+
+    NumDelays.fetch_add(1, std::memory_order_relaxed);
+    TotalOvershoot.fetch_add(Now - Deadline, std::memory_order_relaxed);
+    StoreMax(MaxOvershoot, Now - Deadline);
+    TotalSpin.fetch_add(Now - SpinStart, std::memory_order_relaxed);
+
+    return BGE_SUCCESS;
+}
+
+
+void GetDelayStats(DelayStats* Stats)
+{
+    memset((void*)Stats, 0, sizeof(DelayStats));
+
+    Stats->NumDelays = NumDelays.load(std::memory_order_relaxed);
+    if(Stats->NumDelays > 0) {
+        Stats->MeanOvershoot = TotalOvershoot.load(std::memory_order_relaxed)
+                                                        / Stats->NumDelays;
+        Stats->MaxOvershoot = MaxOvershoot.load(std::memory_order_relaxed);
+    }
+
+    Stats->SpinTime = TotalSpin.load(std::memory_order_relaxed);
+
+    Stats->NumSlices = NumSlices.load(std::memory_order_relaxed);
+    if(Stats->NumSlices > 0) {
+        Stats->MeanSliceOvershoot = TotalSliceOvershoot.load(
+                        std::memory_order_relaxed) / Stats->NumSlices;
+        Stats->MaxSliceOvershoot = MaxSliceOvershoot.load(
+                                            std::memory_order_relaxed);
+    }
+}
+
+
+void ResetDelayStats()
+{
+    NumDelays.store(0, std::memory_order_relaxed);
+    TotalOvershoot.store(0, std::memory_order_relaxed);
+    MaxOvershoot.store(0, std::memory_order_relaxed);
+    TotalSpin.store(0, std::memory_order_relaxed);
+    NumSlices.store(0, std::memory_order_relaxed);
+    TotalSliceOvershoot.store(0, std::memory_order_relaxed);
+    MaxSliceOvershoot.store(0, std::memory_order_relaxed);
+}
+
+} /* bakge */
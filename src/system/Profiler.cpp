@@ -0,0 +1,451 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <chrono>
+#include <bakge/Bakge.h>
+
+namespace bakge
+{
+
+std::atomic<bool> ProfilerRunning(false);
+
+struct ProfileEvent
+{
+    const char* Name;
+    long long Start;
+    long long End;
+};
+
+
+/* Written only by its thread; read by others once profiling stops */
+struct ProfileBuffer
+{
+    ProfileEvent* Events;
+    std::atomic<int> Count;
+    std::atomic<int> NumDropped;
+
+    /* Cleared when the owning thread exits, so the buffer can be reused */
+    std::atomic<bool> Owned;
+
+    int ThreadIndex;
+    char ThreadName[32];
+
+    ProfileBuffer* Next;
+};
+
+
+/* Plain pointer, so recording needs no check for construction */
+static thread_local ProfileBuffer* ThreadBuffer = NULL;
+
+/* Every buffer made, guarded by BuffersLock */
+static ProfileBuffer* Buffers = NULL;
+static int NumBuffers = 0;
+static std::atomic_flag BuffersLock = ATOMIC_FLAG_INIT;
+
+/* Both clocks when profiling started and stopped, to convert ticks */
+static long long StartTicks = 0;
+static long long StartNanoseconds = 0;
+static long long StopTicks = 0;
+static long long StopNanoseconds = 0;
+
+
+static long long SteadyNanoseconds()
+{
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+#if !defined(__i386__) && !defined(__x86_64__) \
+                        && !(defined(_MSC_VER) && (defined(_M_IX86) \
+                                                || defined(_M_X64)))
+long long ReadProfileClock()
+{
+    return SteadyNanoseconds();
+}
+#endif /* !__i386__ #endif#endif !__x86_64__ */
+
+
+/* Gives the thread's buffer up for reuse when the thread exits */
+struct ProfileBufferOwner
+{
+    bool Armed;
+
+    ProfileBufferOwner()
+    {
+        Armed = false;
+    }
+
+    ~ProfileBufferOwner()
+    {
+        if(ThreadBuffer != NULL)
+            ThreadBuffer->Owned.store(false, std::memory_order_release);
+    }
+};
+
+static thread_local ProfileBufferOwner BufferOwner;
+
+
+static ProfileBuffer* AcquireThreadBuffer()
+{
+    ProfileBuffer* B;
+    bool Expected;
+
+    while(BuffersLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    /* Reuse the buffer of an exited thread if its events were cleared */
+    for(B = Buffers; B != NULL; B = B->Next) {
+        Expected = false;
+        if(B->Count.load(std::memory_order_acquire) == 0
+                && B->Owned.compare_exchange_strong(Expected, true))
+            break;
+    }
+
+    if(B == NULL) {
+        B = new ProfileBuffer;
+        B->Events = (ProfileEvent*)TrackedMalloc(sizeof(ProfileEvent)
+                        * BGE_PROFILE_EVENTS_PER_THREAD, MEMORY_TAG_GENERAL);
+        if(B->Events == NULL) {
+            BuffersLock.clear(std::memory_order_release);
+            printf("Unable to allocate profile event buffer\n");
+            delete B;
+            return NULL;
+        }
+
+        B->Count.store(0);
+        B->NumDropped.store(0);
+        B->Owned.store(true);
+        B->ThreadIndex = NumBuffers++;
+        B->Next = Buffers;
+        Buffers = B;
+    }
+
+    sprintf(B->ThreadName, "Thread %d", B->ThreadIndex);
+
+    BuffersLock.clear(std::memory_order_release);
+
+    /* Constructs the owner, so it is destructed when the thread exits */
+    BufferOwner.Armed = true;
+    ThreadBuffer = B;
+
+    return B;
+}
+
+
+void RecordProfileZone(const char* Name, long long Start, long long End)
+{
+    ProfileBuffer* B = ThreadBuffer;
+    int N;
+
+    if(B == NULL) {
+        B = AcquireThreadBuffer();
+        if(B == NULL)
+            return;
+    }
+
+    N = B->Count.load(std::memory_order_relaxed);
+    if(N == BGE_PROFILE_EVENTS_PER_THREAD) {
+        B->NumDropped.store(B->NumDropped.load(std::memory_order_relaxed)
+                                        + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    B->Events[N].Name = Name;
+    B->Events[N].Start = Start;
+    B->Events[N].End = End;
+    B->Count.store(N + 1, std::memory_order_release);
+}
+
+
+void StartProfiling()
+{
+    ClearProfile();
+
+    StartTicks = ReadProfileClock();
+    StartNanoseconds = SteadyNanoseconds();
+    StopTicks = 0;
+
+    ProfilerRunning.store(true);
+}
+
+
+void StopProfiling()
+{
+    ProfilerRunning.store(false);
+
+    /* Ticks are converted by comparing both clocks over at least 10ms */
+    do {
+        StopTicks = ReadProfileClock();
+        StopNanoseconds = SteadyNanoseconds();
+    } while(StopNanoseconds - StartNanoseconds < 10000000);
+}
+
+
+void ClearProfile()
+{
+    while(BuffersLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    for(ProfileBuffer* B = Buffers; B != NULL; B = B->Next) {
+        B->Count.store(0, std::memory_order_release);
+        B->NumDropped.store(0, std::memory_order_relaxed);
+    }
+
+    BuffersLock.clear(std::memory_order_release);
+}
+
+
+void SetProfileThreadName(const char* Name)
+{
+    ProfileBuffer* B = ThreadBuffer;
+
+    if(B == NULL) {
+        B = AcquireThreadBuffer();
+        if(B == NULL)
+            return;
+    }
+
+    strncpy(B->ThreadName, Name, sizeof(B->ThreadName) - 1);
+    B->ThreadName[sizeof(B->ThreadName) - 1] = '\0';
+}
+
+
+/* Buffers are only ever added at the front, so the rest can be walked */
+static ProfileBuffer* GetBuffers()
+{
+    ProfileBuffer* First;
+
+    while(BuffersLock.test_and_set(std::memory_order_acquire))
+        ;
+
+    First = Buffers;
+
+    BuffersLock.clear(std::memory_order_release);
+
+    return First;
+}
+
+
+static double TicksPerMicrosecond()
+{
+    if(StopTicks == 0 || StopNanoseconds == StartNanoseconds)
+        return 1000.0;
+
+    return (StopTicks - StartTicks) * 1000.0
+                            / (StopNanoseconds - StartNanoseconds);
+}
+
+
+/* Earlier zones first, and parents before the children they start with */
+static int CompareEvents(const void* A, const void* B)
+{
+    const ProfileEvent* EA = (const ProfileEvent*)A;
+    const ProfileEvent* EB = (const ProfileEvent*)B;
+
+    if(EA->Start != EB->Start)
+        return EA->Start < EB->Start ? -1 : 1;
+
+    if(EA->End != EB->End)
+        return EA->End > EB->End ? -1 : 1;
+
+    return 0;
+}
+
+
+struct ZoneSummary
+{
+    const char* Name;
+    int Depth;
+    long long NumCalls;
+    long long Ticks;
+    long long SelfTicks;
+};
+
+
+static int CompareSummaries(const void* A, const void* B)
+{
+    const ZoneSummary* SA = (const ZoneSummary*)A;
+    const ZoneSummary* SB = (const ZoneSummary*)B;
+
+    if(SA->Ticks != SB->Ticks)
+        return SA->Ticks > SB->Ticks ? -1 : 1;
+
+    return 0;
+}
+
+
+static ZoneSummary* FindSummary(ZoneSummary* Summaries, int* NumSummaries,
+                                                        const char* Name)
+{
+    ZoneSummary* S;
+
+    for(int i = 0; i < *NumSummaries; ++i) {
+        if(Summaries[i].Name == Name || !strcmp(Summaries[i].Name, Name))
+            return &Summaries[i];
+    }
+
+    S = &Summaries[(*NumSummaries)++];
+    S->Name = Name;
+    S->Depth = -1;
+    S->NumCalls = 0;
+    S->Ticks = 0;
+    S->SelfTicks = 0;
+
+    return S;
+}
+
+
+void ReportProfile()
+{
+    ProfileEvent* Sorted;
+    ZoneSummary* Summaries;
+    ZoneSummary* S;
+    int* Open;
+    int NumSummaries = 0;
+    int NumOpen, N;
+    long long Ticks;
+    double Scale = 1.0 / (TicksPerMicrosecond() * 1000.0);
+
+    Sorted = new ProfileEvent[BGE_PROFILE_EVENTS_PER_THREAD];
+    Summaries = new ZoneSummary[BGE_PROFILE_EVENTS_PER_THREAD];
+    Open = new int[BGE_PROFILE_EVENTS_PER_THREAD];
+
+    for(ProfileBuffer* B = GetBuffers(); B != NULL; B = B->Next) {
+        N = B->Count.load(std::memory_order_acquire);
+        memcpy((void*)Sorted, (void*)B->Events, sizeof(ProfileEvent) * N);
+        qsort(Sorted, N, sizeof(ProfileEvent), CompareEvents);
+
+        /* Open holds the zones enclosing the current one */
+        NumOpen = 0;
+        for(int i = 0; i < N; ++i) {
+            while(NumOpen > 0 && Sorted[Open[NumOpen - 1]].End
+                                                    <= Sorted[i].Start)
+                --NumOpen;
+
+            Ticks = Sorted[i].End - Sorted[i].Start;
+            if(NumOpen > 0) {
+                FindSummary(Summaries, &NumSummaries,
+                    Sorted[Open[NumOpen - 1]].Name)->SelfTicks -= Ticks;
+            }
+
+            S = FindSummary(Summaries, &NumSummaries, Sorted[i].Name);
+            if(S->Depth < 0 || NumOpen < S->Depth)
+                S->Depth = NumOpen;
+
+            ++S->NumCalls;
+            S->Ticks += Ticks;
+            S->SelfTicks += Ticks;
+
+            Open[NumOpen++] = i;
+        }
+
+        if(B->NumDropped.load() > 0)
+            printf("%s dropped %d zones; its buffer was full\n",
+                                    B->ThreadName, B->NumDropped.load());
+    }
+
+    qsort(Summaries, NumSummaries, sizeof(ZoneSummary), CompareSummaries);
+
+    printf("%-40s %10s %12s %12s\n", "Zone", "Calls", "Total ms",
+                                                            "Self ms");
+    for(int i = 0; i < NumSummaries; ++i) {
+        S = &Summaries[i];
+        printf("%*s%-*s %10lld %12.3f %12.3f\n", S->Depth * 2, "",
+                    40 - S->Depth * 2, S->Name, S->NumCalls,
+                    S->Ticks * Scale, S->SelfTicks * Scale);
+    }
+
+    delete[] Open;
+    delete[] Summaries;
+    delete[] Sorted;
+}
+
+
+/* Names are usually literals, but escape what JSON can't hold as is */
+static void WriteJSONString(FILE* Out, const char* String)
+{
+    fputc('"', Out);
+
+    for(; *String != '\0'; ++String) {
+        if(*String == '"' || *String == '\\')
+            fputc('\\', Out);
+
+        if((unsigned char)*String < 0x20)
+            fprintf(Out, "\\u%04x", *String);
+        else
+            fputc(*String, Out);
+    }
+
+    fputc('"', Out);
+}
+
+
+Result WriteChromeTrace(const char* Path)
+{
+    FILE* Out;
+    ProfileEvent* E;
+    bool First = true;
+    int N;
+    double Scale = 1.0 / TicksPerMicrosecond();
+
+    Out = fopen(Path, "w");
+    if(Out == NULL) {
+        printf("Unable to open %s to write trace\n", Path);
+        return BGE_FAILURE;
+    }
+
+    fprintf(Out, "{\"traceEvents\":[\n");
+
+    for(ProfileBuffer* B = GetBuffers(); B != NULL; B = B->Next) {
+        fprintf(Out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                        "\"tid\":%d,\"args\":{\"name\":", First ? "" : ",\n",
+                                                        B->ThreadIndex);
+        WriteJSONString(Out, B->ThreadName);
+        fprintf(Out, "}}");
+        First = false;
+
+        N = B->Count.load(std::memory_order_acquire);
+        for(int i = 0; i < N; ++i) {
+            E = &B->Events[i];
+            fprintf(Out, ",\n{\"name\":");
+            WriteJSONString(Out, E->Name);
+            fprintf(Out, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+                        "\"dur\":%.3f}", B->ThreadIndex,
+                        (E->Start - StartTicks) * Scale,
+                        (E->End - E->Start) * Scale);
+        }
+    }
+
+    fprintf(Out, "\n]}\n");
+
+    if(fclose(Out) != 0) {
+        printf("Error writing trace to %s\n", Path);
+        return BGE_FAILURE;
+    }
+
+    return BGE_SUCCESS;
+}
+
+} /* bakge */
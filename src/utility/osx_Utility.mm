@@ -29,6 +29,8 @@ namespace bakge
 
 NSAutoreleasePool* NSPool;
 NSDate* StartTime;
+uint64_t StartMachTime;
+mach_timebase_info_data_t Timebase;
 
 Result PlatformInit(int argc, char* argv[])
 {
@@ -36,6 +38,8 @@ Result PlatformInit(int argc, char* argv[])
 
     /* Set start date of app */
     StartTime = [[NSDate date] retain];
+    mach_timebase_info(&Timebase);
+    StartMachTime = mach_absolute_time();
 
     return BGE_SUCCESS;
 }
@@ -53,4 +57,12 @@ void PlatformSystemInfo()
 {
 }
 
+
+int GetNumProcessors()
+{
+    long Count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return Count > 0 ? (int)Count : 1;
+}
+
 } /* bakge */
@@ -73,4 +73,14 @@ void PlatformSystemInfo()
 {
 }
 
+
+int GetNumProcessors()
+{
+    SYSTEM_INFO Info;
+
+    GetSystemInfo(&Info);
+
+    return Info.dwNumberOfProcessors > 0 ? (int)Info.dwNumberOfProcessors : 1;
+}
+
 } /* bakge */
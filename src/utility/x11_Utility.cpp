@@ -47,4 +47,12 @@ void PlatformSystemInfo()
 {
 }
 
+
+int GetNumProcessors()
+{
+    long Count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return Count > 0 ? (int)Count : 1;
+}
+
 } /* bakge */
@@ -67,6 +67,9 @@ class TestEngine : public Engine, public EventHandler
     Result Initialize()
     {
 
+        if(Timestep == NULL || Timer == NULL)
+            return BGE_FAILURE;
+
         EngineWindow = Window::Create(600, 400);
         if(EngineWindow == NULL)
             return BGE_FAILURE;
@@ -107,8 +110,13 @@ class TestEngine : public Engine, public EventHandler
 
         while(1)
         {
+            BGE_PROFILE_ZONE("Engine::Frame");
+            Timer->BeginFrame();
 
-            Window::PollEvents();
+            {
+                FrameStageScope EventsTime(Timer, FRAME_STAGE_EVENTS);
+                Window::PollEvents();
+            }
 
             if(EngineWindow->IsOpen() == false) {
 
@@ -121,21 +129,50 @@ class TestEngine : public Engine, public EventHandler
             }
 
 
-            Update(0);
-            if(UpdateCB != NULL)
-                UpdateCB(0);
+            {
+                BGE_PROFILE_ZONE("Engine::ServiceNetwork");
+                FrameStageScope NetworkTime(Timer, FRAME_STAGE_NETWORK);
+                ServiceNetwork();
+            }
+
+            {
+                BGE_PROFILE_ZONE("Engine::Update");
+                FrameStageScope UpdateTime(Timer, FRAME_STAGE_UPDATE);
+
+                /* Simulation advances in fixed steps of real time */
+                Timestep->BeginFrame();
+                while(Timestep->Step()) {
+                    Update(Timestep->GetStepSize());
+                    if(UpdateCB != NULL)
+                        UpdateCB(Timestep->GetStepSize());
+                }
+            }
+
+            {
+                BGE_PROFILE_ZONE("Engine::PreRenderStage");
+                FrameStageScope PreRenderTime(Timer, FRAME_STAGE_PRE_RENDER);
+                PreRenderStage();
+                if(PreRenderCB != NULL)
+                    PreRenderCB(0);
+            }
 
-            PreRenderStage();
-            if(PreRenderCB != NULL)
-                PreRenderCB(0);
+            {
+                BGE_PROFILE_ZONE("Engine::RenderStage");
+                FrameStageScope RenderTime(Timer, FRAME_STAGE_RENDER);
+                RenderStage();
+                if(RenderCB != NULL)
+                    RenderCB(0);
+            }
 
-            RenderStage();
-            if(RenderCB != NULL)
-                RenderCB(0);
+            {
+                BGE_PROFILE_ZONE("Engine::PostRenderStage");
+                FrameStageScope PostRenderTime(Timer, FRAME_STAGE_POST_RENDER);
+                PostRenderStage();
+                if(PostRenderCB != NULL)
+                    PostRenderCB(0);
+            }
 
-            PostRenderStage();
-            if(PostRenderCB != NULL)
-                PostRenderCB(0);
+            EndFrame();
         }
 
         return ExitCode;
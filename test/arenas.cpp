@@ -0,0 +1,267 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::LinearArena;
+using bakge::StackAllocator;
+using bakge::StackMarker;
+using bakge::DoubleBufferedArena;
+
+#define ARENA_SIZE 4096
+#define NUM_FRAMES 1000
+#define ALLOCATIONS_PER_FRAME 10000
+
+int NumFailures = 0;
+
+/* Keeps results alive so benchmarks aren't optimized away */
+volatile long long Sink;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+bool IsFilledWith(const void* Memory, int Value, size_t NumBytes)
+{
+    const unsigned char* Bytes = (const unsigned char*)Memory;
+
+    for(size_t i = 0; i < NumBytes; ++i) {
+        if(Bytes[i] != (unsigned char)Value)
+            return false;
+    }
+
+    return true;
+}
+
+
+double Milliseconds(bakge::Microseconds Start)
+{
+    return (bakge::GetRunningTime() - Start) / 1000.0;
+}
+
+
+void CheckLinearArena()
+{
+    LinearArena* A = LinearArena::Create(ARENA_SIZE);
+    char* First;
+    char* Second;
+    double* Aligned;
+    char* Big;
+
+    First = (char*)A->Allocate(10, 1);
+    Second = (char*)A->Allocate(10, 1);
+    Check(Second == First + 10, "linear arena allocates contiguously");
+
+    Aligned = A->AllocateArray<double>(4);
+    Check(((size_t)Aligned & 7) == 0, "linear arena aligns arrays");
+    Check(((size_t)A->Allocate(1) & (BGE_ARENA_ALIGN - 1)) == 0,
+                                        "linear arena default alignment");
+    Check(A->GetUsed() > 20, "linear arena counts used bytes");
+
+#ifdef _DEBUG
+    Check(IsFilledWith(Aligned, BGE_POISON_ALLOCATED, sizeof(double) * 4),
+                                        "new allocations are poisoned");
+#endif /* _DEBUG */
+
+    A->Reset();
+    Check(A->GetUsed() == 0, "reset frees everything");
+    Check(A->GetHighWater() > 20, "high water survives reset");
+    Check(A->Allocate(10, 1) == First, "reset reuses memory");
+
+#ifdef _DEBUG
+    Check(IsFilledWith(Second, BGE_POISON_FREED, 10),
+                                        "reset memory is poisoned");
+#endif /* _DEBUG */
+
+    /* Running out of room takes memory from the heap until reset */
+    Big = (char*)A->Allocate(ARENA_SIZE * 2);
+    Check(Big != NULL, "full arena still allocates");
+    Big[ARENA_SIZE * 2 - 1] = 1;
+    Check(A->GetUsed() > ARENA_SIZE * 2, "overflow counts as used");
+    Check(A->GetHighWater() > ARENA_SIZE * 2, "overflow raises high water");
+    A->Reset();
+    Check(A->GetUsed() == 0, "reset frees overflow");
+
+    A->ReportUsage("Linear arena");
+
+    delete A;
+}
+
+
+void CheckStackAllocator()
+{
+    StackAllocator* S = StackAllocator::Create(ARENA_SIZE);
+    StackMarker Outer, Inner;
+#ifdef _DEBUG
+    char* Kept;
+#endif /* _DEBUG */
+    char* Freed;
+    size_t Used;
+
+#ifdef _DEBUG
+    Kept = (char*)S->Allocate(100);
+#else
+    S->Allocate(100);
+#endif /* _DEBUG */
+    Outer = S->GetMarker();
+    Used = S->GetUsed();
+
+    Freed = (char*)S->Allocate(100);
+    Inner = S->GetMarker();
+    S->Allocate(ARENA_SIZE);
+    Check(S->GetUsed() > ARENA_SIZE, "stack overflows to the heap");
+
+    S->FreeToMarker(Inner);
+    Check(S->GetUsed() < ARENA_SIZE, "marker frees overflow after it");
+
+    S->FreeToMarker(Outer);
+    Check(S->GetUsed() == Used, "marker frees back to where it was taken");
+    Check(S->Allocate(100) == Freed, "marker reuses memory");
+
+#ifdef _DEBUG
+    Check(IsFilledWith(Kept, BGE_POISON_ALLOCATED, 100),
+                                "memory below a marker is left alone");
+#endif /* _DEBUG */
+
+    Check(StackAllocator::GetScratch() != NULL, "thread has scratch stack");
+    Check(StackAllocator::GetScratch() == StackAllocator::GetScratch(),
+                                        "scratch stack is kept per thread");
+
+    delete S;
+}
+
+
+void CheckDoubleBufferedArena()
+{
+    DoubleBufferedArena* D = DoubleBufferedArena::Create(ARENA_SIZE);
+    int* Data;
+
+    Data = D->AllocateArray<int>(16);
+    for(int i = 0; i < 16; ++i)
+        Data[i] = i;
+
+    /* Last frame's data lives through this frame */
+    D->Swap();
+    D->Allocate(ARENA_SIZE / 2);
+    Check(D->GetPrevious()->GetUsed() >= sizeof(int) * 16,
+                                    "previous frame keeps its memory");
+
+    bool Intact = true;
+    for(int i = 0; i < 16; ++i)
+        Intact = Intact && Data[i] == i;
+    Check(Intact, "previous frame's data survives a swap");
+
+    D->Swap();
+    Check(D->GetCurrent()->GetUsed() == 0, "second swap frees old frame");
+    Check(D->GetPrevious()->GetUsed() >= ARENA_SIZE / 2,
+                                        "second swap keeps last frame");
+
+    D->ReportUsage("Cross-frame arena");
+
+    delete D;
+}
+
+
+/* Sizes like those of per-frame temporaries, 16 to 256 bytes */
+size_t AllocationSize(int i)
+{
+    return 16 + (size_t)(i * 37 % 241);
+}
+
+
+void Benchmark()
+{
+    LinearArena* A = LinearArena::Create(ALLOCATIONS_PER_FRAME * 256);
+    char** Blocks = new char*[ALLOCATIONS_PER_FRAME];
+    bakge::Microseconds Start;
+    long long Sum = 0;
+
+    Start = bakge::GetRunningTime();
+    for(int f = 0; f < NUM_FRAMES; ++f) {
+        for(int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            Blocks[i] = new char[AllocationSize(i)];
+            Blocks[i][0] = (char)i;
+        }
+
+        for(int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            Sum += Blocks[i][0];
+            delete[] Blocks[i];
+        }
+    }
+    printf("  new/delete    %8.1f ms\n", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int f = 0; f < NUM_FRAMES; ++f) {
+        for(int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            Blocks[i] = (char*)A->Allocate(AllocationSize(i));
+            Blocks[i][0] = (char)i;
+        }
+
+        for(int i = 0; i < ALLOCATIONS_PER_FRAME; ++i)
+            Sum += Blocks[i][0];
+
+        A->Reset();
+    }
+    printf("  linear arena  %8.1f ms\n", Milliseconds(Start));
+
+    Sink = Sum;
+
+    A->ReportUsage("  Benchmark arena");
+
+    delete[] Blocks;
+    delete A;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    CheckLinearArena();
+    CheckStackAllocator();
+    CheckDoubleBufferedArena();
+
+    printf("%d frames of %d allocations\n", NUM_FRAMES,
+                                        ALLOCATIONS_PER_FRAME);
+    Benchmark();
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,172 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Packet;
+
+#define SENDER_PORT 7210
+#define RECEIVER_PORT 7211
+#define DEFAULT_PACKETS 200000
+
+int NumFailures = 0;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+/* *
+ * Moves NumPackets packets over loopback BatchSize at a time. Returns
+ * system calls made per packet, counting each batched call as one.
+ * */
+double RunBatches(bakge::Socket* Sender, bakge::Socket* Receiver,
+                                        int BatchSize, int NumPackets)
+{
+    bakge::Remote Destinations[BGE_SOCKET_BATCH];
+    Packet* Out[BGE_SOCKET_BATCH];
+    Packet* In[BGE_SOCKET_BATCH];
+    bakge::Nanoseconds Start;
+    bakge::Nanoseconds Elapsed;
+    long long NumCalls = 0;
+    int Sequence;
+    int Count;
+    int Got;
+    int Received;
+    int Number;
+    bool InOrder = true;
+    bool Delivered = true;
+
+    for(int i = 0; i < BGE_SOCKET_BATCH; ++i) {
+        Destinations[i].SetAddress(127, 0, 0, 1);
+        Destinations[i].SetPort(RECEIVER_PORT);
+    }
+
+    Start = bakge::GetRunningNanoseconds();
+
+    for(Sequence = 0; Sequence < NumPackets && Delivered;
+                                            Sequence += Count) {
+        Count = NumPackets - Sequence;
+        if(Count > BatchSize)
+            Count = BatchSize;
+
+        for(int i = 0; i < Count; ++i) {
+            Out[i] = Packet::Create();
+            Out[i]->WriteValue(Sequence + i);
+        }
+
+        if(Sender->SendMany(Destinations, Out, Count) != Count)
+            Delivered = false;
+        ++NumCalls;
+
+        for(int i = 0; i < Count; ++i)
+            delete Out[i];
+
+        for(Got = 0; Got < Count && Delivered; Got += Received) {
+            Received = Receiver->ReceiveMany(In, Count - Got);
+            ++NumCalls;
+            if(Received < 1) {
+                Delivered = false;
+                break;
+            }
+
+            for(int i = 0; i < Received; ++i) {
+                if(In[i]->ReadValue(&Number) != BGE_SUCCESS
+                            || Number != Sequence + Got + i
+                            || In[i]->GetSender().GetPort() != SENDER_PORT)
+                    InOrder = false;
+
+                delete In[i];
+            }
+        }
+    }
+
+    Elapsed = bakge::GetRunningNanoseconds() - Start;
+
+    Check(Delivered, "every batch sent and received");
+    Check(InOrder, "packets arrive intact, in order, from the sender");
+
+    printf("%10d %14.0f %16.3f\n", BatchSize, Sequence / (Elapsed / 1e9),
+                                            (double)NumCalls / Sequence);
+
+    return (double)NumCalls / Sequence;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Socket* Sender;
+    bakge::Socket* Receiver;
+    int NumPackets = DEFAULT_PACKETS;
+    double CallsPerPacket;
+
+    if(argc > 1)
+        NumPackets = atoi(argv[1]);
+
+    bakge::Init(argc, argv);
+
+    Sender = bakge::Socket::Create(SENDER_PORT);
+    Receiver = bakge::Socket::Create(RECEIVER_PORT);
+    if(Sender == NULL || Receiver == NULL) {
+        printf("Unable to create loopback sockets\n");
+        bakge::Deinit();
+        return 1;
+    }
+
+    Check(Receiver->ReceiveMany(NULL, 1) == -1, "no packet array refused");
+
+    printf("%10s %14s %16s\n", "Batch", "Packets/s", "Syscalls/packet");
+
+    for(int BatchSize = 1; BatchSize <= BGE_SOCKET_BATCH; BatchSize *= 2) {
+        CallsPerPacket = RunBatches(Sender, Receiver, BatchSize,
+                                                        NumPackets);
+        if(BatchSize == 1)
+            Check(CallsPerPacket == 2, "unbatched, one call each way");
+    }
+
+#ifdef __linux__
+    Check(CallsPerPacket < 0.05, "full batches take one call each way");
+#endif /* __linux__ */
+
+    delete Sender;
+    delete Receiver;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All batching checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Vector4;
+using bakge::Matrix;
+using bakge::Quaternion;
+using bakge::BoundingBox;
+using bakge::BoundingSphere;
+using bakge::Frustum;
+
+#define NUM_OBJECTS 4096
+#define BENCH_ROUNDS 500
+
+int NumFailures = 0;
+
+BoundingBox Boxes[NUM_OBJECTS];
+BoundingSphere Spheres[NUM_OBJECTS];
+bool Batched[NUM_OBJECTS];
+bool Single[NUM_OBJECTS];
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+bool Near(Scalar A, Scalar B)
+{
+    return fabsf(A - B) < 1e-4f;
+}
+
+
+Scalar Random(Scalar Low, Scalar High)
+{
+    return Low + (High - Low) * ((Scalar)rand() / (Scalar)RAND_MAX);
+}
+
+
+/* GL style perspective projection, column-major */
+Matrix Perspective(Scalar FOV, Scalar Aspect, Scalar Near, Scalar Far)
+{
+    Scalar F = 1 / tanf(FOV * 0.5f);
+
+    return Matrix(F / Aspect, 0, 0, 0,
+                  0, F, 0, 0,
+                  0, 0, (Far + Near) / (Near - Far), -1,
+                  0, 0, 2 * Far * Near / (Near - Far), 0);
+}
+
+
+int main(int argc, char* argv[])
+{
+    Scalar Corners[] = {
+        -1, -2, -3,
+        +1, +2, +3,
+        -1, +2, -3,
+        +1, -2, +3
+    };
+    Matrix View, Turn;
+    Frustum ViewFrustum;
+    BoundingBox Box, Turned, Query;
+    BoundingSphere Sphere;
+    bakge::Microseconds Start, SingleTime, BatchTime;
+    size_t NumVisible;
+
+    bakge::Init(argc, argv);
+
+    /* Building bounds */
+    Box = BoundingBox::FromPoints(Corners, 4);
+    Check(Box.GetMin()[0] == -1 && Box.GetMin()[2] == -3
+            && Box.GetMax()[1] == 2, "BoundingBox::FromPoints");
+    Check(Box.GetExtents()[2] == 3 && Box.GetCenter()[0] == 0,
+                                        "BoundingBox extents and center");
+    Check(BoundingBox().IsEmpty() && !Box.IsEmpty(), "Empty boxes");
+    Check(BoundingBox().Expand(bakge::Point(1, 2, 3)).GetMin()[1] == 2,
+                                            "Expanding an empty box");
+
+    Sphere = BoundingSphere::FromPoints(Corners, 4);
+    Check(Near(Sphere.GetRadius(), sqrtf(14)), "BoundingSphere::FromPoints");
+    Check(BoundingSphere().IsEmpty() && !Sphere.IsEmpty(), "Empty spheres");
+
+    /* Rotating 90 degrees about Y swaps the X and Z extents */
+    Turn = Quaternion::FromAxisAndAngle(bakge::Vector(0, 1, 0),
+                                            1.57079633f).ToMatrix();
+    Turned = Box.Transformed(Turn);
+    Check(Near(Turned.GetExtents()[0], 3) && Near(Turned.GetExtents()[2], 1),
+                                        "BoundingBox::Transformed rotation");
+
+    Turn[12] = 10;
+    Turned = Box.Transformed(Turn);
+    Check(Near(Turned.GetCenter()[0], 10), "BoundingBox::Transformed moves");
+    Check(Near(Sphere.Transformed(Turn).GetCenter()[0], 10)
+            && Near(Sphere.Transformed(Turn).GetRadius(), sqrtf(14)),
+                                            "BoundingSphere::Transformed");
+
+    /* Overlap */
+    Check(Box.Intersects(BoundingBox(bakge::Point(1, 2, 3),
+                bakge::Point(5, 5, 5))), "Touching boxes intersect");
+    Check(!Box.Intersects(BoundingBox(bakge::Point(1.1f, 0, 0),
+                bakge::Point(5, 5, 5))), "Separate boxes don't intersect");
+    Check(Sphere.Intersects(Box) && !BoundingSphere(bakge::Point(20, 0, 0),
+                        1).Intersects(Box), "Sphere against box");
+
+    /* Camera at +Z looking down -Z */
+    View.SetLookAt(bakge::Point(0, 0, 10), bakge::Point(0, 0, 0),
+                                            bakge::Vector(0, 1, 0));
+    ViewFrustum.SetMatrix(Perspective(1.0f, 1.0f, 1.0f, 100.0f) * View);
+
+    Check(ViewFrustum.Contains(bakge::Point(0, 0, 0)), "Target is in view");
+    Check(!ViewFrustum.Contains(bakge::Point(0, 0, 20)),
+                                        "Behind the camera is out of view");
+    Check(!ViewFrustum.Contains(bakge::Point(0, 0, -95)),
+                                        "Past the far plane is out of view");
+    Check(ViewFrustum.Intersects(BoundingSphere(bakge::Point(0, 0, 11), 2)),
+                                    "Sphere crossing the near plane");
+    Check(!ViewFrustum.Intersects(BoundingSphere(bakge::Point(50, 0, 0), 2)),
+                                    "Sphere off to the side");
+    Check(Frustum().Intersects(Box), "Default frustum contains everything");
+    Check(!ViewFrustum.Intersects(BoundingBox()), "Empty box is never seen");
+
+    /* Batched tests must match the single object tests exactly */
+    srand(1);
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        Vector4 Center = bakge::Point(Random(-120, 120), Random(-120, 120),
+                                                        Random(-120, 120));
+        Vector4 Size = bakge::Vector(Random(0, 8), Random(0, 8),
+                                                        Random(0, 8));
+
+        Boxes[i] = BoundingBox(Center - Size, Center + Size);
+        Spheres[i] = BoundingSphere(Center, Random(0, 8));
+    }
+
+    /* Include some empty bounds, and a box inverted along one axis */
+    Boxes[7] = BoundingBox();
+    Spheres[7] = BoundingSphere();
+    Boxes[9] = BoundingBox(bakge::Point(1, 0, 0), bakge::Point(-1, 1, 1));
+
+    NumVisible = ViewFrustum.Intersects(Boxes, Batched, NUM_OBJECTS);
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Single[i] = ViewFrustum.Intersects(Boxes[i]);
+    Check(memcmp(Batched, Single, sizeof(Batched)) == 0,
+                                        "Batched frustum-box test");
+    printf("%d of %d boxes in view\n", (int)NumVisible, NUM_OBJECTS);
+
+    NumVisible = ViewFrustum.Intersects(Spheres, Batched, NUM_OBJECTS);
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Single[i] = ViewFrustum.Intersects(Spheres[i]);
+    Check(memcmp(Batched, Single, sizeof(Batched)) == 0,
+                                        "Batched frustum-sphere test");
+    printf("%d of %d spheres in view\n", (int)NumVisible, NUM_OBJECTS);
+
+    /* Default planes can't reject by position; empty bounds still fail */
+    Frustum().Intersects(Boxes, Batched, NUM_OBJECTS);
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Single[i] = Frustum().Intersects(Boxes[i]);
+    Check(memcmp(Batched, Single, sizeof(Batched)) == 0 && !Batched[7]
+                && !Batched[9], "Batched default frustum-box test");
+
+    Frustum().Intersects(Spheres, Batched, NUM_OBJECTS);
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Single[i] = Frustum().Intersects(Spheres[i]);
+    Check(memcmp(Batched, Single, sizeof(Batched)) == 0 && !Batched[7],
+                                "Batched default frustum-sphere test");
+
+    Query = BoundingBox(bakge::Point(-30, -30, -30), bakge::Point(30, 30, 30));
+    NumVisible = Query.Intersects(Boxes, Batched, NUM_OBJECTS);
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Single[i] = Query.Intersects(Boxes[i]);
+    Check(memcmp(Batched, Single, sizeof(Batched)) == 0,
+                                        "Batched box-box test");
+    printf("%d of %d boxes overlap the query box\n", (int)NumVisible,
+                                                        NUM_OBJECTS);
+
+    /* Speed of the batched tests against testing one object at a time */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < BENCH_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_OBJECTS; ++i)
+            Single[i] = ViewFrustum.Intersects(Boxes[i]);
+    }
+    SingleTime = bakge::GetRunningTime() - Start;
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < BENCH_ROUNDS; ++r)
+        ViewFrustum.Intersects(Boxes, Batched, NUM_OBJECTS);
+    BatchTime = bakge::GetRunningTime() - Start;
+
+    printf("Frustum-box: %.2f ns/box one at a time, %.2f ns/box batched\n",
+            SingleTime * 1000.0 / (NUM_OBJECTS * BENCH_ROUNDS),
+            BatchTime * 1000.0 / (NUM_OBJECTS * BENCH_ROUNDS));
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < BENCH_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_OBJECTS; ++i)
+            Single[i] = ViewFrustum.Intersects(Spheres[i]);
+    }
+    SingleTime = bakge::GetRunningTime() - Start;
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < BENCH_ROUNDS; ++r)
+        ViewFrustum.Intersects(Spheres, Batched, NUM_OBJECTS);
+    BatchTime = bakge::GetRunningTime() - Start;
+
+    printf("Frustum-sphere: %.2f ns/sphere one at a time, %.2f ns/sphere"
+            " batched\n", SingleTime * 1000.0 / (NUM_OBJECTS * BENCH_ROUNDS),
+            BatchTime * 1000.0 / (NUM_OBJECTS * BENCH_ROUNDS));
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,458 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Vector4;
+using bakge::BoundingBox;
+using bakge::BoundingSphere;
+using bakge::Broadphase;
+using bakge::BroadphasePair;
+
+#define MAX_OBJECTS 100000
+#define NUM_FRAMES 10
+#define NUM_STRUCTURES 3
+
+/* Largest half size of an object's box */
+#define MAX_HALF_SIZE 1.5f
+
+/* Objects verified against brute force up to this many */
+#define MAX_BRUTE_FORCE 10000
+
+int NumFailures = 0;
+
+BoundingBox Boxes[MAX_OBJECTS];
+Vector4 Velocities[MAX_OBJECTS];
+void* Data[MAX_OBJECTS];
+int Handles[NUM_STRUCTURES][MAX_OBJECTS];
+
+BroadphasePair* Pairs;
+long long* Found;
+long long* Expected;
+int MaxPairs;
+
+
+/* Moves a box with Node::SetPosition; its broadphase follows it */
+class Crate : public bakge::Pawn
+{
+
+public:
+
+    Crate()
+    {
+        SetLocalBounds(BoundingBox(bakge::Point(-1, -1, -1),
+                                    bakge::Point(1, 1, 1)),
+                        BoundingSphere(bakge::Point(0, 0, 0), 1.8f));
+    }
+
+}; /* Crate */
+
+
+Scalar Random(Scalar Low, Scalar High)
+{
+    return Low + (High - Low) * ((Scalar)rand() / (Scalar)RAND_MAX);
+}
+
+
+int ObjectOf(Broadphase* Phase, int Handle)
+{
+    return (int)((BoundingBox*)Phase->GetData(Handle) - Boxes);
+}
+
+
+int CompareKeys(const void* A, const void* B)
+{
+    long long KA = *(const long long*)A;
+    long long KB = *(const long long*)B;
+
+    return KA < KB ? -1 : KA > KB ? 1 : 0;
+}
+
+
+/* Pairs as sorted object index keys */
+int PairKeys(Broadphase* Phase, int Count, int Num, long long* Keys)
+{
+    int NumKeys = 0;
+
+    for(int i = 0; i < Count; ++i) {
+        int A = ObjectOf(Phase, Pairs[i].A);
+        int B = ObjectOf(Phase, Pairs[i].B);
+
+        /* The BVH's boxes are grown, so keep pairs that really overlap */
+        if(!Boxes[A].Intersects(Boxes[B]))
+            continue;
+
+        Keys[NumKeys++] = A < B ? (long long)A * Num + B
+                                : (long long)B * Num + A;
+    }
+
+    qsort(Keys, NumKeys, sizeof(long long), CompareKeys);
+
+    return NumKeys;
+}
+
+
+int BruteForcePairs(int Num, long long* Keys)
+{
+    int NumKeys = 0;
+
+    for(int i = 0; i < Num; ++i) {
+        for(int j = i + 1; j < Num; ++j) {
+            if(Boxes[i].Intersects(Boxes[j]) && NumKeys < MaxPairs)
+                Keys[NumKeys++] = (long long)i * Num + j;
+        }
+    }
+
+    return NumKeys;
+}
+
+
+void CheckPairs(Broadphase* Phase, const char* Name, int Num,
+                                                int NumExpected)
+{
+    int Count = Phase->FindPairs(Pairs, MaxPairs);
+    int NumFound = PairKeys(Phase, Count, Num, Found);
+
+    if(NumFound != NumExpected || memcmp(Found, Expected,
+                                sizeof(long long) * NumFound) != 0) {
+        printf("FAILED: %s found %d pairs, expected %d\n", Name,
+                                            NumFound, NumExpected);
+        ++NumFailures;
+    }
+
+    for(int i = 1; i < NumFound; ++i) {
+        if(Found[i] == Found[i - 1]) {
+            printf("FAILED: %s reported a pair twice\n", Name);
+            ++NumFailures;
+            break;
+        }
+    }
+}
+
+
+void CheckQueries(Broadphase* Phase, const char* Name, int Num,
+                                                Scalar WorldHalf)
+{
+    int* Results = (int*)Found;
+
+    for(int q = 0; q < 20; ++q) {
+        Vector4 Center = bakge::Point(Random(-WorldHalf, WorldHalf),
+                    Random(-WorldHalf, WorldHalf), Random(-WorldHalf,
+                    WorldHalf));
+        Vector4 Half = bakge::Vector(5, 5, 5);
+        BoundingBox Query(Center - Half, Center + Half);
+        int Count = Phase->Query(Query, Results, MaxPairs);
+        int NumExpected = 0, NumFound = 0;
+
+        for(int i = 0; i < Num; ++i)
+            NumExpected += Query.Intersects(Boxes[i]);
+
+        for(int i = 0; i < Count; ++i)
+            NumFound += Query.Intersects(Boxes[ObjectOf(Phase, Results[i])]);
+
+        if(NumFound != NumExpected) {
+            printf("FAILED: %s query found %d objects, expected %d\n",
+                                        Name, NumFound, NumExpected);
+            ++NumFailures;
+            return;
+        }
+    }
+}
+
+
+void Move(int Num, Scalar WorldHalf)
+{
+    for(int i = 0; i < Num; ++i) {
+        Vector4 Min = Boxes[i].GetMin() + Velocities[i];
+        Vector4 Max = Boxes[i].GetMax() + Velocities[i];
+
+        /* Bounce off the edges of the world */
+        for(int a = 0; a < 3; ++a) {
+            if(Min[a] < -WorldHalf || Max[a] > WorldHalf)
+                Velocities[i][a] = -Velocities[i][a];
+        }
+
+        Boxes[i] = BoundingBox(Min, Max);
+    }
+}
+
+
+void Run(int Num)
+{
+    /* Same density at every size: about a third of objects overlap one */
+    Scalar WorldHalf = 3 * cbrtf((Scalar)Num);
+    int Depth = (int)log2f(WorldHalf / MAX_HALF_SIZE);
+    bakge::BoundingVolumeHierarchy* Tree;
+    Broadphase* Phases[NUM_STRUCTURES];
+    const char* Names[NUM_STRUCTURES] = {
+        "Loose octree",
+        "Uniform grid",
+        "BVH",
+    };
+    bakge::Microseconds Start, UpdateTime[NUM_STRUCTURES] = {0, 0, 0};
+    bakge::Microseconds PairTime[NUM_STRUCTURES] = {0, 0, 0};
+    bakge::Microseconds BruteForceTime = 0;
+    int NumPairs[NUM_STRUCTURES] = {0, 0, 0};
+    int NumExpected = 0;
+
+    srand(Num);
+    for(int i = 0; i < Num; ++i) {
+        Vector4 Center = bakge::Point(Random(-WorldHalf, WorldHalf),
+                    Random(-WorldHalf, WorldHalf), Random(-WorldHalf,
+                    WorldHalf));
+        Vector4 Half = bakge::Vector(Random(0.5f, MAX_HALF_SIZE),
+            Random(0.5f, MAX_HALF_SIZE), Random(0.5f, MAX_HALF_SIZE));
+
+        Boxes[i] = BoundingBox(Center - Half, Center + Half);
+        Velocities[i] = bakge::Vector(Random(-0.1f, 0.1f),
+                        Random(-0.1f, 0.1f), Random(-0.1f, 0.1f));
+        Data[i] = &Boxes[i];
+    }
+
+    Phases[0] = bakge::LooseOctree::Create(bakge::Point(0, 0, 0),
+                                            WorldHalf, Depth);
+    Phases[1] = bakge::UniformGrid::Create(MAX_HALF_SIZE * 4, Num * 2);
+    Phases[2] = Tree = bakge::BoundingVolumeHierarchy::Create();
+
+    for(int s = 0; s < 2; ++s) {
+        for(int i = 0; i < Num; ++i)
+            Handles[s][i] = Phases[s]->Insert(Boxes[i], Data[i]);
+    }
+
+    Tree->SetMargin(0.5f);
+    Tree->Build(Boxes, Data, Num, Handles[2]);
+
+    if(Num <= MAX_BRUTE_FORCE) {
+        NumExpected = BruteForcePairs(Num, Expected);
+        for(int s = 0; s < NUM_STRUCTURES; ++s) {
+            CheckPairs(Phases[s], Names[s], Num, NumExpected);
+            CheckQueries(Phases[s], Names[s], Num, WorldHalf);
+        }
+    }
+
+    for(int Frame = 0; Frame < NUM_FRAMES; ++Frame) {
+        Move(Num, WorldHalf);
+
+        for(int s = 0; s < NUM_STRUCTURES; ++s) {
+            Start = bakge::GetRunningTime();
+            for(int i = 0; i < Num; ++i)
+                Phases[s]->Update(Handles[s][i], Boxes[i]);
+            UpdateTime[s] += bakge::GetRunningTime() - Start;
+
+            Start = bakge::GetRunningTime();
+            NumPairs[s] = Phases[s]->FindPairs(Pairs, MaxPairs);
+            PairTime[s] += bakge::GetRunningTime() - Start;
+        }
+
+        if(Num <= MAX_BRUTE_FORCE) {
+            Start = bakge::GetRunningTime();
+            NumExpected = BruteForcePairs(Num, Expected);
+            BruteForceTime += bakge::GetRunningTime() - Start;
+        }
+    }
+
+    /* Everything has moved; check again */
+    if(Num <= MAX_BRUTE_FORCE) {
+        for(int s = 0; s < NUM_STRUCTURES; ++s) {
+            /* Handles that aren't objects must leave the structure alone */
+            if(Phases[s]->Update(-1, Boxes[0])
+                    || Phases[s]->Update(MAX_OBJECTS * 8, Boxes[0])) {
+                printf("FAILED: %s accepted an invalid handle\n", Names[s]);
+                ++NumFailures;
+            }
+
+            CheckPairs(Phases[s], Names[s], Num, NumExpected);
+            CheckQueries(Phases[s], Names[s], Num, WorldHalf);
+        }
+    }
+
+    printf("%d objects, %.0f units wide, per frame:\n", Num, WorldHalf * 2);
+
+    for(int s = 0; s < NUM_STRUCTURES; ++s) {
+        printf("  %-13s update %8.2f ms  pairs %8.2f ms  (%d pairs)\n",
+                Names[s], UpdateTime[s] / 1000.0 / NUM_FRAMES,
+                PairTime[s] / 1000.0 / NUM_FRAMES, NumPairs[s]);
+    }
+
+    if(Num <= MAX_BRUTE_FORCE) {
+        printf("  %-13s                   pairs %8.2f ms  (%d pairs)\n",
+                "Brute force", BruteForceTime / 1000.0 / NUM_FRAMES,
+                NumExpected);
+    } else {
+        /* A tenth of the objects takes a hundredth of the tests */
+        Start = bakge::GetRunningTime();
+        BruteForcePairs(Num / 10, Expected);
+        BruteForceTime = (bakge::GetRunningTime() - Start) * 100;
+
+        printf("  %-13s                   pairs %8.0f ms  (estimated)\n",
+                "Brute force", BruteForceTime / 1000.0);
+    }
+
+    printf("\n");
+
+    for(int s = 0; s < NUM_STRUCTURES; ++s)
+        delete Phases[s];
+}
+
+
+/* Pawns keep their broadphase entries up to date as they move */
+void CheckPawns(Broadphase* Phase, const char* Name)
+{
+    Crate* Crates[2];
+    int Results[4];
+    BoundingBox Around(bakge::Point(9, -1, -1), bakge::Point(11, 1, 1));
+
+    Crates[0] = new Crate;
+    Crates[1] = new Crate;
+    Crates[0]->SetBroadphase(Phase);
+    Crates[1]->SetBroadphase(Phase);
+
+    if(Phase->Query(Around, Results, 4) != 0) {
+        printf("FAILED: %s found a Pawn before it moved there\n", Name);
+        ++NumFailures;
+    }
+
+    Crates[1]->SetPosition(10, 0, 0);
+
+    if(Phase->Query(Around, Results, 4) != 1
+                    || Phase->GetData(Results[0]) != Crates[1]) {
+        printf("FAILED: %s didn't follow a Pawn's SetPosition\n", Name);
+        ++NumFailures;
+    }
+
+    delete Crates[1];
+
+    if(Phase->GetNumObjects() != 1
+                    || Phase->Query(Around, Results, 4) != 0) {
+        printf("FAILED: %s kept a deleted Pawn\n", Name);
+        ++NumFailures;
+    }
+
+    delete Crates[0];
+}
+
+
+/* Objects outside a loose octree are still found */
+void CheckOutside()
+{
+    Broadphase* Phase;
+    BroadphasePair Found[4];
+    int Results[4];
+    BoundingBox Far(bakge::Point(1000, 0, 0), bakge::Point(1002, 2, 2));
+
+    Phase = bakge::LooseOctree::Create(bakge::Point(0, 0, 0), 64, 6);
+    Phase->Insert(Far, NULL);
+    Phase->Insert(BoundingBox(bakge::Point(1001, 1, 1),
+                            bakge::Point(1003, 3, 3)), NULL);
+    Phase->Insert(BoundingBox(bakge::Point(0, 0, 0),
+                            bakge::Point(1, 1, 1)), NULL);
+
+    if(Phase->Query(Far, Results, 4) != 2 || Phase->FindPairs(Found, 4) != 1) {
+        printf("FAILED: Loose octree lost objects outside it\n");
+        ++NumFailures;
+    }
+
+    delete Phase;
+}
+
+
+/* Boxes spanning far more cells or nodes than exist are still handled */
+void CheckHuge(Broadphase* Phase, const char* Name)
+{
+    BroadphasePair Found[4];
+    int Results[4];
+    BoundingBox Small(bakge::Point(0, 0, 0), bakge::Point(1, 1, 1));
+    BoundingBox Huge(bakge::Point(-1e30f, -1e30f, -1e30f),
+                            bakge::Point(1e30f, 1e30f, 1e30f));
+    BoundingBox Infinite(bakge::Point(-INFINITY, -INFINITY, -INFINITY),
+                            bakge::Point(INFINITY, INFINITY, INFINITY));
+
+    Phase->Insert(Small, NULL);
+    Phase->Insert(Huge, NULL);
+    Phase->Insert(Infinite, NULL);
+
+    if(Phase->Query(Small, Results, 4) != 3
+                    || Phase->Query(Huge, Results, 4) != 3
+                    || Phase->Query(Infinite, Results, 4) != 3
+                    || Phase->FindPairs(Found, 4) != 3) {
+        printf("FAILED: %s mishandled huge and infinite boxes\n", Name);
+        ++NumFailures;
+    }
+
+    delete Phase;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Window* Win;
+    Broadphase* Phase;
+
+    bakge::Init(argc, argv);
+
+    MaxPairs = MAX_OBJECTS * 4;
+    Pairs = new BroadphasePair[MaxPairs];
+    Found = new long long[MaxPairs];
+    Expected = new long long[MaxPairs];
+
+    /* Pawns need a context for their buffers */
+    Win = bakge::Window::Create(64, 64);
+    if(Win != NULL) {
+        Phase = bakge::LooseOctree::Create(bakge::Point(0, 0, 0), 64, 6);
+        CheckPawns(Phase, "Loose octree");
+        delete Phase;
+
+        Phase = bakge::UniformGrid::Create(4, 256);
+        CheckPawns(Phase, "Uniform grid");
+        delete Phase;
+
+        delete Win;
+    } else {
+        printf("No window, skipping Pawn checks\n");
+    }
+
+    CheckOutside();
+    CheckHuge(bakge::LooseOctree::Create(bakge::Point(0, 0, 0), 64, 6),
+                                                        "Loose octree");
+    CheckHuge(bakge::UniformGrid::Create(1, 256), "Uniform grid");
+    CheckHuge(bakge::BoundingVolumeHierarchy::Create(), "BVH");
+
+    Run(1000);
+    Run(10000);
+    Run(100000);
+
+    delete[] Pairs;
+    delete[] Found;
+    delete[] Expected;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Vector4;
+using bakge::Matrix;
+using bakge::BoundingBox;
+using bakge::BoundingSphere;
+using bakge::Frustum;
+using bakge::BoundingVolumeHierarchy;
+
+#define NUM_BOXES 100000
+#define WORLD_SIZE 500.0f
+#define NUM_BOX_QUERIES 20000
+#define NUM_FRUSTUM_QUERIES 200
+#define NUM_RAYS 100000
+#define MAX_RESULTS NUM_BOXES
+
+int NumFailures = 0;
+
+BoundingBox Boxes[NUM_BOXES];
+void* Data[NUM_BOXES];
+int Handles[NUM_BOXES];
+bool Alive[NUM_BOXES];
+bool Found[NUM_BOXES];
+int Results[MAX_RESULTS];
+
+
+Scalar Random(Scalar Low, Scalar High)
+{
+    return Low + (High - Low) * ((Scalar)rand() / (Scalar)RAND_MAX);
+}
+
+
+Vector4 RandomPoint(Scalar Range)
+{
+    return bakge::Point(Random(-Range, Range), Random(-Range, Range),
+                                                Random(-Range, Range));
+}
+
+
+BoundingBox RandomBox(Scalar Range, Scalar MaxHalfSize)
+{
+    Vector4 Center = RandomPoint(Range);
+    Vector4 Half = bakge::Vector(Random(0.5f, MaxHalfSize),
+                Random(0.5f, MaxHalfSize), Random(0.5f, MaxHalfSize));
+
+    return BoundingBox(Center - Half, Center + Half);
+}
+
+
+Frustum RandomView()
+{
+    Matrix Perspective, View;
+    Vector4 Eye = RandomPoint(WORLD_SIZE);
+
+    Perspective.SetPerspective(60.0f, 1.5f, 0.5f, 300.0f);
+    View.SetLookAt(Eye, RandomPoint(WORLD_SIZE), bakge::Vector(0, 1, 0));
+
+    return Frustum(Perspective * View);
+}
+
+
+/* Object index of a handle; each object's Data points at its box */
+int ObjectOf(BoundingVolumeHierarchy* Tree, int Handle)
+{
+    return (int)((BoundingBox*)Tree->GetData(Handle) - Boxes);
+}
+
+
+/* Same slab test as the tree, for brute force raycasts */
+bool RayHitsBox(Vector4 BGE_NCP Origin, Vector4 BGE_NCP Direction,
+                BoundingBox BGE_NCP Box, Scalar MaxDistance, Scalar* Entry)
+{
+    Scalar TMin = 0, TMax = MaxDistance;
+
+    for(int i = 0; i < 3; ++i) {
+        Scalar Inv = Direction[i] != 0 ? 1 / Direction[i] : FLT_MAX;
+        Scalar T1 = (Box.GetMin()[i] - Origin[i]) * Inv;
+        Scalar T2 = (Box.GetMax()[i] - Origin[i]) * Inv;
+
+        TMin = T1 < T2 ? (T1 > TMin ? T1 : TMin) : (T2 > TMin ? T2 : TMin);
+        TMax = T1 > T2 ? (T1 < TMax ? T1 : TMax) : (T2 < TMax ? T2 : TMax);
+    }
+
+    *Entry = TMin;
+
+    return TMin <= TMax;
+}
+
+
+/* *
+ * Compare the tree's results with testing every live box. Expected is
+ * filled in by the caller's brute force pass
+ * */
+void CompareResults(BoundingVolumeHierarchy* Tree, int Count,
+                                const bool* Expected, const char* What)
+{
+    int NumExpected = 0;
+
+    memset(Found, 0, sizeof(Found));
+
+    for(int i = 0; i < Count; ++i)
+        Found[ObjectOf(Tree, Results[i])] = true;
+
+    for(int i = 0; i < NUM_BOXES; ++i) {
+        NumExpected += Expected[i];
+
+        if(Found[i] != Expected[i]) {
+            printf("FAILED: %s query disagrees with brute force on box %d\n",
+                                                                What, i);
+            ++NumFailures;
+            return;
+        }
+    }
+
+    if(Count != NumExpected) {
+        printf("FAILED: %s query returned duplicates\n", What);
+        ++NumFailures;
+    }
+}
+
+
+void CheckQueries(BoundingVolumeHierarchy* Tree, const char* Name)
+{
+    static bool Expected[NUM_BOXES];
+    int Count;
+
+    for(int q = 0; q < 20; ++q) {
+        BoundingBox Query = RandomBox(WORLD_SIZE, 40);
+        BoundingSphere Sphere(RandomPoint(WORLD_SIZE), 40);
+        Frustum View = RandomView();
+
+        Count = Tree->Query(Query, Results, MAX_RESULTS);
+        for(int i = 0; i < NUM_BOXES; ++i)
+            Expected[i] = Alive[i] && Query.Intersects(Boxes[i]);
+        CompareResults(Tree, Count, Expected, "Box");
+
+        Count = Tree->Query(Sphere, Results, MAX_RESULTS);
+        for(int i = 0; i < NUM_BOXES; ++i)
+            Expected[i] = Alive[i] && Sphere.Intersects(Boxes[i]);
+        CompareResults(Tree, Count, Expected, "Sphere");
+
+        Count = Tree->Query(View, Results, MAX_RESULTS);
+        for(int i = 0; i < NUM_BOXES; ++i)
+            Expected[i] = Alive[i] && View.Intersects(Boxes[i]);
+        CompareResults(Tree, Count, Expected, "Frustum");
+    }
+
+    for(int q = 0; q < 20; ++q) {
+        Vector4 Origin = RandomPoint(WORLD_SIZE);
+        Vector4 Direction = RandomPoint(1).Normalized();
+        Scalar Distance = -1, BestEntry = FLT_MAX, Entry;
+        int Closest, Best = -1;
+
+        Count = Tree->Raycast(Origin, Direction, 400, Results, MAX_RESULTS);
+        for(int i = 0; i < NUM_BOXES; ++i) {
+            Expected[i] = Alive[i] && RayHitsBox(Origin, Direction,
+                                                Boxes[i], 400, &Entry);
+            if(Expected[i] && Entry < BestEntry) {
+                BestEntry = Entry;
+                Best = i;
+            }
+        }
+        CompareResults(Tree, Count, Expected, "Raycast");
+
+        Closest = Tree->RaycastClosest(Origin, Direction, 400, &Distance);
+        if((Best < 0) != (Closest < 0) || (Best >= 0
+                                        && Distance != BestEntry)) {
+            printf("FAILED: Closest raycast hit the wrong box\n");
+            ++NumFailures;
+        }
+    }
+
+    printf("%s: %d objects, height %d, queries agree with brute force\n",
+                        Name, Tree->GetNumObjects(), Tree->GetHeight());
+}
+
+
+void Benchmark(BoundingVolumeHierarchy* Tree, const char* Name)
+{
+    bakge::Microseconds Start, Elapsed;
+    long Total = 0;
+
+    srand(7);
+    Start = bakge::GetRunningTime();
+    for(int q = 0; q < NUM_BOX_QUERIES; ++q)
+        Total += Tree->Query(RandomBox(WORLD_SIZE, 10), Results, MAX_RESULTS);
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("%s box queries:     %10.0f /s (%.1f hits each)\n", Name,
+            NUM_BOX_QUERIES * 1e6 / Elapsed, (double)Total / NUM_BOX_QUERIES);
+
+    Total = 0;
+    Start = bakge::GetRunningTime();
+    for(int q = 0; q < NUM_FRUSTUM_QUERIES; ++q)
+        Total += Tree->Query(RandomView(), Results, MAX_RESULTS);
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("%s frustum queries: %10.0f /s (%.1f hits each)\n", Name,
+            NUM_FRUSTUM_QUERIES * 1e6 / Elapsed,
+            (double)Total / NUM_FRUSTUM_QUERIES);
+
+    Total = 0;
+    Start = bakge::GetRunningTime();
+    for(int q = 0; q < NUM_RAYS; ++q) {
+        Total += Tree->RaycastClosest(RandomPoint(WORLD_SIZE),
+                    RandomPoint(1).Normalized(), 1000, NULL) >= 0;
+    }
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("%s closest rays:    %10.0f /s (%.0f%% hit)\n", Name,
+            NUM_RAYS * 1e6 / Elapsed, 100.0 * Total / NUM_RAYS);
+}
+
+
+int main(int argc, char* argv[])
+{
+    BoundingVolumeHierarchy* Built;
+    BoundingVolumeHierarchy* Dynamic;
+    bakge::Microseconds Start, Elapsed;
+    BoundingBox Query;
+    int NumReinserted = 0;
+
+    bakge::Init(argc, argv);
+
+    srand(3);
+    for(int i = 0; i < NUM_BOXES; ++i) {
+        Boxes[i] = RandomBox(WORLD_SIZE, 5);
+        Data[i] = &Boxes[i];
+        Alive[i] = true;
+    }
+
+    /* Whole scene at once */
+    Built = BoundingVolumeHierarchy::Create();
+    Start = bakge::GetRunningTime();
+    Built->Build(Boxes, Data, NUM_BOXES, Handles);
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("Built %d boxes in %.1f ms\n", NUM_BOXES, Elapsed / 1000.0);
+
+    CheckQueries(Built, "Built");
+
+    /* One object at a time */
+    Dynamic = BoundingVolumeHierarchy::Create();
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_BOXES; ++i)
+        Handles[i] = Dynamic->Insert(Boxes[i], Data[i]);
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("Inserted %d boxes in %.1f ms\n", NUM_BOXES, Elapsed / 1000.0);
+
+    CheckQueries(Dynamic, "Inserted");
+
+    printf("\n");
+    Benchmark(Built, "Built   ");
+    Benchmark(Dynamic, "Inserted");
+
+    /* Brute force, for scale */
+    Start = bakge::GetRunningTime();
+    for(int q = 0; q < 100; ++q) {
+        Query = RandomBox(WORLD_SIZE, 10);
+        Query.Intersects(Boxes, Found, NUM_BOXES);
+    }
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("Brute force box queries: %10.0f /s\n\n", 100 * 1e6 / Elapsed);
+
+    /* Move a tenth of the boxes a little, mostly within the margin */
+    Built->SetMargin(1);
+    Built->Build(Boxes, Data, NUM_BOXES, Handles);
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_BOXES; i += 10) {
+        Vector4 Offset = RandomPoint(1.2f) - bakge::Point(0, 0, 0);
+
+        Boxes[i] = BoundingBox(Boxes[i].GetMin() + Offset,
+                                Boxes[i].GetMax() + Offset);
+        NumReinserted += Built->Update(Handles[i], Boxes[i]);
+    }
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("Updated %d moving boxes in %.2f ms, %d reinserted\n",
+                NUM_BOXES / 10, Elapsed / 1000.0, NumReinserted);
+
+    /* Remove half */
+    for(int i = 0; i < NUM_BOXES; i += 2) {
+        Built->Remove(Handles[i]);
+        Alive[i] = false;
+    }
+
+    /* *
+     * With a margin the tree stores and reports fattened boxes, so check
+     * it against those
+     * */
+    for(int i = 0; i < NUM_BOXES; ++i) {
+        if(Alive[i])
+            Boxes[i] = Built->GetBox(Handles[i]);
+    }
+
+    CheckQueries(Built, "Updated");
+
+    /* Handles that aren't objects are refused, leaving the tree intact */
+    if(Built->Update(Handles[0], Boxes[1]) || Built->Update(-1, Boxes[1])
+                        || Built->Update(NUM_BOXES * 4, Boxes[1])) {
+        printf("FAILED: Update accepted an invalid handle\n");
+        ++NumFailures;
+    }
+
+    CheckQueries(Built, "Invalid update");
+
+    delete Built;
+    delete Dynamic;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    return 0;
+}
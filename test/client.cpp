@@ -35,8 +35,10 @@ int main(int argc, char* argv[])
     bakge::Packet* Pack;
     bakge::Remote Server;
 
-    Pack = bakge::Packet::Create(NULL);
-    
+    Pack = bakge::Packet::Create();
+    if(Pack != NULL)
+        Pack->Write("Hello, server", 14);
+
     Server.SetAddress(72, 129, 81, 23);
     Server.SetPort(7000);
 
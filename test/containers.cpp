@@ -0,0 +1,433 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <bakge/Bakge.h>
+
+using bakge::SmallVector;
+using bakge::FlatHashMap;
+using bakge::SlotMap;
+using bakge::SlotHandle;
+
+#define NUM_RANDOM_OPS 1000000
+#define NUM_SMALL_VECTORS 1000000
+#define SMALL_SIZE 8
+#define NUM_KEYS 1000000
+#define NUM_OBJECTS 1000000
+
+int NumFailures = 0;
+unsigned int Seed = 1;
+
+/* Keeps results alive so benchmarks aren't optimized away */
+volatile long long Sink;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+unsigned int Random()
+{
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+
+    return Seed;
+}
+
+
+/* Each index below Count once, out of order, since 7919 is prime */
+int Scatter(int i, int Count)
+{
+    return (int)((long long)i * 7919 % Count);
+}
+
+
+double Milliseconds(bakge::Microseconds Start)
+{
+    return (bakge::GetRunningTime() - Start) / 1000.0;
+}
+
+
+/* Counts live copies, to catch values constructed or destructed wrongly */
+struct Counted
+{
+    static int NumLive;
+    int Value;
+
+    Counted() { Value = 0; ++NumLive; }
+    Counted(int V) { Value = V; ++NumLive; }
+    Counted(const Counted& Other) { Value = Other.Value; ++NumLive; }
+    Counted& operator=(const Counted& Other)
+    {
+        Value = Other.Value;
+        return *this;
+    }
+    ~Counted() { --NumLive; }
+};
+
+int Counted::NumLive = 0;
+
+
+void CheckSmallVector()
+{
+    bool Correct = true;
+
+    {
+        SmallVector<Counted, 4> V;
+
+        for(int i = 0; i < 4; ++i)
+            V.PushBack(Counted(i));
+        Check(V.IsInline(), "small vector stays inline up to N");
+
+        /* Pushing one of its own values while it grows */
+        V.PushBack(V[0]);
+        for(int i = 5; i < 100; ++i)
+            V.PushBack(Counted(i));
+        Check(!V.IsInline() && V.GetSize() == 100, "small vector grows");
+        Check(V[4].Value == 0, "push own value while growing");
+
+        V.RemoveSwap(4);
+        Check(V[4].Value == 99 && V.GetSize() == 99, "remove by swapping");
+
+        SmallVector<Counted, 4> Copy(V);
+        for(int i = 0; i < Copy.GetSize(); ++i)
+            Correct = Correct && Copy[i].Value == V[i].Value;
+        Check(Correct && Copy.GetSize() == 99, "small vector copies");
+
+        V.Resize(2);
+        Check(V.GetSize() == 2 && V[1].Value == 1, "resize smaller");
+        V.Clear();
+        Check(V.IsEmpty(), "clear");
+    }
+
+    Check(Counted::NumLive == 0, "small vector destructs every value");
+}
+
+
+void CheckFlatHashMap()
+{
+    FlatHashMap<int, int> Map;
+    std::unordered_map<int, int> Reference;
+    bool Correct = true;
+    int Walked = 0;
+
+    /* *
+     * Random inserts, removes and finds over a small key range, so there
+     * are lots of collisions and deleted slots
+     * */
+    for(int i = 0; i < NUM_RANDOM_OPS && Correct; ++i) {
+        int Key = Random() % 5000;
+        int Op = Random() % 3;
+
+        if(Op == 0) {
+            bool New = Map.Insert(Key, i);
+            Correct = New == (Reference.find(Key) == Reference.end());
+            Reference[Key] = i;
+        } else if(Op == 1) {
+            Correct = Map.Remove(Key) == (Reference.erase(Key) == 1);
+        } else {
+            int* Found = Map.Find(Key);
+            std::unordered_map<int, int>::iterator It = Reference.find(Key);
+
+            if(It == Reference.end())
+                Correct = Found == NULL;
+            else
+                Correct = Found != NULL && *Found == It->second;
+        }
+    }
+
+    Check(Correct, "hash map agrees with std::unordered_map");
+    Check(Map.GetSize() == (int)Reference.size(), "hash map size");
+
+    for(int Slot = Map.GetFirst(); Slot >= 0; Slot = Map.GetNext(Slot)) {
+        std::unordered_map<int, int>::iterator It;
+
+        It = Reference.find(Map.GetKey(Slot));
+        if(It == Reference.end() || It->second != Map.GetValue(Slot))
+            Correct = false;
+        ++Walked;
+    }
+    Check(Correct && Walked == Map.GetSize(), "walk hash map");
+
+    Map.Clear();
+    Check(Map.IsEmpty() && Map.Find(1) == NULL, "clear hash map");
+
+    /* Copies of a value already in the map, through several grows */
+    FlatHashMap<int, std::string> Names;
+    Names.Insert(0, "long enough to live outside the string itself");
+    for(int i = 1; i < 200; ++i)
+        Names.Insert(i, *Names.Find(0));
+
+    for(int i = 1; i < 200; ++i)
+        Correct = Correct && *Names.Find(i) == *Names.Find(0);
+    Check(Correct, "insert own value while growing");
+}
+
+
+void CheckSlotMap()
+{
+    SlotMap<Counted> Map;
+    std::vector<SlotHandle> Handles;
+    std::vector<int> Expected;
+    SlotHandle Stale, Fresh;
+    bool Correct = true;
+
+    for(int i = 0; i < 1000; ++i) {
+        Handles.push_back(Map.Insert(Counted(i)));
+        Expected.push_back(i);
+    }
+
+    /* Remove every third value */
+    for(int i = 0; i < 1000; i += 3) {
+        Correct = Correct && Map.Remove(Handles[i]);
+        Correct = Correct && !Map.Remove(Handles[i]);
+    }
+    Check(Correct, "slot map removes once");
+
+    for(int i = 0; i < 1000; ++i) {
+        Counted* C = Map.Get(Handles[i]);
+
+        if(i % 3 == 0)
+            Correct = Correct && C == NULL;
+        else
+            Correct = Correct && C != NULL && C->Value == i;
+    }
+    Check(Correct, "handles survive other removals");
+
+    /* The freed slot gets reused, but not by the old handle */
+    Stale = Handles[0];
+    Fresh = Map.Insert(Counted(-1));
+    Check(Fresh.Index == Stale.Index || Map.Get(Stale) == NULL,
+                                                "stale handle stays stale");
+    Check(Map.Get(Stale) == NULL && Map.Get(Fresh)->Value == -1,
+                                                "reused slot has new value");
+    Check(!Map.IsValid(SlotHandle()), "default handle is invalid");
+
+    for(int i = 0; i < Map.GetSize(); ++i) {
+        if(Map.Get(Map.GetHandle(i)) != &Map.GetData()[i])
+            Correct = false;
+    }
+    Check(Correct, "handles of packed values");
+
+    /* Copies of a value already in the map, through several grows */
+    for(int i = 0; i < 2000; ++i) {
+        Fresh = Map.Insert(*Map.Get(Handles[1]));
+        Correct = Correct && Map.Get(Fresh)->Value == 1;
+    }
+    Check(Correct, "insert own value while growing");
+
+    Map.Clear();
+    Check(Map.IsEmpty() && !Map.IsValid(Fresh), "clear slot map");
+    Check(Counted::NumLive == 0, "slot map destructs every value");
+}
+
+
+void BenchmarkSmallVector()
+{
+    bakge::Microseconds Start;
+    long long Sum = 0;
+
+    /* Many short-lived short lists, like per-object work lists */
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_SMALL_VECTORS; ++i) {
+        std::vector<int> V;
+        for(int j = 0; j < SMALL_SIZE; ++j)
+            V.push_back(i + j);
+        Sum += V[i % SMALL_SIZE];
+    }
+    printf("  std::vector          %7.1f ms\n", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_SMALL_VECTORS; ++i) {
+        SmallVector<int, SMALL_SIZE> V;
+        for(int j = 0; j < SMALL_SIZE; ++j)
+            V.PushBack(i + j);
+        Sum += V[i % SMALL_SIZE];
+    }
+    printf("  SmallVector          %7.1f ms\n", Milliseconds(Start));
+
+    Sink = Sum;
+}
+
+
+void BenchmarkHashMap(int* Keys)
+{
+    FlatHashMap<int, int> Flat;
+    std::unordered_map<int, int> Std;
+    bakge::Microseconds Start;
+    long long Sum = 0;
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Std[Keys[i]] = i;
+    printf("  insert   std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Flat.Insert(Keys[i], i);
+    printf("   FlatHashMap %7.1f ms\n", Milliseconds(Start));
+
+    /* Hits in a different order than inserted */
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Sum += Std.find(Keys[Scatter(i, NUM_KEYS)])->second;
+    printf("  hit      std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Sum += *Flat.Find(Keys[Scatter(i, NUM_KEYS)]);
+    printf("   FlatHashMap %7.1f ms\n", Milliseconds(Start));
+
+    /* Keys are all even, so odd ones miss */
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Sum += Std.count(Keys[i] + 1);
+    printf("  miss     std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Sum += Flat.Contains(Keys[i] + 1);
+    printf("   FlatHashMap %7.1f ms\n", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(std::unordered_map<int, int>::iterator It = Std.begin();
+                                                It != Std.end(); ++It)
+        Sum += It->second;
+    printf("  iterate  std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int Slot = Flat.GetFirst(); Slot >= 0; Slot = Flat.GetNext(Slot))
+        Sum += Flat.GetValue(Slot);
+    printf("   FlatHashMap %7.1f ms\n", Milliseconds(Start));
+
+    Sink = Sum;
+}
+
+
+/* What a scene might keep per object */
+struct Object
+{
+    float Position[4];
+    int Mesh;
+    int Texture;
+};
+
+
+void BenchmarkSlotMap()
+{
+    SlotMap<Object> Slots;
+    std::unordered_map<int, Object> Std;
+    std::vector<SlotHandle> Handles;
+    bakge::Microseconds Start;
+    Object O;
+    long long Sum = 0;
+
+    memset(&O, 0, sizeof(O));
+
+    /* The usual alternative: objects keyed by an id */
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        O.Mesh = i;
+        Std[i] = O;
+    }
+    printf("  insert   std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        O.Mesh = i;
+        Handles.push_back(Slots.Insert(O));
+    }
+    printf("   SlotMap     %7.1f ms\n", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Sum += Std[Scatter(i, NUM_OBJECTS)].Mesh;
+    printf("  lookup   std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Sum += Slots.Get(Handles[Scatter(i, NUM_OBJECTS)])->Mesh;
+    printf("   SlotMap     %7.1f ms\n", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(std::unordered_map<int, Object>::iterator It = Std.begin();
+                                                It != Std.end(); ++It)
+        Sum += It->second.Mesh;
+    printf("  iterate  std::unordered_map %7.1f ms", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < Slots.GetSize(); ++i)
+        Sum += Slots.GetData()[i].Mesh;
+    printf("   SlotMap     %7.1f ms\n", Milliseconds(Start));
+
+    Sink = Sum;
+}
+
+
+int main(int argc, char* argv[])
+{
+    int* Keys;
+
+    bakge::Init(argc, argv);
+
+    CheckSmallVector();
+    CheckFlatHashMap();
+    CheckSlotMap();
+
+    Keys = new int[NUM_KEYS];
+    for(int i = 0; i < NUM_KEYS; ++i)
+        Keys[i] = (int)(Random() & 0x3FFFFFFF) * 2;
+
+    printf("%d vectors of %d ints\n", NUM_SMALL_VECTORS, SMALL_SIZE);
+    BenchmarkSmallVector();
+
+    printf("%d random int keys\n", NUM_KEYS);
+    BenchmarkHashMap(Keys);
+
+    printf("%d objects\n", NUM_OBJECTS);
+    BenchmarkSlotMap();
+
+    delete[] Keys;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Result;
+using bakge::Vector4;
+using bakge::Matrix;
+using bakge::BoundingBox;
+using bakge::Frustum;
+
+#define NUM_OBJECTS 10000
+#define BENCH_ROUNDS 200
+
+/* Stands in for a Shape; counts draws instead of issuing GL calls */
+class Marker : public bakge::Drawable
+{
+
+public:
+
+    BoundingBox Bounds;
+    mutable int NumDraws;
+
+    Marker() : NumDraws(0)
+    {
+    }
+
+    Result Bind() const
+    {
+        return BGE_SUCCESS;
+    }
+
+    Result Unbind() const
+    {
+        return BGE_SUCCESS;
+    }
+
+    Result Draw() const
+    {
+        ++NumDraws;
+        return BGE_SUCCESS;
+    }
+
+    BoundingBox GetBoundingBox() const
+    {
+        return Bounds;
+    }
+
+}; /* Marker */
+
+Marker Markers[NUM_OBJECTS];
+bakge::Drawable* Scene[NUM_OBJECTS];
+
+
+Scalar Random(Scalar Low, Scalar High)
+{
+    return Low + (High - Low) * ((Scalar)rand() / (Scalar)RAND_MAX);
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::FrontRenderer* Renderer;
+    Matrix Perspective, View;
+    Frustum ViewFrustum;
+    bakge::Microseconds Start, SingleTime, BatchTime;
+    int NumFailures = 0;
+    int NumUnbounded = 0;
+    int NumVisible = 0;
+
+    bakge::Init(argc, argv);
+
+    Renderer = bakge::FrontRenderer::Create();
+
+    Perspective.SetPerspective(80.0f, 1.5f, 0.1f, 500.0f);
+    View.SetLookAt(bakge::Point(0, 0, 3), bakge::Point(0, 0, 0),
+                                        bakge::UnitVector(0, 1, 0));
+    Renderer->SetViewProjection(Perspective, View);
+    ViewFrustum.SetMatrix(Perspective * View);
+
+    /* A scene around the camera with a few objects that have no bounds */
+    srand(2);
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        Vector4 Center = bakge::Point(Random(-50, 50), Random(-50, 50),
+                                                        Random(-50, 50));
+        Vector4 Size = bakge::Vector(0.5f, 0.5f, 0.5f);
+
+        if(i % 100 == 0) {
+            ++NumUnbounded;
+        } else {
+            Markers[i].Bounds = BoundingBox(Center - Size, Center + Size);
+            NumVisible += ViewFrustum.Intersects(Markers[i].Bounds);
+        }
+
+        Scene[i] = &Markers[i];
+    }
+
+    Renderer->Draw(Scene, NUM_OBJECTS);
+
+    printf("Tested %d, culled %d, drew %d\n", Renderer->GetNumTested(),
+                    Renderer->GetNumCulled(), Renderer->GetNumDrawn());
+
+    if(Renderer->GetNumTested() != NUM_OBJECTS - NumUnbounded
+            || Renderer->GetNumDrawn() != NumVisible + NumUnbounded
+            || Renderer->GetNumCulled() != NUM_OBJECTS - NumUnbounded
+                                                        - NumVisible) {
+        printf("Culling counters are wrong\n");
+        ++NumFailures;
+    }
+
+    /* Exactly the visible objects were drawn, each once */
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        bool Expected = Markers[i].Bounds.IsEmpty()
+                            || ViewFrustum.Intersects(Markers[i].Bounds);
+
+        if(Markers[i].NumDraws != (Expected ? 1 : 0)) {
+            printf("Object %d was drawn %d times\n", i, Markers[i].NumDraws);
+            ++NumFailures;
+            break;
+        }
+    }
+
+    /* Drawing one at a time gives the same counts */
+    Renderer->ResetCounters();
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        Renderer->Draw(Scene[i]);
+
+    if(Renderer->GetNumDrawn() != NumVisible + NumUnbounded
+            || Renderer->GetNumTested() != NUM_OBJECTS - NumUnbounded) {
+        printf("Drawing objects one at a time culled differently\n");
+        ++NumFailures;
+    }
+
+    /* Cost of culling one object at a time against batches */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < BENCH_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_OBJECTS; ++i)
+            Renderer->Draw(Scene[i]);
+    }
+    SingleTime = bakge::GetRunningTime() - Start;
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < BENCH_ROUNDS; ++r)
+        Renderer->Draw(Scene, NUM_OBJECTS);
+    BatchTime = bakge::GetRunningTime() - Start;
+
+    printf("%.2f ns/object one at a time, %.2f ns/object batched\n",
+                SingleTime * 1000.0 / (NUM_OBJECTS * BENCH_ROUNDS),
+                BatchTime * 1000.0 / (NUM_OBJECTS * BENCH_ROUNDS));
+
+    delete Renderer;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    return 0;
+}
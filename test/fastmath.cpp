@@ -0,0 +1,281 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::ScalarLanes;
+
+/* *
+ * Error bounds documented in bakge/math/FastMath.h. Sine and cosine are
+ * also allowed a small absolute error, which dominates near their zeros
+ * where the result is tiny and ULPs are meaningless
+ * */
+#define RSQRT_MAX_ULP 4.0
+#define SINCOS_MAX_ULP 2.0
+#define SINCOS_MAX_ABS 8e-8
+#define ATAN2_MAX_ULP 3.5
+
+#define NEAR_ZERO (1.0 / 64)
+#define SINCOS_RANGE 8192.0f
+#define BENCH_COUNT 4096
+#define BENCH_ROUNDS 2000
+
+int NumFailures = 0;
+
+/* Keeps the compiler from discarding results of the timed loops */
+volatile Scalar Sink;
+
+Scalar BenchIn[BENCH_COUNT];
+Scalar BenchIn2[BENCH_COUNT];
+Scalar BenchOut[BENCH_COUNT];
+
+
+/* Error of Value in units of the last place of Exact rounded to float */
+double ULPs(Scalar Value, double Exact)
+{
+    Scalar Rounded = (Scalar)Exact;
+    double Unit = (double)nextafterf(fabsf(Rounded), INFINITY)
+                                    - (double)fabsf(Rounded);
+
+    return fabs((double)Value - Exact) / Unit;
+}
+
+
+struct ErrorStats
+{
+    double MaxULP;
+    double MaxAbs;
+    Scalar WorstInput;
+    int Mismatches;
+};
+
+
+void Record(ErrorStats* Stats, Scalar In, Scalar Value, double Exact,
+                                                    double AbsAllowed)
+{
+    double U = ULPs(Value, Exact);
+    double Abs = fabs((double)Value - Exact);
+
+    /* Near zeros of sin/cos only the absolute error is meaningful */
+    if(fabs(Exact) < NEAR_ZERO && Abs <= AbsAllowed)
+        U = 0;
+
+    if(U > Stats->MaxULP) {
+        Stats->MaxULP = U;
+        Stats->WorstInput = In;
+    }
+
+    if(Abs > Stats->MaxAbs)
+        Stats->MaxAbs = Abs;
+}
+
+
+void Report(const char* Name, ErrorStats BGE_NCP Stats, double Bound)
+{
+    bool Passed = Stats.MaxULP <= Bound && Stats.Mismatches == 0;
+
+    printf("%-12s max %6.3f ULP (bound %.1f) max abs %.3g at %g, %d lane"
+            " mismatches  %s\n", Name, Stats.MaxULP, Bound, Stats.MaxAbs,
+            Stats.WorstInput, Stats.Mismatches, Passed ? "ok" : "FAILED");
+
+    if(!Passed)
+        ++NumFailures;
+}
+
+
+/* Run a lane function over N inputs, BGE_LANE_WIDTH at a time */
+template<ScalarLanes (*Func)(ScalarLanes)>
+void RunLanes(const Scalar* In, Scalar* Out, int N)
+{
+    for(int i = 0; i < N; i += BGE_LANE_WIDTH)
+        bakge::LanesStoreU(&Out[i], Func(bakge::LanesLoadU(&In[i])));
+}
+
+
+ScalarLanes LanesAtan2OfBenchIn(ScalarLanes Y)
+{
+    return bakge::LanesAtan2(Y, bakge::LanesSet(0.75f));
+}
+
+
+double NanosecondsPerOp(bakge::Microseconds Elapsed)
+{
+    return (double)Elapsed * 1000.0 / (double)(BENCH_COUNT * BENCH_ROUNDS);
+}
+
+
+int main(int argc, char* argv[])
+{
+    Scalar In[64], LaneOut[64];
+    ErrorStats Rsqrt = {0, 0, 0, 0};
+    ErrorStats Sin = {0, 0, 0, 0};
+    ErrorStats Cos = {0, 0, 0, 0};
+    ErrorStats Atan2 = {0, 0, 0, 0};
+    bakge::Microseconds Start;
+    double LibmNs, FastNs, LanesNs;
+
+    bakge::Init(argc, argv);
+
+    printf("SIMD: %s, %d lanes\n", BGE_SIMD_NAME, BGE_LANE_WIDTH);
+
+    /* Reciprocal square root over every 61st positive normal float */
+    for(unsigned int Bits = 0x00800000; Bits < 0x7F800000; Bits += 61) {
+        Scalar X;
+
+        memcpy(&X, &Bits, sizeof(X));
+        Record(&Rsqrt, X, bakge::FastRsqrt(X), 1.0 / sqrt((double)X), 0);
+    }
+
+    /* Sine and cosine over the documented domain */
+    for(Scalar X = -SINCOS_RANGE; X <= SINCOS_RANGE; X += 0.000977f) {
+        Scalar S, C;
+
+        bakge::FastSinCos(X, &S, &C);
+        Record(&Sin, X, S, sin((double)X), SINCOS_MAX_ABS);
+        Record(&Cos, X, C, cos((double)X), SINCOS_MAX_ABS);
+    }
+
+    /* Small arguments, where sin(x) ~ x must stay accurate */
+    for(Scalar X = 1e-30f; X < 1; X *= 1.0001f) {
+        Record(&Sin, X, bakge::FastSin(X), sin((double)X), 0);
+        Record(&Sin, -X, bakge::FastSin(-X), sin(-(double)X), 0);
+    }
+
+    /* atan2 around the circle at many magnitudes */
+    for(Scalar R = 1e-20f; R < 1e20f; R *= 7.3f) {
+        for(int i = 0; i < 100000; ++i) {
+            double Angle = (i / 100000.0) * 2 * 3.14159265358979 - 3.14159;
+            Scalar Y = (Scalar)(R * sin(Angle));
+            Scalar X = (Scalar)(R * cos(Angle));
+
+            Record(&Atan2, Angle, bakge::FastAtan2(Y, X),
+                        atan2((double)Y, (double)X), 0);
+        }
+    }
+
+    /* Lane forms must agree with the scalar forms */
+    srand(0);
+    for(int r = 0; r < 10000; ++r) {
+        for(int i = 0; i < 64; ++i)
+            In[i] = (Scalar)(rand() % 2000000 - 1000000) / 100.0f;
+
+        RunLanes<bakge::LanesSin>(In, LaneOut, 64);
+        for(int i = 0; i < 64; ++i)
+            Sin.Mismatches += LaneOut[i] != bakge::FastSin(In[i]);
+
+        RunLanes<bakge::LanesCos>(In, LaneOut, 64);
+        for(int i = 0; i < 64; ++i)
+            Cos.Mismatches += LaneOut[i] != bakge::FastCos(In[i]);
+
+        RunLanes<LanesAtan2OfBenchIn>(In, LaneOut, 64);
+        for(int i = 0; i < 64; ++i)
+            Atan2.Mismatches += LaneOut[i] != bakge::FastAtan2(In[i], 0.75f);
+
+        for(int i = 0; i < 64; ++i)
+            In[i] = fabsf(In[i]) + 1e-3f;
+
+        /* Estimates can differ between instruction sets; check bounds */
+        RunLanes<bakge::LanesRsqrt>(In, LaneOut, 64);
+        for(int i = 0; i < 64; ++i)
+            Record(&Rsqrt, In[i], LaneOut[i], 1.0 / sqrt((double)In[i]), 0);
+    }
+
+    /* Arguments past the limit are clamped, in lanes as in scalars */
+    for(int i = 0; i < 64; ++i) {
+        Scalar Huge[] = {2e6f, 3.4e38f, INFINITY, NAN};
+
+        In[i] = Huge[i % 4] * (i % 8 < 4 ? 1 : -1);
+    }
+
+    RunLanes<bakge::LanesSin>(In, LaneOut, 64);
+    for(int i = 0; i < 64; ++i) {
+        Scalar S, C;
+
+        bakge::FastSinCos(In[i], &S, &C);
+        Sin.Mismatches += LaneOut[i] != S;
+
+        if(!(fabsf(S) <= 1 && fabsf(C) <= 1)) {
+            printf("FastSinCos(%g) out of range: %g, %g  FAILED\n",
+                                                        In[i], S, C);
+            ++NumFailures;
+        }
+    }
+
+    Report("FastRsqrt", Rsqrt, RSQRT_MAX_ULP);
+    Report("FastSin", Sin, SINCOS_MAX_ULP);
+    Report("FastCos", Cos, SINCOS_MAX_ULP);
+    Report("FastAtan2", Atan2, ATAN2_MAX_ULP);
+
+    /* Speed against libm */
+    for(int i = 0; i < BENCH_COUNT; ++i) {
+        BenchIn[i] = (Scalar)(rand() % 20000 - 10000) / 100.0f;
+        BenchIn2[i] = fabsf(BenchIn[i]) + 0.5f;
+    }
+
+    printf("\n%-12s %10s %10s %10s\n", "ns/op", "libm", "Fast", "Lanes");
+
+#define BENCH(Result, Loop) \
+    Start = bakge::GetRunningTime(); \
+    for(int r = 0; r < BENCH_ROUNDS; ++r) { \
+        Loop; \
+        Sink = BenchOut[r % BENCH_COUNT]; \
+    } \
+    Result = NanosecondsPerOp(bakge::GetRunningTime() - Start)
+
+    BENCH(LibmNs, for(int i = 0; i < BENCH_COUNT; ++i)
+                    BenchOut[i] = 1 / sqrtf(BenchIn2[i]));
+    BENCH(FastNs, for(int i = 0; i < BENCH_COUNT; ++i)
+                    BenchOut[i] = bakge::FastRsqrt(BenchIn2[i]));
+    BENCH(LanesNs, RunLanes<bakge::LanesRsqrt>(BenchIn2, BenchOut,
+                                                        BENCH_COUNT));
+    printf("%-12s %10.3f %10.3f %10.3f\n", "rsqrt", LibmNs, FastNs, LanesNs);
+
+    BENCH(LibmNs, for(int i = 0; i < BENCH_COUNT; ++i)
+                    BenchOut[i] = sinf(BenchIn[i]));
+    BENCH(FastNs, for(int i = 0; i < BENCH_COUNT; ++i)
+                    BenchOut[i] = bakge::FastSin(BenchIn[i]));
+    BENCH(LanesNs, RunLanes<bakge::LanesSin>(BenchIn, BenchOut,
+                                                        BENCH_COUNT));
+    printf("%-12s %10.3f %10.3f %10.3f\n", "sin", LibmNs, FastNs, LanesNs);
+
+    BENCH(LibmNs, for(int i = 0; i < BENCH_COUNT; ++i)
+                    BenchOut[i] = atan2f(BenchIn[i], 0.75f));
+    BENCH(FastNs, for(int i = 0; i < BENCH_COUNT; ++i)
+                    BenchOut[i] = bakge::FastAtan2(BenchIn[i], 0.75f));
+    BENCH(LanesNs, RunLanes<LanesAtan2OfBenchIn>(BenchIn, BenchOut,
+                                                        BENCH_COUNT));
+    printf("%-12s %10.3f %10.3f %10.3f\n", "atan2", LibmNs, FastNs, LanesNs);
+
+#undef BENCH
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,231 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Nanoseconds;
+using bakge::FrameTimer;
+using bakge::FrameStageScope;
+using bakge::FrameStageStats;
+
+#define MS 1000000LL
+
+int NumFailures = 0;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+/* One frame whose update stage takes Work */
+void RunFrame(FrameTimer* T, Nanoseconds Work)
+{
+    T->BeginFrame();
+
+    {
+        FrameStageScope UpdateTime(T, bakge::FRAME_STAGE_UPDATE);
+        bakge::PreciseDelay(Work);
+    }
+
+    T->Pace();
+}
+
+
+void TestNames()
+{
+    bool RoundTrip = true;
+
+    for(int i = 0; i < bakge::NUM_FRAME_STAGES; ++i) {
+        if(bakge::GetFrameStage(bakge::GetFrameStageName(i)) != i)
+            RoundTrip = false;
+    }
+
+    Check(RoundTrip, "stage names map back to stages");
+    Check(bakge::GetFrameStage("nonsense") == bakge::NUM_FRAME_STAGES,
+                                            "unknown stage name");
+    Check(strcmp(bakge::GetFrameStageName(-1), "unknown") == 0,
+                                            "out of range stage name");
+}
+
+
+void TestPercentiles()
+{
+    FrameTimer* T;
+    FrameStageStats Stats;
+
+    T = FrameTimer::Create();
+    if(T == NULL) {
+        Check(false, "create frame timer");
+        return;
+    }
+
+    T->GetStageStats(bakge::FRAME_STAGE_UPDATE, &Stats);
+    Check(Stats.NumSamples == 0 && Stats.Max == 0, "empty window");
+    Check(T->GetStageStats(bakge::NUM_FRAME_STAGES, &Stats) == BGE_FAILURE,
+                                            "out of range stage refused");
+
+    /* Every tenth update is slow */
+    for(int i = 0; i < 41; ++i)
+        RunFrame(T, i % 10 == 9 ? 3 * MS : 1 * MS);
+
+    /* The 41st frame is still in progress */
+    T->GetStageStats(bakge::FRAME_STAGE_UPDATE, &Stats);
+    Check(Stats.NumSamples == 40, "finished frames counted");
+    Check(Stats.P50 >= 1 * MS && Stats.P50 < 2 * MS, "p50 is a fast frame");
+    Check(Stats.P95 >= 3 * MS, "p95 is a slow frame");
+    Check(Stats.P99 >= 3 * MS && Stats.Max >= Stats.P99, "p99 and max");
+    Check(Stats.Mean > Stats.P50 && Stats.Mean < Stats.P95, "mean between");
+
+    T->GetStageStats(bakge::FRAME_STAGE_RENDER, &Stats);
+    Check(Stats.NumSamples == 40 && Stats.Max == 0,
+                                    "stages not entered take no time");
+
+    T->GetStageStats(bakge::FRAME_STAGE_FRAME, &Stats);
+    Check(Stats.P50 >= 1 * MS, "frame includes its stages");
+
+    /* The window keeps only the most recent frames */
+    for(int i = 0; i < BGE_FRAME_HISTORY + 10; ++i) {
+        T->BeginFrame();
+        T->BeginStage(bakge::FRAME_STAGE_RENDER);
+        T->EndStage(bakge::FRAME_STAGE_RENDER);
+    }
+
+    T->GetStageStats(bakge::FRAME_STAGE_UPDATE, &Stats);
+    Check(Stats.NumSamples == BGE_FRAME_HISTORY, "window is bounded");
+    Check(Stats.Max == 0, "old frames roll out of the window");
+
+    T->Reset();
+    T->GetStageStats(bakge::FRAME_STAGE_FRAME, &Stats);
+    Check(Stats.NumSamples == 0 && T->GetNumFrames() == 0, "reset");
+
+    delete T;
+}
+
+
+void TestHitches()
+{
+    FrameTimer* T;
+
+    T = FrameTimer::Create();
+    if(T == NULL)
+        return;
+
+    Check(T->SetHitchFactor(0.5) == BGE_FAILURE, "hitch factor below one");
+    Check(T->SetTargetFrameRate(500) == BGE_SUCCESS, "set frame rate");
+
+    for(int i = 0; i < 30; ++i)
+        RunFrame(T, MS / 2);
+
+    Check(T->GetNumHitches() == 0, "steady frames aren't hitches");
+
+    RunFrame(T, 12 * MS);
+    RunFrame(T, MS / 2);
+
+    Check(T->GetNumHitches() == 1, "long frame is a hitch");
+    Check(T->GetLastHitchFrame() == 30, "hitch frame index");
+    Check(T->GetLastHitchTime() >= 12 * MS, "hitch length");
+
+    delete T;
+}
+
+
+void TestPacing()
+{
+    FrameTimer* T;
+    FrameStageStats Frame;
+    FrameStageStats Pacing;
+
+    T = FrameTimer::Create();
+    if(T == NULL)
+        return;
+
+    Check(T->SetTargetFrameRate(-1) == BGE_FAILURE, "negative frame rate");
+    Check(T->SetTargetFrameRate(200) == BGE_SUCCESS, "set frame rate");
+    Check(fabs(T->GetTargetFrameRate() - 200) < 0.01, "get frame rate");
+
+    for(int i = 0; i < 51; ++i)
+        RunFrame(T, 1 * MS);
+
+    T->GetStageStats(bakge::FRAME_STAGE_FRAME, &Frame);
+    T->GetStageStats(bakge::FRAME_STAGE_PACING, &Pacing);
+
+    printf("Paced to 5 ms: frame mean %.3f p50 %.3f p99 %.3f max %.3f ms, "
+                "pacing mean %.3f ms\n", Frame.Mean / 1e6, Frame.P50 / 1e6,
+                Frame.P99 / 1e6, Frame.Max / 1e6, Pacing.Mean / 1e6);
+
+    Check(llabs(Frame.P50 - 5 * MS) < MS / 10, "frames last the period");
+    Check(Pacing.P50 > 3 * MS, "time left over is spent pacing");
+
+    /* An overrun isn't made up by rushing the frames after it */
+    T->Reset();
+    RunFrame(T, 8 * MS);
+    for(int i = 0; i < 4; ++i)
+        RunFrame(T, 1 * MS);
+
+    T->GetStageStats(bakge::FRAME_STAGE_FRAME, &Frame);
+    Check(Frame.Max >= 8 * MS, "overrun frame recorded");
+    Check(Frame.P50 >= 5 * MS - MS / 10, "frames after an overrun paced");
+
+    /* Unpaced frames don't wait */
+    T->SetTargetFrameRate(0);
+    T->Reset();
+    for(int i = 0; i < 5; ++i)
+        RunFrame(T, MS / 2);
+
+    T->GetStageStats(bakge::FRAME_STAGE_PACING, &Pacing);
+    Check(Pacing.Max == 0, "unpaced frames don't wait");
+
+    T->Report();
+
+    delete T;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    TestNames();
+    TestPercentiles();
+    TestHitches();
+    TestPacing();
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All frame timer checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,304 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <bakge/Bakge.h>
+
+using bakge::JobScheduler;
+using bakge::JobCounter;
+
+#define NUM_COUNT_JOBS 10000
+#define CHAIN_LENGTH 64
+#define NUM_ELEMENTS 2000000
+#define NUM_NESTED 16
+#define NUM_FOREIGN_JOBS 1000
+
+int NumFailures = 0;
+
+std::atomic<int> Counted;
+
+float Elements[NUM_ELEMENTS];
+double Sums[NUM_ELEMENTS / 64 + 1];
+
+int ChainOrder[CHAIN_LENGTH];
+std::atomic<int> ChainNext;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+void CountJob(void*)
+{
+    Counted.fetch_add(1);
+}
+
+
+void ChainJob(void* Data)
+{
+    ChainOrder[ChainNext.fetch_add(1)] = (int)(size_t)Data;
+}
+
+
+/* Enough work per element to be worth spreading out */
+float Work(int i)
+{
+    return sqrtf((float)i) * sinf((float)i * 0.001f);
+}
+
+
+void FillRange(int Begin, int End, void*)
+{
+    for(int i = Begin; i < End; ++i)
+        Elements[i] = Work(i);
+}
+
+
+/* One partial sum per 64 elements, so results don't depend on splitting */
+void SumRange(int Begin, int End, void*)
+{
+    for(int i = Begin; i < End; ++i) {
+        double Sum = 0;
+        int Last = (i + 1) * 64;
+
+        if(Last > NUM_ELEMENTS)
+            Last = NUM_ELEMENTS;
+
+        for(int j = i * 64; j < Last; ++j)
+            Sum += Elements[j];
+
+        Sums[i] = Sum;
+    }
+}
+
+
+void NestedJob(void* Data)
+{
+    JobScheduler* S = (JobScheduler*)Data;
+    JobCounter Inner;
+
+    /* Waiting from inside a job runs other jobs meanwhile */
+    for(int i = 0; i < 8; ++i)
+        S->Run(CountJob, NULL, &Inner);
+    S->Wait(&Inner);
+}
+
+
+struct ForeignData
+{
+    JobScheduler* Scheduler;
+    JobCounter* Counter;
+};
+
+
+int ForeignThread(void* Data)
+{
+    ForeignData* Foreign = (ForeignData*)Data;
+
+    for(int i = 0; i < NUM_FOREIGN_JOBS; ++i)
+        Foreign->Scheduler->Run(CountJob, NULL, Foreign->Counter);
+
+    return 0;
+}
+
+
+double SerialSum()
+{
+    double Sum = 0;
+
+    FillRange(0, NUM_ELEMENTS, NULL);
+    for(int i = 0; i < NUM_ELEMENTS; ++i)
+        Sum += Elements[i];
+
+    return Sum;
+}
+
+
+double ParallelSum(JobScheduler* S)
+{
+    int NumSums = (NUM_ELEMENTS + 63) / 64;
+    double Sum = 0;
+
+    S->ParallelFor(0, NUM_ELEMENTS, 0, FillRange, NULL);
+    S->ParallelFor(0, NumSums, 0, SumRange, NULL);
+    for(int i = 0; i < NumSums; ++i)
+        Sum += Sums[i];
+
+    return Sum;
+}
+
+
+/* The usual alternative: a new thread for each piece of work */
+int ThreadPerChunk(void* Data)
+{
+    int Chunk = (int)(size_t)Data;
+    int Size = NUM_ELEMENTS / 8;
+
+    FillRange(Chunk * Size, Chunk == 7 ? NUM_ELEMENTS : (Chunk + 1) * Size,
+                                                                    NULL);
+
+    return 0;
+}
+
+
+void Exercise(JobScheduler* S)
+{
+    bakge::Microseconds Start, Elapsed;
+    JobCounter Counter;
+    JobCounter Links[CHAIN_LENGTH];
+    double Serial, Parallel;
+    bool InOrder;
+
+    printf("%d workers\n", S->GetNumWorkers());
+
+    Check(S->GetWorkerIndex() == -1, "main thread has no worker index");
+
+    /* Lots of small independent jobs */
+    Counted.store(0);
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_COUNT_JOBS; ++i)
+        S->Run(CountJob, NULL, &Counter);
+    S->Wait(&Counter);
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("  Ran %d jobs in %.2f ms\n", NUM_COUNT_JOBS, Elapsed / 1000.0);
+    Check(Counted.load() == NUM_COUNT_JOBS, "every job ran");
+    Check(Counter.IsDone(), "counter reaches zero");
+
+    /* Each link waits on the one before */
+    ChainNext.store(0);
+    S->Run(ChainJob, (void*)(size_t)0, &Links[0]);
+    for(int i = 1; i < CHAIN_LENGTH; ++i)
+        S->RunAfter(&Links[i - 1], ChainJob, (void*)(size_t)i, &Links[i]);
+    S->Wait(&Links[CHAIN_LENGTH - 1]);
+
+    InOrder = ChainNext.load() == CHAIN_LENGTH;
+    for(int i = 0; i < CHAIN_LENGTH && InOrder; ++i)
+        InOrder = ChainOrder[i] == i;
+    Check(InOrder, "dependent jobs run in order");
+
+    /* Jobs that queue and wait on jobs of their own */
+    Counted.store(0);
+    for(int i = 0; i < NUM_NESTED; ++i)
+        S->Run(NestedJob, S, &Counter);
+    S->Wait(&Counter);
+    Check(Counted.load() == NUM_NESTED * 8, "nested jobs all ran");
+
+    /* ParallelFor gives the same answer as a plain loop */
+    Start = bakge::GetRunningTime();
+    Serial = SerialSum();
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("  Serial loop      %.2f ms\n", Elapsed / 1000.0);
+
+    Start = bakge::GetRunningTime();
+    Parallel = ParallelSum(S);
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("  ParallelFor      %.2f ms\n", Elapsed / 1000.0);
+
+    Check(fabs(Serial - Parallel) <= fabs(Serial) * 1e-9,
+                                    "ParallelFor matches serial loop");
+}
+
+
+int main(int argc, char* argv[])
+{
+    JobScheduler* S;
+    JobCounter Counter;
+    ForeignData Foreign;
+    bakge::Thread* Threads[8];
+    bakge::Microseconds Start, Elapsed;
+
+    bakge::Init(argc, argv);
+
+    printf("%d processors\n", bakge::GetNumProcessors());
+
+    /* Jobs only run while the main thread waits */
+    S = JobScheduler::Create(0);
+    Check(S != NULL, "create scheduler without workers");
+    if(S != NULL) {
+        Exercise(S);
+        delete S;
+    }
+
+    S = JobScheduler::Create(3);
+    Check(S != NULL, "create scheduler with workers");
+    if(S != NULL) {
+        Exercise(S);
+        delete S;
+    }
+
+    S = JobScheduler::Create();
+    Check(S != NULL, "create default scheduler");
+    if(S == NULL)
+        goto CLEANUP;
+
+    Exercise(S);
+
+    /* Other threads can queue work too */
+    Counted.store(0);
+    Foreign.Scheduler = S;
+    Foreign.Counter = &Counter;
+
+    /* Join the threads first so every job is counted before Wait */
+    for(int i = 0; i < 4; ++i)
+        Threads[i] = bakge::Thread::Create(ForeignThread, &Foreign);
+    for(int i = 0; i < 4; ++i) {
+        if(Threads[i] != NULL)
+            delete Threads[i];
+    }
+    S->Wait(&Counter);
+    Check(Counted.load() == NUM_FOREIGN_JOBS * 4, "jobs from other threads");
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < 8; ++i)
+        Threads[i] = bakge::Thread::Create(ThreadPerChunk, (void*)(size_t)i);
+    for(int i = 0; i < 8; ++i) {
+        if(Threads[i] != NULL)
+            delete Threads[i];
+    }
+    Elapsed = bakge::GetRunningTime() - Start;
+    printf("  Thread per chunk %.2f ms\n", Elapsed / 1000.0);
+
+    delete S;
+
+
+CLEANUP:
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -26,6 +26,48 @@
 #include <stdlib.h>
 #include <bakge/Bakge.h>
 
+/* Push/pop pairs to time, done in bursts like a per-frame event queue */
+#define NUM_PAIRS 10000000
+#define BURST_SIZE 64
+
+typedef bakge::LinkedList<int> PooledList;
+typedef bakge::LinkedList<int, bakge::HeapAllocator<bakge::SingleNode<int> > >
+                                                                HeapList;
+
+int NumFailures = 0;
+
+
+void Check(bool Passed, const char* What)
+{
+    if (!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+template<class List>
+double TimePushPop(List* L)
+{
+    bakge::Microseconds Start, Elapsed;
+    int Sum = 0;
+
+    Start = bakge::GetRunningTime();
+    for (int i = 0; i < NUM_PAIRS / BURST_SIZE; i++) {
+        for (int j = 0; j < BURST_SIZE; j++)
+            L->Append(j);
+        for (int j = 0; j < BURST_SIZE; j++)
+            Sum += L->Pop();
+    }
+    Elapsed = bakge::GetRunningTime() - Start;
+
+    Check(Sum == NUM_PAIRS / BURST_SIZE * (BURST_SIZE * (BURST_SIZE - 1) / 2),
+                                            "benchmark pops what it pushed");
+
+    return Elapsed / 1000.0;
+}
+
+
 int main(int argc, char* argv[])
 {
     printf("Checking linked list as a stack\n");
@@ -45,5 +87,53 @@ int main(int argc, char* argv[])
     }
     printf("\n");
 
+    printf("Checking linked list as a queue\n");
+
+    PooledList Queue;
+    bakge::SingleNode<int>* Node;
+    int Expected;
+
+    for (int i = 0; i < 100; i++)
+        Queue.Append(i);
+    Queue.Push(-1);
+    Check(Queue.GetSize() == 101, "size counts every value");
+    Check(Queue.GetLast()->GetData() == 99, "append adds to the back");
+
+    /* Walk the list without changing it */
+    Expected = -1;
+    for (Node = Queue.GetFirst(); Node != NULL; Node = Node->GetNext()) {
+        if (Node->GetData() != Expected)
+            break;
+        Expected++;
+    }
+    Check(Node == NULL && Expected == 100, "iterate in order");
+
+    Expected = -1;
+    while (!Queue.IsEmpty() && Queue.Pop() == Expected)
+        Expected++;
+    Check(Expected == 100 && Queue.GetSize() == 0, "pop in append order");
+    Check(Queue.GetFirst() == NULL && Queue.GetLast() == NULL,
+                                                "empty list has no nodes");
+
+    /* Appending after emptying must start over from the front */
+    Queue.Append(7);
+    Queue.Append(8);
+    Queue.Clear();
+    Queue.Append(9);
+    Check(Queue.GetFirst() == Queue.GetLast() && Queue.Pop() == 9,
+                                            "append after clear");
+
+    HeapList HeapQueue;
+    PooledList PoolQueue;
+
+    printf("%d push/pop pairs\n", NUM_PAIRS);
+    printf("  new/delete per node %7.1f ms\n", TimePushPop(&HeapQueue));
+    printf("  Pooled nodes        %7.1f ms\n", TimePushPop(&PoolQueue));
+
+    if (NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
     return 0;
 }
@@ -0,0 +1,402 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <bakge/Bakge.h>
+
+using bakge::Mutex;
+using bakge::RecursiveMutex;
+using bakge::ReaderWriterLock;
+using bakge::ConditionVariable;
+using bakge::SpinLock;
+using bakge::AdaptiveMutex;
+using bakge::ScopedLock;
+using bakge::ScopedSharedLock;
+
+#define MAX_THREADS 64
+#define NUM_OPERATIONS 200000
+#define NUM_HANDOFFS 1000
+#define READ_PERCENT 90
+
+int NumFailures = 0;
+
+/* What the benchmark threads fight over */
+bakge::api::Mutex* Contested;
+ReaderWriterLock* ContestedShared;
+int Counter;
+int Values[16];
+
+std::atomic<int> NumReady;
+std::atomic<int> ReadSum;
+std::atomic<bool> Go;
+
+/* For trying a lock from another thread */
+bakge::api::Mutex* TryTarget;
+ReaderWriterLock* TrySharedTarget;
+bool TryResult;
+
+/* Single slot passed between threads by Handoff */
+Mutex* SlotLock;
+ConditionVariable* SlotChanged;
+int Slot;
+bool SlotFull;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+int TryLockThread(void*)
+{
+    TryResult = TryTarget->TryLock();
+    if(TryResult)
+        TryTarget->Unlock();
+
+    return 0;
+}
+
+
+int TryLockSharedThread(void*)
+{
+    TryResult = TrySharedTarget->TryLockShared();
+    if(TryResult)
+        TrySharedTarget->UnlockShared();
+
+    return 0;
+}
+
+
+/* TryLock from a fresh thread, since some locks let their holder back in */
+bool TryFromOtherThread(bakge::api::Mutex* Target)
+{
+    TryTarget = Target;
+    delete bakge::Thread::Create(TryLockThread, NULL);
+
+    return TryResult;
+}
+
+
+bool TrySharedFromOtherThread(ReaderWriterLock* Target)
+{
+    TrySharedTarget = Target;
+    delete bakge::Thread::Create(TryLockSharedThread, NULL);
+
+    return TryResult;
+}
+
+
+int Producer(void*)
+{
+    for(int i = 1; i <= NUM_HANDOFFS; ++i) {
+        SlotLock->Lock();
+        while(SlotFull)
+            SlotChanged->Wait(SlotLock);
+
+        Slot = i;
+        SlotFull = true;
+        SlotChanged->Broadcast();
+        SlotLock->Unlock();
+    }
+
+    return 0;
+}
+
+
+void CheckLocks()
+{
+    Mutex* M = Mutex::Create();
+    RecursiveMutex* R = RecursiveMutex::Create();
+    ReaderWriterLock* RW = ReaderWriterLock::Create();
+    SpinLock* S = SpinLock::Create();
+    AdaptiveMutex* A = AdaptiveMutex::Create();
+    bakge::Thread* Thr;
+    bakge::Microseconds Start, Elapsed;
+    int Sum;
+
+    Check(M != NULL && R != NULL && RW != NULL && S != NULL && A != NULL,
+                                                        "create locks");
+
+    M->Lock();
+    Check(!TryFromOtherThread(M), "mutex excludes other threads");
+    M->Unlock();
+    Check(TryFromOtherThread(M), "mutex free after unlock");
+
+    R->Lock();
+    R->Lock();
+    Check(R->TryLock(), "recursive mutex lets its holder back in");
+    R->Unlock();
+    R->Unlock();
+    Check(!TryFromOtherThread(R), "recursive mutex held until last unlock");
+    R->Unlock();
+    Check(TryFromOtherThread(R), "recursive mutex free after last unlock");
+
+    RW->LockShared();
+    Check(TrySharedFromOtherThread(RW), "readers share the lock");
+    Check(!TryFromOtherThread(RW), "readers exclude writers");
+    RW->UnlockShared();
+    RW->Lock();
+    Check(!TrySharedFromOtherThread(RW), "writers exclude readers");
+    RW->Unlock();
+    Check(TryFromOtherThread(RW), "reader-writer lock free after unlock");
+
+    S->Lock();
+    Check(!S->TryLock(), "spin lock can't be taken twice");
+    Check(!TryFromOtherThread(S), "spin lock excludes other threads");
+    S->Unlock();
+    Check(TryFromOtherThread(S), "spin lock free after unlock");
+
+    A->Lock();
+    Check(!TryFromOtherThread(A), "adaptive mutex excludes other threads");
+    A->Unlock();
+    Check(TryFromOtherThread(A), "adaptive mutex free after unlock");
+
+    {
+        ScopedLock<Mutex> Guard(M);
+        Check(!TryFromOtherThread(M), "scoped lock holds mutex");
+    }
+    Check(TryFromOtherThread(M), "scoped lock releases mutex");
+
+    {
+        ScopedSharedLock<ReaderWriterLock> Guard(RW);
+        Check(!TryFromOtherThread(RW), "scoped shared lock holds lock");
+    }
+    Check(TryFromOtherThread(RW), "scoped shared lock releases lock");
+
+    /* Pass values one at a time between two threads */
+    SlotLock = M;
+    SlotChanged = ConditionVariable::Create();
+    Check(SlotChanged != NULL, "create condition variable");
+    SlotFull = false;
+    Sum = 0;
+
+    Thr = bakge::Thread::Create(Producer, NULL);
+    for(int i = 0; i < NUM_HANDOFFS; ++i) {
+        M->Lock();
+        while(!SlotFull)
+            SlotChanged->Wait(M);
+
+        Sum += Slot;
+        SlotFull = false;
+        SlotChanged->Broadcast();
+        M->Unlock();
+    }
+    delete Thr;
+    Check(Sum == NUM_HANDOFFS * (NUM_HANDOFFS + 1) / 2,
+                                        "condition variable handoff");
+
+    M->Lock();
+    Start = bakge::GetRunningTime();
+    Check(!SlotChanged->WaitFor(M, 10000), "wait times out");
+    Elapsed = bakge::GetRunningTime() - Start;
+    M->Unlock();
+    Check(Elapsed >= 9000, "wait lasts until its timeout");
+
+#ifdef _DEBUG
+    bakge::LockStats Stats = M->GetStats();
+    Check(Stats.NumAcquired >= NUM_HANDOFFS, "mutex counts acquires");
+#endif /* _DEBUG */
+
+    delete SlotChanged;
+    delete A;
+    delete S;
+    delete RW;
+    delete R;
+    delete M;
+}
+
+
+void WaitForStart()
+{
+    NumReady.fetch_add(1);
+    while(!Go.load())
+        std::this_thread::yield();
+}
+
+
+int LockWorker(void* Data)
+{
+    int NumOps = (int)(size_t)Data;
+
+    WaitForStart();
+
+    for(int i = 0; i < NumOps; ++i) {
+        Contested->Lock();
+        ++Counter;
+        Values[Counter & 15] += Counter;
+        Contested->Unlock();
+    }
+
+    return 0;
+}
+
+
+int ReadMostlyWorker(void* Data)
+{
+    int NumOps = (int)(size_t)Data;
+    unsigned int Seed = (unsigned int)(size_t)&NumOps;
+    int Sum = 0;
+
+    WaitForStart();
+
+    for(int i = 0; i < NumOps; ++i) {
+        Seed = Seed * 1103515245 + 12345;
+        if((Seed >> 16) % 100 < READ_PERCENT) {
+            ContestedShared->LockShared();
+            for(int j = 0; j < 16; ++j)
+                Sum += Values[j];
+            ContestedShared->UnlockShared();
+        } else {
+            ContestedShared->Lock();
+            ++Counter;
+            Values[Counter & 15] += Counter;
+            ContestedShared->Unlock();
+        }
+    }
+
+    /* So the reads aren't optimized away */
+    ReadSum.fetch_add(Sum);
+
+    return 0;
+}
+
+
+/* Nanoseconds per operation with NumThreads threads sharing the work */
+double Benchmark(int (*Worker)(void*), int NumThreads)
+{
+    bakge::Thread* Threads[MAX_THREADS];
+    bakge::Microseconds Start, Elapsed;
+    int PerThread = NUM_OPERATIONS / NumThreads;
+
+    Counter = 0;
+    NumReady.store(0);
+    Go.store(false);
+
+    for(int i = 0; i < NumThreads; ++i)
+        Threads[i] = bakge::Thread::Create(Worker, (void*)(size_t)PerThread);
+
+    /* Don't count the time taken to start threads */
+    while(NumReady.load() < NumThreads)
+        std::this_thread::yield();
+
+    Start = bakge::GetRunningTime();
+    Go.store(true);
+    for(int i = 0; i < NumThreads; ++i)
+        delete Threads[i];
+    Elapsed = bakge::GetRunningTime() - Start;
+
+    return Elapsed * 1000.0 / (PerThread * NumThreads);
+}
+
+
+void BenchmarkLock(const char* Name, bakge::api::Mutex* Lock)
+{
+    Contested = Lock;
+
+    printf("%-17s", Name);
+    for(int NumThreads = 2; NumThreads <= MAX_THREADS; NumThreads *= 2) {
+#ifdef _DEBUG
+        Lock->ResetStats();
+#endif /* _DEBUG */
+        printf(" %6.1f", Benchmark(LockWorker, NumThreads));
+        fflush(stdout);
+        if(Counter != NUM_OPERATIONS / NumThreads * NumThreads) {
+            printf("\nFAILED: %s lost updates\n", Name);
+            ++NumFailures;
+        }
+    }
+
+#ifdef _DEBUG
+    /* Stats from the last run, with the most threads */
+    bakge::LockStats Stats = Lock->GetStats();
+    printf("   %4.1f%% contended, hold %.0f ns mean %llu ns max",
+            Stats.NumContended * 100.0 / Stats.NumAcquired,
+            (double)Stats.HoldTime / Stats.NumAcquired,
+            (unsigned long long)Stats.MaxHoldTime);
+#endif /* _DEBUG */
+
+    printf("\n");
+}
+
+
+int main(int argc, char* argv[])
+{
+    Mutex* M;
+    RecursiveMutex* R;
+    ReaderWriterLock* RW;
+    SpinLock* S;
+    AdaptiveMutex* A;
+
+    bakge::Init(argc, argv);
+
+    CheckLocks();
+
+    M = Mutex::Create();
+    R = RecursiveMutex::Create();
+    RW = ReaderWriterLock::Create();
+    S = SpinLock::Create();
+    A = AdaptiveMutex::Create();
+
+    printf("\n%d processors, ns per lock and unlock with N threads\n",
+                                                bakge::GetNumProcessors());
+    printf("%-17s", "");
+    for(int NumThreads = 2; NumThreads <= MAX_THREADS; NumThreads *= 2)
+        printf(" %6d", NumThreads);
+    printf("\n");
+
+    BenchmarkLock("Mutex", M);
+    BenchmarkLock("RecursiveMutex", R);
+    BenchmarkLock("SpinLock", S);
+    BenchmarkLock("AdaptiveMutex", A);
+    BenchmarkLock("ReaderWriterLock", RW);
+
+    ContestedShared = RW;
+    printf("%-17s", "  90% reads");
+    for(int NumThreads = 2; NumThreads <= MAX_THREADS; NumThreads *= 2)
+        printf(" %6.1f", Benchmark(ReadMostlyWorker, NumThreads));
+    printf("\n");
+
+    delete A;
+    delete S;
+    delete RW;
+    delete R;
+    delete M;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
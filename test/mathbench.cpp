@@ -0,0 +1,327 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+
+#define NUM_VECTORS 1024
+#define NUM_MATRICES 256
+#define NUM_ROUNDS 4000
+
+Scalar Lefts[NUM_VECTORS][4];
+Scalar Rights[NUM_VECTORS][4];
+Scalar Outs[NUM_VECTORS][4];
+Scalar RefOuts[NUM_VECTORS][4];
+
+Scalar MatLefts[NUM_MATRICES][16];
+Scalar MatRights[NUM_MATRICES][16];
+Scalar MatOuts[NUM_MATRICES][16];
+Scalar MatRefOuts[NUM_MATRICES][16];
+
+/* Keeps the compiler from discarding results of the timed loops */
+volatile Scalar Sink;
+
+int NumMismatches = 0;
+
+
+Scalar RandomScalar()
+{
+    return (Scalar)(rand() % 2000 - 1000) / 100.0f;
+}
+
+
+double NanosecondsPerOp(bakge::Microseconds Elapsed, int NumOps)
+{
+    return (double)Elapsed * 1000.0 / (double)NumOps;
+}
+
+
+void Report(const char* Name, double RefNs, double SIMDNs, bool Match)
+{
+    printf("%-16s %8.3f ns/op %8.3f ns/op %7.2fx  %s\n", Name, RefNs, SIMDNs,
+                        RefNs / SIMDNs, Match ? "match" : "MISMATCH");
+
+    if(!Match)
+        ++NumMismatches;
+}
+
+
+template<void (*Kernel)(const Scalar*, const Scalar*, Scalar*)>
+double TimeBinary(Scalar (*Out)[4])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_VECTORS; ++j)
+            Kernel(Lefts[j], Rights[j], Out[j]);
+        Sink = Out[i % NUM_VECTORS][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_VECTORS);
+}
+
+
+template<void (*Ref)(const Scalar*, const Scalar*, Scalar*),
+         void (*SIMD)(const Scalar*, const Scalar*, Scalar*)>
+void BenchBinary(const char* Name)
+{
+    double RefNs = TimeBinary<Ref>(RefOuts);
+    double SIMDNs = TimeBinary<SIMD>(Outs);
+
+    Report(Name, RefNs, SIMDNs, memcmp(Outs, RefOuts, sizeof(Outs)) == 0);
+}
+
+
+template<void (*Kernel)(const Scalar*, Scalar, Scalar*)>
+double TimeScale(Scalar (*Out)[4])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_VECTORS; ++j)
+            Kernel(Lefts[j], Rights[j][0], Out[j]);
+        Sink = Out[i % NUM_VECTORS][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_VECTORS);
+}
+
+
+template<void (*Kernel)(const Scalar*, Scalar*)>
+double TimeUnary(Scalar (*Out)[4])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_VECTORS; ++j)
+            Kernel(Lefts[j], Out[j]);
+        Sink = Out[i % NUM_VECTORS][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_VECTORS);
+}
+
+
+template<Scalar (*Kernel)(const Scalar*, const Scalar*)>
+double TimeDot(Scalar (*Out)[4])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_VECTORS; ++j)
+            Out[j][0] = Kernel(Lefts[j], Rights[j]);
+        Sink = Out[i % NUM_VECTORS][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_VECTORS);
+}
+
+
+/* Kernels that don't promise bit-identical results are checked loosely */
+bool NearlyEqual(const Scalar* A, const Scalar* B, int Num)
+{
+    for(int i = 0; i < Num; ++i) {
+        if(fabs(A[i] - B[i]) > 0.001f * (fabs(B[i]) + 1.0f))
+            return false;
+    }
+
+    return true;
+}
+
+
+template<void (*Kernel)(const Scalar*, const Scalar*, Scalar*)>
+double TimeMatrix(Scalar (*Out)[16])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_MATRICES; ++j)
+            Kernel(MatLefts[j], MatRights[j], Out[j]);
+        Sink = Out[i % NUM_MATRICES][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_MATRICES);
+}
+
+
+template<void (*Kernel)(const Scalar*, Scalar*)>
+double TimeMatrixUnary(Scalar (*In)[16], Scalar (*Out)[16])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_MATRICES; ++j)
+            Kernel(In[j], Out[j]);
+        Sink = Out[i % NUM_MATRICES][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_MATRICES);
+}
+
+
+template<Scalar (*Kernel)(const Scalar*, Scalar*)>
+double TimeInverse(Scalar (*In)[16], Scalar (*Out)[16])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        for(int j = 0; j < NUM_MATRICES; ++j)
+            Kernel(In[j], Out[j]);
+        Sink = Out[i % NUM_MATRICES][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_MATRICES);
+}
+
+
+/* Reported per transformed vector */
+template<void (*Kernel)(const Scalar*, const Scalar*, Scalar*, size_t)>
+double TimeTransform(Scalar (*Out)[4])
+{
+    bakge::Microseconds Start = bakge::GetRunningTime();
+
+    for(int i = 0; i < NUM_ROUNDS; ++i) {
+        Kernel(MatLefts[i % NUM_MATRICES], Lefts[0], Out[0], NUM_VECTORS);
+        Sink = Out[i % NUM_VECTORS][0];
+    }
+
+    return NanosecondsPerOp(bakge::GetRunningTime() - Start,
+                                        NUM_ROUNDS * NUM_VECTORS);
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    srand(1234);
+
+    for(int i = 0; i < NUM_VECTORS; ++i) {
+        for(int j = 0; j < 4; ++j) {
+            Lefts[i][j] = RandomScalar();
+            Rights[i][j] = RandomScalar();
+        }
+    }
+
+    for(int i = 0; i < NUM_MATRICES; ++i) {
+        for(int j = 0; j < 16; ++j) {
+            MatLefts[i][j] = RandomScalar();
+            MatRights[i][j] = RandomScalar();
+        }
+
+        /* Right-hand matrices double as affine transforms */
+        MatRights[i][3] = MatRights[i][7] = MatRights[i][11] = 0;
+        MatRights[i][15] = 1;
+    }
+
+    printf("Math kernel benchmark (%s)\n", BGE_SIMD_NAME);
+    printf("%-16s %14s %14s %8s\n", "Kernel", "Scalar", "SIMD", "Speedup");
+
+    BenchBinary<bakge::Vec4AddRef, bakge::Vec4Add>("Add");
+    BenchBinary<bakge::Vec4SubRef, bakge::Vec4Sub>("Sub");
+    BenchBinary<bakge::Vec4AddXYZRef, bakge::Vec4AddXYZ>("AddXYZ");
+    BenchBinary<bakge::Vec4SubXYZRef, bakge::Vec4SubXYZ>("SubXYZ");
+    BenchBinary<bakge::Vec4Cross3Ref, bakge::Vec4Cross3>("Cross");
+
+    {
+        double RefNs = TimeScale<bakge::Vec4ScaleXYZRef>(RefOuts);
+        double SIMDNs = TimeScale<bakge::Vec4ScaleXYZ>(Outs);
+        Report("ScaleXYZ", RefNs, SIMDNs,
+                        memcmp(Outs, RefOuts, sizeof(Outs)) == 0);
+    }
+
+    {
+        double RefNs = TimeDot<bakge::Vec4Dot3Ref>(RefOuts);
+        double SIMDNs = TimeDot<bakge::Vec4Dot3>(Outs);
+        Report("Dot", RefNs, SIMDNs,
+                        memcmp(Outs, RefOuts, sizeof(Outs)) == 0);
+    }
+
+    {
+        double RefNs = TimeUnary<bakge::Vec4NormalizeXYZRef>(RefOuts);
+        double SIMDNs = TimeUnary<bakge::Vec4NormalizeXYZ>(Outs);
+        Report("Normalize", RefNs, SIMDNs,
+                        memcmp(Outs, RefOuts, sizeof(Outs)) == 0);
+    }
+
+    {
+        double RefNs = TimeMatrix<bakge::Mat4MultiplyRef>(MatRefOuts);
+        double SIMDNs = TimeMatrix<bakge::Mat4Multiply>(MatOuts);
+        Report("MatrixMultiply", RefNs, SIMDNs,
+                    memcmp(MatOuts, MatRefOuts, sizeof(MatOuts)) == 0);
+    }
+
+    {
+        double RefNs = TimeMatrixUnary<bakge::Mat4TransposeRef>(MatLefts,
+                                                            MatRefOuts);
+        double SIMDNs = TimeMatrixUnary<bakge::Mat4Transpose>(MatLefts,
+                                                                MatOuts);
+        Report("Transpose", RefNs, SIMDNs,
+                    memcmp(MatOuts, MatRefOuts, sizeof(MatOuts)) == 0);
+    }
+
+    {
+        double RefNs = TimeInverse<bakge::Mat4InverseRef>(MatLefts,
+                                                        MatRefOuts);
+        double SIMDNs = TimeInverse<bakge::Mat4Inverse>(MatLefts, MatOuts);
+        Report("Inverse", RefNs, SIMDNs, NearlyEqual(MatOuts[0],
+                            MatRefOuts[0], NUM_MATRICES * 16));
+    }
+
+    {
+        double RefNs = TimeInverse<bakge::Mat4InverseAffineRef>(MatRights,
+                                                                MatRefOuts);
+        double SIMDNs = TimeInverse<bakge::Mat4InverseAffine>(MatRights,
+                                                                MatOuts);
+        Report("InverseAffine", RefNs, SIMDNs, NearlyEqual(MatOuts[0],
+                                MatRefOuts[0], NUM_MATRICES * 16));
+    }
+
+    {
+        double RefNs = TimeTransform<bakge::Mat4TransformVec4sRef>(RefOuts);
+        double SIMDNs = TimeTransform<bakge::Mat4TransformVec4s>(Outs);
+        Report("TransformPoints", RefNs, SIMDNs,
+                        memcmp(Outs, RefOuts, sizeof(Outs)) == 0);
+    }
+
+    bakge::Deinit();
+
+    if(NumMismatches > 0) {
+        printf("%d kernels disagree with the scalar reference\n",
+                                                    NumMismatches);
+        return 1;
+    }
+
+    return 0;
+}
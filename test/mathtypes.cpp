@@ -0,0 +1,156 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <type_traits>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Vector3;
+using bakge::Vector4;
+using bakge::Quaternion;
+using bakge::Matrix;
+using bakge::Transform;
+using bakge::DualQuaternion;
+using bakge::BoundingBox;
+using bakge::BoundingSphere;
+using bakge::Frustum;
+
+/* *
+ * Compile-time checks. If any of these fail the math types can no longer
+ * be memcpy'd into GL buffers or built as compile-time constants.
+ * */
+#define BGE_ASSERT_VALUE_TYPE(T) \
+    static_assert(std::is_trivially_copyable<T>::value, \
+                            #T " must be trivially copyable"); \
+    static_assert(std::is_trivially_destructible<T>::value, \
+                            #T " must be trivially destructible"); \
+    static_assert(std::is_standard_layout<T>::value, \
+                            #T " must be standard layout"); \
+    static_assert(std::is_nothrow_copy_constructible<T>::value, \
+                            #T " must copy without throwing")
+
+BGE_ASSERT_VALUE_TYPE(Vector3);
+BGE_ASSERT_VALUE_TYPE(Vector4);
+BGE_ASSERT_VALUE_TYPE(Quaternion);
+BGE_ASSERT_VALUE_TYPE(Matrix);
+BGE_ASSERT_VALUE_TYPE(Transform);
+BGE_ASSERT_VALUE_TYPE(DualQuaternion);
+BGE_ASSERT_VALUE_TYPE(BoundingBox);
+BGE_ASSERT_VALUE_TYPE(BoundingSphere);
+BGE_ASSERT_VALUE_TYPE(Frustum);
+
+/* No padding or hidden members, so arrays match GL's tightly packed layout */
+static_assert(sizeof(Vector3) == sizeof(Scalar) * 3, "Vector3 is padded");
+static_assert(sizeof(Vector4) == sizeof(Scalar) * 4, "Vector4 is padded");
+static_assert(sizeof(Quaternion) == sizeof(Scalar) * 5,
+                                            "Quaternion is padded");
+static_assert(sizeof(Matrix) == sizeof(Scalar) * 16, "Matrix is padded");
+static_assert(sizeof(Transform) == sizeof(Scalar) * 12, "Transform is padded");
+static_assert(sizeof(DualQuaternion) == sizeof(Scalar) * 8,
+                                        "DualQuaternion is padded");
+static_assert(sizeof(BoundingBox) == sizeof(Scalar) * 8,
+                                        "BoundingBox is padded");
+static_assert(sizeof(BoundingSphere) == sizeof(Scalar) * 4,
+                                        "BoundingSphere is padded");
+static_assert(sizeof(Vector4[8]) == sizeof(Scalar) * 32,
+                                        "Vector4 arrays are padded");
+
+/* Constructors are usable in constant expressions */
+constexpr Vector4 Origin;
+constexpr Vector4 Up(0, 1, 0, 0);
+constexpr Vector3 Forward(0, 0, -1);
+constexpr Matrix Identity;
+constexpr Matrix Translation(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 3, 4, 5, 1);
+constexpr Quaternion NoRotation;
+constexpr Transform NoTransform;
+constexpr DualQuaternion NoDualTransform;
+constexpr BoundingBox NoBox;
+constexpr BoundingSphere NoSphere;
+
+static_assert(Origin[0] == 0 && Origin[1] == 0 && Origin[2] == 0
+                        && Origin[3] == 1, "Vector4 default isn't Origin");
+static_assert(Up[1] == 1 && Up[3] == 0, "Vector4 constructor is wrong");
+static_assert(Forward[2] == -1, "Vector3 constructor is wrong");
+static_assert(Identity[0] == 1 && Identity[1] == 0 && Identity[5] == 1
+                    && Identity[10] == 1 && Identity[15] == 1
+                    && Identity[12] == 0, "Matrix default isn't Identity");
+static_assert(Translation[12] == 3 && Translation[13] == 4
+            && Translation[14] == 5, "Matrix constructor isn't column-major");
+static_assert(NoBox.GetMin()[0] > NoBox.GetMax()[0]
+                    && NoSphere.GetRadius() < 0, "Default bounds aren't empty");
+
+
+int main(int argc, char* argv[])
+{
+    Matrix Buffer[2];
+    Vector4 Points[3];
+    Scalar Raw[12];
+    int NumFailures = 0;
+
+    bakge::Init(argc, argv);
+
+    /* The library's constants must agree with the constexpr defaults */
+    if(memcmp(&Matrix::Identity, &Identity, sizeof(Matrix)) != 0) {
+        printf("Matrix::Identity isn't the identity matrix\n");
+        ++NumFailures;
+    }
+
+    if(memcmp(&Vector4::Origin, &Origin, sizeof(Vector4)) != 0) {
+        printf("Vector4::Origin isn't (0, 0, 0, 1)\n");
+        ++NumFailures;
+    }
+
+    /* Raw copies round trip */
+    memcpy(&Buffer[0], &Translation, sizeof(Matrix));
+    Buffer[1] = Buffer[0];
+    if(!(Buffer[1][12] == 3 && Buffer[1][15] == 1)) {
+        printf("Matrix didn't survive memcpy\n");
+        ++NumFailures;
+    }
+
+    for(int i = 0; i < 12; ++i)
+        Raw[i] = (Scalar)i;
+
+    memcpy(Points, Raw, sizeof(Raw));
+    if(!(Points[1][0] == 4 && Points[2][3] == 11)) {
+        printf("Vector4 array isn't tightly packed\n");
+        ++NumFailures;
+    }
+
+    if(!(NoRotation.ToMatrix() * Up == Up)) {
+        printf("Default Quaternion isn't the identity rotation\n");
+        ++NumFailures;
+    }
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    printf("Math types are trivially copyable value types\n");
+
+    return 0;
+}
@@ -60,6 +60,30 @@ int main(int argc, char* argv[])
     printf("\n");
     PrintMatrix(M);
 
+    /* A matrix times its inverse should give the identity */
+    printf("\nLook At times its inverse:\n");
+    PrintMatrix(M * M.Inverted());
+
+    printf("\nLook At times its affine inverse:\n");
+    PrintMatrix(M * M.InvertedAffine());
+
+    printf("\nTransposed Look At:\n");
+    PrintMatrix(M.Transposed());
+
+    /* Transform points in place, then back through the inverse */
+    bakge::Vector4 Points[3];
+    Points[0] = bakge::Point(1, 0, 0);
+    Points[1] = bakge::Point(0, 1, 0);
+    Points[2] = bakge::Vector(0, 0, 1);
+
+    M.TransformPoints(Points, Points, 3);
+    M.Inverted().TransformPoints(Points, Points, 3);
+
+    printf("\nPoints transformed there and back:\n");
+    for(int i = 0; i < 3; ++i)
+        printf("[ %03.2f %03.2f %03.2f %03.2f ]\n", Points[i][0],
+                            Points[i][1], Points[i][2], Points[i][3]);
+
     bakge::Deinit();
 
     return 0;
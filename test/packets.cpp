@@ -0,0 +1,296 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Packet;
+
+#define SENDER_PORT 7200
+#define RECEIVER_PORT 7201
+
+/* Packets in flight at once; few enough that loopback never drops any */
+#define BATCH_SIZE 32
+
+#define DEFAULT_PACKETS 1000000
+
+int NumFailures = 0;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+void TestPacket()
+{
+    Packet* P;
+    Packet* Shared;
+    int Value;
+    double Real;
+    bakge::Byte Big[BGE_PACKET_CAPACITY + 1];
+
+    Check(Packet::Create(NULL, 4) == NULL, "no data to copy is refused");
+
+    P = Packet::Create(NULL, 0);
+    Check(P != NULL && P->GetSize() == 0, "nothing to copy is fine");
+    delete P;
+    Check(Packet::Create(Big, sizeof(Big)) == NULL,
+                                    "data over capacity is refused");
+
+    P = Packet::Create();
+    if(P == NULL) {
+        Check(false, "create packet");
+        return;
+    }
+
+    Check(P->GetSize() == 0 && P->GetRemaining() == 0, "new packet empty");
+
+    Check(P->WriteValue(42) == BGE_SUCCESS, "write int");
+    Check(P->WriteValue(2.5) == BGE_SUCCESS, "write double");
+    Check(P->GetSize() == sizeof(int) + sizeof(double), "size follows writes");
+
+    Check(P->ReadValue(&Value) == BGE_SUCCESS && Value == 42, "read int");
+    Check(P->ReadValue(&Real) == BGE_SUCCESS && Real == 2.5, "read double");
+    Check(P->ReadValue(&Value) == BGE_FAILURE, "read past the end fails");
+
+    Check(P->Seek(0) == BGE_SUCCESS && P->GetRemaining() == P->GetSize(),
+                                                            "rewind");
+    Check(P->Seek(P->GetSize() + 1) == BGE_FAILURE, "seek past the end");
+
+    /* Sharing doesn't copy until someone writes */
+    Shared = P->Share();
+    Check(Shared != NULL, "share packet");
+    if(Shared != NULL) {
+        Check(P->GetNumReferences() == 2, "shared payload counted twice");
+        Check(Shared->GetData() == P->GetData(), "sharing doesn't copy");
+        Check(Shared->GetReadPosition() == 0, "shared cursor starts over");
+
+        Check(Shared->WriteValue(7) == BGE_SUCCESS, "write shared packet");
+        Check(Shared->GetData() != P->GetData(), "write copies payload");
+        Check(P->GetNumReferences() == 1, "writer let go of payload");
+        Check(P->GetSize() == sizeof(int) + sizeof(double),
+                                        "original packet unchanged");
+
+        Shared->Seek(0);
+        Check(Shared->ReadValue(&Value) == BGE_SUCCESS && Value == 42,
+                                        "copy keeps the old payload");
+
+        delete Shared;
+    }
+
+    P->Clear();
+    Check(P->GetSize() == 0 && P->GetReadPosition() == 0, "clear");
+
+    memset((void*)Big, 7, sizeof(Big));
+    Check(P->Write(Big, BGE_PACKET_CAPACITY) == BGE_SUCCESS, "fill packet");
+    Check(P->Write(Big, 1) == BGE_FAILURE, "write past capacity fails");
+    Check(P->SetSize(BGE_PACKET_CAPACITY + 1) == BGE_FAILURE,
+                                        "size past capacity refused");
+
+    delete P;
+}
+
+
+/* Sends packets numbered 0 to NumPackets - 1 over loopback */
+void TestLoopback(int NumPackets)
+{
+    bakge::Socket* Sender;
+    bakge::Socket* Receiver;
+    bakge::Remote Destination;
+    Packet* Out;
+    Packet* Received;
+    bakge::Nanoseconds Start;
+    bakge::Nanoseconds Elapsed;
+    int Capacity;
+    int Sequence;
+    int Count;
+    int Number;
+    bool InOrder = true;
+    bool FromSender = true;
+    bool Delivered = true;
+
+    Sender = bakge::Socket::Create(SENDER_PORT);
+    Receiver = bakge::Socket::Create(RECEIVER_PORT);
+    if(Sender == NULL || Receiver == NULL) {
+        Check(false, "create loopback sockets");
+        return;
+    }
+
+    Destination.SetAddress(127, 0, 0, 1);
+    Destination.SetPort(RECEIVER_PORT);
+
+    Capacity = Packet::GetPool().GetCapacity();
+    Start = bakge::GetRunningNanoseconds();
+
+    for(Sequence = 0; Sequence < NumPackets && Delivered;) {
+        Count = NumPackets - Sequence;
+        if(Count > BATCH_SIZE)
+            Count = BATCH_SIZE;
+
+        for(int i = 0; i < Count; ++i) {
+            Out = Packet::Create();
+            Out->WriteValue(Sequence + i);
+            if(Sender->Send(&Destination, Out) != BGE_SUCCESS)
+                Delivered = false;
+            delete Out;
+        }
+
+        for(int i = 0; i < Count && Delivered; ++i) {
+            Received = Receiver->Receive();
+            if(Received == NULL) {
+                Delivered = false;
+                break;
+            }
+
+            if(Received->ReadValue(&Number) != BGE_SUCCESS
+                                        || Number != Sequence + i)
+                InOrder = false;
+
+            if(Received->GetSender().GetPort() != SENDER_PORT
+                    || Received->GetSender().GetAddress() != 0x7F000001)
+                FromSender = false;
+
+            delete Received;
+        }
+
+        Sequence += Count;
+    }
+
+    Elapsed = bakge::GetRunningNanoseconds() - Start;
+
+    Check(Delivered, "every packet sent and received");
+    Check(InOrder, "packets arrive intact and in order");
+    Check(FromSender, "sender reported as the sending socket");
+    Check(Packet::GetPool().GetCapacity() == Capacity,
+                            "no packet memory allocated after warmup");
+
+    printf("%d packets over loopback in %.3f s: %.0f packets/s\n",
+                Sequence, Elapsed / 1e9, Sequence / (Elapsed / 1e9));
+
+    delete Sender;
+    delete Receiver;
+}
+
+
+#ifndef _WIN32
+
+/* *
+ * Sends a datagram too big for a packet ahead of one that fits, from a
+ * plain OS socket since bakge sockets won't send one. Both receive
+ * calls should skip the big one rather than hand it over cut short.
+ * */
+void TestOversized(bool Batched)
+{
+    bakge::Socket* Receiver;
+    Packet* In[2];
+    struct sockaddr_in Destination;
+    char Big[BGE_PACKET_CAPACITY * 2];
+    char Small[4] = { 1, 2, 3, 4 };
+    int Handle;
+    int Received;
+
+    Receiver = bakge::Socket::Create(RECEIVER_PORT);
+    Handle = socket(AF_INET, SOCK_DGRAM, 0);
+    if(Receiver == NULL || Handle < 0) {
+        Check(false, "create oversized test sockets");
+        if(Handle >= 0)
+            close(Handle);
+        delete Receiver;
+        return;
+    }
+
+    memset((void*)&Destination, 0, sizeof(Destination));
+    Destination.sin_family = AF_INET;
+    Destination.sin_port = htons(RECEIVER_PORT);
+    Destination.sin_addr.s_addr = htonl(0x7F000001);
+
+    memset((void*)Big, 9, sizeof(Big));
+    sendto(Handle, Big, sizeof(Big), 0, (struct sockaddr*)&Destination,
+                                                    sizeof(Destination));
+    sendto(Handle, Small, sizeof(Small), 0,
+                (struct sockaddr*)&Destination, sizeof(Destination));
+
+    if(Batched) {
+        /* The big one may be dropped in a call of its own */
+        do {
+            Received = Receiver->ReceiveMany(In, 2);
+        } while(Received == 0);
+    } else {
+        In[0] = Receiver->Receive();
+        Received = In[0] == NULL ? -1 : 1;
+    }
+
+    Check(Received == 1, Batched ? "batch skips oversized datagram"
+                                    : "receive skips oversized datagram");
+    if(Received == 1) {
+        Check(In[0]->GetSize() == sizeof(Small) && memcmp(
+                    In[0]->GetData(), Small, sizeof(Small)) == 0,
+                    "datagram after the oversized one arrives intact");
+        delete In[0];
+    }
+
+    close(Handle);
+    delete Receiver;
+}
+
+#endif /* _WIN32 */
+
+
+int main(int argc, char* argv[])
+{
+    int NumPackets = DEFAULT_PACKETS;
+
+    if(argc > 1)
+        NumPackets = atoi(argv[1]);
+
+    bakge::Init(argc, argv);
+
+    TestPacket();
+
+#ifndef _WIN32
+    TestOversized(false);
+    TestOversized(true);
+#endif /* _WIN32 */
+
+    /* Warm the pools so the loopback run allocates nothing new */
+    Packet::GetPool().Reserve(BATCH_SIZE * 2);
+    TestLoopback(NumPackets);
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All packet checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,329 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::BlockPool;
+using bakge::ObjectPool;
+
+#define NUM_ENTITIES 10000
+#define NUM_WAVES 1000
+#define NUM_THREADS 4
+
+int NumFailures = 0;
+
+/* Keeps results alive so benchmarks aren't optimized away */
+volatile long long Sink;
+std::atomic<long long> ThreadSink;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+double Milliseconds(bakge::Microseconds Start)
+{
+    return (bakge::GetRunningTime() - Start) / 1000.0;
+}
+
+
+/* About the size of a scene node */
+struct Entity
+{
+    Entity()
+    {
+        ++NumConstructed;
+    }
+
+    virtual ~Entity()
+    {
+        ++NumDestructed;
+    }
+
+    float Position[4];
+    float Rotation[4];
+    int Flags;
+
+    /* Per thread, so benchmark threads don't share them */
+    static thread_local int NumConstructed;
+    static thread_local int NumDestructed;
+};
+
+thread_local int Entity::NumConstructed = 0;
+thread_local int Entity::NumDestructed = 0;
+
+
+/* Allocated with new and delete, but from a pool */
+struct PooledEntity : public Entity
+{
+    BGE_POOLED_DECLARE
+};
+
+BGE_POOLED_DEFINE(PooledEntity, false, bakge::MEMORY_TAG_GENERAL)
+
+
+struct CachedEntity : public Entity
+{
+    BGE_POOLED_DECLARE
+};
+
+BGE_POOLED_DEFINE(CachedEntity, true, bakge::MEMORY_TAG_GENERAL)
+
+
+/* Bigger than its base, so it can't use the base's pool */
+struct BiggerEntity : public PooledEntity
+{
+    double Extra[8];
+};
+
+
+void CheckBlockPool()
+{
+    BlockPool Pool("Aligned", 24, 32, false);
+    void* Blocks[100];
+    void* First;
+    bool Aligned = true;
+    bool Distinct = true;
+
+    for(int i = 0; i < 100; ++i) {
+        Blocks[i] = Pool.Allocate();
+        Aligned = Aligned && ((size_t)Blocks[i] & 31) == 0;
+        if(i > 0)
+            Distinct = Distinct && Blocks[i] != Blocks[i - 1];
+    }
+
+    Check(Aligned, "pool blocks are aligned");
+    Check(Distinct, "pool blocks are distinct");
+    Check(Pool.GetNumLive() == 100, "pool counts live blocks");
+    Check(Pool.GetCapacity() >= 100, "pool grows to fit");
+    Check(BlockPool::ReportLeaks() == 1, "unfreed blocks are reported");
+
+    First = Blocks[99];
+    for(int i = 0; i < 100; ++i)
+        Pool.Free(Blocks[i]);
+
+    Check(Pool.GetNumLive() == 0, "pool counts freed blocks");
+    Check(Pool.Allocate() == First, "pool reuses the last freed block");
+    Pool.Free(First);
+    Check(BlockPool::ReportLeaks() == 0, "freed pools aren't reported");
+
+    Pool.Reserve(5000);
+    Check(Pool.GetCapacity() >= 5000, "reserve grows the pool");
+}
+
+
+void CheckObjectPool()
+{
+    ObjectPool<Entity> Pool("Entity");
+    Entity* E;
+
+    Entity::NumConstructed = 0;
+    Entity::NumDestructed = 0;
+
+    E = Pool.Create();
+    E->Flags = 7;
+    Check(Entity::NumConstructed == 1, "object pool constructs");
+    Check(Pool.GetNumLive() == 1, "object pool counts objects");
+
+    Pool.Destroy(E);
+    Check(Entity::NumDestructed == 1, "object pool destructs");
+    Check(Pool.GetNumLive() == 0, "object pool frees");
+}
+
+
+void CheckPooledClasses()
+{
+    PooledEntity* P;
+    Entity* B;
+
+    Entity::NumConstructed = 0;
+    Entity::NumDestructed = 0;
+
+    P = new PooledEntity;
+    Check(PooledEntity::GetPool().GetNumLive() == 1,
+                                        "new draws from the class pool");
+    delete P;
+    Check(PooledEntity::GetPool().GetNumLive() == 0,
+                                        "delete returns to the class pool");
+
+    /* Deleted through a base pointer, so the size comes from ~Entity */
+    B = new BiggerEntity;
+    Check(PooledEntity::GetPool().GetNumLive() == 0,
+                                        "bigger subclasses use the heap");
+    delete B;
+    Check(PooledEntity::GetPool().GetNumLive() == 0,
+                                        "bigger subclasses free to the heap");
+
+    Check(Entity::NumConstructed == 2 && Entity::NumDestructed == 2,
+                                "pooled classes construct and destruct");
+}
+
+
+int CrossThreadFree(void* Data)
+{
+    CachedEntity** Entities = (CachedEntity**)Data;
+
+    for(int i = 0; i < NUM_ENTITIES; ++i)
+        delete Entities[i];
+
+    return 0;
+}
+
+
+void CheckThreadCaches()
+{
+    CachedEntity** Entities = new CachedEntity*[NUM_ENTITIES];
+
+    for(int i = 0; i < NUM_ENTITIES; ++i)
+        Entities[i] = new CachedEntity;
+
+    Check(CachedEntity::GetPool().GetNumLive() == NUM_ENTITIES,
+                                        "cached pool counts live objects");
+
+    /* Freed by another thread, whose cache hands them back as it exits */
+    delete bakge::Thread::Create(CrossThreadFree, (void*)Entities);
+    Check(CachedEntity::GetPool().GetNumLive() == 0,
+                                "objects can be freed on another thread");
+
+    for(int i = 0; i < NUM_ENTITIES; ++i)
+        Entities[i] = new CachedEntity;
+
+    Check(CachedEntity::GetPool().GetCapacity() < NUM_ENTITIES * 2,
+                                "blocks freed on other threads are reused");
+
+    for(int i = 0; i < NUM_ENTITIES; ++i)
+        delete Entities[i];
+
+    delete[] Entities;
+}
+
+
+/* Spawns and despawns waves of entities */
+template<class T>
+long long Churn(int NumWaves)
+{
+    T* Entities[NUM_ENTITIES / 10];
+    long long Sum = 0;
+
+    for(int w = 0; w < NumWaves; ++w) {
+        for(int i = 0; i < NUM_ENTITIES / 10; ++i) {
+            Entities[i] = new T;
+            Entities[i]->Flags = i;
+        }
+
+        for(int i = 0; i < NUM_ENTITIES / 10; ++i) {
+            Sum += Entities[i]->Flags;
+            delete Entities[i];
+        }
+    }
+
+    return Sum;
+}
+
+
+template<class T>
+int ChurnWorker(void* Data)
+{
+    ThreadSink.fetch_add(Churn<T>((int)(size_t)Data));
+
+    return 0;
+}
+
+
+template<class T>
+void BenchmarkThreads(const char* Name)
+{
+    bakge::Thread* Threads[NUM_THREADS];
+    bakge::Microseconds Start;
+    int Waves = NUM_WAVES * 10 / NUM_THREADS;
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_THREADS; ++i)
+        Threads[i] = bakge::Thread::Create(ChurnWorker<T>,
+                                                (void*)(size_t)Waves);
+
+    for(int i = 0; i < NUM_THREADS; ++i)
+        delete Threads[i];
+
+    printf("  %-20s %8.1f ms\n", Name, Milliseconds(Start));
+}
+
+
+void Benchmark()
+{
+    bakge::Microseconds Start;
+
+    printf("%d waves of %d entities, one thread\n", NUM_WAVES * 10,
+                                                    NUM_ENTITIES / 10);
+
+    Start = bakge::GetRunningTime();
+    Sink = Churn<Entity>(NUM_WAVES * 10);
+    printf("  %-20s %8.1f ms\n", "new/delete", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    Sink = Churn<PooledEntity>(NUM_WAVES * 10);
+    printf("  %-20s %8.1f ms\n", "pool", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    Sink = Churn<CachedEntity>(NUM_WAVES * 10);
+    printf("  %-20s %8.1f ms\n", "pool, thread cache", Milliseconds(Start));
+
+    printf("The same waves split across %d threads\n", NUM_THREADS);
+    BenchmarkThreads<Entity>("new/delete");
+    BenchmarkThreads<PooledEntity>("pool");
+    BenchmarkThreads<CachedEntity>("pool, thread cache");
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    CheckBlockPool();
+    CheckObjectPool();
+    CheckPooledClasses();
+    CheckThreadCaches();
+
+    Benchmark();
+
+    Check(BlockPool::ReportLeaks() == 0, "nothing leaked");
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::ProfileZone;
+
+#define TRACE_PATH "profiler_trace.json"
+#define NUM_ZONES 50000
+#define NUM_ROUNDS 20
+#define NUM_THREADS 3
+#define ZONES_PER_THREAD 1000
+
+int NumFailures = 0;
+
+/* Keeps results alive so benchmarks aren't optimized away */
+volatile long long Sink;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+/* Counts occurrences of Pattern in the file at Path */
+int CountInFile(const char* Path, const char* Pattern)
+{
+    FILE* In = fopen(Path, "r");
+    char Line[512];
+    const char* At;
+    int Count = 0;
+
+    if(In == NULL)
+        return -1;
+
+    while(fgets(Line, sizeof(Line), In) != NULL) {
+        for(At = strstr(Line, Pattern); At != NULL;
+                                At = strstr(At + 1, Pattern))
+            ++Count;
+    }
+
+    fclose(In);
+
+    return Count;
+}
+
+
+void Work(int Amount)
+{
+    long long Sum = 0;
+
+    for(int i = 0; i < Amount; ++i)
+        Sum += i * i;
+
+    Sink = Sum;
+}
+
+
+int ThreadWork(void*)
+{
+    bakge::SetProfileThreadName("Worker \"quoted\"");
+
+    for(int i = 0; i < ZONES_PER_THREAD; ++i) {
+        ProfileZone Zone("ThreadWork");
+        Work(10);
+    }
+
+    return 0;
+}
+
+
+void CheckProfiler()
+{
+    bakge::Thread* Threads[NUM_THREADS];
+
+    /* Zones are free while the profiler is off */
+    {
+        ProfileZone Zone("Ignored");
+    }
+
+    bakge::StartProfiling();
+    bakge::SetProfileThreadName("Main");
+
+    {
+        ProfileZone Frame("Frame");
+
+        for(int i = 0; i < 3; ++i) {
+            ProfileZone Update("Update");
+            Work(1000);
+
+            {
+                ProfileZone Inner("Physics");
+                Work(1000);
+            }
+        }
+    }
+
+    for(int i = 0; i < NUM_THREADS; ++i)
+        Threads[i] = bakge::Thread::Create(ThreadWork, NULL);
+
+    for(int i = 0; i < NUM_THREADS; ++i)
+        delete Threads[i];
+
+    bakge::StopProfiling();
+
+    /* Zones after stopping aren't recorded either */
+    {
+        ProfileZone Zone("Ignored");
+    }
+
+    bakge::ReportProfile();
+
+    Check(bakge::WriteChromeTrace(TRACE_PATH) == BGE_SUCCESS,
+                                                "trace is written");
+    Check(CountInFile(TRACE_PATH, "\"ph\":\"X\"")
+                    == 7 + NUM_THREADS * ZONES_PER_THREAD,
+                                        "trace holds every zone");
+    Check(CountInFile(TRACE_PATH, "Ignored") == 0,
+                            "zones outside the profile aren't recorded");
+    Check(CountInFile(TRACE_PATH, "\"name\":\"Main\"") == 1,
+                                        "threads are named");
+    Check(CountInFile(TRACE_PATH, "Worker \\\"quoted\\\"") >= 1,
+                                        "names are escaped");
+
+    /* Restarting clears the last profile */
+    bakge::StartProfiling();
+    bakge::StopProfiling();
+    bakge::WriteChromeTrace(TRACE_PATH);
+    Check(CountInFile(TRACE_PATH, "\"ph\":\"X\"") == 0,
+                                        "starting clears old zones");
+
+    /* A full buffer drops zones rather than growing */
+    bakge::StartProfiling();
+    for(int i = 0; i < BGE_PROFILE_EVENTS_PER_THREAD + 10; ++i) {
+        ProfileZone Zone("Flood");
+    }
+    bakge::StopProfiling();
+    bakge::WriteChromeTrace(TRACE_PATH);
+    Check(CountInFile(TRACE_PATH, "\"ph\":\"X\"")
+                == BGE_PROFILE_EVENTS_PER_THREAD, "full buffers drop zones");
+
+    remove(TRACE_PATH);
+}
+
+
+void Benchmark()
+{
+    bakge::Microseconds Start, Elapsed = 0;
+    double Off, On;
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_ZONES * NUM_ROUNDS; ++i) {
+        ProfileZone Zone("Off");
+    }
+    Off = (bakge::GetRunningTime() - Start) * 1000.0
+                                        / (NUM_ZONES * NUM_ROUNDS);
+
+    /* Rounds fit in the event buffer; clearing between them isn't timed */
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        bakge::StartProfiling();
+
+        Start = bakge::GetRunningTime();
+        for(int i = 0; i < NUM_ZONES; ++i) {
+            ProfileZone Zone("On");
+        }
+        Elapsed += bakge::GetRunningTime() - Start;
+
+        bakge::StopProfiling();
+    }
+    On = Elapsed * 1000.0 / (NUM_ZONES * NUM_ROUNDS);
+
+    /* Not a check, since timings vary from machine to machine */
+    printf("Zone overhead: %.1f ns profiling, %.1f ns not profiling%s\n",
+                    On, Off, On > 50.0 ? " (over the 50ns budget)" : "");
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    CheckProfiler();
+    Benchmark();
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
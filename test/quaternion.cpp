@@ -26,15 +26,203 @@
 #include <stdlib.h>
 #include <bakge/Bakge.h>
 
+using bakge::Scalar;
+using bakge::Vector4;
+using bakge::Quaternion;
+
+#define NUM_OBJECTS 4096
+#define NUM_ROUNDS 500
+
+Quaternion Rotations[NUM_OBJECTS];
+Vector4 Facings[NUM_OBJECTS];
+Vector4 MatrixOuts[NUM_OBJECTS];
+Vector4 RotateOuts[NUM_OBJECTS];
+
+/* Keeps the compiler from discarding results of the timed loops */
+volatile Scalar Sink;
+
+int NumFailures = 0;
+
+
+Scalar RandomScalar()
+{
+    return (Scalar)(rand() % 2000 - 1000) / 100.0f;
+}
+
+
+void Check(const char* Name, bool Passed)
+{
+    printf("%-36s %s\n", Name, Passed ? "ok" : "FAILED");
+
+    if(!Passed)
+        ++NumFailures;
+}
+
+
+Scalar MaxError(const Vector4* A, const Vector4* B, int Num)
+{
+    Scalar Max = 0;
+
+    for(int i = 0; i < Num; ++i) {
+        for(int c = 0; c < 4; ++c) {
+            Scalar Err = fabsf(A[i][c] - B[i][c]);
+            if(Err > Max)
+                Max = Err;
+        }
+    }
+
+    return Max;
+}
+
+
+bool NearlyEqual(Quaternion BGE_NCP A, Quaternion BGE_NCP B)
+{
+    Vector4 Probe = bakge::Vector(1, 2, 3);
+    Vector4 RotatedA = A.Rotate(Probe);
+    Vector4 RotatedB = B.Rotate(Probe);
+
+    return MaxError(&RotatedA, &RotatedB, 1) < 1e-4f;
+}
+
+
+double NanosecondsPerVector(bakge::Microseconds Elapsed)
+{
+    return (double)Elapsed * 1000.0 / (double)(NUM_ROUNDS * NUM_OBJECTS);
+}
+
+
 int main(int argc, char* argv[])
 {
+    bakge::Microseconds Start;
+    double MatrixNs, RotateNs;
+
     bakge::Init(argc, argv);
 
-    bakge::Quaternion Q;
+    srand(0);
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        Rotations[i] = Quaternion::FromEulerAngles(RandomScalar(),
+                                    RandomScalar(), RandomScalar());
+        Facings[i] = bakge::Vector(RandomScalar(), RandomScalar(),
+                                                    RandomScalar());
+    }
+
+    /* Rotate agrees with the matrix path */
+    for(int i = 0; i < NUM_OBJECTS; ++i) {
+        MatrixOuts[i] = Rotations[i].ToMatrix() * Facings[i];
+        RotateOuts[i] = Rotations[i].Rotate(Facings[i]);
+    }
+
+    Check("Rotate matches ToMatrix",
+            MaxError(MatrixOuts, RotateOuts, NUM_OBJECTS) < 1e-3f);
+
+    /* RotateMany agrees with Rotate exactly, in place too */
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        MatrixOuts[i] = Rotations[7].Rotate(Facings[i]);
+
+    Rotations[7].RotateMany(Facings, RotateOuts, NUM_OBJECTS - 1);
+    RotateOuts[NUM_OBJECTS - 1] = MatrixOuts[NUM_OBJECTS - 1];
+    Check("RotateMany matches Rotate",
+            memcmp(MatrixOuts, RotateOuts, sizeof(RotateOuts)) == 0);
+
+    memcpy(RotateOuts, Facings, sizeof(RotateOuts));
+    Rotations[7].RotateMany(RotateOuts, RotateOuts, NUM_OBJECTS);
+    Check("RotateMany in place",
+            memcmp(MatrixOuts, RotateOuts, sizeof(RotateOuts)) == 0);
+
+    /* Per-object RotateMany agrees with Rotate exactly, and overlapping */
+    for(int i = 0; i < NUM_OBJECTS; ++i)
+        MatrixOuts[i] = Rotations[i].Rotate(Facings[i]);
+
+    Quaternion::RotateMany(Rotations, Facings, RotateOuts, NUM_OBJECTS);
+    Check("Per-object RotateMany",
+            memcmp(MatrixOuts, RotateOuts, sizeof(RotateOuts)) == 0);
 
-    /* Test some operations */
+    memcpy(RotateOuts + 1, Facings, sizeof(Vector4) * (NUM_OBJECTS - 1));
+    Quaternion::RotateMany(Rotations, RotateOuts + 1, RotateOuts,
+                                                    NUM_OBJECTS - 1);
+    Check("Per-object RotateMany overlapping", memcmp(MatrixOuts,
+            RotateOuts, sizeof(Vector4) * (NUM_OBJECTS - 1)) == 0);
+
+    memcpy(RotateOuts, Facings, sizeof(Vector4) * (NUM_OBJECTS - 1));
+    Quaternion::RotateMany(Rotations, RotateOuts, RotateOuts + 1,
+                                                    NUM_OBJECTS - 1);
+    Check("Per-object RotateMany trailing", memcmp(MatrixOuts,
+            RotateOuts + 1, sizeof(Vector4) * (NUM_OBJECTS - 1)) == 0);
+
+    /* Interpolation */
+    {
+        Vector4 Up = bakge::Vector(0, 1, 0);
+        Quaternion From;
+        Quaternion To = Quaternion::FromAxisAndAngle(Up, 1.5707963f);
+        Quaternion Half = Quaternion::FromAxisAndAngle(Up, 0.7853982f);
+
+        Check("Slerp endpoints",
+                NearlyEqual(Quaternion::Slerp(From, To, 0), From)
+                && NearlyEqual(Quaternion::Slerp(From, To, 1), To));
+        Check("Slerp midpoint",
+                NearlyEqual(Quaternion::Slerp(From, To, 0.5f), Half));
+        Check("Slerp takes the shorter arc",
+                NearlyEqual(Quaternion::Slerp(From, -To, 0.5f), Half));
+        Check("Nlerp midpoint",
+                NearlyEqual(Quaternion::Nlerp(From, To, 0.5f), Half));
+        Check("Nlerp is unit length", fabsf(Quaternion::Nlerp(From,
+                            Rotations[3], 0.3f).Length() - 1) < 1e-5f);
+    }
+
+    /* One rotation per object, as when animating Pawn facings */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_OBJECTS; ++i)
+            MatrixOuts[i] = Rotations[i].ToMatrix() * Facings[i];
+        Sink = MatrixOuts[r][0];
+    }
+    MatrixNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_OBJECTS; ++i)
+            RotateOuts[i] = Rotations[i].Rotate(Facings[i]);
+        Sink = RotateOuts[r][0];
+    }
+    RotateNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    printf("\nPer object  ToMatrix * Vec   %8.3f ns  Rotate     %8.3f ns"
+                    "  %5.2fx\n", MatrixNs, RotateNs, MatrixNs / RotateNs);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Quaternion::RotateMany(Rotations, Facings, RotateOuts, NUM_OBJECTS);
+        Sink = RotateOuts[r][0];
+    }
+    RotateNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    printf("Per object  ToMatrix * Vec   %8.3f ns  RotateMany %8.3f ns"
+                    "  %5.2fx\n", MatrixNs, RotateNs, MatrixNs / RotateNs);
+
+    /* One rotation applied to many vectors */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Rotations[r % NUM_OBJECTS].ToMatrix().TransformPoints(Facings,
+                                                MatrixOuts, NUM_OBJECTS);
+        Sink = MatrixOuts[r][0];
+    }
+    MatrixNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Rotations[r % NUM_OBJECTS].RotateMany(Facings, RotateOuts,
+                                                        NUM_OBJECTS);
+        Sink = RotateOuts[r][0];
+    }
+    RotateNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    printf("One for all ToMatrix + Points %8.3f ns  RotateMany %8.3f ns"
+                    "  %5.2fx\n", MatrixNs, RotateNs, MatrixNs / RotateNs);
 
     bakge::Deinit();
 
+    if(NumFailures > 0)
+        return 1;
+
     return 0;
 }
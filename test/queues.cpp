@@ -0,0 +1,265 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <bakge/Bakge.h>
+
+using bakge::SPSCQueue;
+using bakge::MPMCQueue;
+
+#define QUEUE_CAPACITY 1024
+#define NUM_MESSAGES 2000000
+#define NUM_PRODUCERS 4
+#define NUM_CONSUMERS 4
+
+/* MPMC messages carry the producer in the top bits, a sequence below */
+#define PRODUCER_SHIFT 24
+#define SEQUENCE_MASK ((1 << PRODUCER_SHIFT) - 1)
+
+int NumFailures = 0;
+
+SPSCQueue<int>* SingleQueue;
+MPMCQueue<int>* MultiQueue;
+
+std::atomic<int> NumPopped;
+std::atomic<int> NumOutOfOrder;
+
+/* Baseline: what we had before, a list guarded by a lock */
+bakge::Mutex* ListLock;
+bakge::LinkedList<int>* LockedList;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+template<class Queue>
+void CheckSingleThreaded(Queue* Q, const char* Name)
+{
+    int Value;
+    bool InOrder = true;
+    char What[128];
+
+    snprintf(What, sizeof(What), "%s rounds capacity up", Name);
+    Check(Q->GetCapacity() == QUEUE_CAPACITY, What);
+
+    snprintf(What, sizeof(What), "%s pop fails when empty", Name);
+    Check(!Q->Pop(&Value) && Q->IsEmpty(), What);
+
+    /* Go around a few times so indices wrap */
+    for(int Lap = 0; Lap < 3; ++Lap) {
+        for(int i = 0; i < QUEUE_CAPACITY; ++i)
+            Q->Push(i);
+
+        snprintf(What, sizeof(What), "%s push fails when full", Name);
+        Check(!Q->Push(-1) && Q->GetSize() == QUEUE_CAPACITY, What);
+
+        for(int i = 0; i < QUEUE_CAPACITY; ++i) {
+            if(!Q->Pop(&Value) || Value != i)
+                InOrder = false;
+        }
+    }
+
+    snprintf(What, sizeof(What), "%s pops in push order", Name);
+    Check(InOrder && Q->IsEmpty(), What);
+}
+
+
+int SingleProducer(void*)
+{
+    for(int i = 0; i < NUM_MESSAGES; ++i) {
+        while(!SingleQueue->Push(i))
+            std::this_thread::yield();
+    }
+
+    return 0;
+}
+
+
+int MultiProducer(void* Data)
+{
+    int Producer = (int)(size_t)Data;
+    int NumMessages = NUM_MESSAGES / NUM_PRODUCERS;
+
+    for(int i = 0; i < NumMessages; ++i) {
+        while(!MultiQueue->Push((Producer << PRODUCER_SHIFT) | i))
+            std::this_thread::yield();
+    }
+
+    return 0;
+}
+
+
+int MultiConsumer(void*)
+{
+    int Last[NUM_PRODUCERS];
+    int Total = NUM_MESSAGES / NUM_PRODUCERS * NUM_PRODUCERS;
+    int Message;
+
+    for(int i = 0; i < NUM_PRODUCERS; ++i)
+        Last[i] = -1;
+
+    while(NumPopped.load(std::memory_order_relaxed) < Total) {
+        if(!MultiQueue->Pop(&Message)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        /* Each producer's messages must come out in order */
+        int Producer = Message >> PRODUCER_SHIFT;
+        int Sequence = Message & SEQUENCE_MASK;
+
+        if(Producer >= NUM_PRODUCERS || Sequence <= Last[Producer])
+            NumOutOfOrder.fetch_add(1);
+        else
+            Last[Producer] = Sequence;
+
+        NumPopped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return 0;
+}
+
+
+int ListProducer(void*)
+{
+    for(int i = 0; i < NUM_MESSAGES; ++i) {
+        ListLock->Lock();
+        LockedList->Push(i);
+        ListLock->Unlock();
+    }
+
+    return 0;
+}
+
+
+double MessagesPerSecond(int NumMessages, bakge::Microseconds Elapsed)
+{
+    return NumMessages / (Elapsed / 1000000.0);
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Thread* Threads[NUM_PRODUCERS + NUM_CONSUMERS];
+    bakge::Microseconds Start, Elapsed;
+    int Value, Expected;
+
+    bakge::Init(argc, argv);
+
+    Check(SPSCQueue<int>::Create(0) == NULL, "reject empty queue");
+
+    SingleQueue = SPSCQueue<int>::Create(QUEUE_CAPACITY - 100);
+    MultiQueue = MPMCQueue<int>::Create(QUEUE_CAPACITY - 100);
+    ListLock = bakge::Mutex::Create();
+    LockedList = new bakge::LinkedList<int>;
+
+    CheckSingleThreaded(SingleQueue, "SPSC");
+    CheckSingleThreaded(MultiQueue, "MPMC");
+
+    /* One producer, the main thread consuming */
+    Expected = 0;
+    Start = bakge::GetRunningTime();
+    Threads[0] = bakge::Thread::Create(SingleProducer, NULL);
+    while(Expected < NUM_MESSAGES) {
+        if(!SingleQueue->Pop(&Value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if(Value != Expected)
+            break;
+
+        ++Expected;
+    }
+    delete Threads[0];
+    Elapsed = bakge::GetRunningTime() - Start;
+    Check(Expected == NUM_MESSAGES, "SPSC messages arrive in order");
+
+    printf("%d processors, millions of messages per second\n",
+                                            bakge::GetNumProcessors());
+    printf("  SPSC 1:1           %6.1f\n",
+                    MessagesPerSecond(NUM_MESSAGES, Elapsed) / 1e6);
+
+    /* Several of each */
+    NumPopped.store(0);
+    NumOutOfOrder.store(0);
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_PRODUCERS; ++i)
+        Threads[i] = bakge::Thread::Create(MultiProducer, (void*)(size_t)i);
+    for(int i = 0; i < NUM_CONSUMERS; ++i)
+        Threads[NUM_PRODUCERS + i] = bakge::Thread::Create(MultiConsumer,
+                                                                NULL);
+    for(int i = 0; i < NUM_PRODUCERS + NUM_CONSUMERS; ++i)
+        delete Threads[i];
+    Elapsed = bakge::GetRunningTime() - Start;
+
+    Check(NumPopped.load() == NUM_MESSAGES / NUM_PRODUCERS * NUM_PRODUCERS
+                        && MultiQueue->IsEmpty(), "MPMC delivers everything");
+    Check(NumOutOfOrder.load() == 0, "MPMC keeps each producer's order");
+
+    printf("  MPMC %d:%d           %6.1f\n", NUM_PRODUCERS, NUM_CONSUMERS,
+                    MessagesPerSecond(NumPopped.load(), Elapsed) / 1e6);
+
+    /* The same one-to-one traffic through a locked list */
+    Expected = 0;
+    Start = bakge::GetRunningTime();
+    Threads[0] = bakge::Thread::Create(ListProducer, NULL);
+    while(Expected < NUM_MESSAGES) {
+        ListLock->Lock();
+        while(!LockedList->IsEmpty()) {
+            LockedList->Pop();
+            ++Expected;
+        }
+        ListLock->Unlock();
+    }
+    delete Threads[0];
+    Elapsed = bakge::GetRunningTime() - Start;
+
+    printf("  Mutex + LinkedList %6.1f\n",
+                    MessagesPerSecond(NUM_MESSAGES, Elapsed) / 1e6);
+
+    delete LockedList;
+    delete ListLock;
+    delete MultiQueue;
+    delete SingleQueue;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,302 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Packet;
+
+#define NUM_SOCKETS 256
+#define WAKE_DELAY 50000
+
+int NumFailures = 0;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+/* Counts and drains packets for sockets added with a callback */
+void OnReadable(bakge::api::Socket* Sock, int Events, void* UserData)
+{
+    Packet* In[BGE_SOCKET_BATCH];
+    int Received;
+
+    if(Events & BGE_SOCKET_READABLE) {
+        Received = Sock->ReceiveMany(In, BGE_SOCKET_BATCH);
+        for(int i = 0; i < Received; ++i)
+            delete In[i];
+
+        *(int*)UserData += Received;
+    }
+}
+
+
+struct RemovalTest
+{
+    bakge::Reactor* R;
+    bakge::Socket* Other;
+    int Calls;
+};
+
+
+/* Removes the other socket of the pair, which may be ready as well */
+void OnRemoveOther(bakge::api::Socket* Sock, int, void* UserData)
+{
+    RemovalTest* Test = (RemovalTest*)UserData;
+
+    ++Test->Calls;
+    Test->R->Remove(Test->Other);
+    Test->R->Remove(Sock);
+}
+
+
+int WakeLater(void* Data)
+{
+    bakge::Delay(WAKE_DELAY);
+    ((bakge::Reactor*)Data)->Wake();
+
+    return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Socket* Sockets[NUM_SOCKETS];
+    bakge::Remote Destinations[NUM_SOCKETS];
+    Packet* Out[NUM_SOCKETS];
+    bakge::SocketEvent Events[BGE_REACTOR_BATCH];
+    bakge::Socket* Sender;
+    bakge::Reactor* R;
+    bakge::Thread* Waker;
+    bakge::Nanoseconds Start;
+    bakge::Nanoseconds Elapsed;
+    Packet* Pack;
+    RemovalTest Pair[2];
+    int CallbackPackets;
+    int PolledPackets;
+    int NumEvents;
+    int Sent;
+    bool Created;
+    bool Reported;
+
+    bakge::Init(argc, argv);
+
+    R = bakge::Reactor::Create();
+    Sender = bakge::Socket::Create(0);
+    if(R == NULL || Sender == NULL) {
+        printf("Unable to create reactor or sender\n");
+        bakge::Deinit();
+        return 1;
+    }
+
+    /* Port 0 lets the system pick free ones */
+    Created = true;
+    for(int i = 0; i < NUM_SOCKETS; ++i) {
+        Sockets[i] = bakge::Socket::Create(0);
+        if(Sockets[i] == NULL || Sockets[i]->SetBlocking(false)
+                                                    != BGE_SUCCESS) {
+            Created = false;
+            break;
+        }
+
+        Destinations[i].SetAddress(127, 0, 0, 1);
+        Destinations[i].SetPort(Sockets[i]->GetPort());
+    }
+
+    if(!Created) {
+        printf("Unable to create %d non-blocking sockets\n", NUM_SOCKETS);
+        bakge::Deinit();
+        return 1;
+    }
+
+    Check(Sockets[0]->IsBlocking() == false, "socket is non-blocking");
+    Check(Sockets[0]->GetPort() > 0, "system picked a port");
+
+    /* Nothing has been sent, so this must not wait */
+    Start = bakge::GetRunningNanoseconds();
+    Pack = Sockets[0]->Receive();
+    Check(Pack == NULL, "non-blocking receive with nothing queued");
+    Check(Sockets[0]->ReceiveMany(Out, 4) == 0,
+                            "non-blocking batch with nothing queued");
+    Check(bakge::GetRunningNanoseconds() - Start < 100000000,
+                                "non-blocking receives return at once");
+
+    /* Half the sockets run callbacks; Poll reports the other half */
+    CallbackPackets = 0;
+    for(int i = 0; i < NUM_SOCKETS; ++i) {
+        if(i % 2 == 0)
+            R->Add(Sockets[i], BGE_SOCKET_READABLE, OnReadable,
+                                                (void*)&CallbackPackets);
+        else
+            R->Add(Sockets[i], BGE_SOCKET_READABLE, NULL, (void*)Sockets[i]);
+    }
+
+    Check(R->GetNumSockets() == NUM_SOCKETS, "every socket added");
+    Check(R->Add(Sockets[0], BGE_SOCKET_READABLE) == BGE_FAILURE,
+                                        "socket can't be added twice");
+
+    Start = bakge::GetRunningNanoseconds();
+    Check(R->Poll(Events, BGE_REACTOR_BATCH, 0) == 0, "quiet poll");
+    Check(bakge::GetRunningNanoseconds() - Start < 100000000,
+                                    "zero timeout returns at once");
+
+    /* One packet to every socket */
+    for(int i = 0; i < NUM_SOCKETS; ++i) {
+        Out[i] = Packet::Create();
+        Out[i]->WriteValue(i);
+    }
+
+    Start = bakge::GetRunningNanoseconds();
+
+    for(Sent = 0; Sent < NUM_SOCKETS; Sent += BGE_SOCKET_BATCH) {
+        if(Sender->SendMany(Destinations + Sent, Out + Sent,
+                            BGE_SOCKET_BATCH) != BGE_SOCKET_BATCH)
+            break;
+    }
+
+    for(int i = 0; i < NUM_SOCKETS; ++i)
+        delete Out[i];
+
+    Check(Sent == NUM_SOCKETS, "a packet sent to every socket");
+
+    /* Ready sockets come back in batches until every one is drained */
+    PolledPackets = 0;
+    Reported = true;
+    while(CallbackPackets + PolledPackets < NUM_SOCKETS) {
+        NumEvents = R->Poll(Events, BGE_REACTOR_BATCH, 1);
+        if(NumEvents < 0)
+            break;
+
+        if(NumEvents == 0 && bakge::GetRunningNanoseconds() - Start
+                                                        > 5000000000LL)
+            break;
+
+        for(int i = 0; i < NumEvents; ++i) {
+            if(Events[i].UserData != (void*)Events[i].Sock
+                        || !(Events[i].Events & BGE_SOCKET_READABLE))
+                Reported = false;
+
+            while((Pack = Events[i].Sock->Receive()) != NULL) {
+                ++PolledPackets;
+                delete Pack;
+            }
+        }
+    }
+
+    Elapsed = bakge::GetRunningNanoseconds() - Start;
+
+    Check(CallbackPackets == NUM_SOCKETS / 2, "callbacks drained half");
+    Check(PolledPackets == NUM_SOCKETS / 2, "events reported other half");
+    Check(Reported, "events carry their socket and user data");
+    Check(R->Poll(Events, BGE_REACTOR_BATCH, 0) == 0,
+                                            "drained sockets are quiet");
+
+    printf("Serviced %d sockets in %.3f ms\n", NUM_SOCKETS,
+                                                    Elapsed / 1e6);
+
+    /* Sockets that are ready to send report it once asked to */
+    Check(R->Modify(Sockets[1], BGE_SOCKET_WRITABLE) == BGE_SUCCESS,
+                                                    "watch for writes");
+    NumEvents = R->Poll(Events, BGE_REACTOR_BATCH, 0);
+    Check(NumEvents == 1 && Events[0].Sock == Sockets[1]
+                && Events[0].Events == BGE_SOCKET_WRITABLE,
+                                        "idle socket is writable");
+    R->Modify(Sockets[1], BGE_SOCKET_READABLE);
+
+    /* Wake cuts a long wait short, from another thread */
+    Start = bakge::GetRunningNanoseconds();
+    Waker = bakge::Thread::Create(WakeLater, (void*)R);
+    Check(Waker != NULL, "waking thread created");
+    Check(R->Poll(Events, BGE_REACTOR_BATCH, 10) == 0, "woken poll");
+    Elapsed = bakge::GetRunningNanoseconds() - Start;
+    Check(Elapsed < 5000000000LL, "wake ends the wait early");
+
+    if(Waker != NULL) {
+        Waker->Wait();
+        delete Waker;
+    }
+
+    /* A wakeup before Poll is kept, and only counts once */
+    R->Wake();
+    R->Wake();
+    Start = bakge::GetRunningNanoseconds();
+    R->Poll(Events, BGE_REACTOR_BATCH, 10);
+    Check(bakge::GetRunningNanoseconds() - Start < 5000000000LL,
+                                        "earlier wake isn't lost");
+    Start = bakge::GetRunningNanoseconds();
+    R->Poll(Events, BGE_REACTOR_BATCH, 0.05);
+    Check(bakge::GetRunningNanoseconds() - Start >= 40000000,
+                                    "timeout waits once woken up");
+
+    /* Two ready sockets that each remove both from the reactor */
+    R->Remove(Sockets[2]);
+    R->Remove(Sockets[4]);
+    for(int i = 0; i < 2; ++i) {
+        Pair[i].R = R;
+        Pair[i].Other = Sockets[i == 0 ? 4 : 2];
+        Pair[i].Calls = 0;
+        R->Add(Sockets[i == 0 ? 2 : 4], BGE_SOCKET_READABLE,
+                                OnRemoveOther, (void*)&Pair[i]);
+    }
+
+    Pack = Packet::Create();
+    Pack->WriteValue(0);
+    Sender->Send(&Destinations[2], Pack);
+    Sender->Send(&Destinations[4], Pack);
+    delete Pack;
+    bakge::Delay(10000);
+
+    R->Poll(Events, BGE_REACTOR_BATCH, 1);
+    Check(Pair[0].Calls + Pair[1].Calls == 1,
+                            "removed socket's callback doesn't run");
+    Check(R->GetNumSockets() == NUM_SOCKETS - 2,
+                                    "callback removed both sockets");
+    Check(R->Remove(Sockets[2]) == BGE_FAILURE,
+                                    "removed socket can't be removed");
+
+    delete R;
+
+    for(int i = 0; i < NUM_SOCKETS; ++i)
+        delete Sockets[i];
+
+    delete Sender;
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All reactor checks passed\n");
+
+    return 0;
+}
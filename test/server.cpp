@@ -35,7 +35,9 @@ int main(int argc, char* argv[])
     bakge::Packet* Pack;
 
     Pack = Sock->Receive();
-    printf("Received Packet\n");
+    if(Pack != NULL)
+        printf("Received %d byte packet from %s\n", Pack->GetSize(),
+                                Pack->GetSender().GetAddressString());
 
     printf("Deleting received packet\n");
     if(Pack != NULL)
@@ -0,0 +1,262 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Nanoseconds;
+using bakge::FixedTimestep;
+
+#define MS 1000000LL
+#define NUM_DELAYS 50
+#define DELAY_TIME (MS * 3 / 2)
+
+int NumFailures = 0;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+int RunSteps(FixedTimestep* T)
+{
+    int Steps = 0;
+
+    while(T->Step())
+        ++Steps;
+
+    return Steps;
+}
+
+
+void TestAccumulator()
+{
+    FixedTimestep* T;
+
+    Check(FixedTimestep::Create(0) == NULL, "zero timestep is refused");
+
+    T = FixedTimestep::Create(0.01);
+    Check(T != NULL, "create 10 ms timestep");
+    if(T == NULL)
+        return;
+
+    Check(T->Advance(25 * MS) == 2, "25 ms makes two steps due");
+    Check(RunSteps(T) == 2, "two steps run");
+    Check(fabs(T->GetAlpha() - 0.5) < 1e-9, "half a step left over");
+
+    /* The leftover carries into the next frame */
+    Check(T->Advance(5 * MS) == 1, "leftover completes a step");
+    Check(RunSteps(T) == 1, "one step run");
+    Check(T->GetAlpha() < 1e-9, "nothing left over");
+
+    Check(T->Advance(3 * MS) == 0, "short frame makes no step due");
+    Check(RunSteps(T) == 0, "no steps run");
+
+    /* Long stalls are clamped instead of building a backlog */
+    Check(T->SetMaxFrameTime(0.001) == BGE_FAILURE,
+                            "max frame time shorter than a step is refused");
+    Check(T->SetMaxFrameTime(0.05) == BGE_SUCCESS, "set max frame time");
+    T->ResetJitterStats();
+    T->Advance(1000 * MS);
+    Check(RunSteps(T) == 5, "stall clamped to five steps");
+
+    bakge::FrameJitterStats Stats;
+    T->GetJitterStats(&Stats);
+    Check(Stats.DroppedTime == 950 * MS, "clamped time counted as dropped");
+    Check(Stats.NumSteps == 5, "steps counted");
+
+    delete T;
+}
+
+
+void TestJitter()
+{
+    FixedTimestep* T;
+    bakge::FrameJitterStats Stats;
+
+    T = FixedTimestep::Create(0.01);
+    if(T == NULL)
+        return;
+
+    T->GetJitterStats(&Stats);
+    Check(Stats.NumFrames == 0 && Stats.MeanFrameTime == 0,
+                                            "no frames, empty stats");
+
+    for(int i = 0; i < 10; ++i) {
+        T->Advance(i % 2 == 0 ? 10 * MS : 20 * MS);
+        RunSteps(T);
+    }
+
+    T->GetJitterStats(&Stats);
+    Check(Stats.NumFrames == 10, "frames counted");
+    Check(Stats.MinFrameTime == 10 * MS, "minimum frame time");
+    Check(Stats.MaxFrameTime == 20 * MS, "maximum frame time");
+    Check(Stats.MeanFrameTime == 15 * MS, "mean frame time");
+    Check(Stats.MeanJitter == 10 * MS, "frame to frame jitter");
+    Check(llabs(Stats.FrameTimeDeviation - 5270462) < 1000,
+                                            "frame time deviation");
+    Check(Stats.NumSteps == 15, "steps follow frame time");
+
+    T->ResetJitterStats();
+    T->GetJitterStats(&Stats);
+    Check(Stats.NumFrames == 0 && Stats.NumSteps == 0, "stats reset");
+
+    delete T;
+}
+
+
+void TestClock()
+{
+    Nanoseconds Start;
+    Nanoseconds Last;
+    Nanoseconds Now;
+    bakge::Microseconds Micro;
+    bool Monotonic = true;
+
+    Start = bakge::GetRunningNanoseconds();
+    Micro = bakge::GetRunningTime();
+    Check(llabs(Start / 1000 - (Nanoseconds)Micro) < 1000,
+                    "nanosecond clock agrees with microsecond clock");
+
+    Last = Start;
+    for(int i = 0; i < 100000; ++i) {
+        Now = bakge::GetRunningNanoseconds();
+        if(Now < Last)
+            Monotonic = false;
+        Last = Now;
+    }
+
+    Check(Monotonic, "nanosecond clock never goes backwards");
+
+    Start = bakge::GetRunningNanoseconds();
+    Check(bakge::Delay(2000) == BGE_SUCCESS, "delay succeeds");
+    Check(bakge::GetRunningNanoseconds() - Start >= 2 * MS,
+                                            "delay waits long enough");
+}
+
+
+void TestPreciseDelay()
+{
+    bakge::DelayStats Stats;
+    Nanoseconds Start;
+    Nanoseconds Overshoot;
+    Nanoseconds TotalDelayOvershoot = 0;
+    Nanoseconds MaxDelayOvershoot = 0;
+    bool Early = false;
+
+    for(int i = 0; i < NUM_DELAYS; ++i) {
+        Start = bakge::GetRunningNanoseconds();
+        bakge::Delay(DELAY_TIME / 1000);
+        Overshoot = bakge::GetRunningNanoseconds() - Start - DELAY_TIME;
+        TotalDelayOvershoot += Overshoot;
+        if(Overshoot > MaxDelayOvershoot)
+            MaxDelayOvershoot = Overshoot;
+    }
+
+    bakge::ResetDelayStats();
+
+    for(int i = 0; i < NUM_DELAYS; ++i) {
+        Start = bakge::GetRunningNanoseconds();
+        bakge::PreciseDelay(DELAY_TIME);
+        if(bakge::GetRunningNanoseconds() - Start < DELAY_TIME)
+            Early = true;
+    }
+
+    bakge::GetDelayStats(&Stats);
+    Check(!Early, "precise delay never returns early");
+    Check(Stats.NumDelays == NUM_DELAYS, "precise delays counted");
+    Check(Stats.MeanOvershoot >= 0 && Stats.MaxOvershoot >= 0,
+                                            "overshoot is never negative");
+
+    printf("Delay(%lld us)        overshoot: mean %8lld ns, max %8lld ns\n",
+                        DELAY_TIME / 1000,
+                        (long long)(TotalDelayOvershoot / NUM_DELAYS),
+                        (long long)MaxDelayOvershoot);
+    printf("PreciseDelay(%lld us) overshoot: mean %8lld ns, max %8lld ns\n",
+                    DELAY_TIME / 1000, (long long)Stats.MeanOvershoot,
+                    (long long)Stats.MaxOvershoot);
+    printf("  %lld slices, overshoot: mean %lld ns, max %lld ns; "
+                "%lld ns spinning\n", Stats.NumSlices,
+                (long long)Stats.MeanSliceOvershoot,
+                (long long)Stats.MaxSliceOvershoot,
+                (long long)Stats.SpinTime);
+
+    bakge::ResetDelayStats();
+    bakge::GetDelayStats(&Stats);
+    Check(Stats.NumDelays == 0 && Stats.NumSlices == 0, "delay stats reset");
+}
+
+
+void TestPacing()
+{
+    FixedTimestep* T;
+    int Steps = 0;
+
+    T = FixedTimestep::Create(0.01);
+    if(T == NULL)
+        return;
+
+    Check(T->BeginFrame() == 0, "first frame only starts the clock");
+
+    /* Wait for each step to fall due, as a paced frame loop would */
+    for(int i = 0; i < 5; ++i) {
+        bakge::PreciseDelayUntil(T->GetNextStepTime());
+        T->BeginFrame();
+        Steps += RunSteps(T);
+    }
+
+    Check(Steps >= 5, "each paced frame runs a step");
+    Check(T->GetLastFrameTime() >= 0.0099, "paced frame lasts a step");
+
+    delete T;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    TestAccumulator();
+    TestJitter();
+    TestClock();
+    TestPreciseDelay();
+    TestPacing();
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All timestep checks passed\n");
+
+    return 0;
+}
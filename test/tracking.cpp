@@ -0,0 +1,215 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::MemoryStats;
+
+#define NUM_ALLOCATIONS 1000000
+
+int NumFailures = 0;
+
+/* Keeps results alive so benchmarks aren't optimized away */
+volatile long long Sink;
+
+
+void Check(bool Passed, const char* What)
+{
+    if(!Passed) {
+        printf("FAILED: %s\n", What);
+        ++NumFailures;
+    }
+}
+
+
+double Milliseconds(bakge::Microseconds Start)
+{
+    return (bakge::GetRunningTime() - Start) / 1000.0;
+}
+
+
+size_t LiveBytes(int Tag)
+{
+    MemoryStats Stats;
+
+    bakge::GetMemoryStats(Tag, &Stats);
+
+    return Stats.LiveBytes;
+}
+
+
+void CheckTrackedAllocations()
+{
+    MemoryStats Before, After;
+    char* Memory;
+
+    bakge::GetMemoryStats(bakge::MEMORY_TAG_FILE, &Before);
+
+    Memory = (char*)bakge::TrackedMalloc(100, bakge::MEMORY_TAG_FILE);
+    Check(((size_t)Memory & 15) == 0, "tracked memory is 16-byte aligned");
+    memset(Memory, 1, 100);
+
+    Memory = (char*)bakge::TrackedRealloc(Memory, 1000,
+                                            bakge::MEMORY_TAG_FILE);
+    Check(Memory[99] == 1, "tracked realloc keeps contents");
+
+#ifdef BGE_TRACK_MEMORY
+    Check(LiveBytes(bakge::MEMORY_TAG_FILE) == Before.LiveBytes + 1000,
+                                        "realloc updates live bytes");
+#endif /* BGE_TRACK_MEMORY */
+
+    bakge::TrackedFree(Memory);
+    bakge::GetMemoryStats(bakge::MEMORY_TAG_FILE, &After);
+    Check(After.LiveBytes == Before.LiveBytes, "free returns live bytes");
+
+#ifdef BGE_TRACK_MEMORY
+    Check(After.PeakBytes >= Before.LiveBytes + 1000, "peak is kept");
+    Check(After.NumAllocations == Before.NumAllocations + 2,
+                                        "allocations are counted");
+    Check(After.NumFrees == Before.NumFrees + 1, "frees are counted");
+#else
+    Check(After.NumAllocations == 0, "nothing counted when compiled out");
+#endif /* BGE_TRACK_MEMORY */
+}
+
+
+void CheckTaggedSubsystems()
+{
+    size_t Math = LiveBytes(bakge::MEMORY_TAG_MATH);
+    size_t Network = LiveBytes(bakge::MEMORY_TAG_NETWORK);
+    bakge::VectorStream* V;
+    bakge::ObjectPool<int>* Pool;
+    int* Object;
+
+    V = bakge::VectorStream::Create(1000);
+    Pool = new bakge::ObjectPool<int>("Tagged", false,
+                                        bakge::MEMORY_TAG_NETWORK);
+    Object = Pool->Create();
+
+#ifdef BGE_TRACK_MEMORY
+    Check(LiveBytes(bakge::MEMORY_TAG_MATH)
+                            >= Math + 4000 * sizeof(bakge::Scalar),
+                                        "vector streams count as math");
+    Check(LiveBytes(bakge::MEMORY_TAG_NETWORK) > Network,
+                                        "pools count under their tag");
+#endif /* BGE_TRACK_MEMORY */
+
+    Pool->Destroy(Object);
+    delete Pool;
+    delete V;
+
+    Check(LiveBytes(bakge::MEMORY_TAG_MATH) == Math, "math memory freed");
+    Check(LiveBytes(bakge::MEMORY_TAG_NETWORK) == Network,
+                                        "pool memory freed");
+}
+
+
+/* Makes the calls a lua_State makes over its life */
+void CheckLuaAllocator()
+{
+    size_t Script = LiveBytes(bakge::MEMORY_TAG_SCRIPT);
+    void* Table;
+    void* String;
+
+    /* New blocks pass the type of object as the old size */
+    Table = bakge::TrackedLuaAllocator(NULL, NULL, 5, 64);
+    String = bakge::TrackedLuaAllocator(NULL, NULL, 4, 32);
+    Table = bakge::TrackedLuaAllocator(NULL, Table, 64, 256);
+
+#ifdef BGE_TRACK_MEMORY
+    Check(LiveBytes(bakge::MEMORY_TAG_SCRIPT) == Script + 288,
+                                        "Lua memory is counted");
+#endif /* BGE_TRACK_MEMORY */
+
+    Check(bakge::TrackedLuaAllocator(NULL, Table, 256, 0) == NULL,
+                                        "Lua free returns NULL");
+    bakge::TrackedLuaAllocator(NULL, String, 32, 0);
+    Check(LiveBytes(bakge::MEMORY_TAG_SCRIPT) == Script,
+                                        "Lua frees are counted");
+}
+
+
+void Benchmark()
+{
+    void** Blocks = new void*[1000];
+    bakge::Microseconds Start;
+    long long Sum = 0;
+
+    printf("%d allocations and frees of 16-1024 bytes\n", NUM_ALLOCATIONS);
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_ALLOCATIONS; i += 1000) {
+        for(int j = 0; j < 1000; ++j)
+            Blocks[j] = malloc(16 + (j * 37) % 1009);
+
+        for(int j = 0; j < 1000; ++j) {
+            Sum += (size_t)Blocks[j] & 0xFF;
+            free(Blocks[j]);
+        }
+    }
+    printf("  malloc/free            %8.1f ms\n", Milliseconds(Start));
+
+    Start = bakge::GetRunningTime();
+    for(int i = 0; i < NUM_ALLOCATIONS; i += 1000) {
+        for(int j = 0; j < 1000; ++j)
+            Blocks[j] = bakge::TrackedMalloc(16 + (j * 37) % 1009,
+                                            j % bakge::NUM_MEMORY_TAGS);
+
+        for(int j = 0; j < 1000; ++j) {
+            Sum += (size_t)Blocks[j] & 0xFF;
+            bakge::TrackedFree(Blocks[j]);
+        }
+    }
+    printf("  TrackedMalloc/Free     %8.1f ms\n", Milliseconds(Start));
+
+    Sink = Sum;
+    delete[] Blocks;
+}
+
+
+int main(int argc, char* argv[])
+{
+    bakge::Init(argc, argv);
+
+    CheckTrackedAllocations();
+    CheckTaggedSubsystems();
+    CheckLuaAllocator();
+
+    Benchmark();
+
+    bakge::ReportMemory();
+
+    bakge::Deinit();
+
+    if(NumFailures > 0) {
+        printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+
+    printf("All checks passed\n");
+
+    return 0;
+}
@@ -0,0 +1,259 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Vector4;
+using bakge::Quaternion;
+using bakge::Matrix;
+using bakge::Transform;
+using bakge::DualQuaternion;
+
+#define NUM_JOINTS 10000
+#define NUM_ROUNDS 200
+
+Transform PoseA[NUM_JOINTS];
+Transform PoseB[NUM_JOINTS];
+Transform PoseOut[NUM_JOINTS];
+Transform PoseRef[NUM_JOINTS];
+
+DualQuaternion DualA[NUM_JOINTS];
+DualQuaternion DualB[NUM_JOINTS];
+DualQuaternion DualOut[NUM_JOINTS];
+DualQuaternion DualRef[NUM_JOINTS];
+
+/* Keeps the compiler from discarding results of the timed loops */
+volatile Scalar Sink;
+
+int NumFailures = 0;
+
+
+Scalar RandomScalar()
+{
+    return (Scalar)(rand() % 2000 - 1000) / 100.0f;
+}
+
+
+Quaternion RandomRotation()
+{
+    return Quaternion::FromEulerAngles(RandomScalar(), RandomScalar(),
+                                                    RandomScalar());
+}
+
+
+void Check(const char* Name, bool Passed)
+{
+    printf("%-36s %s\n", Name, Passed ? "ok" : "FAILED");
+
+    if(!Passed)
+        ++NumFailures;
+}
+
+
+bool NearlyEqual(Vector4 BGE_NCP A, Vector4 BGE_NCP B)
+{
+    for(int i = 0; i < 4; ++i) {
+        if(fabsf(A[i] - B[i]) > 1e-3f * (1 + fabsf(A[i])))
+            return false;
+    }
+
+    return true;
+}
+
+
+bool NearlyEqual(Matrix BGE_NCP A, Matrix BGE_NCP B)
+{
+    for(int i = 0; i < 16; ++i) {
+        if(fabsf(A[i] - B[i]) > 1e-3f * (1 + fabsf(A[i])))
+            return false;
+    }
+
+    return true;
+}
+
+
+double NanosecondsPerJoint(bakge::Microseconds Elapsed)
+{
+    return (double)Elapsed * 1000.0 / (double)(NUM_ROUNDS * NUM_JOINTS);
+}
+
+
+int main(int argc, char* argv[])
+{
+    Vector4 P = bakge::Point(1, -2, 3);
+    Vector4 V = bakge::Vector(-4, 5, 0.5f);
+    bakge::Microseconds Start;
+    double RefNs, SIMDNs;
+
+    bakge::Init(argc, argv);
+
+    srand(0);
+    for(int i = 0; i < NUM_JOINTS; ++i) {
+        Vector4 Offset = bakge::Vector(RandomScalar(), RandomScalar(),
+                                                        RandomScalar());
+
+        PoseA[i] = Transform(Offset, RandomRotation(), bakge::Vector(1 +
+                    (i % 3), 1 + (i % 5) * 0.5f, 1 + (i % 7) * 0.25f));
+        PoseB[i] = Transform(-Offset, RandomRotation(), bakge::Vector(1,
+                                                                1, 1));
+        DualA[i] = DualQuaternion::FromTransform(PoseA[i]);
+        DualB[i] = DualQuaternion::FromTransform(PoseB[i]);
+    }
+
+    /* Transform */
+    {
+        Transform A = PoseA[1];
+        Transform B = PoseA[2];
+        Transform U(bakge::Vector(3, 2, 1), RandomRotation(),
+                                        bakge::Vector(2, 2, 2));
+
+        A.SetScale(1.5f);
+        B.SetScale(0.5f);
+
+        Check("Transform * Vec matches ToMatrix",
+                NearlyEqual(PoseA[0] * P, PoseA[0].ToMatrix() * P)
+                && NearlyEqual(PoseA[0] * V, PoseA[0].ToMatrix() * V));
+        Check("Transform composition",
+                NearlyEqual((A * B).ToMatrix(), A.ToMatrix() * B.ToMatrix())
+                && NearlyEqual((A * B) * P, A * (B * P)));
+        Check("Transform inverse",
+                NearlyEqual(U.Inverted() * (U * P), P)
+                && NearlyEqual((U * U.Inverted()).ToMatrix(), Matrix()));
+        Check("Transform blend endpoints",
+                NearlyEqual(Transform::Blend(A, B, 0).ToMatrix(),
+                                                    A.ToMatrix())
+                && NearlyEqual(Transform::Blend(A, B, 1).ToMatrix(),
+                                                    B.ToMatrix()));
+    }
+
+    /* DualQuaternion */
+    {
+        Transform Rigid = PoseB[0];
+        DualQuaternion D = DualA[1];
+        DualQuaternion E = DualA[2];
+        DualQuaternion Joints[3] = { DualA[0], DualA[0], DualB[0] };
+        Scalar Weights[3] = { 0.25f, 0.75f, 0 };
+
+        Check("DualQuaternion matches Transform",
+                NearlyEqual(DualQuaternion::FromTransform(Rigid).ToMatrix(),
+                                                    Rigid.ToMatrix())
+                && NearlyEqual(DualB[0] * P, Rigid * P)
+                && NearlyEqual(DualB[0] * V, Rigid * V));
+        Check("DualQuaternion translation",
+                NearlyEqual(DualB[0].GetTranslation(),
+                                            Rigid.GetTranslation()));
+        Check("DualQuaternion composition",
+                NearlyEqual((D * E).ToMatrix(), D.ToMatrix() * E.ToMatrix()));
+        Check("DualQuaternion inverse",
+                NearlyEqual(D.Inverted() * (D * P), P)
+                && NearlyEqual((D * D.Inverted()).ToMatrix(), Matrix()));
+        Check("DualQuaternion blend endpoints",
+                NearlyEqual(DualQuaternion::Blend(D, E, 0).ToMatrix(),
+                                                    D.ToMatrix())
+                && NearlyEqual(DualQuaternion::Blend(D, E, 1).ToMatrix(),
+                                                    E.ToMatrix()));
+        Check("DualQuaternion weighted blend",
+                NearlyEqual(DualQuaternion::Blend(Joints, Weights,
+                                            3).ToMatrix(), D.ToMatrix())
+                || NearlyEqual(DualQuaternion::Blend(Joints, Weights,
+                                    3).ToMatrix(), DualA[0].ToMatrix()));
+        Check("DualQuaternion normalize",
+                NearlyEqual((D * E * D * E).Normalized().ToMatrix(),
+                    D.ToMatrix() * E.ToMatrix() * D.ToMatrix()
+                                                * E.ToMatrix()));
+    }
+
+    /* Batched blends agree with the scalar reference exactly */
+    Transform::BlendMany(PoseA, PoseB, 0.3f, PoseOut, NUM_JOINTS);
+    for(int i = 0; i < NUM_JOINTS; ++i)
+        PoseRef[i] = Transform::Blend(PoseA[i], PoseB[i], 0.3f);
+    Check("Transform::BlendMany matches Blend",
+            memcmp(PoseOut, PoseRef, sizeof(PoseOut)) == 0);
+
+    DualQuaternion::BlendMany(DualA, DualB, 0.3f, DualOut, NUM_JOINTS);
+    for(int i = 0; i < NUM_JOINTS; ++i)
+        DualRef[i] = DualQuaternion::Blend(DualA[i], DualB[i], 0.3f);
+    Check("DualQuaternion::BlendMany matches Blend",
+            memcmp(DualOut, DualRef, sizeof(DualOut)) == 0);
+
+    bakge::TransformBlendsRef((Scalar*)PoseA, (Scalar*)PoseB, 0.3f,
+                                        (Scalar*)PoseRef, NUM_JOINTS);
+    Check("TransformBlends matches reference",
+            memcmp(PoseOut, PoseRef, sizeof(PoseOut)) == 0);
+
+    bakge::DualQuatBlendsRef((Scalar*)DualA, (Scalar*)DualB, 0.3f,
+                                        (Scalar*)DualRef, NUM_JOINTS);
+    Check("DualQuatBlends matches reference",
+            memcmp(DualOut, DualRef, sizeof(DualOut)) == 0);
+
+    /* Benchmarks */
+    printf("\nBlending %d joints, %s\n", NUM_JOINTS, BGE_SIMD_NAME);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        bakge::TransformBlendsRef((Scalar*)PoseA, (Scalar*)PoseB,
+                    r * 0.005f, (Scalar*)PoseRef, NUM_JOINTS);
+        Sink = PoseRef[r].GetScale()[0];
+    }
+    RefNs = NanosecondsPerJoint(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Transform::BlendMany(PoseA, PoseB, r * 0.005f, PoseOut, NUM_JOINTS);
+        Sink = PoseOut[r].GetScale()[0];
+    }
+    SIMDNs = NanosecondsPerJoint(bakge::GetRunningTime() - Start);
+
+    printf("Transform       %8.3f ns/joint %8.3f ns/joint %6.2fx\n", RefNs,
+                                                SIMDNs, RefNs / SIMDNs);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        bakge::DualQuatBlendsRef((Scalar*)DualA, (Scalar*)DualB,
+                    r * 0.005f, (Scalar*)DualRef, NUM_JOINTS);
+        Sink = DualRef[r].GetTranslation()[0];
+    }
+    RefNs = NanosecondsPerJoint(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        DualQuaternion::BlendMany(DualA, DualB, r * 0.005f, DualOut,
+                                                        NUM_JOINTS);
+        Sink = DualOut[r].GetTranslation()[0];
+    }
+    SIMDNs = NanosecondsPerJoint(bakge::GetRunningTime() - Start);
+
+    printf("DualQuaternion  %8.3f ns/joint %8.3f ns/joint %6.2fx\n", RefNs,
+                                                SIMDNs, RefNs / SIMDNs);
+
+    bakge::Deinit();
+
+    if(NumFailures > 0)
+        return 1;
+
+    return 0;
+}
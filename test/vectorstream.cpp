@@ -0,0 +1,225 @@
+/* *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013 Paul Holden et al. (See AUTHORS)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <bakge/Bakge.h>
+
+using bakge::Scalar;
+using bakge::Vector4;
+using bakge::VectorStream;
+
+/* Odd count so the conversions and Dot exercise their remainder loops */
+#define NUM_VECTORS 10001
+#define NUM_ROUNDS 200
+
+Vector4 Positions[NUM_VECTORS];
+Vector4 Velocities[NUM_VECTORS];
+Vector4 Results[NUM_VECTORS];
+Scalar Dots[NUM_VECTORS];
+Scalar StreamDots[NUM_VECTORS];
+
+/* Keeps the compiler from discarding results of the timed loops */
+volatile Scalar Sink;
+
+int NumMismatches = 0;
+
+
+Scalar RandomScalar()
+{
+    return (Scalar)(rand() % 2000 - 1000) / 100.0f;
+}
+
+
+double NanosecondsPerVector(bakge::Microseconds Elapsed)
+{
+    return (double)Elapsed * 1000.0 / (double)(NUM_ROUNDS * NUM_VECTORS);
+}
+
+
+void Report(const char* Name, double AoSNs, double SoANs, bool Match)
+{
+    printf("%-12s %8.3f ns/vec %8.3f ns/vec %7.2fx  %s\n", Name, AoSNs,
+                        SoANs, AoSNs / SoANs, Match ? "match" : "MISMATCH");
+
+    if(!Match)
+        ++NumMismatches;
+}
+
+
+/* Compare the stream against the Vector4 results */
+bool Matches(VectorStream* Stream)
+{
+    static Vector4 Out[NUM_VECTORS];
+
+    Stream->ToVectors(Out, NUM_VECTORS);
+
+    return memcmp(Out, Results, sizeof(Out)) == 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    VectorStream* Pos;
+    VectorStream* Vel;
+    bakge::Matrix M;
+    bakge::Microseconds Start;
+    double AoSNs, SoANs;
+
+    bakge::Init(argc, argv);
+
+    printf("SIMD: %s, %d lanes\n", BGE_SIMD_NAME, BGE_LANE_WIDTH);
+
+    Pos = VectorStream::Create(NUM_VECTORS);
+    Vel = VectorStream::Create(NUM_VECTORS);
+    if(Pos == NULL || Vel == NULL) {
+        printf("Error creating vector streams\n");
+        return 1;
+    }
+
+    srand(0);
+    for(int i = 0; i < NUM_VECTORS; ++i) {
+        Positions[i] = bakge::Point(RandomScalar(), RandomScalar(),
+                                                    RandomScalar());
+        Velocities[i] = bakge::Vector(RandomScalar(), RandomScalar(),
+                                                    RandomScalar());
+    }
+
+    M.SetLookAt(bakge::Point(1, 2, 3), bakge::Point(0, 0, 0),
+                                    bakge::Vector(0, 1, 0));
+    M *= bakge::Matrix(2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 5, -3, 1, 1);
+
+    /* Round trip */
+    Pos->FromVectors(Positions, NUM_VECTORS);
+    Vel->FromVectors(Velocities, NUM_VECTORS);
+    for(int i = 0; i < NUM_VECTORS; ++i)
+        Results[i] = Positions[i];
+
+    if(!Matches(Pos)) {
+        printf("Vectors changed in a FromVectors/ToVectors round trip\n");
+        ++NumMismatches;
+    }
+
+    if(Pos->FromVectors(Positions, 2, NUM_VECTORS - 1) != BGE_FAILURE) {
+        printf("Out of range FromVectors was accepted\n");
+        ++NumMismatches;
+    }
+
+    /* Integrate: Position += Velocity * dt */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_VECTORS; ++i)
+            Results[i] += Velocities[i] * 0.016f;
+        Sink = Results[r][0];
+    }
+    AoSNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Pos->AddScaled(*Vel, 0.016f);
+        Sink = Pos->GetX()[r];
+    }
+    SoANs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+    Report("AddScaled", AoSNs, SoANs, Matches(Pos));
+
+    /* Transform */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        M.TransformPoints(Results, Results, NUM_VECTORS);
+        Sink = Results[r][0];
+    }
+    AoSNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Pos->Transform(M);
+        Sink = Pos->GetX()[r];
+    }
+    SoANs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+    Report("Transform", AoSNs, SoANs, Matches(Pos));
+
+    /* Dot. Done before Normalize so the lengths aren't all 1 */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_VECTORS; ++i)
+            Dots[i] = bakge::Dot(Results[i], Velocities[i]);
+        Sink = Dots[r];
+    }
+    AoSNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Pos->Dot(*Vel, StreamDots);
+        Sink = StreamDots[r];
+    }
+    SoANs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+    Report("Dot", AoSNs, SoANs, memcmp(Dots, StreamDots, sizeof(Dots)) == 0);
+
+    /* Normalize. Repeating it is harmless, lengths just stay near 1 */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_VECTORS; ++i)
+            Results[i].Normalize();
+        Sink = Results[r][0];
+    }
+    AoSNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Pos->Normalize();
+        Sink = Pos->GetX()[r];
+    }
+    SoANs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+    Report("Normalize", AoSNs, SoANs, Matches(Pos));
+
+    /* Cross */
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        for(int i = 0; i < NUM_VECTORS; ++i)
+            Results[i] = bakge::Cross(Results[i], Velocities[i]);
+        Sink = Results[r][0];
+    }
+    AoSNs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+
+    Start = bakge::GetRunningTime();
+    for(int r = 0; r < NUM_ROUNDS; ++r) {
+        Pos->Cross(*Pos, *Vel);
+        Sink = Pos->GetX()[r];
+    }
+    SoANs = NanosecondsPerVector(bakge::GetRunningTime() - Start);
+    Report("Cross", AoSNs, SoANs, Matches(Pos));
+
+    delete Pos;
+    delete Vel;
+
+    bakge::Deinit();
+
+    if(NumMismatches > 0) {
+        printf("%d stream operations disagree with Vector4\n",
+                                                NumMismatches);
+        return 1;
+    }
+
+    return 0;
+}